@@ -4,7 +4,8 @@ CUDASolverInterface::CUDASolverInterface()
 {
 	numRows = 0;
 	numNonZeros = 0;
-	dataType = sizeof(CUDANUMBER) == 8 ? CUDA_R_64F : CUDA_R_32F;
+	factorNonZeros = 0;
+	dataType = sizeof(Ipopt::Number) == 8 ? CUDA_R_64F : CUDA_R_32F;
 	previousNumRHS = 1;
 
 	cudssCreate(&handle);
@@ -14,6 +15,7 @@ CUDASolverInterface::CUDASolverInterface()
 	cudssDataCreate(handle, &solverData);
 
 	AValuesHost = nullptr;
+	AValuesHostSingle = nullptr;
 	AValues = nullptr;
 	ARowPointers = nullptr;
 	AColIndices = nullptr;
@@ -28,16 +30,11 @@ CUDASolverInterface::CUDASolverInterface()
 
 CUDASolverInterface::~CUDASolverInterface()
 {
+	DestroyDeviceMatrices();
 	free(AValuesHost);
-	cudaFree(AValues);
+	free(AValuesHostSingle);
 	cudaFree(ARowPointers);
 	cudaFree(AColIndices);
-	cudaFree(bValues);
-	cudaFree(xValues);
-	
-	cudssMatrixDestroy(AMatrix);
-	cudssMatrixDestroy(bMatrix);
-	cudssMatrixDestroy(xMatrix);
 
 	cudssDataDestroy(handle, solverData);
 	cudssConfigDestroy(solverConfig);
@@ -60,61 +57,161 @@ Ipopt::ESymSolverStatus CUDASolverInterface::InitializeStructure(Ipopt::Index di
 	numRows = dim;
 	numNonZeros = nonzeros;
 
-	AValuesHost = (double*)malloc(numNonZeros * sizeof(CUDANUMBER));
+	free(AValuesHost);
+	AValuesHost = (Ipopt::Number*)malloc(numNonZeros * sizeof(Ipopt::Number));
 	std::fill_n(AValuesHost, numNonZeros, 1.0); // Fill with 1's for symbolic analysis
+	free(AValuesHostSingle);
+	AValuesHostSingle = nullptr;
 
-	cudaMalloc((void**)&AValues, numNonZeros * sizeof(CUDANUMBER));
+	cudaFree(ARowPointers);
+	cudaFree(AColIndices);
 	cudaMalloc((void**)&ARowPointers, (numRows + 1) * sizeof(int));
 	cudaMalloc((void**)&AColIndices, numNonZeros * sizeof(int));
-	cudaMalloc((void**)&xValues, numRows * sizeof(CUDANUMBER));
-	cudaMalloc((void**)&bValues, numRows * sizeof(CUDANUMBER));
-
-	cudaMemcpy(AValues, AValuesHost, numNonZeros * sizeof(CUDANUMBER), cudaMemcpyHostToDevice);
 	cudaMemcpy(ARowPointers, ia, (numRows + 1) * sizeof(int), cudaMemcpyHostToDevice);
 	cudaMemcpy(AColIndices, ja, numNonZeros * sizeof(int), cudaMemcpyHostToDevice);
 
+	CreateDeviceMatrices();
+
+	return Ipopt::SYMSOLVER_SUCCESS;
+}
+
+Ipopt::Number* CUDASolverInterface::GetValuesArrayPtr()
+{
+	return AValuesHost;
+}
+
+Ipopt::ESymSolverStatus CUDASolverInterface::MultiSolve(bool new_matrix, const Ipopt::Index* ia, const Ipopt::Index* ja, Ipopt::Index nrhs, Ipopt::Number* rhs_vals, bool check_NegEVals, Ipopt::Index numberOfNegEVals)
+{
+	cudaDataType_t numberType = sizeof(Ipopt::Number) == 8 ? CUDA_R_64F : CUDA_R_32F;
+	if (dataType != numberType)
+	{
+		SetDataType(numberType);
+		new_matrix = true;
+	}
+	return Solve(new_matrix, nrhs, rhs_vals);
+}
+
+bool CUDASolverInterface::ProvidesSinglePrecision() const
+{
+	return true;
+}
+
+Ipopt::ESymSolverStatus CUDASolverInterface::MultiSolveSingle(bool new_matrix, const Ipopt::Index* ia, const Ipopt::Index* ja, Ipopt::Index nrhs, float* rhs_vals, bool check_NegEVals, Ipopt::Index numberOfNegEVals)
+{
+	if (dataType != CUDA_R_32F)
+	{
+		SetDataType(CUDA_R_32F);
+		new_matrix = true;
+	}
+	return Solve(new_matrix, nrhs, rhs_vals);
+}
+
+size_t CUDASolverInterface::ValueSize() const
+{
+	return dataType == CUDA_R_32F ? sizeof(float) : sizeof(double);
+}
+
+void CUDASolverInterface::CreateDeviceMatrices()
+{
+	DestroyDeviceMatrices();
+
+	cudaMalloc(&AValues, numNonZeros * ValueSize());
+	cudaMalloc(&xValues, numRows * previousNumRHS * ValueSize());
+	cudaMalloc(&bValues, numRows * previousNumRHS * ValueSize());
+	CopyValuesToDevice();
+
 	cudssMatrixCreateCsr(&AMatrix, numRows, numRows, numNonZeros, ARowPointers, NULL, AColIndices, AValues, CUDA_R_32I, dataType, CUDSS_MTYPE_SYMMETRIC, CUDSS_MVIEW_UPPER, CUDSS_BASE_ZERO);
 
-	cudssMatrixCreateDn(&xMatrix, numRows, 1, numRows, xValues, dataType, CUDSS_LAYOUT_COL_MAJOR);
-	cudssMatrixCreateDn(&bMatrix, numRows, 1, numRows, bValues, dataType, CUDSS_LAYOUT_COL_MAJOR);
+	cudssMatrixCreateDn(&xMatrix, numRows, previousNumRHS, numRows, xValues, dataType, CUDSS_LAYOUT_COL_MAJOR);
+	cudssMatrixCreateDn(&bMatrix, numRows, previousNumRHS, numRows, bValues, dataType, CUDSS_LAYOUT_COL_MAJOR);
 
 	cudssExecute(handle, CUDSS_PHASE_ANALYSIS, solverConfig, solverData, AMatrix, xMatrix, bMatrix); // Symbolic analysis
 	cudaStreamSynchronize(stream);
 
-	return Ipopt::SYMSOLVER_SUCCESS;
+	size_t sizeWritten = 0;
+	factorNonZeros = 0;
+	cudssDataGet(handle, solverData, CUDSS_DATA_LU_NNZ, &factorNonZeros, sizeof(factorNonZeros), &sizeWritten);
 }
 
-Ipopt::Number* CUDASolverInterface::GetValuesArrayPtr()
+void CUDASolverInterface::DestroyDeviceMatrices()
 {
-	return AValuesHost;
+	cudssMatrixDestroy(AMatrix);
+	cudssMatrixDestroy(bMatrix);
+	cudssMatrixDestroy(xMatrix);
+	AMatrix = NULL;
+	bMatrix = NULL;
+	xMatrix = NULL;
+
+	cudaFree(AValues);
+	cudaFree(bValues);
+	cudaFree(xValues);
+	AValues = nullptr;
+	bValues = nullptr;
+	xValues = nullptr;
 }
 
-Ipopt::ESymSolverStatus CUDASolverInterface::MultiSolve(bool new_matrix, const Ipopt::Index* ia, const Ipopt::Index* ja, Ipopt::Index nrhs, Ipopt::Number* rhs_vals, bool check_NegEVals, Ipopt::Index numberOfNegEVals)
+void CUDASolverInterface::SetDataType(cudaDataType_t type)
+{
+	dataType = type;
+
+	// The analysis was done for the matrix of the previous type
+	cudssDataDestroy(handle, solverData);
+	cudssDataCreate(handle, &solverData);
+	CreateDeviceMatrices();
+}
+
+void CUDASolverInterface::CopyValuesToDevice()
+{
+	if (ValueSize() == sizeof(Ipopt::Number))
+	{
+		cudaMemcpy(AValues, AValuesHost, numNonZeros * sizeof(Ipopt::Number), cudaMemcpyHostToDevice);
+		return;
+	}
+
+	if (AValuesHostSingle == nullptr)
+	{
+		AValuesHostSingle = (float*)malloc(numNonZeros * sizeof(float));
+	}
+	for (int i = 0; i < numNonZeros; i++)
+	{
+		AValuesHostSingle[i] = (float)AValuesHost[i];
+	}
+	cudaMemcpy(AValues, AValuesHostSingle, numNonZeros * sizeof(float), cudaMemcpyHostToDevice);
+}
+
+Ipopt::ESymSolverStatus CUDASolverInterface::Solve(bool new_matrix, Ipopt::Index nrhs, void* rhs_vals)
 {
 	if (nrhs != previousNumRHS)
 	{
+		cudssMatrixDestroy(bMatrix);
 		cudaFree(bValues);
-		cudaMalloc((void**)&bValues, numRows * nrhs * sizeof(CUDANUMBER));
+		cudaMalloc(&bValues, numRows * nrhs * ValueSize());
 		cudssMatrixCreateDn(&bMatrix, numRows, nrhs, numRows, bValues, dataType, CUDSS_LAYOUT_COL_MAJOR);
 
+		cudssMatrixDestroy(xMatrix);
 		cudaFree(xValues);
-		cudaMalloc((void**)&xValues, numRows * nrhs * sizeof(CUDANUMBER));
+		cudaMalloc(&xValues, numRows * nrhs * ValueSize());
 		cudssMatrixCreateDn(&xMatrix, numRows, nrhs, numRows, xValues, dataType, CUDSS_LAYOUT_COL_MAJOR);
 	}
-	cudaMemcpy(bValues, rhs_vals, numRows * nrhs * sizeof(CUDANUMBER), cudaMemcpyHostToDevice);
+	cudaMemcpy(bValues, rhs_vals, numRows * nrhs * ValueSize(), cudaMemcpyHostToDevice);
 	previousNumRHS = nrhs;
 
 	if (new_matrix)
 	{
-		cudaMemcpy(AValues, AValuesHost, numNonZeros * sizeof(CUDANUMBER), cudaMemcpyHostToDevice);
+		CopyValuesToDevice();
 
 		cudssExecute(handle, CUDSS_PHASE_FACTORIZATION, solverConfig, solverData, AMatrix, xMatrix, bMatrix);
+
+		if (HaveIpData() && factorNonZeros > 0)
+		{
+			IpData().Set_info_factorization_size((Ipopt::Number)numNonZeros, (Ipopt::Number)factorNonZeros);
+		}
 	}
 	
 	cudssExecute(handle, CUDSS_PHASE_SOLVE, solverConfig, solverData, AMatrix, xMatrix, bMatrix);
 	cudaStreamSynchronize(stream);
 	
-	cudaMemcpy(rhs_vals, xValues, numRows * nrhs * sizeof(CUDANUMBER), cudaMemcpyDeviceToHost);
+	cudaMemcpy(rhs_vals, xValues, numRows * nrhs * ValueSize(), cudaMemcpyDeviceToHost);
 
 	return Ipopt::SYMSOLVER_SUCCESS;
 }
@@ -1,12 +1,6 @@
 #ifndef IP_CUDA_SOLVER_INTERFACE_H
 #define IP_CUDA_SOLVER_INTERFACE_H
 
-#ifdef IPOPT_SINGLE
-#define CUDANUMBER float
-#else
-#define CUDANUMBER double
-#endif
-
 #include "IpoptConfig.h"
 #include "IpSparseSymLinearSolverInterface.hpp"
 #include "IpLibraryLoader.hpp"
@@ -30,9 +24,24 @@ public:
     Ipopt::SparseSymLinearSolverInterface::EMatrixFormat MatrixFormat() const;
     bool ProvidesDegeneracyDetection() const;
     Ipopt::ESymSolverStatus DetermineDependentRows(const Ipopt::Index* ia, const Ipopt::Index* ja, std::list<Ipopt::Index>& c_deps);
+    bool ProvidesSinglePrecision() const;
+    Ipopt::ESymSolverStatus MultiSolveSingle(bool new_matrix, const Ipopt::Index* ia, const Ipopt::Index* ja, Ipopt::Index nrhs, float* rhs_vals, bool check_NegEVals, Ipopt::Index numberOfNegEVals);
 private:
+    // Size of one value on the device for the current dataType
+    size_t ValueSize() const;
+    // (Re)creates the device arrays and matrices for the current dataType and does the symbolic analysis
+    void CreateDeviceMatrices();
+    void DestroyDeviceMatrices();
+    // Switches the precision of the factorization; the matrix has to be factorized again afterwards
+    void SetDataType(cudaDataType_t type);
+    // Copies AValuesHost to the device, converting to single precision if required
+    void CopyValuesToDevice();
+    // rhs_vals holds values of the current dataType
+    Ipopt::ESymSolverStatus Solve(bool new_matrix, Ipopt::Index nrhs, void* rhs_vals);
+
     int numRows; // Square matrix, same as number of columns
     int numNonZeros;
+    int64_t factorNonZeros; // number of nonzeros in the factor, from the symbolic analysis
     cudaDataType_t dataType;
     int previousNumRHS;
 
@@ -41,16 +50,17 @@ private:
     cudssConfig_t solverConfig;
     cudssData_t solverData;
 
-    CUDANUMBER* AValuesHost;
-    CUDANUMBER* AValues;
+    Ipopt::Number* AValuesHost;
+    float* AValuesHostSingle; // single precision copy of AValuesHost, if required
+    void* AValues;
     int* ARowPointers;
     int* AColIndices;
     cudssMatrix_t AMatrix;
 
-    CUDANUMBER* bValues;
+    void* bValues;
     cudssMatrix_t bMatrix;
 
-    CUDANUMBER* xValues;
+    void* xValues;
     cudssMatrix_t xMatrix;
 };
 
@@ -14,6 +14,7 @@
 #include "IpCGPenaltyCq.hpp"
 
 #include "IpStdAugSystemSolver.hpp"
+#include "IpIterativeAugSystemSolver.hpp"
 #include "IpAugRestoSystemSolver.hpp"
 #include "IpPDFullSpaceSolver.hpp"
 #include "IpPDPerturbationHandler.hpp"
@@ -32,6 +33,7 @@
 #include "IpQualityFunctionMuOracle.hpp"
 #include "IpRestoMinC_1Nrm.hpp"
 #include "IpLeastSquareMults.hpp"
+#include "IpNormalEqMults.hpp"
 #include "IpDefaultIterateInitializer.hpp"
 #include "IpWarmStartIterateInitializer.hpp"
 #include "IpOrigIterationOutput.hpp"
@@ -50,6 +52,7 @@
 #include "IpEquilibrationScaling.hpp"
 #include "IpExactHessianUpdater.hpp"
 #include "IpSlackBasedTSymScalingMethod.hpp"
+#include "IpRuizTSymScalingMethod.hpp"
 
 #include "IpLinearSolvers.h"
 #include "IpMa27TSolverInterface.hpp"
@@ -58,6 +61,7 @@
 #include "IpMa86SolverInterface.hpp"
 #include "IpMa97SolverInterface.hpp"
 #include "IpMc19TSymScalingMethod.hpp"
+#include "IpOutOfCoreLdlSolverInterface.hpp"
 #include "IpPardisoSolverInterface.hpp"
 #ifdef IPOPT_HAS_PARDISO_MKL
 # include "IpPardisoMKLSolverInterface.hpp"
@@ -210,6 +214,12 @@ void AlgorithmBuilder::RegisterOptions(
 	  descrs.push_back("use the CUDA package from NVIDIA");
    }
 
+   options.push_back("oocldl");
+   descrs.push_back("use the in-tree supernodal LDL^T solver that keeps the factor on disk if it exceeds the memory limit");
+
+   options.push_back("sqmr");
+   descrs.push_back("use the in-tree SQMR solver with incomplete LDL^T preconditioner (only for the inexact step computation)");
+
    options.push_back("custom");
    descrs.push_back("use custom linear solver (expert use)");
 
@@ -307,12 +317,25 @@ void AlgorithmBuilder::RegisterOptions(
    options.push_back("slack-based");
    descrs.push_back("use the slack values");
 
+   options.push_back("ruiz");
+   descrs.push_back("use the native symmetric Ruiz equilibration");
+
    roptions->AddStringOption(
       "linear_system_scaling", "Method for scaling the linear system.",
       defaultsolver,
       options, descrs,
       longdescr);
 
+   roptions->AddStringOption2(
+      "aug_system_solver",
+      "Method for solving the augmented system.",
+      "direct",
+      "direct", "factorize the assembled augmented system with the selected linear solver",
+      "minres", "use preconditioned MINRES on the unassembled augmented system",
+      "The MINRES solver never forms the augmented system matrix and only needs memory for a few vectors, "
+      "but it does not provide the inertia of the system and may need many iterations for ill-conditioned systems.",
+      true);
+
    // have hsllib option if some HSL solvers are not linked but can be loaded
    if( (availablesolverslinked ^ availablesolvers) & IPOPTLINEARSOLVER_ALLHSL )
       roptions->AddStringOption1(
@@ -340,19 +363,9 @@ void AlgorithmBuilder::RegisterOptions(
    options.push_back("gradient-based");
    descrs.push_back("scale the problem so the maximum gradient at the starting point is nlp_scaling_max_gradient");
 
-   if( availablesolvers & IPOPTLINEARSOLVER_MC19 )
-   {
-      options.push_back("equilibration-based");
-      descrs.push_back("scale the problem so that first derivatives are of order 1 at random points");
-      if( availablesolverslinked & IPOPTLINEARSOLVER_MC19 )
-      {
-         descrs.back() += " (uses Harwell routine MC19)";
-      }
-      else
-      {
-         descrs.back() += " (load the Harwell routine MC19 from library at runtime)";
-      }
-   }
+   options.push_back("equilibration-based");
+   descrs.push_back("scale the problem so that first derivatives are of order 1 at random points "
+                    "(see \"nlp_scaling_equilibration_method\")");
    roptions->AddStringOption(
       "nlp_scaling_method", "Select the technique used for scaling the NLP.",
       "gradient-based",
@@ -414,6 +427,19 @@ void AlgorithmBuilder::RegisterOptions(
       "Only the \"filter\" choice is officially supported. "
       "But sometimes, good results might be obtained with the other choices.",
       true);
+
+   roptions->SetRegisteringCategory("Initialization");
+   roptions->AddStringOption2(
+      "least_square_mults_method",
+      "Method for computing least-square estimates of the constraint multipliers.",
+      "augmented-system",
+      "augmented-system", "solve an augmented system with the linear solver of the step computation",
+      "normal-equations", "solve the normal equations of the constraint Jacobian with the conjugate gradient method",
+      "The estimates are used for the initial multipliers and, if \"recalc_y\" is chosen, to recompute the multipliers. "
+      "The normal equations only need the Jacobian and no factorization, which is cheaper for problems with few "
+      "constraints compared to the number of variables. "
+      "If the conjugate gradient method does not converge, the augmented system is used.",
+      true);
    roptions->SetRegisteringCategory("Undocumented");
    roptions->AddBoolOption(
       "wsmp_iterative",
@@ -534,11 +560,21 @@ SmartPtr<SymLinearSolver> AlgorithmBuilder::SymLinearSolverFactory(
    }
 #endif
 
+   else if( linear_solver == "oocldl" )
+   {
+      SolverInterface = new OutOfCoreLdlSolverInterface();
+   }
+
    else if( linear_solver == "custom" )
    {
       SolverInterface = NULL;
    }
 
+   else if( linear_solver == "sqmr" )
+   {
+      THROW_EXCEPTION(OPTION_INVALID, "Linear solver sqmr can only be used with the inexact step computation");
+   }
+
    else
    {
       // this should have been checked earlier
@@ -560,6 +596,10 @@ SmartPtr<SymLinearSolver> AlgorithmBuilder::SymLinearSolverFactory(
    {
       ScalingMethod = new SlackBasedTSymScalingMethod();
    }
+   else if( linear_system_scaling == "ruiz" )
+   {
+      ScalingMethod = new RuizTSymScalingMethod();
+   }
 #ifndef IPOPT_INT64
    else if( linear_system_scaling == "mc19" )
    {
@@ -604,7 +644,16 @@ SmartPtr<AugSystemSolver> AlgorithmBuilder::AugSystemSolverFactory(
    }
    else
    {
-      AugSolver = new StdAugSystemSolver(*GetSymLinearSolver(jnlst, options, prefix));
+      std::string aug_system_solver;
+      options.GetStringValue("aug_system_solver", aug_system_solver, prefix);
+      if( aug_system_solver == "minres" )
+      {
+         AugSolver = new IterativeAugSystemSolver();
+      }
+      else
+      {
+         AugSolver = new StdAugSystemSolver(*GetSymLinearSolver(jnlst, options, prefix));
+      }
    }
 
    Index enum_int;
@@ -679,8 +728,37 @@ SmartPtr<PDSystemSolver> AlgorithmBuilder::PDSystemSolverFactory(
       pertHandler = new PDPerturbationHandler();
    }
 
-   SmartPtr<PDSystemSolver> PDSolver = new PDFullSpaceSolver(*GetAugSystemSolver(jnlst, options, prefix), *pertHandler);
-   return PDSolver;
+   SmartPtr<PDFullSpaceSolver> PDSolver = new PDFullSpaceSolver(*GetAugSystemSolver(jnlst, options, prefix), *pertHandler);
+
+   Index speculative_factorizations;
+   options.GetIntegerValue("speculative_inertia_factorizations", speculative_factorizations, prefix);
+   if( speculative_factorizations > 0 )
+   {
+      // the speculative factorizations need their own instances of the
+      // linear solver, which only the standard augmented system solver
+      // with exact Hessians can be given
+      std::string linsolver;
+      options.GetStringValue("linear_solver", linsolver, prefix);
+      std::string aug_system_solver;
+      options.GetStringValue("aug_system_solver", aug_system_solver, prefix);
+      Index enum_int;
+      options.GetEnumValue("hessian_approximation", enum_int, prefix);
+      if( linsolver == "custom" || aug_system_solver == "minres" || HessianApproximationType(enum_int) != EXACT )
+      {
+         jnlst.Printf(J_WARNING, J_INITIALIZATION,
+                      "Option \"speculative_inertia_factorizations\" is ignored for the chosen linear solver and Hessian approximation.\n");
+      }
+      else
+      {
+         for( Index i = 0; i < speculative_factorizations; i++ )
+         {
+            SmartPtr<AugSystemSolver> AugSolver = new StdAugSystemSolver(*SymLinearSolverFactory(jnlst, options, prefix));
+            PDSolver->AddSpeculativeSolver(*AugSolver);
+         }
+      }
+   }
+
+   return GetRawPtr(PDSolver);
 }
 
 void AlgorithmBuilder::BuildIpoptObjects(
@@ -851,8 +929,15 @@ SmartPtr<EqMultiplierCalculator> AlgorithmBuilder::BuildEqMultiplierCalculator(
    const std::string&    prefix
 )
 {
+   std::string lsmethod;
+   options.GetStringValue("least_square_mults_method", lsmethod, prefix);
+
    SmartPtr<EqMultiplierCalculator> EqMultCalculator = new LeastSquareMultipliers(
       *GetAugSystemSolver(jnlst, options, prefix));
+   if( lsmethod == "normal-equations" )
+   {
+      EqMultCalculator = new NormalEqMultipliers(EqMultCalculator);
+   }
    return EqMultCalculator;
 }
 
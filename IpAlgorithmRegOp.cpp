@@ -17,7 +17,9 @@
 #include "IpIpoptAlg.hpp"
 #include "IpIpoptCalculatedQuantities.hpp"
 #include "IpIpoptData.hpp"
+#include "IpIterativeAugSystemSolver.hpp"
 #include "IpMonotoneMuUpdate.hpp"
+#include "IpNormalEqMults.hpp"
 #include "IpNLPScaling.hpp"
 #include "IpOptErrorConvCheck.hpp"
 #include "IpOrigIpoptNLP.hpp"
@@ -63,6 +65,8 @@ void RegisterOptions_Algorithm(
    EquilibrationScaling::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("");
    IpoptAlgorithm::RegisterOptions(roptions);
+   roptions->SetRegisteringCategory("Linear Solver");
+   IterativeAugSystemSolver::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("");
    IpoptData::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("");
@@ -71,6 +75,8 @@ void RegisterOptions_Algorithm(
    LimMemQuasiNewtonUpdater::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("Barrier Parameter Update");
    MonotoneMuUpdate::RegisterOptions(roptions);
+   roptions->SetRegisteringCategory("Initialization");
+   NormalEqMultipliers::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("Termination");
    OptimalityErrorConvergenceCheck::RegisterOptions(roptions);
    roptions->SetRegisteringCategory("NLP");
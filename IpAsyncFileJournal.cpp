@@ -0,0 +1,304 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpAsyncFileJournal.hpp"
+#include "IpDebug.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+namespace Ipopt
+{
+
+/** Source of the serial numbers of the journals */
+static std::atomic<size_t> num_async_journals(0);
+
+AsyncFileJournal::AsyncFileJournal(
+   const std::string& name,
+   EJournalLevel      default_level,
+   bool               drop_when_full,
+   size_t             buffer_size,
+   size_t             max_queued
+)
+   : Journal(name, default_level),
+     serial_(++num_async_journals),
+     drop_when_full_(drop_when_full),
+     buffer_size_(buffer_size),
+     max_queued_(max_queued > 0 ? max_queued : 1),
+     file_(NULL),
+     flush_requested_(0),
+     flush_completed_(0),
+     dropped_bytes_(0),
+     stop_(false)
+{ }
+
+AsyncFileJournal::~AsyncFileJournal()
+{
+   Close();
+   for( size_t i = 0; i < thread_buffers_.size(); i++ )
+   {
+      delete thread_buffers_[i];
+   }
+}
+
+bool AsyncFileJournal::Open(
+   const char* fname,
+   bool        fappend
+)
+{
+   Close();
+
+   if( strcmp("stdout", fname) == 0 )
+   {
+      file_ = stdout;
+   }
+   else if( strcmp("stderr", fname) == 0 )
+   {
+      file_ = stderr;
+   }
+   else
+   {
+      // open the file on disk
+      file_ = fopen(fname, fappend ? "a+" : "w+");
+      if( !file_ )
+      {
+         return false;
+      }
+   }
+
+   stop_ = false;
+   flush_requested_ = 0;
+   flush_completed_ = 0;
+   dropped_bytes_ = 0;
+   writer_ = std::thread(&AsyncFileJournal::WriterLoop, this);
+   return true;
+}
+
+void AsyncFileJournal::Close()
+{
+   if( !file_ )
+   {
+      return;
+   }
+
+   // no thread may print anymore, so all buffers can be handed over
+   {
+      std::lock_guard<std::mutex> lock(buffers_mutex_);
+      for( size_t i = 0; i < thread_buffers_.size(); i++ )
+      {
+         Enqueue(*thread_buffers_[i]);
+      }
+   }
+   {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      stop_ = true;
+   }
+   work_available_.notify_one();
+   writer_.join();
+
+   if( file_ != stdout && file_ != stderr )
+   {
+      fclose(file_);
+   }
+   else
+   {
+      fflush(file_);
+   }
+   file_ = NULL;
+}
+
+std::string& AsyncFileJournal::ThreadBuffer()
+{
+   struct CacheEntry
+   {
+      size_t serial;
+      std::string* buffer;
+   };
+   static thread_local std::vector<CacheEntry> cache;
+
+   for( size_t i = 0; i < cache.size(); i++ )
+   {
+      if( cache[i].serial == serial_ )
+      {
+         return *cache[i].buffer;
+      }
+   }
+
+   // first output of this thread to this journal
+   std::string* buffer = new std::string();
+   buffer->reserve(buffer_size_);
+   {
+      std::lock_guard<std::mutex> lock(buffers_mutex_);
+      thread_buffers_.push_back(buffer);
+   }
+   CacheEntry entry;
+   entry.serial = serial_;
+   entry.buffer = buffer;
+   cache.push_back(entry);
+   return *buffer;
+}
+
+void AsyncFileJournal::Enqueue(
+   std::string& buffer
+)
+{
+   if( buffer.empty() )
+   {
+      return;
+   }
+
+   std::unique_lock<std::mutex> lock(queue_mutex_);
+   if( queue_.size() >= max_queued_ )
+   {
+      if( drop_when_full_ )
+      {
+         dropped_bytes_ += buffer.size();
+         buffer.clear();
+         lock.unlock();
+         work_available_.notify_one();
+         return;
+      }
+      // back-pressure: wait until the writer thread has taken a buffer
+      work_done_.wait(lock, [this]
+      {
+         return queue_.size() < max_queued_;
+      });
+   }
+   queue_.push_back(std::string());
+   queue_.back().swap(buffer);
+   lock.unlock();
+   work_available_.notify_one();
+
+   buffer.reserve(buffer_size_);
+}
+
+void AsyncFileJournal::WriterLoop()
+{
+   std::unique_lock<std::mutex> lock(queue_mutex_);
+   for( ;; )
+   {
+      work_available_.wait(lock, [this]
+      {
+         return !queue_.empty() || dropped_bytes_ > 0 || flush_completed_ < flush_requested_ || stop_;
+      });
+
+      while( !queue_.empty() )
+      {
+         std::string chunk;
+         chunk.swap(queue_.front());
+         queue_.pop_front();
+         work_done_.notify_all();
+         lock.unlock();
+         fwrite(chunk.data(), 1, chunk.size(), file_);
+         lock.lock();
+      }
+
+      if( dropped_bytes_ > 0 )
+      {
+         size_t dropped = dropped_bytes_;
+         dropped_bytes_ = 0;
+         lock.unlock();
+         fprintf(file_, "\n*** %lu bytes of output have been dropped because the output queue was full. ***\n",
+                 (unsigned long) dropped);
+         lock.lock();
+      }
+
+      if( flush_completed_ < flush_requested_ )
+      {
+         // the queue is empty, so everything handed over before the
+         // flush requests has been written
+         size_t requested = flush_requested_;
+         lock.unlock();
+         fflush(file_);
+         lock.lock();
+         flush_completed_ = requested;
+         work_done_.notify_all();
+      }
+
+      if( stop_ && queue_.empty() )
+      {
+         break;
+      }
+   }
+}
+
+void AsyncFileJournal::PrintImpl(
+   EJournalCategory /*category*/,
+   EJournalLevel    /*level*/,
+   const char*      str
+)
+{
+   if( !file_ )
+   {
+      return;
+   }
+   std::string& buffer = ThreadBuffer();
+   buffer += str;
+   if( buffer.size() >= buffer_size_ )
+   {
+      Enqueue(buffer);
+   }
+}
+
+void AsyncFileJournal::PrintfImpl(
+   EJournalCategory /*category*/,
+   EJournalLevel    /*level*/,
+   const char*      pformat,
+   va_list          ap
+)
+{
+   if( !file_ )
+   {
+      return;
+   }
+   std::string& buffer = ThreadBuffer();
+
+   // format into a local array first, since most messages are short
+   char str[1024];
+   va_list apcopy;
+   va_copy(apcopy, ap);
+   int len = vsnprintf(str, sizeof(str), pformat, apcopy);
+   va_end(apcopy);
+   if( len < 0 )
+   {
+      return;
+   }
+   if( (size_t) len < sizeof(str) )
+   {
+      buffer.append(str, (size_t) len);
+   }
+   else
+   {
+      size_t pos = buffer.size();
+      buffer.resize(pos + (size_t) len + 1);
+      vsnprintf(&buffer[pos], (size_t) len + 1, pformat, ap);
+      buffer.resize(pos + (size_t) len);
+   }
+
+   if( buffer.size() >= buffer_size_ )
+   {
+      Enqueue(buffer);
+   }
+}
+
+void AsyncFileJournal::FlushBufferImpl()
+{
+   if( !file_ )
+   {
+      return;
+   }
+   Enqueue(ThreadBuffer());
+
+   std::unique_lock<std::mutex> lock(queue_mutex_);
+   size_t requested = ++flush_requested_;
+   work_available_.notify_one();
+   work_done_.wait(lock, [this, requested]
+   {
+      return flush_completed_ >= requested;
+   });
+}
+
+} // namespace Ipopt
@@ -0,0 +1,169 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPASYNCFILEJOURNAL_HPP__
+#define __IPASYNCFILEJOURNAL_HPP__
+
+#include "IpJournalist.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Journal that writes to a file from a background thread.
+ *
+ *  The messages are formatted into a buffer of the printing thread.
+ *  When this buffer is full, it is handed to a bounded queue, from
+ *  which a writer thread writes it to the file, so that the printing
+ *  thread does not wait for the file system.  If the queue is full,
+ *  the printing thread either waits until the writer thread has made
+ *  room (J_WRITER_ASYNC), or the buffer is dropped and a note about the
+ *  lost output is written to the file (J_WRITER_ASYNC_DROP).
+ *
+ *  FlushBuffer hands over the buffer of the calling thread and waits
+ *  until everything in the queue is written.  The buffers of other
+ *  threads are handed over when they are full and when the journal is
+ *  destroyed.
+ */
+class IPOPTLIB_EXPORT AsyncFileJournal: public Journal
+{
+public:
+   /** Constructor.
+    *
+    *  @param name          name of the journal
+    *  @param default_level default print level for all categories
+    *  @param drop_when_full whether to drop output instead of waiting if
+    *                       the queue is full
+    *  @param buffer_size   size in bytes at which the buffer of a thread
+    *                       is handed to the writer thread
+    *  @param max_queued    maximal number of buffers in the queue
+    */
+   AsyncFileJournal(
+      const std::string& name,
+      EJournalLevel      default_level,
+      bool               drop_when_full = false,
+      size_t             buffer_size = 65536,
+      size_t             max_queued = 64
+   );
+
+   /** Destructor; writes all output and closes the file. */
+   virtual ~AsyncFileJournal();
+
+   /** Open a new file for the output location.
+    *
+    *  Special Names: stdout means stdout,
+    *               : stderr means stderr.
+    *
+    *  @return false only if the file with the given name could not be opened
+    */
+   virtual bool Open(
+      const char* fname,
+      bool        fappend = false
+   );
+
+protected:
+   /**@name Implementation version of Print methods
+    *
+    * Overloaded from Journal base class.
+    */
+   ///@{
+   /** Print to the designated output location */
+   virtual void PrintImpl(
+      EJournalCategory /*category*/,
+      EJournalLevel    /*level*/,
+      const char*      str
+   );
+
+   /** Printf to the designated output location */
+   virtual void PrintfImpl(
+      EJournalCategory /*category*/,
+      EJournalLevel    /*level*/,
+      const char*      pformat,
+      va_list          ap
+   );
+
+   /** Flush output buffer.*/
+   virtual void FlushBufferImpl();
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default Constructor */
+   AsyncFileJournal();
+
+   /** Copy Constructor */
+   AsyncFileJournal(
+      const AsyncFileJournal&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const AsyncFileJournal&
+   );
+   ///@}
+
+   /** Get the buffer of the calling thread */
+   std::string& ThreadBuffer();
+
+   /** Hand a buffer to the writer thread, if it is not empty */
+   void Enqueue(
+      std::string& buffer
+   );
+
+   /** Stop the writer thread after it has written all output, and close the file */
+   void Close();
+
+   /** Main loop of the writer thread */
+   void WriterLoop();
+
+   /** Identifier that distinguishes this journal in the thread-local
+    *  buffer caches, also from destroyed journals at the same address
+    */
+   size_t serial_;
+
+   bool drop_when_full_;
+   size_t buffer_size_;
+   size_t max_queued_;
+
+   /** Buffers of all threads that printed, guarded by buffers_mutex_ */
+   std::vector<std::string*> thread_buffers_;
+   std::mutex buffers_mutex_;
+
+   /** @name Queue and writer thread, guarded by queue_mutex_ */
+   ///@{
+   FILE* file_;
+   std::deque<std::string> queue_;
+   std::mutex queue_mutex_;
+   /** Signaled when there is work for the writer thread */
+   std::condition_variable work_available_;
+   /** Signaled when the writer thread has taken buffers from the queue or written them */
+   std::condition_variable work_done_;
+   /** Number of flush requests, and of flush requests that are completed */
+   size_t flush_requested_;
+   size_t flush_completed_;
+   /** Bytes dropped since the last note in the file */
+   size_t dropped_bytes_;
+   bool stop_;
+   std::thread writer_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
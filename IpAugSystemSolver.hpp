@@ -183,6 +183,59 @@ public:
     */
    virtual bool IncreaseQuality() = 0;
 
+   /** @name Factorization in concurrent threads
+    *
+    *  PrepareFactorization sets up the augmented system as Solve does,
+    *  but does not factorize it.  FactorizePrepared then computes the
+    *  factorization and only accesses data that is owned by this solver
+    *  object, so that several solver objects can factorize their
+    *  systems in concurrent threads.  A subsequent Solve with the same
+    *  data only performs the backsolves.
+    *
+    *  The vectors proto_x, proto_s, proto_c, and proto_d are used as
+    *  prototypes for the right hand side, like rhs_x etc. in Solve.
+    */
+   ///@{
+   /** Query whether PrepareFactorization and FactorizePrepared are implemented. */
+   virtual bool ProvidesConcurrentFactorization() const
+   {
+      return false;
+   }
+
+   /** Set up the augmented system for a subsequent call of FactorizePrepared. */
+   virtual void PrepareFactorization(
+      const SymMatrix* /*W*/,
+      Number           /*W_factor*/,
+      const Vector*    /*D_x*/,
+      Number           /*delta_x*/,
+      const Vector*    /*D_s*/,
+      Number           /*delta_s*/,
+      const Matrix*    /*J_c*/,
+      const Vector*    /*D_c*/,
+      Number           /*delta_c*/,
+      const Matrix*    /*J_d*/,
+      const Vector*    /*D_d*/,
+      Number           /*delta_d*/,
+      const Vector&    /*proto_x*/,
+      const Vector&    /*proto_s*/,
+      const Vector&    /*proto_c*/,
+      const Vector&    /*proto_d*/
+   )
+   { }
+
+   /** Factorize the augmented system set up by PrepareFactorization.
+    *
+    *  The return values are those of Solve.
+    */
+   virtual ESymSolverStatus FactorizePrepared(
+      bool  /*check_NegEVals*/,
+      Index /*numberOfNegEVals*/
+   )
+   {
+      return SYMSOLVER_FATAL_ERROR;
+   }
+   ///@}
+
 private:
    /**@name Default Compiler Generated Methods
     * (Hidden to avoid implicit creation/calling).
@@ -182,6 +182,22 @@ public:
       return false;
    }
 
+   /** Return the internal data that should be kept for a warm start,
+    *  or NULL if there is none (see LineSearch::GetWarmState).
+    */
+   virtual SmartPtr<const ReferencedObject> GetWarmState() const
+   {
+      return NULL;
+   }
+
+   /** Restore the internal data from an object returned by
+    *  GetWarmState.
+    */
+   virtual void SetWarmState(
+      const SmartPtr<const ReferencedObject>& /*state*/
+   )
+   { }
+
    /** Methods for OptionsList */
    ///@{
    static void RegisterOptions(
@@ -80,6 +80,18 @@ void BacktrackingLineSearch::RegisterOptions(
       -1,
       "Setting this to -1 disables this option.",
       true);
+   roptions->AddLowerBoundedIntegerOption(
+      "concurrent_trial_points",
+      "Number of trial step sizes of the backtracking line search at which the functions are evaluated concurrently.",
+      1,
+      1,
+      "If larger than 1, the objective and constraint functions are evaluated for up to this many successive "
+      "trial step sizes at once in concurrent threads whenever the line search has to evaluate a new trial point. "
+      "The trial points are still checked one after the other, and the first acceptable one is taken. "
+      "This only pays off if the function evaluations are expensive and it requires that eval_f and eval_g "
+      "of the TNLP are thread safe; they are called with new_x=true for each point. "
+      "The restoration phase always evaluates one trial point at a time.",
+      true);
 
    roptions->AddStringOption10(
       "alpha_for_y",
@@ -197,6 +209,7 @@ bool BacktrackingLineSearch::InitializeImpl(
    options.GetBoolValue("magic_steps", magic_steps_, prefix);
    options.GetBoolValue("accept_every_trial_step", accept_every_trial_step_, prefix);
    options.GetIntegerValue("accept_after_max_steps", accept_after_max_steps_, prefix);
+   options.GetIntegerValue("concurrent_trial_points", concurrent_trial_points_, prefix);
    Index enum_int;
    bool is_default = !options.GetEnumValue("alpha_for_y", enum_int, prefix);
    alpha_for_y_ = AlphaForYEnum(enum_int);
@@ -724,6 +737,13 @@ bool BacktrackingLineSearch::DoBacktrackingLineSearch(
 
    if( !accept )
    {
+      // Step sizes and primal trial points for which the functions
+      // have been evaluated concurrently, and the next one to be tried
+      std::vector<Number> concurrent_alphas;
+      std::vector<SmartPtr<const Vector> > concurrent_x;
+      std::vector<SmartPtr<const Vector> > concurrent_s;
+      size_t next_concurrent = 0;
+
       // Loop over decreasing step sizes until acceptable point is
       // found or until step size becomes too small
 
@@ -737,7 +757,26 @@ bool BacktrackingLineSearch::DoBacktrackingLineSearch(
          try
          {
             // Compute the primal trial point
-            IpData().SetTrialPrimalVariablesFromStep(alpha_primal, *actual_delta->x(), *actual_delta->s());
+            if( next_concurrent < concurrent_alphas.size() && concurrent_alphas[next_concurrent] == alpha_primal )
+            {
+               // The functions have already been evaluated at this point
+               SmartPtr<IteratesVector> trial = IpData().trial()->MakeNewContainer();
+               trial->Set_x(*concurrent_x[next_concurrent]);
+               trial->Set_s(*concurrent_s[next_concurrent]);
+               IpData().set_trial(trial);
+               next_concurrent++;
+            }
+            else
+            {
+               IpData().SetTrialPrimalVariablesFromStep(alpha_primal, *actual_delta->x(), *actual_delta->s());
+               if( concurrent_trial_points_ > 1 && !in_watchdog_ && !accept_every_trial_step_
+                   && IpNLP().ProvidesConcurrentEvaluation() )
+               {
+                  EvaluateTrialPointsConcurrently(alpha_primal, alpha_min, *actual_delta, concurrent_alphas,
+                                                  concurrent_x, concurrent_s);
+                  next_concurrent = 0;
+               }
+            }
 
             if( magic_steps_ )
             {
@@ -842,6 +881,52 @@ bool BacktrackingLineSearch::DoBacktrackingLineSearch(
    return accept;
 }
 
+void BacktrackingLineSearch::EvaluateTrialPointsConcurrently(
+   Number                                alpha_primal,
+   Number                                alpha_min,
+   const IteratesVector&                 delta,
+   std::vector<Number>&                  alphas,
+   std::vector<SmartPtr<const Vector> >& x,
+   std::vector<SmartPtr<const Vector> >& s
+)
+{
+   DBG_START_METH("BacktrackingLineSearch::EvaluateTrialPointsConcurrently",
+                  dbg_verbosity);
+
+   alphas.clear();
+   x.clear();
+   s.clear();
+
+   // The trial points are computed exactly as by
+   // SetTrialPrimalVariablesFromStep for the following step sizes
+   Number alpha = alpha_primal;
+   for( Index i = 1; i < concurrent_trial_points_; i++ )
+   {
+      alpha *= alpha_red_factor_;
+      if( alpha <= alpha_min )
+      {
+         break;
+      }
+      SmartPtr<Vector> x_i = IpData().curr()->x()->MakeNew();
+      x_i->AddTwoVectors(1., *IpData().curr()->x(), alpha, *delta.x(), 0.);
+      SmartPtr<Vector> s_i = IpData().curr()->s()->MakeNew();
+      s_i->AddTwoVectors(1., *IpData().curr()->s(), alpha, *delta.s(), 0.);
+      alphas.push_back(alpha);
+      x.push_back(ConstPtr(x_i));
+      s.push_back(ConstPtr(s_i));
+   }
+   if( alphas.empty() )
+   {
+      return;
+   }
+
+   std::vector<SmartPtr<const Vector> > xV(1, IpData().trial()->x());
+   xV.insert(xV.end(), x.begin(), x.end());
+   Jnlst().Printf(J_DETAILED, J_LINE_SEARCH,
+                  "Evaluating functions at %" IPOPT_INDEX_FORMAT " trial points concurrently\n", (Index) xV.size());
+   IpNLP().EvaluateConcurrently(xV);
+}
+
 void BacktrackingLineSearch::StartWatchDog()
 {
    DBG_START_FUN("BacktrackingLineSearch::StartWatchDog", dbg_verbosity);
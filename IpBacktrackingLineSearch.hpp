@@ -112,6 +112,19 @@ public:
     */
    virtual bool ActivateFallbackMechanism();
 
+   /** The internal data for a warm start are those of the acceptor. */
+   virtual SmartPtr<const ReferencedObject> GetWarmState() const
+   {
+      return acceptor_->GetWarmState();
+   }
+
+   virtual void SetWarmState(
+      const SmartPtr<const ReferencedObject>& state
+   )
+   {
+      acceptor_->SetWarmState(state);
+   }
+
    /** Stop watch dog if started and restore iterate from before watchdog started.
     *
     *  This method is intended to be called if Ipopt is interrupted during the watchdog pahase.
@@ -252,6 +265,24 @@ private:
       SmartPtr<IteratesVector>& actual_delta
    );
 
+   /** Evaluate the functions at the current trial point and the
+    *  trial points for the following step sizes concurrently.
+    *
+    *  The current trial point has been computed for the step size
+    *  alpha_primal.  Up to concurrent_trial_points_-1 following step
+    *  sizes larger than alpha_min are returned in alphas, together
+    *  with the corresponding trial points in x and s.  The function
+    *  values are kept in the caches of the IpoptNLP.
+    */
+   void EvaluateTrialPointsConcurrently(
+      Number                                alpha_primal,
+      Number                                alpha_min,
+      const IteratesVector&                 delta,
+      std::vector<Number>&                  alphas,
+      std::vector<SmartPtr<const Vector> >& x,
+      std::vector<SmartPtr<const Vector> >& s
+   );
+
    /** Perform magic steps.
     *
     *  Take the current values of the slacks in
@@ -347,6 +378,10 @@ private:
     *  even if it is not satisfying acceptance criteria.
     */
    Index accept_after_max_steps_;
+   /** Number of trial step sizes for which the functions are
+    *  evaluated concurrently.
+    */
+   Index concurrent_trial_points_;
    /** Indicates whether problem can be expected to be infeasible.
     *
     *  This will trigger requesting a tighter reduction in
@@ -505,7 +505,7 @@ bool CGPenaltyLSAcceptor::TrySecondOrderCorrection(
       rhs->Set_z_U(*IpCq().curr_relaxed_compl_x_U());
       rhs->Set_v_L(*IpCq().curr_relaxed_compl_s_L());
       rhs->Set_v_U(*IpCq().curr_relaxed_compl_s_U());
-      pd_solver_->Solve(-1.0, 0.0, *rhs, *delta_soc, true);
+      pd_solver_->BackSolve(-1.0, *rhs, *delta_soc);
       // Update the delta_y_c and delta_y_d vectors in case we do
       // additional SOC steps
       delta_y_c = ConstPtr(delta_soc->y_c());
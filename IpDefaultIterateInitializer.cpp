@@ -5,7 +5,10 @@
 // Authors:  Carl Laird, Andreas Waechter              IBM    2004-09-23
 
 #include "IpDefaultIterateInitializer.hpp"
+#include "IpDenseVector.hpp"
+#include "IpExpansionMatrix.hpp"
 
+#include <cmath>
 #include <limits>
 
 namespace Ipopt
@@ -14,6 +17,11 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
+/** Minimal number of variables for which the variables are pushed
+ *  into the bounds in parallel.
+ */
+static const Index min_parallel_push_entries = 50000;
+
 DefaultIterateInitializer::DefaultIterateInitializer(
    const SmartPtr<EqMultiplierCalculator>& eq_mult_calculator,
    const SmartPtr<IterateInitializer>&     warm_start_initializer,
@@ -470,6 +478,133 @@ bool DefaultIterateInitializer::CalculateLeastSquareDuals(
    return true;
 }
 
+/** Move the variables into the bounds in one pass over the elements,
+ *  if the vectors are DenseVectors and the bounds are given by
+ *  ExpansionMatrices.
+ *
+ *  This computes the same values as the general implementation in
+ *  push_variables: the variables are first projected onto the bounds
+ *  and then moved away from them by the margins derived from
+ *  bound_push and bound_frac.  On return, moved tells whether the
+ *  last step changed any variable.
+ *
+ *  @return false, if the data is not of the required types
+ */
+static bool push_variables_expanded(
+   Number                  bound_push,
+   Number                  bound_frac,
+   const Vector&           orig_x,
+   SmartPtr<const Vector>& new_x,
+   const Vector&           x_L,
+   const Vector&           x_U,
+   const Matrix&           Px_L,
+   const Matrix&           Px_U,
+   bool&                   moved
+)
+{
+   const DenseVector* dorig_x = dynamic_cast<const DenseVector*>(&orig_x);
+   const DenseVector* dx_L = dynamic_cast<const DenseVector*>(&x_L);
+   const DenseVector* dx_U = dynamic_cast<const DenseVector*>(&x_U);
+   const ExpansionMatrix* ePx_L = dynamic_cast<const ExpansionMatrix*>(&Px_L);
+   const ExpansionMatrix* ePx_U = dynamic_cast<const ExpansionMatrix*>(&Px_U);
+   if( !dorig_x || !dx_L || !dx_U || !ePx_L || !ePx_U )
+   {
+      return false;
+   }
+
+   const Index n = orig_x.Dim();
+   const Number* x = dorig_x->ExpandedValues();
+   const Number* xl = dx_L->ExpandedValues();
+   const Number* xu = dx_U->ExpandedValues();
+   const Index* lower_pos = ePx_L->CompressedPosIndices();
+   const Index* upper_pos = ePx_U->CompressedPosIndices();
+
+   const Number tiny_double = 100.0 * std::numeric_limits<Number>::min();
+   const bool push = bound_frac > 0.;
+   const bool project = push || bound_push > 0.;
+
+   SmartPtr<DenseVector> delta_x = static_cast<DenseVector*>(orig_x.MakeNew());
+   DBG_ASSERT(dynamic_cast<DenseVector*>(GetRawPtr(delta_x)));
+   Number* xnew = delta_x->Values();
+
+   Index nprojected = 0;
+   Index npushed = 0;
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(static) reduction(+:nprojected,npushed) if( n >= min_parallel_push_entries )
+#endif
+   for( Index i = 0; i < n; i++ )
+   {
+      const Index l = lower_pos[i];
+      const Index u = upper_pos[i];
+      Number xi = x[i];
+
+      // To avoid round-off error, move variables first at the bounds
+      if( project )
+      {
+         const Number corr_l = (l >= 0) ? Max(xl[l] - xi, Number(0.)) : 0.;
+         const Number corr_u = (u >= 0) ? Max(xi - xu[u], Number(0.)) : 0.;
+         if( corr_l > 0. || corr_u > 0. )
+         {
+            xi = (corr_l - corr_u) + xi;
+            nprojected++;
+         }
+      }
+
+      Number corr_l = 0.;
+      Number corr_u = 0.;
+      if( push )
+      {
+         // The margin to each bound is
+         //  min(bound_push * max(|bound|,1), bound_frac*(x_U-x_L)) for components
+         //                                                         with two bounds
+         //  bound_push * max(|bound|,1)                            otherwise
+         if( l >= 0 )
+         {
+            const Number q_l = ((u >= 0) ? bound_frac * (xu[u] - xl[l]) : 0.) - tiny_double;
+            Number p_l = Max(std::abs(bound_push * xl[l]), bound_push);
+            p_l = 1. / Max(1. / p_l, 1. / q_l);
+            corr_l = Max(-xi + (xl[l] + p_l), Number(0.));
+         }
+         if( u >= 0 )
+         {
+            const Number q_u = ((l >= 0) ? bound_frac * (xu[u] - xl[l]) : 0.) - tiny_double;
+            Number p_u = Max(std::abs(bound_push * xu[u]), bound_push);
+            p_u = 1. / Max(1. / p_u, 1. / q_u) + tiny_double;
+            corr_u = Max(xi + (-xu[u] + p_u), Number(0.));
+         }
+      }
+      else
+      {
+         if( l >= 0 )
+         {
+            corr_l = Max(xl[l] - xi, Number(0.));
+         }
+         if( u >= 0 )
+         {
+            corr_u = Max(xi - xu[u], Number(0.));
+         }
+      }
+      if( corr_l > 0. || corr_u > 0. )
+      {
+         xi = (corr_l - corr_u) + xi;
+         npushed++;
+      }
+
+      xnew[i] = xi;
+   }
+
+   moved = npushed > 0;
+   if( nprojected > 0 || npushed > 0 )
+   {
+      new_x = ConstPtr(delta_x);
+   }
+   else
+   {
+      new_x = &orig_x;
+   }
+   return true;
+}
+
 void DefaultIterateInitializer::push_variables(
    const Journalist&       jnlst,
    Number                  bound_push,
@@ -486,8 +621,28 @@ void DefaultIterateInitializer::push_variables(
    DBG_START_FUN("DefaultIterateInitializer::push_variables",
                  dbg_verbosity);
 
+   bool moved;
+   if( push_variables_expanded(bound_push, bound_frac, orig_x, new_x, x_L, x_U, Px_L, Px_U, moved) )
+   {
+      if( bound_push > 0. )
+      {
+         if( moved )
+         {
+            jnlst.Printf(J_DETAILED, J_INITIALIZATION,
+                         "Moved initial values of %s sufficiently inside the bounds.\n", name.c_str());
+            orig_x.Print(jnlst, J_VECTOR, J_INITIALIZATION, "original vars");
+            new_x->Print(jnlst, J_VECTOR, J_INITIALIZATION, "new vars");
+         }
+         else
+         {
+            jnlst.Printf(J_DETAILED, J_INITIALIZATION,
+                         "Initial values of %s sufficiently inside the bounds.\n", name.c_str());
+         }
+      }
+      return;
+   }
+
    SmartPtr<const Vector> my_orig_x = &orig_x;
-   // ToDo: Make this more efficient...?
 
    // To avoid round-off error, move variables first at the bounds
    if( bound_push > 0. || bound_frac > 0. )
@@ -8,6 +8,7 @@
 #include "IpEquilibrationScaling.hpp"
 #include "IpTripletHelper.hpp"
 #include "IpTypes.h"
+#include "IpLinearSolvers.h"
 
 #include <cmath>
 
@@ -42,36 +43,90 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
+/** Minimal number of nonzeros for which the passes of the native
+ *  equilibration run in parallel.
+ */
+static const Index min_parallel_equilibration_entries = 50000;
+
 void EquilibrationScaling::RegisterOptions(
-   const SmartPtr<RegisteredOptions>& /*roptions*/
+   const SmartPtr<RegisteredOptions>& roptions
 )
-{ }
+{
+   IpoptLinearSolver availablesolvers = IpoptGetAvailableLinearSolvers(false);
+   IpoptLinearSolver availablesolverslinked = IpoptGetAvailableLinearSolvers(true);
+
+   std::vector<std::string> options;
+   std::vector<std::string> descrs;
+   std::string defaultmethod = "geometric-mean";
+
+   options.push_back("geometric-mean");
+   descrs.push_back("use geometric-mean scaling followed by Ruiz equilibration");
+
+   if( availablesolvers & IPOPTLINEARSOLVER_MC19 )
+   {
+      options.push_back("mc19");
+      if( availablesolverslinked & IPOPTLINEARSOLVER_MC19 )
+      {
+         descrs.push_back("use the Harwell routine MC19");
+         defaultmethod = "mc19";
+      }
+      else
+      {
+         descrs.push_back("load the Harwell routine MC19 from library at runtime");
+      }
+   }
+
+   roptions->AddStringOption(
+      "nlp_scaling_equilibration_method",
+      "Method for computing the equilibration-based NLP scaling.",
+      defaultmethod,
+      options, descrs,
+      "This is only used if \"nlp_scaling_method\" is \"equilibration-based\". "
+      "The default is MC19 only if it is linked with Ipopt.",
+      true);
+   roptions->AddBoolOption(
+      "nlp_scaling_concurrent_evaluation",
+      "Whether to evaluate the derivatives for equilibration-based scaling concurrently.",
+      false,
+      "If enabled, the objective gradient and the constraint Jacobian at the randomly perturbed points are evaluated "
+      "in concurrent threads. "
+      "The methods eval_grad_f and eval_jac_g of the TNLP must then be thread safe.",
+      true);
+}
 
 bool EquilibrationScaling::InitializeImpl(
    const OptionsList& options,
    const std::string& prefix
 )
 {
-   // check if user stored a MC19A in Mc19TSymScalingMethod
+   std::string method;
+   options.GetStringValue("nlp_scaling_equilibration_method", method, prefix);
+   use_mc19_ = (method == "mc19");
+
+   if( use_mc19_ )
+   {
+      // check if user stored a MC19A in Mc19TSymScalingMethod
 #ifndef IPOPT_INT64
-   mc19a = Mc19TSymScalingMethod::GetMC19A();
+      mc19a = Mc19TSymScalingMethod::GetMC19A();
 #endif
-   if( mc19a == NULL )
-   {
+      if( mc19a == NULL )
+      {
 #if (defined(COINHSL_HAS_MC19) && !defined(IPOPT_SINGLE)) || (defined(COINHSL_HAS_MC19S) && defined(IPOPT_SINGLE))
-      // use HSL function that should be available in linked HSL library
-      mc19a = &::IPOPT_HSL_FUNCP(mc19a, MC19A);
+         // use HSL function that should be available in linked HSL library
+         mc19a = &::IPOPT_HSL_FUNCP(mc19a, MC19A);
 #else
-      // try to load HSL function from a shared library at runtime
-      DBG_ASSERT(IsValid(hslloader));
+         // try to load HSL function from a shared library at runtime
+         DBG_ASSERT(IsValid(hslloader));
 
-      mc19a = (IPOPT_DECL_MC19A(*))hslloader->loadSymbol("mc19a" HSLFUNCNAMESUFFIX);
+         mc19a = (IPOPT_DECL_MC19A(*))hslloader->loadSymbol("mc19a" HSLFUNCNAMESUFFIX);
 #endif
-   }
+      }
 
-   DBG_ASSERT(mc19a != NULL);
+      DBG_ASSERT(mc19a != NULL);
+   }
 
    options.GetNumericValue("point_perturbation_radius", point_perturbation_radius_, prefix);
+   options.GetBoolValue("nlp_scaling_concurrent_evaluation", concurrent_evaluation_, prefix);
    return StandardScalingBase::InitializeImpl(options, prefix);
 }
 
@@ -107,31 +162,77 @@ void EquilibrationScaling::DetermineScalingParametersImpl(
    // We store the added absolute values of the Jacobian and
    // objective function gradient in an array of sufficient size
 
-   SmartPtr<Matrix> jac_c = jac_c_space->MakeNew();
-   SmartPtr<Matrix> jac_d = jac_d_space->MakeNew();
-   SmartPtr<Vector> grad_f = x_space->MakeNew();
-   const Index nnz_jac_c = TripletHelper::GetNumberEntries(*jac_c);
-   const Index nnz_jac_d = TripletHelper::GetNumberEntries(*jac_d);
+   const Index num_evals = 4;
+   const Index max_num_eval_errors = 10;
+   Index num_eval_errors = 0;
+
+   SmartPtr<PointPerturber> perturber = new PointPerturber(*x0, point_perturbation_radius_, Px_L, x_L, Px_U, x_U);
+
+   // Compute obj gradient and Jacobian at random perturbation points.
+   // All points are drawn before any of them is evaluated, and the
+   // replacements for points at which the evaluation failed are drawn
+   // afterwards, so that the points, and hence the scaling, do not
+   // depend on whether the points are evaluated concurrently.
+   // If they are evaluated concurrently, every point gets its own
+   // objects, otherwise the points are evaluated one after the other
+   // in the loop below and share them.
+   std::vector<SmartPtr<const Vector> > xpert(num_evals);
+   for( Index ieval = 0; ieval < num_evals; ieval++ )
+   {
+      xpert[ieval] = ConstPtr(perturber->MakeNewPerturbedPoint());
+   }
+   std::vector<SmartPtr<Vector> > grad_f(num_evals);
+   std::vector<SmartPtr<Matrix> > jac_c(num_evals);
+   std::vector<SmartPtr<Matrix> > jac_d(num_evals);
+   std::vector<bool> success(num_evals, false);
+   if( concurrent_evaluation_ && nlp_->ProvidesConcurrentEvaluation() )
+   {
+      for( Index ieval = 0; ieval < num_evals; ieval++ )
+      {
+         grad_f[ieval] = x_space->MakeNew();
+         jac_c[ieval] = jac_c_space->MakeNew();
+         jac_d[ieval] = jac_d_space->MakeNew();
+      }
+      nlp_->Eval_grad_f_jac_c_jac_d_Concurrent(xpert, grad_f, jac_c, jac_d, success);
+   }
+   else
+   {
+      SmartPtr<Vector> shared_grad_f = x_space->MakeNew();
+      SmartPtr<Matrix> shared_jac_c = jac_c_space->MakeNew();
+      SmartPtr<Matrix> shared_jac_d = jac_d_space->MakeNew();
+      for( Index ieval = 0; ieval < num_evals; ieval++ )
+      {
+         grad_f[ieval] = shared_grad_f;
+         jac_c[ieval] = shared_jac_c;
+         jac_d[ieval] = shared_jac_d;
+      }
+   }
+
+   const Index nnz_jac_c = TripletHelper::GetNumberEntries(*jac_c[0]);
+   const Index nnz_jac_d = TripletHelper::GetNumberEntries(*jac_d[0]);
    const Index nc = jac_c_space->NRows();
    const Index nd = jac_d_space->NRows();
    const Index nx = x_space->Dim();
    Number* avrg_values = new Number[nnz_jac_c + nnz_jac_d + nx];
    Number* val_buffer = new Number[Max(nnz_jac_c, nnz_jac_d, nx)];
 
-   SmartPtr<PointPerturber> perturber = new PointPerturber(*x0, point_perturbation_radius_, Px_L, x_L, Px_U, x_U);
-
-   const Index num_evals = 4;
-   const Index max_num_eval_errors = 10;
-   Index num_eval_errors = 0;
    for( Index ieval = 0; ieval < num_evals; ieval++ )
    {
-      // Compute obj gradient and Jacobian at random perturbation point
-      bool done = false;
+      // Evaluate the points that were not evaluated yet, and those that
+      // failed in the concurrent evaluation again at the same point, as
+      // in the sequential evaluation.  If this fails, evaluate at new
+      // random perturbation points.
+      bool done = success[ieval];
+      SmartPtr<const Vector> xeval = xpert[ieval];
       while( !done )
       {
-         SmartPtr<Vector> xpert = perturber->MakeNewPerturbedPoint();
-         done =
-            (nlp_->Eval_grad_f(*xpert, *grad_f) && nlp_->Eval_jac_c(*xpert, *jac_c) && nlp_->Eval_jac_d(*xpert, *jac_d));
+         if( IsNull(xeval) )
+         {
+            xeval = ConstPtr(perturber->MakeNewPerturbedPoint());
+         }
+         done = (nlp_->Eval_grad_f(*xeval, *grad_f[ieval]) && nlp_->Eval_jac_c(*xeval, *jac_c[ieval])
+                 && nlp_->Eval_jac_d(*xeval, *jac_d[ieval]));
+         xeval = NULL;
          if( !done )
          {
             Jnlst().Printf(J_WARNING, J_INITIALIZATION,
@@ -147,7 +248,7 @@ void EquilibrationScaling::DetermineScalingParametersImpl(
       }
       // Get the numbers out of the matrices and vectors, and add it
       // to avrg_values
-      TripletHelper::FillValues(nnz_jac_c, *jac_c, val_buffer);
+      TripletHelper::FillValues(nnz_jac_c, *jac_c[ieval], val_buffer);
       if( ieval == 0 )
       {
          for( Index i = 0; i < nnz_jac_c; i++ )
@@ -162,7 +263,7 @@ void EquilibrationScaling::DetermineScalingParametersImpl(
             avrg_values[i] += std::abs(val_buffer[i]);
          }
       }
-      TripletHelper::FillValues(nnz_jac_d, *jac_d, val_buffer);
+      TripletHelper::FillValues(nnz_jac_d, *jac_d[ieval], val_buffer);
       if( ieval == 0 )
       {
          for( Index i = 0; i < nnz_jac_d; i++ )
@@ -177,7 +278,7 @@ void EquilibrationScaling::DetermineScalingParametersImpl(
             avrg_values[nnz_jac_c + i] += std::abs(val_buffer[i]);
          }
       }
-      TripletHelper::FillValuesFromVector(nx, *grad_f, val_buffer);
+      TripletHelper::FillValuesFromVector(nx, *grad_f[ieval], val_buffer);
       if( ieval == 0 )
       {
          for( Index i = 0; i < nx; i++ )
@@ -202,8 +303,8 @@ void EquilibrationScaling::DetermineScalingParametersImpl(
    // Get the sparsity structure
    Index* AIRN = new Index[nnz_jac_c + nnz_jac_d + nx];
    Index* AJCN = new Index[nnz_jac_c + nnz_jac_d + nx];
-   TripletHelper::FillRowCol(nnz_jac_c, *jac_c, &AIRN[0], &AJCN[0]);
-   TripletHelper::FillRowCol(nnz_jac_d, *jac_d, &AIRN[nnz_jac_c], &AJCN[nnz_jac_c], nc);
+   TripletHelper::FillRowCol(nnz_jac_c, *jac_c[0], &AIRN[0], &AJCN[0]);
+   TripletHelper::FillRowCol(nnz_jac_d, *jac_d[0], &AIRN[nnz_jac_c], &AJCN[nnz_jac_c], nc);
 
    // sort out the zero entries in objective function gradient
    Index nnz_grad_f = 0;
@@ -219,33 +320,40 @@ void EquilibrationScaling::DetermineScalingParametersImpl(
       }
    }
 
-   // Now call MC19 to compute the scaling factors
-   const Index N = Max(nc + nd + 1, nx);
-   float* R = new float[N];
-   float* C = new float[N];
-   float* W = new float[5 * N];
-   const Index NZ = nnz_jac_c + nnz_jac_d + nnz_grad_f;
-   mc19a(&N, &NZ, avrg_values, AJCN, AIRN, C, R, W);
-
-   delete[] W;
-
-   delete[] avrg_values;
-   delete[] AIRN;
-   delete[] AJCN;
-
-   // Correct the scaling values
    Number* row_scale = new Number[nc + nd + 1];
    Number* col_scale = new Number[nx];
-   for( Index i = 0; i < nc + nd + 1; i++ )
+   const Index NZ = nnz_jac_c + nnz_jac_d + nnz_grad_f;
+   if( use_mc19_ )
    {
-      row_scale[i] = std::exp(Number(R[i]));
+      // Now call MC19 to compute the scaling factors
+      const Index N = Max(nc + nd + 1, nx);
+      float* R = new float[N];
+      float* C = new float[N];
+      float* W = new float[5 * N];
+      mc19a(&N, &NZ, avrg_values, AJCN, AIRN, C, R, W);
+
+      delete[] W;
+
+      // Correct the scaling values
+      for( Index i = 0; i < nc + nd + 1; i++ )
+      {
+         row_scale[i] = std::exp(Number(R[i]));
+      }
+      for( Index i = 0; i < nx; i++ )
+      {
+         col_scale[i] = std::exp(Number(C[i]));
+      }
+      delete[] R;
+      delete[] C;
    }
-   for( Index i = 0; i < nx; i++ )
+   else
    {
-      col_scale[i] = std::exp(Number(C[i]));
+      ComputeEquilibrationFactors(nc + nd + 1, nx, NZ, AIRN, AJCN, avrg_values, row_scale, col_scale);
    }
-   delete[] R;
-   delete[] C;
+
+   delete[] avrg_values;
+   delete[] AIRN;
+   delete[] AJCN;
 
    // get the scaling factors
    df = row_scale[nc + nd];
@@ -260,6 +368,224 @@ void EquilibrationScaling::DetermineScalingParametersImpl(
    delete[] col_scale;
 }
 
+void EquilibrationScaling::ComputeEquilibrationFactors(
+   Index         nrows,
+   Index         ncols,
+   Index         nnz,
+   const Index*  airn,
+   const Index*  ajcn,
+   const Number* a,
+   Number*       row_scale,
+   Number*       col_scale
+) const
+{
+   DBG_START_METH("EquilibrationScaling::ComputeEquilibrationFactors",
+                  dbg_verbosity);
+
+   // Maximal number of geometric-mean passes, and relative decrease
+   // of the largest ratio between the entries in a row or column
+   // below which they are stopped
+   const Index max_geom_passes = 10;
+   const Number geom_pass_decrease = 0.9;
+   // Maximal number of Ruiz sweeps, and tolerance for the deviation
+   // of the row and column norms from one
+   const Index max_ruiz_sweeps = 20;
+   const Number ruiz_tol = 1e-2;
+
+   // Store the nonzero entries row-wise and column-wise
+   std::vector<Index> row_start(nrows + 1, 0);
+   std::vector<Index> col_start(ncols + 1, 0);
+   for( Index k = 0; k < nnz; k++ )
+   {
+      DBG_ASSERT(airn[k] >= 1 && airn[k] <= nrows);
+      DBG_ASSERT(ajcn[k] >= 1 && ajcn[k] <= ncols);
+      if( a[k] != 0. )
+      {
+         row_start[airn[k]]++;
+         col_start[ajcn[k]]++;
+      }
+   }
+   for( Index i = 0; i < nrows; i++ )
+   {
+      row_start[i + 1] += row_start[i];
+   }
+   for( Index j = 0; j < ncols; j++ )
+   {
+      col_start[j + 1] += col_start[j];
+   }
+   const Index nz = row_start[nrows];
+   std::vector<Index> row_col(nz);
+   std::vector<Number> row_val(nz);
+   std::vector<Index> col_row(nz);
+   std::vector<Number> col_val(nz);
+   {
+      std::vector<Index> row_pos(row_start.begin(), row_start.end() - 1);
+      std::vector<Index> col_pos(col_start.begin(), col_start.end() - 1);
+      for( Index k = 0; k < nnz; k++ )
+      {
+         if( a[k] != 0. )
+         {
+            Index p = row_pos[airn[k] - 1]++;
+            row_col[p] = ajcn[k] - 1;
+            row_val[p] = a[k];
+            p = col_pos[ajcn[k] - 1]++;
+            col_row[p] = airn[k] - 1;
+            col_val[p] = a[k];
+         }
+      }
+   }
+
+   for( Index i = 0; i < nrows; i++ )
+   {
+      row_scale[i] = 1.;
+   }
+   for( Index j = 0; j < ncols; j++ )
+   {
+      col_scale[j] = 1.;
+   }
+
+   // Largest and smallest scaled entry in every row and column
+   std::vector<Number> row_max(nrows);
+   std::vector<Number> col_max(ncols);
+   std::vector<Number> col_min(ncols);
+
+   // Geometric-mean passes: every row and then every column is
+   // divided by the geometric mean of its largest and smallest entry
+   Number last_ratio = -1.;
+   Index geom_pass;
+   for( geom_pass = 0; geom_pass < max_geom_passes; geom_pass++ )
+   {
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) if( nz >= min_parallel_equilibration_entries )
+#endif
+      for( Index i = 0; i < nrows; i++ )
+      {
+         Number vmax = 0.;
+         Number vmin = 0.;
+         for( Index p = row_start[i]; p < row_start[i + 1]; p++ )
+         {
+            Number v = row_val[p] * col_scale[row_col[p]];
+            vmax = (p == row_start[i]) ? v : Max(vmax, v);
+            vmin = (p == row_start[i]) ? v : Min(vmin, v);
+         }
+         if( vmax > 0. )
+         {
+            row_scale[i] = 1. / std::sqrt(vmax * vmin);
+         }
+      }
+
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) if( nz >= min_parallel_equilibration_entries )
+#endif
+      for( Index j = 0; j < ncols; j++ )
+      {
+         Number vmax = 0.;
+         Number vmin = 0.;
+         for( Index p = col_start[j]; p < col_start[j + 1]; p++ )
+         {
+            Number v = col_val[p] * row_scale[col_row[p]];
+            vmax = (p == col_start[j]) ? v : Max(vmax, v);
+            vmin = (p == col_start[j]) ? v : Min(vmin, v);
+         }
+         col_max[j] = vmax * col_scale[j];
+         col_min[j] = vmin * col_scale[j];
+         if( vmax > 0. )
+         {
+            col_scale[j] = 1. / std::sqrt(vmax * vmin);
+         }
+      }
+
+      // largest ratio between the entries in a column (before the
+      // column pass), as measure of the progress
+      Number ratio = 1.;
+      for( Index j = 0; j < ncols; j++ )
+      {
+         if( col_max[j] > 0. )
+         {
+            ratio = Max(ratio, col_max[j] / col_min[j]);
+         }
+      }
+      if( last_ratio > 0. && ratio > geom_pass_decrease * last_ratio )
+      {
+         geom_pass++;
+         break;
+      }
+      last_ratio = ratio;
+   }
+
+   // Ruiz sweeps: every row and column is divided by the square root
+   // of its largest scaled entry, until all of them are close to one
+   Index sweep = 0;
+   Number max_dev = 0.;
+   while( true )
+   {
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) if( nz >= min_parallel_equilibration_entries )
+#endif
+      for( Index i = 0; i < nrows; i++ )
+      {
+         Number vmax = 0.;
+         for( Index p = row_start[i]; p < row_start[i + 1]; p++ )
+         {
+            vmax = Max(vmax, row_val[p] * col_scale[row_col[p]]);
+         }
+         row_max[i] = vmax * row_scale[i];
+      }
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) if( nz >= min_parallel_equilibration_entries )
+#endif
+      for( Index j = 0; j < ncols; j++ )
+      {
+         Number vmax = 0.;
+         for( Index p = col_start[j]; p < col_start[j + 1]; p++ )
+         {
+            vmax = Max(vmax, col_val[p] * row_scale[col_row[p]]);
+         }
+         col_max[j] = vmax * col_scale[j];
+      }
+
+      max_dev = 0.;
+      for( Index i = 0; i < nrows; i++ )
+      {
+         if( row_max[i] > 0. )
+         {
+            max_dev = Max(max_dev, std::abs(1. - row_max[i]));
+         }
+      }
+      for( Index j = 0; j < ncols; j++ )
+      {
+         if( col_max[j] > 0. )
+         {
+            max_dev = Max(max_dev, std::abs(1. - col_max[j]));
+         }
+      }
+      if( max_dev <= ruiz_tol || sweep == max_ruiz_sweeps )
+      {
+         break;
+      }
+
+      sweep++;
+      for( Index i = 0; i < nrows; i++ )
+      {
+         if( row_max[i] > 0. )
+         {
+            row_scale[i] /= std::sqrt(row_max[i]);
+         }
+      }
+      for( Index j = 0; j < ncols; j++ )
+      {
+         if( col_max[j] > 0. )
+         {
+            col_scale[j] /= std::sqrt(col_max[j]);
+         }
+      }
+   }
+
+   Jnlst().Printf(J_DETAILED, J_INITIALIZATION,
+                  "Equilibration scaling: %" IPOPT_INDEX_FORMAT " geometric-mean passes, %" IPOPT_INDEX_FORMAT " Ruiz sweeps, max. deviation of norms from one %e\n",
+                  geom_pass, sweep, max_dev);
+}
+
 PointPerturber::PointPerturber(
    const Vector& x0,
    Number        random_pert_radius,
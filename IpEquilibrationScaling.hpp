@@ -13,9 +13,14 @@
 
 namespace Ipopt
 {
-/** This class does problem scaling by setting the
- *  scaling parameters based on the maximum of the
- *  gradient at the user provided initial point.
+/** This class does problem scaling by equilibrating the matrix
+ *  formed by the objective function gradient and the constraint
+ *  Jacobians, averaged over a few randomly perturbed points around
+ *  the user provided initial point.
+ *
+ *  The equilibration is computed either by the Harwell routine MC19
+ *  or natively, by geometric-mean scaling followed by Ruiz
+ *  equilibration.
  */
 class EquilibrationScaling: public StandardScalingBase
 {
@@ -27,6 +32,8 @@ public:
       SmartPtr<LibraryLoader> hslloader_
    )  : StandardScalingBase(),
       nlp_(nlp),
+      use_mc19_(false),
+      concurrent_evaluation_(false),
       hslloader(hslloader_),
       mc19a(NULL)
    { }
@@ -91,12 +98,37 @@ private:
    );
    ///@}
 
+   /** Compute the native equilibration scaling factors.
+    *
+    *  The nonnegative matrix with nrows rows and ncols columns is
+    *  given in triplet format with 1-based indices.  The factors are
+    *  chosen such that row_scale[i]*a_ij*col_scale[j] is close to one.
+    */
+   void ComputeEquilibrationFactors(
+      Index         nrows,
+      Index         ncols,
+      Index         nnz,
+      const Index*  airn,
+      const Index*  ajcn,
+      const Number* a,
+      Number*       row_scale,
+      Number*       col_scale
+   ) const;
+
    /** pointer to the NLP to get scaling parameters */
    SmartPtr<NLP> nlp_;
 
    /** maximal radius for the random perturbation of the initial point */
    Number point_perturbation_radius_;
 
+   /** whether MC19 is used instead of the native equilibration */
+   bool use_mc19_;
+
+   /** whether the derivatives at the perturbed points are evaluated
+    *  concurrently, if the NLP supports it
+    */
+   bool concurrent_evaluation_;
+
    /**@name MC19 function pointer
     * @{
     */
@@ -85,6 +85,26 @@ void Filter::AddEntry(
    filter_list_.push_back(new_entry);
 }
 
+void Filter::GetEntries(
+   std::vector<std::vector<Number> >& vals,
+   std::vector<Index>&                iterations
+) const
+{
+   vals.clear();
+   iterations.clear();
+   std::list<FilterEntry*>::const_iterator iter;
+   for( iter = filter_list_.begin(); iter != filter_list_.end(); ++iter )
+   {
+      std::vector<Number> entry_vals(dim_);
+      for( Index i = 0; i < dim_; i++ )
+      {
+         entry_vals[i] = (*iter)->val(i);
+      }
+      vals.push_back(entry_vals);
+      iterations.push_back((*iter)->iter());
+   }
+}
+
 void Filter::Clear()
 {
    DBG_START_METH("FilterLineSearch::Filter::Clear", dbg_verbosity);
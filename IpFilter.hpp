@@ -198,6 +198,14 @@ public:
    /** Delete all filter entries */
    void Clear();
 
+   /** Get the coordinates of all filter entries and the iterations in
+    *  which they were added.
+    */
+   void GetEntries(
+      std::vector<std::vector<Number> >& vals,
+      std::vector<Index>&                iterations
+   ) const;
+
    /** Print current filter entries */
    void Print(
       const Journalist& jnlst
@@ -21,6 +21,16 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
+/** Filter entries kept for a warm start. */
+class FilterWarmState: public ReferencedObject
+{
+public:
+   /** Coordinates of the filter entries */
+   std::vector<std::vector<Number> > vals;
+   /** Iterations in which the entries were added */
+   std::vector<Index> iterations;
+};
+
 FilterLSAcceptor::FilterLSAcceptor(const SmartPtr<PDSystemSolver>& pd_solver)
    :
    filter_(2),
@@ -527,6 +537,35 @@ void FilterLSAcceptor::Reset()
    filter_.Clear();
 }
 
+SmartPtr<const ReferencedObject> FilterLSAcceptor::GetWarmState() const
+{
+   SmartPtr<FilterWarmState> state = new FilterWarmState();
+   filter_.GetEntries(state->vals, state->iterations);
+   return ConstPtr(state);
+}
+
+void FilterLSAcceptor::SetWarmState(
+   const SmartPtr<const ReferencedObject>& state
+)
+{
+   DBG_START_METH("FilterLSAcceptor::SetWarmState",
+                  dbg_verbosity);
+
+   const FilterWarmState* filter_state = dynamic_cast<const FilterWarmState*>(GetRawPtr(state));
+   if( filter_state == NULL )
+   {
+      return;
+   }
+
+   filter_.Clear();
+   for( size_t i = 0; i < filter_state->vals.size(); i++ )
+   {
+      filter_.AddEntry(filter_state->vals[i], filter_state->iterations[i]);
+   }
+   Jnlst().Printf(J_DETAILED, J_LINE_SEARCH,
+                  "Restored %d filter entries from warm state.\n", (int) filter_state->vals.size());
+}
+
 bool
 FilterLSAcceptor::TrySecondOrderCorrection(
    Number alpha_primal_test,
@@ -552,6 +591,20 @@ FilterLSAcceptor::TrySecondOrderCorrection(
    SmartPtr<Vector> dms_soc = IpCq().curr_d_minus_s()->MakeNew();
    c_soc->Copy(*IpCq().curr_c());
    dms_soc->Copy(*IpCq().curr_d_minus_s());
+
+   // The right hand sides of the SOC systems differ only in the c and
+   // d parts (and, for soc_method 1, in the factor of the x and s
+   // parts), so that the other parts are set only once.  Since the
+   // matrix is the same as for the search direction, the primal-dual
+   // solver only needs to do a back solve for each of them.
+   SmartPtr<IteratesVector> rhs = actual_delta->MakeNewContainer();
+   rhs->Set_x(*IpCq().curr_grad_lag_with_damping_x());
+   rhs->Set_s(*IpCq().curr_grad_lag_with_damping_s());
+   rhs->Set_z_L(*IpCq().curr_relaxed_compl_x_L());
+   rhs->Set_z_U(*IpCq().curr_relaxed_compl_x_U());
+   rhs->Set_v_L(*IpCq().curr_relaxed_compl_s_L());
+   rhs->Set_v_U(*IpCq().curr_relaxed_compl_s_U());
+   SmartPtr<IteratesVector> delta_soc = actual_delta->MakeNewIteratesVector(true);
    while (count_soc < max_soc_ && !accept &&
           (count_soc == 0 || theta_trial <= kappa_soc_ * theta_soc_old) )
    {
@@ -566,42 +619,23 @@ FilterLSAcceptor::TrySecondOrderCorrection(
       dms_soc->AddOneVector(1.0, *IpCq().trial_d_minus_s(), alpha_primal_soc);
 
       // Compute the SOC search direction
-      SmartPtr<IteratesVector> delta_soc = actual_delta->MakeNewIteratesVector(true);
-      SmartPtr<IteratesVector> rhs = actual_delta->MakeNewContainer();
-
-      switch (soc_method_)
+      rhs->Set_y_c(*c_soc);
+      rhs->Set_y_d(*dms_soc);
+      if (soc_method_ == 1)
       {
-         case 0:
-            rhs->Set_x(*IpCq().curr_grad_lag_with_damping_x());
-            rhs->Set_s(*IpCq().curr_grad_lag_with_damping_s());
-            rhs->Set_y_c(*c_soc);
-            rhs->Set_y_d(*dms_soc);
-            rhs->Set_z_L(*IpCq().curr_relaxed_compl_x_L());
-            rhs->Set_z_U(*IpCq().curr_relaxed_compl_x_U());
-            rhs->Set_v_L(*IpCq().curr_relaxed_compl_s_L());
-            rhs->Set_v_U(*IpCq().curr_relaxed_compl_s_U());
-            break;
-         case 1:
-            SmartPtr<Vector> x_soc =
-               IpCq().curr_grad_lag_with_damping_x()->MakeNew();
-            SmartPtr<Vector> s_soc =
-               IpCq().curr_grad_lag_with_damping_s()->MakeNew();
-            x_soc->Copy(*IpCq().curr_grad_lag_with_damping_x());
-            s_soc->Copy(*IpCq().curr_grad_lag_with_damping_s());
-            x_soc->Scal(alpha_primal_soc);
-            s_soc->Scal(alpha_primal_soc);
-
-            rhs->Set_x(*x_soc);
-            rhs->Set_s(*s_soc);
-            rhs->Set_y_c(*c_soc);
-            rhs->Set_y_d(*dms_soc);
-            rhs->Set_z_L(*IpCq().curr_relaxed_compl_x_L());
-            rhs->Set_z_U(*IpCq().curr_relaxed_compl_x_U());
-            rhs->Set_v_L(*IpCq().curr_relaxed_compl_s_L());
-            rhs->Set_v_U(*IpCq().curr_relaxed_compl_s_U());
-            break;
+         SmartPtr<Vector> x_soc =
+            IpCq().curr_grad_lag_with_damping_x()->MakeNew();
+         SmartPtr<Vector> s_soc =
+            IpCq().curr_grad_lag_with_damping_s()->MakeNew();
+         x_soc->Copy(*IpCq().curr_grad_lag_with_damping_x());
+         s_soc->Copy(*IpCq().curr_grad_lag_with_damping_s());
+         x_soc->Scal(alpha_primal_soc);
+         s_soc->Scal(alpha_primal_soc);
+
+         rhs->Set_x(*x_soc);
+         rhs->Set_s(*s_soc);
       }
-      bool retval = pd_solver_->Solve(-1.0, 0.0, *rhs, *delta_soc, true);
+      bool retval = pd_solver_->BackSolve(-1.0, *rhs, *delta_soc);
       if (!retval)
       {
          Jnlst().Printf(J_DETAILED, J_LINE_SEARCH,
@@ -128,6 +128,19 @@ public:
     */
    virtual void StopWatchDog();
 
+   /** The internal data for a warm start are the filter entries.
+    *
+    *  The bounds theta_min and theta_max on the constraint violation
+    *  are not kept, since they are based on the constraint violation
+    *  at the starting point, which may be different in the new
+    *  optimization.
+    */
+   virtual SmartPtr<const ReferencedObject> GetWarmState() const;
+
+   virtual void SetWarmState(
+      const SmartPtr<const ReferencedObject>& state
+   );
+
    /**@name Trial Point Accepting Methods.
     *
     * Used internally to check certain
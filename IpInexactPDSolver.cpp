@@ -65,7 +65,7 @@ bool InexactPDSolver::InitializeImpl(
 
    std::string linear_solver;
    options.GetStringValue("linear_solver", linear_solver, prefix);
-   is_pardiso_ = (linear_solver == "pardiso");
+   is_pardiso_ = (linear_solver == "pardiso" || linear_solver == "sqmr");
 
    if( !augSysSolver_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix) )
    {
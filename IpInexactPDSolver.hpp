@@ -141,7 +141,8 @@ private:
    Index inexact_regularization_ls_count_trigger_;
    ///@}
 
-   /** flag indicating if we are dealing with the Pardiso solver
+   /** flag indicating if we are dealing with an iterative solver
+    *  that calls the termination testers (Pardiso or SQMR)
     *  (temporary)
     */
    bool is_pardiso_;
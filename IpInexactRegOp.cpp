@@ -15,6 +15,7 @@
 #include "IpInexactLSAcceptor.hpp"
 #include "IpInexactCq.hpp"
 #include "IpIterativePardisoSolverInterface.hpp"
+#include "IpIterativeSqmrSolverInterface.hpp"
 #include "IpInexactNormalTerminationTester.hpp"
 #include "IpInexactPDTerminationTester.hpp"
 
@@ -34,6 +35,7 @@ void RegisterOptions_Inexact(
    InexactLSAcceptor::RegisterOptions(roptions);
    InexactCq::RegisterOptions(roptions);
    IterativePardisoSolverInterface::RegisterOptions(roptions);
+   IterativeSqmrSolverInterface::RegisterOptions(roptions);
    InexactNormalTerminationTester::RegisterOptions(roptions);
    InexactPDTerminationTester::RegisterOptions(roptions);
 }
@@ -10,6 +10,8 @@
 #include "IpRestoPhase.hpp"
 #include "IpOrigIpoptNLP.hpp"
 #include "IpBacktrackingLineSearch.hpp"
+#include "IpDefaultIterateInitializer.hpp"
+#include "IpTimingTracer.hpp"
 
 #ifdef IPOPT_HAS_HSL
 #include "CoinHslConfig.h"
@@ -114,6 +116,15 @@ void IpoptAlgorithm::RegisterOptions(
       "Indicates whether to measure time spend in components of Ipopt and NLP evaluation",
       false,
       "The overall algorithm time is unaffected by this option.");
+   roptions->AddBoolOption(
+      "timing_fine_grained",
+      "Indicates whether to measure only the wallclock time of short and frequently called tasks",
+      false,
+      "If enabled, the CPU and system time of the function evaluations, back solves, residual computations, "
+      "and structure conversions of the linear system are not measured, which reduces the overhead "
+      "of the timing. The CPU and system times reported for these tasks are then zero. "
+      "This option is only used if \"timing_statistics\" is enabled.",
+      true);
 }
 
 static bool copyright_message_printed = false;
@@ -133,6 +144,12 @@ bool IpoptAlgorithm::InitializeImpl(
    {
       IpData().TimingStats().DisableTimes();
    }
+   else
+   {
+      bool timing_fine_grained;
+      options.GetBoolValue("timing_fine_grained", timing_fine_grained, "");
+      IpData().TimingStats().SetFineGrainedTimes(timing_fine_grained);
+   }
 
    SmartPtr<const OptionsList> my_options;
    options.GetBoolValue("mehrotra_algorithm", mehrotra_algorithm_, prefix);
@@ -248,6 +265,23 @@ bool IpoptAlgorithm::InitializeImpl(
 
    my_options->GetNumericValue("constr_viol_tol", constr_viol_tol_, prefix);
 
+   if( !my_options->GetNumericValue("warm_start_bound_push", warm_start_bound_push_, prefix) )
+   {
+      my_options->GetNumericValue("bound_push", warm_start_bound_push_, prefix);
+   }
+   if( !my_options->GetNumericValue("warm_start_bound_frac", warm_start_bound_frac_, prefix) )
+   {
+      my_options->GetNumericValue("bound_frac", warm_start_bound_frac_, prefix);
+   }
+   if( !my_options->GetNumericValue("warm_start_slack_bound_push", warm_start_slack_bound_push_, prefix) )
+   {
+      my_options->GetNumericValue("bound_push", warm_start_slack_bound_push_, prefix);
+   }
+   if( !my_options->GetNumericValue("warm_start_slack_bound_frac", warm_start_slack_bound_frac_, prefix) )
+   {
+      my_options->GetNumericValue("bound_frac", warm_start_slack_bound_frac_, prefix);
+   }
+
    if( prefix == "resto." )
    {
       skip_print_problem_stats_ = true;
@@ -295,6 +329,14 @@ SolverReturn IpoptAlgorithm::Optimize(
 {
    DBG_START_METH("IpoptAlgorithm::Optimize", dbg_verbosity);
 
+   // Tag the traced tasks with the iteration counter, which continues
+   // the one of the regular algorithm in the restoration phase
+   SmartPtr<TimingTracer> tracer = IpData().TimingStats().Tracer();
+   if( IsValid(tracer) )
+   {
+      tracer->SetIteration(IpData().iter_count());
+   }
+
    // Start measuring CPU time
    IpData().TimingStats().OverallAlgorithm().Start();
 
@@ -330,6 +372,11 @@ SolverReturn IpoptAlgorithm::Optimize(
       IpData().TimingStats().InitializeIterates().Start();
       // Initialize the iterates
       InitializeIterates();
+      if( !isResto && IsValid(warm_state_) )
+      {
+         RestoreWarmState();
+         warm_state_ = NULL;
+      }
       IpData().TimingStats().InitializeIterates().End();
 
       if( !skip_print_problem_stats_ )
@@ -405,6 +452,10 @@ SolverReturn IpoptAlgorithm::Optimize(
          IpData().TimingStats().AcceptTrialPoint().End();
 
          IpData().Set_iter_count(IpData().iter_count() + 1);
+         if( IsValid(tracer) )
+         {
+            tracer->SetIteration(IpData().iter_count());
+         }
 
          if( IpCq().IsSquareProblem() )
          {
@@ -649,6 +700,99 @@ void IpoptAlgorithm::InitializeIterates()
    ASSERT_EXCEPTION(retval, FAILED_INITIALIZATION, "Error while obtaining initial iterates.");
 }
 
+/** Checks whether x is strictly within its lower and upper bounds */
+static bool StrictlyWithinBounds(
+   const Vector& x,
+   const Vector& x_L,
+   const Vector& x_U,
+   const Matrix& Px_L,
+   const Matrix& Px_U
+)
+{
+   if( x_L.Dim() > 0 )
+   {
+      SmartPtr<Vector> slack = x_L.MakeNew();
+      Px_L.TransMultVector(1., x, 0., *slack);
+      slack->Axpy(-1., x_L);
+      if( slack->Min() <= 0. )
+      {
+         return false;
+      }
+   }
+   if( x_U.Dim() > 0 )
+   {
+      SmartPtr<Vector> slack = x_U.MakeNew();
+      Px_U.TransMultVector(-1., x, 0., *slack);
+      slack->Axpy(1., x_U);
+      if( slack->Min() <= 0. )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+SmartPtr<IpoptWarmState> IpoptAlgorithm::GetWarmState() const
+{
+   DBG_START_METH("IpoptAlgorithm::GetWarmState", dbg_verbosity);
+
+   if( IsNull(IpData().curr()) || !IpData().MuInitialized() || !IpData().TauInitialized() )
+   {
+      return NULL;
+   }
+
+   return new IpoptWarmState(IpData().curr(), IpData().curr_mu(), IpData().curr_tau(), line_search_->GetWarmState(),
+                             hessian_updater_->GetWarmState());
+}
+
+void IpoptAlgorithm::RestoreWarmState()
+{
+   DBG_START_METH("IpoptAlgorithm::RestoreWarmState", dbg_verbosity);
+
+   SmartPtr<const IteratesVector> curr = IpData().curr();
+   SmartPtr<const IteratesVector> iterate = warm_state_->Iterate();
+   ASSERT_EXCEPTION(IsValid(iterate) && iterate->NComps() == curr->NComps(), INVALID_WARMSTART,
+                    "The warm start state does not fit to the problem.");
+   for( Index i = 0; i < curr->NComps(); i++ )
+   {
+      ASSERT_EXCEPTION(iterate->GetComp(i)->Dim() == curr->GetComp(i)->Dim(), INVALID_WARMSTART,
+                       "The dimensions of the warm start state do not match those of the problem.");
+   }
+
+   SmartPtr<IteratesVector> init_vec = curr->MakeNewIteratesVector(true);
+   init_vec->Copy(*iterate);
+
+   // The bounds might have changed since the state has been obtained
+   if( !StrictlyWithinBounds(*init_vec->x(), *IpNLP().x_L(), *IpNLP().x_U(), *IpNLP().Px_L(), *IpNLP().Px_U()) )
+   {
+      SmartPtr<const Vector> new_x;
+      DefaultIterateInitializer::push_variables(Jnlst(), warm_start_bound_push_, warm_start_bound_frac_, "x",
+            *init_vec->x(), new_x, *IpNLP().x_L(), *IpNLP().x_U(), *IpNLP().Px_L(), *IpNLP().Px_U());
+      init_vec->Set_x(*new_x);
+   }
+   if( !StrictlyWithinBounds(*init_vec->s(), *IpNLP().d_L(), *IpNLP().d_U(), *IpNLP().Pd_L(), *IpNLP().Pd_U()) )
+   {
+      SmartPtr<const Vector> new_s;
+      DefaultIterateInitializer::push_variables(Jnlst(), warm_start_slack_bound_push_, warm_start_slack_bound_frac_,
+            "s", *init_vec->s(), new_s, *IpNLP().d_L(), *IpNLP().d_U(), *IpNLP().Pd_L(), *IpNLP().Pd_U());
+      init_vec->Set_s(*new_s);
+   }
+
+   IpData().set_trial(init_vec);
+   IpData().AcceptTrialPoint();
+   IpCq().ResetAdjustedTrialSlacks();
+
+   IpData().Set_mu(warm_state_->Mu());
+   IpData().Set_tau(warm_state_->Tau());
+
+   line_search_->SetWarmState(warm_state_->LineSearchState());
+   hessian_updater_->SetWarmState(warm_state_->HessianUpdaterState());
+
+   Jnlst().Printf(J_DETAILED, J_INITIALIZATION,
+                  "Continuing from warm start state with mu = %e and tau = %e.\n", warm_state_->Mu(),
+                  warm_state_->Tau());
+}
+
 void IpoptAlgorithm::AcceptTrialPoint()
 {
    DBG_START_METH("IpoptAlgorithm::AcceptTrialPoint", dbg_verbosity);
@@ -19,6 +19,7 @@
 #include "IpAlgTypes.hpp"
 #include "IpHessianUpdater.hpp"
 #include "IpEqMultCalculator.hpp"
+#include "IpIpoptWarmState.hpp"
 
 namespace Ipopt
 {
@@ -92,6 +93,31 @@ public:
    }
    ///@}
 
+   /**@name Methods for warm starts from the state of a previous optimization */
+   ///@{
+   /** Collect the current state of the algorithm.
+    *
+    *  This should be called after Optimize has returned.
+    */
+   SmartPtr<IpoptWarmState> GetWarmState() const;
+
+   /** Set the state from which the next call of Optimize continues.
+    *
+    *  The state replaces the initial point computed by the iterate
+    *  initializer in the next call of Optimize (but not in calls for
+    *  the restoration phase), and is used only once.
+    *  The problem must have the same structure as the one from which
+    *  the state has been obtained.  Pass NULL to forget a state that
+    *  has been set before.
+    */
+   void SetWarmState(
+      const SmartPtr<const IpoptWarmState>& warm_state
+   )
+   {
+      warm_state_ = warm_state;
+   }
+   ///@}
+
    static void print_copyright_message(
       const Journalist& jnlst
    );
@@ -183,6 +209,14 @@ private:
     */
    void InitializeIterates();
 
+   /** Replaces the initial iterates by those of warm_state_ and
+    *  restores the remaining state of the algorithm.
+    *
+    *  Corrects x and s if they are not strictly within the bounds of
+    *  the current problem.
+    */
+   void RestoreWarmState();
+
    /** Print the problem size statistics */
    void PrintProblemStatistics();
 
@@ -232,8 +266,19 @@ private:
    std::string linear_solver_name_;
    /** Constraint violation tolerance on unscaled problem */
    Number constr_viol_tol_;
+   /** Absolute distance of restored primal variables from their bounds */
+   Number warm_start_bound_push_;
+   /** Relative distance of restored primal variables from their bounds */
+   Number warm_start_bound_frac_;
+   /** Absolute distance of restored slack variables from their bounds */
+   Number warm_start_slack_bound_push_;
+   /** Relative distance of restored slack variables from their bounds */
+   Number warm_start_slack_bound_frac_;
    ///@}
 
+   /** State to continue from in the next call of Optimize, if any */
+   SmartPtr<const IpoptWarmState> warm_state_;
+
    /** @name auxiliary functions */
    ///@{
    void calc_number_of_bounds(
@@ -8,8 +8,10 @@
 #include "IpIpoptApplication.hpp"
 #include "IpTNLPAdapter.hpp"
 #include "IpIpoptAlg.hpp"
+#include "IpIpoptWarmState.hpp"
 #include "IpOrigIpoptNLP.hpp"
 #include "IpIpoptData.hpp"
+#include "IpTimingTracer.hpp"
 #include "IpIpoptCalculatedQuantities.hpp"
 #include "IpAlgBuilder.hpp"
 #include "IpSolveStatistics.hpp"
@@ -229,13 +231,28 @@ ApplicationReturnStatus IpoptApplication::Initialize(
             }
             bool file_append;
             options_->GetBoolValue("file_append", file_append, "");
-            bool openend = OpenOutputFile(output_filename, file_print_level, file_append);
+            options_->GetEnumValue("file_writer", ivalue, "");
+            bool openend = OpenOutputFile(output_filename, file_print_level, file_append, (EJournalWriter) ivalue);
             if( !openend )
             {
                jnlst_->Printf(J_ERROR, J_INITIALIZATION, "Error opening output file \"%s\"\n", output_filename.c_str());
                return Invalid_Option;
             }
          }
+
+         // Open a metrics file if required
+         std::string metrics_filename;
+         options_->GetStringValue("metrics_file", metrics_filename, "");
+         if( metrics_filename != "" )
+         {
+            bool file_append;
+            options_->GetBoolValue("file_append", file_append, "");
+            if( !OpenMetricsFile(metrics_filename, file_append) )
+            {
+               jnlst_->Printf(J_ERROR, J_INITIALIZATION, "Error opening metrics file \"%s\"\n", metrics_filename.c_str());
+               return Invalid_Option;
+            }
+         }
       }
 
       // output a description of all the options
@@ -393,6 +410,30 @@ void IpoptApplication::RegisterOptions(
       "Whether to append to output file, if set, instead of truncating.",
       false,
       "NOTE: This option only works when read from the ipopt.opt options file!");
+   roptions->AddStringOption3(
+      "file_writer",
+      "How the output file is written.",
+      "sync",
+      "sync", "write on the solver thread",
+      "async", "write from a background thread; the solver waits if too much output is pending",
+      "async-drop", "write from a background thread; output is dropped if too much output is pending",
+      "NOTE: This option only works when read from the ipopt.opt options file! "
+      "With the asynchronous writers, the output is formatted into a buffer that is written to the file "
+      "specified by \"output_file\" by a background thread, so that large amounts of output, "
+      "e.g., with a high \"file_print_level\", slow down the solver less. "
+      "If output is dropped, a note about the number of lost bytes is written to the file.");
+   roptions->AddStringOption1(
+      "metrics_file",
+      "File name for machine-readable iteration metrics (leave unset for no metrics output).",
+      "",
+      "*", "Any acceptable standard file name",
+      "NOTE: This option only works when read from the ipopt.opt options file! "
+      "If set, one JSON object per line is written to this file for every iteration and at the end of every solve. "
+      "The iteration records contain the values of the iteration summary line, "
+      "the number of iterative refinement steps, the size of the factorization if the linear solver reports it, "
+      "and the wallclock time spent in each timed task since the previous iteration; "
+      "the latter requires timing_statistics=yes. "
+      "The file is appended to if \"file_append\" is set.");
    roptions->AddBoolOption(
       "print_user_options",
       "Print all options set by the user.",
@@ -421,6 +462,15 @@ void IpoptApplication::RegisterOptions(
       false,
       "If selected, the program will print the time spend for selected tasks. "
       "This implies timing_statistics=yes.");
+   roptions->AddStringOption1(
+      "timing_trace_file",
+      "File name of a trace of the timed tasks.",
+      "",
+      "*", "Any acceptable standard file name",
+      "If not empty, the begin and end of every timed task, tagged with the iteration number and thread, "
+      "is written to this file in the Chrome trace event format, which can be viewed with chrome://tracing or Perfetto. "
+      "Tasks of the restoration phase are prefixed with \"Restoration.\". "
+      "This implies timing_statistics=yes.");
 
    roptions->SetRegisteringCategory("Miscellaneous");
    roptions->AddStringOption1(
@@ -485,6 +535,38 @@ ApplicationReturnStatus IpoptApplication::ReOptimizeTNLP(
    return ReOptimizeNLP(nlp_adapter_);
 }
 
+ApplicationReturnStatus IpoptApplication::ReOptimizeTNLP(
+   const SmartPtr<TNLP>&                 tnlp,
+   const SmartPtr<const IpoptWarmState>& warm_state
+)
+{
+   ASSERT_EXCEPTION(IsValid(nlp_adapter_), INVALID_WARMSTART, "ReOptimizeTNLP called before OptimizeTNLP.");
+   ASSERT_EXCEPTION(IsValid(warm_state), INVALID_WARMSTART, "ReOptimizeTNLP called without warm start state.");
+   IpoptAlgorithm* p2alg = static_cast<IpoptAlgorithm*>(GetRawPtr(alg_));
+   DBG_ASSERT(dynamic_cast<IpoptAlgorithm*> (GetRawPtr(alg_)));
+
+   // The state refers to the spaces and the scaling of the previous
+   // optimization, so these must not be set up anew
+   std::string same_structure;
+   bool same_structure_set = options_->GetStringValue("warm_start_same_structure", same_structure, "");
+   options_->SetStringValue("warm_start_same_structure", "yes", true, true);
+
+   p2alg->SetWarmState(warm_state);
+   ApplicationReturnStatus retValue = ReOptimizeTNLP(tnlp);
+   p2alg->SetWarmState(NULL);
+
+   if( same_structure_set )
+   {
+      options_->SetStringValue("warm_start_same_structure", same_structure, true, true);
+   }
+   else
+   {
+      options_->UnsetValue("warm_start_same_structure");
+   }
+
+   return retValue;
+}
+
 ApplicationReturnStatus IpoptApplication::OptimizeNLP(
    const SmartPtr<NLP>& nlp
 )
@@ -589,6 +671,67 @@ ApplicationReturnStatus IpoptApplication::ReOptimizeNLP(
    return call_optimize();
 }
 
+/** Write the metrics record of a solve.
+ *
+ *  If the solve ended with an exception, there are no statistics and
+ *  only the status and the number of iterations are recorded.
+ */
+static void WriteSolveMetrics(
+   Journalist&             jnlst,
+   ApplicationReturnStatus status,
+   const SolveStatistics*  statistics,
+   Index                   iter_count
+)
+{
+   if( !jnlst.ProduceMetrics() )
+   {
+      return;
+   }
+
+   MetricsRecord record("solve");
+   record.AddInteger("status", (Index) status);
+   if( statistics == NULL )
+   {
+      record.AddInteger("iterations", iter_count);
+      jnlst.WriteMetrics(record);
+      return;
+   }
+
+   record.AddInteger("iterations", statistics->IterationCount());
+   record.AddNumber("objective", statistics->FinalObjective());
+   Number dual_inf, constr_viol, varbounds_viol, complementarity, kkt_error;
+   statistics->Infeasibilities(dual_inf, constr_viol, varbounds_viol, complementarity, kkt_error);
+   record.AddNumber("dual_inf", dual_inf);
+   record.AddNumber("constr_viol", constr_viol);
+   record.AddNumber("complementarity", complementarity);
+   record.AddNumber("kkt_error", kkt_error);
+   record.AddNumber("wallclock", statistics->TotalWallclockTime());
+   Index num_obj_evals, num_constr_evals, num_obj_grad_evals, num_constr_jac_evals, num_hess_evals;
+   statistics->NumberOfEvaluations(num_obj_evals, num_constr_evals, num_obj_grad_evals, num_constr_jac_evals,
+                                   num_hess_evals);
+   record.AddInteger("obj_evals", num_obj_evals);
+   record.AddInteger("constr_evals", num_constr_evals);
+   record.AddInteger("obj_grad_evals", num_obj_grad_evals);
+   record.AddInteger("constr_jac_evals", num_constr_jac_evals);
+   record.AddInteger("hess_evals", num_hess_evals);
+   jnlst.WriteMetrics(record);
+}
+
+/** Print how many requests for a function value or derivative were
+ *  answered from the cache, relative to all requests.
+ */
+static void PrintCacheHits(
+   const Journalist& jnlst,
+   const char*       name,
+   Index             hits,
+   Index             evals
+)
+{
+   Index lookups = hits + evals;
+   jnlst.Printf(J_DETAILED, J_STATISTICS, "%s = %" IPOPT_INDEX_FORMAT " (%5.1f%%)\n", name, hits,
+                lookups > 0 ? 100. * hits / lookups : 0.);
+}
+
 ApplicationReturnStatus IpoptApplication::call_optimize()
 {
    // Reset the print-level for the screen output
@@ -604,6 +747,7 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
    }
 
    statistics_ = NULL; /* delete old statistics */
+   warm_state_ = NULL;
    // Get the pointers to the real objects (need to do it that
    // awkwardly since otherwise we would have to include so many
    // things in IpoptApplication, which a user would have to
@@ -622,6 +766,7 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
 
    ApplicationReturnStatus retValue = Internal_Error;
    SolverReturn status = INTERNAL_ERROR;
+   SmartPtr<TimingTracer> tracer;
    try
    {
       // check whether timing statistics need to be printed
@@ -633,6 +778,24 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
          options_->SetStringValue("timing_statistics", "yes", true, true);
       }
 
+      // start tracing the timed tasks, if requested
+      std::string timing_trace_file;
+      options_->GetStringValue("timing_trace_file", timing_trace_file, "");
+      if( !timing_trace_file.empty() )
+      {
+         tracer = new TimingTracer();
+         if( tracer->Open(timing_trace_file) )
+         {
+            options_->SetStringValue("timing_statistics", "yes", true, true);
+            p2ip_data->TimingStats().SetTracer(tracer);
+         }
+         else
+         {
+            jnlst_->Printf(J_WARNING, J_MAIN, "Could not open timing trace file %s.\n", timing_trace_file.c_str());
+            tracer = NULL;
+         }
+      }
+
       // Set up the algorithm
       p2alg->Initialize(*jnlst_, *p2ip_nlp, *p2ip_data, *p2ip_cq, *options_, "");
 
@@ -721,6 +884,19 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
                      p2ip_nlp->jac_d_evals());
       jnlst_->Printf(J_SUMMARY, J_STATISTICS, "Number of Lagrangian Hessian evaluations             = %" IPOPT_INDEX_FORMAT "\n",
                      p2ip_nlp->h_evals());
+      jnlst_->Printf(J_DETAILED, J_STATISTICS, "\n");
+      PrintCacheHits(*jnlst_, "Number of objective function cache hits             ", p2ip_nlp->f_cache_hits(),
+                     p2ip_nlp->f_evals());
+      PrintCacheHits(*jnlst_, "Number of objective gradient cache hits             ", p2ip_nlp->grad_f_cache_hits(),
+                     p2ip_nlp->grad_f_evals());
+      PrintCacheHits(*jnlst_, "Number of equality constraint cache hits            ", p2ip_nlp->c_cache_hits(),
+                     p2ip_nlp->c_evals());
+      PrintCacheHits(*jnlst_, "Number of inequality constraint cache hits          ", p2ip_nlp->d_cache_hits(),
+                     p2ip_nlp->d_evals());
+      PrintCacheHits(*jnlst_, "Number of equality constraint Jacobian cache hits   ", p2ip_nlp->jac_c_cache_hits(),
+                     p2ip_nlp->jac_c_evals());
+      PrintCacheHits(*jnlst_, "Number of inequality constraint Jacobian cache hits ", p2ip_nlp->jac_d_cache_hits(),
+                     p2ip_nlp->jac_d_evals());
       Number wall_time_overall_alg = p2ip_data->TimingStats().OverallAlgorithm().TotalWallclockTime();
       if( p2ip_data->TimingStats().IsFunctionEvaluationTimeEnabled() )
       {
@@ -822,6 +998,9 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
       {
          // Create a SolveStatistics object
          statistics_ = new SolveStatistics(p2ip_nlp, p2ip_data, p2ip_cq);
+
+         // Keep the final state for a warm start of a later optimization
+         warm_state_ = p2alg->GetWarmState();
       }
    }
    catch( TOO_FEW_DOF& exc )
@@ -879,11 +1058,15 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
       }
       else
       {
+         WriteSolveMetrics(*jnlst_, NonIpopt_Exception_Thrown, NULL, p2ip_data->iter_count());
          jnlst_->FlushBuffer();
          throw;
       }
    }
 
+   // this is also reached if the solve ended with an exception
+   WriteSolveMetrics(*jnlst_, retValue, GetRawPtr(statistics_), p2ip_data->iter_count());
+
    /** Flag indicating if the NLP:FinalizeSolution method should not
     *  be called after optimization. */
    bool skip_finalize_solution_call;
@@ -943,6 +1126,17 @@ ApplicationReturnStatus IpoptApplication::call_optimize()
       p2ip_nlp->FinalizeSolution(status, *p2ip_data->curr()->x(), *zL, *zU, *c, *d, *yc, *yd, obj, p2ip_data, p2ip_cq);
    }
 
+   if( IsValid(tracer) )
+   {
+      p2ip_data->TimingStats().SetTracer(NULL);
+      tracer->Close();
+      if( tracer->NumDroppedEvents() > 0 )
+      {
+         jnlst_->Printf(J_WARNING, J_MAIN, "%lu events have been dropped from the timing trace.\n",
+                        (unsigned long) tracer->NumDroppedEvents());
+      }
+   }
+
    jnlst_->FlushBuffer();
 
    return retValue;
@@ -972,6 +1166,51 @@ bool IpoptApplication::OpenOutputFile(
    return true;
 }
 
+bool IpoptApplication::OpenOutputFile(
+   std::string    file_name,
+   EJournalLevel  print_level,
+   bool           file_append,
+   EJournalWriter writer
+)
+{
+   if( writer == J_WRITER_SYNC )
+   {
+      return OpenOutputFile(file_name, print_level, file_append);
+   }
+
+   SmartPtr<Journal> file_jrnl = jnlst_->GetJournal("OutputFile:" + file_name);
+
+   if( IsNull(file_jrnl) )
+   {
+      file_jrnl = jnlst_->AddFileJournal("OutputFile:" + file_name, file_name.c_str(), print_level, file_append, writer);
+   }
+
+   // Check, if the output file could be created properly
+   if( IsNull(file_jrnl) )
+   {
+      return false;
+   }
+
+   file_jrnl->SetPrintLevel(J_DBG, J_NONE);
+
+   return true;
+}
+
+bool IpoptApplication::OpenMetricsFile(
+   std::string file_name,
+   bool        file_append
+)
+{
+   SmartPtr<MetricsSink> sink = jnlst_->GetMetricsSink("MetricsFile:" + file_name);
+
+   if( IsNull(sink) )
+   {
+      sink = jnlst_->AddFileMetricsSink("MetricsFile:" + file_name, file_name, file_append);
+   }
+
+   return IsValid(sink);
+}
+
 void IpoptApplication::RegisterAllIpoptOptions(
    const SmartPtr<RegisteredOptions>& roptions
 )
@@ -1037,6 +1276,11 @@ SmartPtr<IpoptCalculatedQuantities> IpoptApplication::IpoptCQObject()
    return ip_cq_;
 }
 
+SmartPtr<IpoptWarmState> IpoptApplication::WarmState()
+{
+   return warm_state_;
+}
+
 SmartPtr<IpoptAlgorithm> IpoptApplication::AlgorithmObject()
 {
    return alg_;
@@ -27,6 +27,7 @@ class AlgorithmBuilder;
 class RegisteredOptions;
 class OptionsList;
 class SolveStatistics;
+class IpoptWarmState;
 
 /** This is the main application class for making calls to Ipopt. */
 class IPOPTLIB_EXPORT IpoptApplication: public ReferencedObject
@@ -164,6 +165,27 @@ public:
       const SmartPtr<TNLP>& tnlp
    );
 
+   /** Solve a problem (that inherits from TNLP) for a repeated time,
+    *  continuing from the state of a previous optimization.
+    *
+    *  As ReOptimizeTNLP(tnlp), but instead of computing a starting
+    *  point, the algorithm continues from the given state, as returned
+    *  by WarmState.  This restores the primal-dual iterate, the slacks,
+    *  the barrier parameter, and the internal data of the line search
+    *  and the Hessian updater.  The bounds and the functions of the
+    *  TNLP may have changed, but its structure must be the same; the
+    *  option warm_start_same_structure is enabled for this solve, so
+    *  that the NLP scaling and the symbolic analysis of the linear
+    *  solver are reused.  If the restored primal variables or slacks
+    *  are not strictly within the new bounds, they are moved inside
+    *  as specified by the warm_start_(slack_)bound_push and
+    *  warm_start_(slack_)bound_frac options.
+    */
+   virtual ApplicationReturnStatus ReOptimizeTNLP(
+      const SmartPtr<TNLP>&                 tnlp,
+      const SmartPtr<const IpoptWarmState>& warm_state
+   );
+
    /** Solve a problem (that inherits from NLP) for a repeated time.
     *
     *  The OptimizeNLP method must have been called before.  The
@@ -180,9 +202,33 @@ public:
     *  @return false if there was a problem
     */
    virtual bool OpenOutputFile(
-      std::string   file_name,             /**< name of file to open */
-      EJournalLevel print_level,           /**< print level to be used */
-      bool          file_append = false    /**< whether to append to file or truncate (since 3.14.13) */
+      std::string   file_name,           /**< name of file to open */
+      EJournalLevel print_level,         /**< print level to be used */
+      bool          file_append = false  /**< whether to append to file or truncate (since 3.14.13) */
+   );
+
+   /** Method for opening an output file with given print_level that
+    *  is written by the given writer.
+    *
+    *  For J_WRITER_SYNC, this calls the method above.
+    *
+    *  @return false if there was a problem
+    */
+   bool OpenOutputFile(
+      std::string    file_name,   /**< name of file to open */
+      EJournalLevel  print_level, /**< print level to be used */
+      bool           file_append, /**< whether to append to file or truncate */
+      EJournalWriter writer       /**< whether to write from a background thread */
+   );
+
+   /** Method for opening a file to which the iteration metrics are
+    *  written, one JSON object per line.
+    *
+    *  @return false if there was a problem
+    */
+   virtual bool OpenMetricsFile(
+      std::string file_name,            /**< name of file to open */
+      bool        file_append = false   /**< whether to append to file or truncate */
    );
 
    /**@name Accessor methods */
@@ -220,6 +266,18 @@ public:
     */
    virtual SmartPtr<SolveStatistics> Statistics();
 
+   /** Get the state of the algorithm at the end of the most recent
+    *  optimization run, which can be passed to ReOptimizeTNLP.
+    *
+    *  The state is already available when the TNLP's
+    *  finalize_solution method is called.
+    *
+    *  @note The state is not available if optimization terminated
+    *  with an invalid number or a serious problem, that is, an
+    *  ApplicationReturnStatus of Not_Enough_Degrees_Of_Freedom or lower.
+    */
+   virtual SmartPtr<IpoptWarmState> WarmState();
+
    /** Get the IpoptNLP Object */
    virtual SmartPtr<IpoptNLP> IpoptNLPObject();
 
@@ -319,6 +377,11 @@ private:
     */
    SmartPtr<SolveStatistics> statistics_;
 
+   /** State of the algorithm at the end of the most recent
+    *  optimization run.
+    */
+   SmartPtr<IpoptWarmState> warm_state_;
+
    /** Object with the algorithm skeleton.
     */
    SmartPtr<IpoptAlgorithm> alg_;
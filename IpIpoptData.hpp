@@ -509,6 +509,34 @@ public:
    {
       info_ls_count_ = ls_count;
    }
+   Index info_refinement_steps() const
+   {
+      return info_refinement_steps_;
+   }
+   void Inc_info_refinement_steps()
+   {
+      info_refinement_steps_++;
+   }
+   Number info_matrix_nonzeros() const
+   {
+      return info_matrix_nonzeros_;
+   }
+   Number info_factor_nonzeros() const
+   {
+      return info_factor_nonzeros_;
+   }
+   /** Set the size of the most recent factorization of the linear
+    *  system, counting the lower triangle of the matrix and the
+    *  entries stored for the factor.
+    */
+   void Set_info_factorization_size(
+      Number matrix_nonzeros,
+      Number factor_nonzeros
+   )
+   {
+      info_matrix_nonzeros_ = matrix_nonzeros;
+      info_factor_nonzeros_ = factor_nonzeros;
+   }
    bool info_skip_output() const
    {
       return info_skip_output_;
@@ -579,6 +607,9 @@ public:
       info_alpha_primal_char_ = ' ';
       info_skip_output_ = false;
       info_string_.erase();
+      info_refinement_steps_ = 0;
+      info_matrix_nonzeros_ = 0.;
+      info_factor_nonzeros_ = 0.;
    }
    ///@}
 
@@ -747,6 +778,14 @@ private:
    Number info_alpha_dual_;
    /** Number of backtracking trial steps */
    Index info_ls_count_;
+   /** Number of iterative refinement steps for all linear systems */
+   Index info_refinement_steps_;
+   /** Nonzeros in the lower triangle of the last factorized matrix,
+    *  0 if unknown
+    */
+   Number info_matrix_nonzeros_;
+   /** Entries stored for the last factor, 0 if unknown */
+   Number info_factor_nonzeros_;
    /** true, if next summary output line should not be printed (eg
     *  after restoration phase).
     */
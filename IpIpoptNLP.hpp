@@ -257,6 +257,28 @@ public:
    virtual SmartPtr<const SymMatrix> uninitialized_h() = 0;
    ///@}
 
+   /** @name Evaluation at several points in concurrent threads */
+   ///@{
+   /** Query whether EvaluateConcurrently is implemented. */
+   virtual bool ProvidesConcurrentEvaluation() const
+   {
+      return false;
+   }
+
+   /** Evaluate the objective function and the constraints at several
+    *  points, possibly in concurrent threads.
+    *
+    *  The results are kept in the caches, so that subsequent calls of
+    *  f, c, and d for these points do not evaluate the functions
+    *  again.  Points at which an evaluation fails are not cached, so
+    *  that the error is reported when f, c, or d is called for them.
+    */
+   virtual void EvaluateConcurrently(
+      const std::vector<SmartPtr<const Vector> >& /*x*/
+   )
+   { }
+   ///@}
+
    /**@name solution routines */
    ///@{
    virtual void FinalizeSolution(
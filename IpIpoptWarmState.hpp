@@ -0,0 +1,123 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPIPOPTWARMSTATE_HPP__
+#define __IPIPOPTWARMSTATE_HPP__
+
+#include "IpReferenced.hpp"
+#include "IpSmartPtr.hpp"
+#include "IpIteratesVector.hpp"
+
+namespace Ipopt
+{
+
+/** State of the algorithm at the end of an optimization, from which
+ *  a later optimization of the same problem can be started.
+ *
+ *  The state consists of the primal-dual iterate (including the
+ *  slacks), the barrier parameter, and the internal data of the line
+ *  search (such as the filter) and of the Hessian updater (such as the
+ *  limited-memory quasi-Newton history).  It is given in terms of the
+ *  internal, scaled problem, and its contents are not meant to be
+ *  interpreted by the user; it is obtained from
+ *  IpoptApplication::WarmState and passed to
+ *  IpoptApplication::ReOptimizeTNLP.
+ */
+class IPOPTLIB_EXPORT IpoptWarmState: public ReferencedObject
+{
+public:
+   /**@name Constructors/Destructors */
+   ///@{
+   /** Constructor */
+   IpoptWarmState(
+      const SmartPtr<const IteratesVector>&   iterate,
+      Number                                  mu,
+      Number                                  tau,
+      const SmartPtr<const ReferencedObject>& line_search_state,
+      const SmartPtr<const ReferencedObject>& hessian_updater_state
+   )
+      : iterate_(iterate),
+        mu_(mu),
+        tau_(tau),
+        line_search_state_(line_search_state),
+        hessian_updater_state_(hessian_updater_state)
+   { }
+
+   /** Destructor */
+   virtual ~IpoptWarmState()
+   { }
+   ///@}
+
+   /** @name Accessor methods */
+   ///@{
+   /** Primal-dual iterate */
+   SmartPtr<const IteratesVector> Iterate() const
+   {
+      return iterate_;
+   }
+
+   /** Barrier parameter */
+   Number Mu() const
+   {
+      return mu_;
+   }
+
+   /** Fraction-to-the-boundary parameter */
+   Number Tau() const
+   {
+      return tau_;
+   }
+
+   /** Internal data of the line search, as returned by
+    *  LineSearch::GetWarmState
+    */
+   SmartPtr<const ReferencedObject> LineSearchState() const
+   {
+      return line_search_state_;
+   }
+
+   /** Internal data of the Hessian updater, as returned by
+    *  HessianUpdater::GetWarmState
+    */
+   SmartPtr<const ReferencedObject> HessianUpdaterState() const
+   {
+      return hessian_updater_state_;
+   }
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default Constructor */
+   IpoptWarmState();
+
+   /** Copy Constructor */
+   IpoptWarmState(
+      const IpoptWarmState&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const IpoptWarmState&
+   );
+   ///@}
+
+   SmartPtr<const IteratesVector> iterate_;
+   Number mu_;
+   Number tau_;
+   SmartPtr<const ReferencedObject> line_search_state_;
+   SmartPtr<const ReferencedObject> hessian_updater_state_;
+};
+
+} // namespace Ipopt
+
+#endif
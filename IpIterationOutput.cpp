@@ -0,0 +1,86 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpIterationOutput.hpp"
+
+namespace Ipopt
+{
+
+void IterationOutput::WriteIterationMetrics(
+   bool               restoration,
+   Index              iter,
+   Number             objective,
+   Number             inf_pr,
+   Number             inf_du,
+   Number             mu,
+   Number             dnrm,
+   Number             regu_x,
+   Number             alpha_dual,
+   Number             alpha_primal,
+   char               alpha_primal_char,
+   Index              ls_count,
+   const std::string& info_string
+)
+{
+   MetricsRecord record("iteration");
+   record.AddInteger("iter", iter);
+   record.AddBool("restoration", restoration);
+   record.AddNumber("objective", objective);
+   record.AddNumber("inf_pr", inf_pr);
+   record.AddNumber("inf_du", inf_du);
+   record.AddNumber("mu", mu);
+   record.AddNumber("d_norm", dnrm);
+   record.AddNumber("regu_x", regu_x);
+   record.AddNumber("alpha_du", alpha_dual);
+   record.AddNumber("alpha_pr", alpha_primal);
+   record.AddString("alpha_pr_char", std::string(1, alpha_primal_char));
+   record.AddInteger("ls_trials", ls_count);
+   record.AddString("info", info_string);
+   record.AddNumber("wallclock", WallclockTime());
+
+   record.AddInteger("refinement_steps", IpData().info_refinement_steps());
+   Number matrix_nonzeros = IpData().info_matrix_nonzeros();
+   Number factor_nonzeros = IpData().info_factor_nonzeros();
+   if( factor_nonzeros > 0. )
+   {
+      record.AddNumber("matrix_nonzeros", matrix_nonzeros);
+      record.AddNumber("factor_nonzeros", factor_nonzeros);
+      record.AddNumber("fill", matrix_nonzeros > 0. ? factor_nonzeros / matrix_nonzeros : 0.);
+   }
+
+   // wallclock time spent in the tasks since the previous record; the
+   // restoration phase starts with new timing statistics
+   const TimingStatistics& timing_stats = IpData().TimingStats();
+   std::vector<std::pair<const char*, const TimedTask*> > tasks;
+   timing_stats.GetTimedTasks(tasks);
+   if( last_timing_stats_ != &timing_stats )
+   {
+      last_timing_stats_ = &timing_stats;
+      last_walltimes_.assign(tasks.size(), 0.);
+   }
+   for( size_t i = 0; i < tasks.size(); i++ )
+   {
+      const TimedTask& task = *tasks[i].second;
+      // tasks that are running, as OverallAlgorithm, have no total yet
+      if( !task.IsEnabled() || task.IsStarted() )
+      {
+         continue;
+      }
+      Number walltime = task.TotalWallclockTime();
+      if( walltime < last_walltimes_[i] )
+      {
+         // the times have been reset
+         last_walltimes_[i] = 0.;
+      }
+      if( walltime > last_walltimes_[i] )
+      {
+         record.AddNumber(std::string("time.") + tasks[i].first, walltime - last_walltimes_[i]);
+         last_walltimes_[i] = walltime;
+      }
+   }
+
+   Jnlst().WriteMetrics(record);
+}
+
+} // namespace Ipopt
@@ -24,6 +24,7 @@ public:
    ///@{
    /** Default Constructor */
    IterationOutput()
+      : last_timing_stats_(NULL)
    { }
 
    /** Destructor */
@@ -51,6 +52,29 @@ protected:
       ORIGINAL
    };
 
+   /** Send the quantities of the iteration summary line to the metrics
+    *  sinks of the Journalist.
+    *
+    *  The record is completed with the number of iterative refinement
+    *  steps, the size of the last factorization, and the wallclock time
+    *  spent in each timed task since the previous record.
+    */
+   void WriteIterationMetrics(
+      bool               restoration,
+      Index              iter,
+      Number             objective,
+      Number             inf_pr,
+      Number             inf_du,
+      Number             mu,
+      Number             dnrm,
+      Number             regu_x,
+      Number             alpha_dual,
+      Number             alpha_primal,
+      char               alpha_primal_char,
+      Index              ls_count,
+      const std::string& info_string
+   );
+
 private:
    /**@name Default Compiler Generated Methods (Hidden to avoid
     * implicit creation/calling).
@@ -71,6 +95,13 @@ private:
    );
    ///@}
 
+   /** @name Times of the timed tasks at the previous metrics record */
+   ///@{
+   /** Timing statistics to which the times belong */
+   const TimingStatistics* last_timing_stats_;
+   std::vector<Number> last_walltimes_;
+   ///@}
+
 };
 
 } // namespace Ipopt
@@ -0,0 +1,583 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpIterativeAugSystemSolver.hpp"
+#include "IpDenseVector.hpp"
+#include "IpGenTMatrix.hpp"
+#include "IpSymTMatrix.hpp"
+#include "IpScaledMatrix.hpp"
+#include "IpSymScaledMatrix.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** Nonzeros of a GenTMatrix, possibly with the row and column scaling
+ *  of a ScaledMatrix around it.
+ */
+struct TripletView
+{
+   Index         nnz;
+   const Index*  irows;
+   const Index*  jcols;
+   const Number* vals;
+   const Number* row_scaling;
+   const Number* col_scaling;
+};
+
+/** Get the triplet data of J, if J is a GenTMatrix or a ScaledMatrix
+ *  with a GenTMatrix and DenseVector scaling factors.
+ */
+static bool GetTripletView(
+   const Matrix& J,
+   TripletView&  view
+)
+{
+   const GenTMatrix* gent = dynamic_cast<const GenTMatrix*>(&J);
+   view.row_scaling = NULL;
+   view.col_scaling = NULL;
+   if( !gent )
+   {
+      const ScaledMatrix* scaled = dynamic_cast<const ScaledMatrix*>(&J);
+      if( !scaled )
+      {
+         return false;
+      }
+      gent = dynamic_cast<const GenTMatrix*>(GetRawPtr(scaled->GetUnscaledMatrix()));
+      if( !gent )
+      {
+         return false;
+      }
+      if( IsValid(scaled->RowScaling()) )
+      {
+         const DenseVector* dv = dynamic_cast<const DenseVector*>(GetRawPtr(scaled->RowScaling()));
+         if( !dv )
+         {
+            return false;
+         }
+         view.row_scaling = dv->ExpandedValues();
+      }
+      if( IsValid(scaled->ColumnScaling()) )
+      {
+         const DenseVector* dv = dynamic_cast<const DenseVector*>(GetRawPtr(scaled->ColumnScaling()));
+         if( !dv )
+         {
+            return false;
+         }
+         view.col_scaling = dv->ExpandedValues();
+      }
+   }
+   view.nnz = gent->Nonzeros();
+   view.irows = gent->Irows();
+   view.jcols = gent->Jcols();
+   view.vals = gent->Values();
+   return true;
+}
+
+/** Value of the k-th nonzero of a triplet view, including scaling */
+static inline Number TripletValue(
+   const TripletView& view,
+   Index              k
+)
+{
+   Number val = view.vals[k];
+   if( view.row_scaling )
+   {
+      val *= view.row_scaling[view.irows[k] - 1];
+   }
+   if( view.col_scaling )
+   {
+      val *= view.col_scaling[view.jcols[k] - 1];
+   }
+   return val;
+}
+
+/** Add factor times the diagonal of W to d, if W is a (scaled)
+ *  SymTMatrix and d is a DenseVector.
+ */
+static bool AddHessianDiagonal(
+   const SymMatrix& W,
+   Number           factor,
+   Vector&          d
+)
+{
+   DenseVector* dd = dynamic_cast<DenseVector*>(&d);
+   if( !dd )
+   {
+      return false;
+   }
+   const SymTMatrix* symt = dynamic_cast<const SymTMatrix*>(&W);
+   const Number* scaling = NULL;
+   if( !symt )
+   {
+      const SymScaledMatrix* scaled = dynamic_cast<const SymScaledMatrix*>(&W);
+      if( !scaled )
+      {
+         return false;
+      }
+      symt = dynamic_cast<const SymTMatrix*>(GetRawPtr(scaled->GetUnscaledMatrix()));
+      if( !symt )
+      {
+         return false;
+      }
+      if( IsValid(scaled->RowColScaling()) )
+      {
+         const DenseVector* dv = dynamic_cast<const DenseVector*>(GetRawPtr(scaled->RowColScaling()));
+         if( !dv )
+         {
+            return false;
+         }
+         scaling = dv->ExpandedValues();
+      }
+   }
+
+   Number* dvals = dd->Values();
+   const Index* irows = symt->Irows();
+   const Index* jcols = symt->Jcols();
+   const Number* vals = symt->Values();
+   for( Index k = 0; k < symt->Nonzeros(); k++ )
+   {
+      if( irows[k] == jcols[k] )
+      {
+         Index i = irows[k] - 1;
+         Number val = vals[k];
+         if( scaling )
+         {
+            val *= scaling[i] * scaling[i];
+         }
+         dvals[i] += factor * val;
+      }
+   }
+   return true;
+}
+
+IterativeAugSystemSolver::IterativeAugSystemSolver()
+   : AugSystemSolver(),
+     W_(NULL),
+     W_factor_(0.),
+     J_c_(NULL),
+     J_d_(NULL)
+{
+   DBG_START_METH("IterativeAugSystemSolver::IterativeAugSystemSolver()", dbg_verbosity);
+}
+
+IterativeAugSystemSolver::~IterativeAugSystemSolver()
+{
+   DBG_START_METH("IterativeAugSystemSolver::~IterativeAugSystemSolver()", dbg_verbosity);
+}
+
+void IterativeAugSystemSolver::RegisterOptions(
+   SmartPtr<RegisteredOptions> roptions
+)
+{
+   roptions->AddLowerBoundedIntegerOption(
+      "minres_max_iter",
+      "Maximal number of MINRES iterations for the augmented system.",
+      1,
+      1000,
+      "Only used if \"aug_system_solver\" is \"minres\". "
+      "If the tolerance is not reached within this number of iterations, the system is treated as singular.",
+      true);
+   roptions->AddLowerBoundedNumberOption(
+      "minres_tol",
+      "Relative tolerance for the MINRES solution of the augmented system.",
+      0., true,
+      1e-8,
+      "Only used if \"aug_system_solver\" is \"minres\". "
+      "MINRES stops when the norm of the preconditioned residual has been reduced by this factor. "
+      "The tolerance is tightened if a more accurate solution is requested.",
+      true);
+}
+
+bool IterativeAugSystemSolver::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   options.GetIntegerValue("minres_max_iter", max_iter_, prefix);
+   options.GetNumericValue("minres_tol", tol_, prefix);
+
+   // IncreaseQuality does not tighten the tolerance beyond this
+   min_tol_ = Min(tol_, 1e-14);
+   current_tol_ = tol_;
+
+   aug_vector_space_ = NULL;
+
+   return true;
+}
+
+void IterativeAugSystemSolver::CreateWorkVectors(
+   const Vector& proto_x,
+   const Vector& proto_s,
+   const Vector& proto_c,
+   const Vector& proto_d
+)
+{
+   DBG_START_METH("IterativeAugSystemSolver::CreateWorkVectors", dbg_verbosity);
+
+   Index total_dim = proto_x.Dim() + proto_s.Dim() + proto_c.Dim() + proto_d.Dim();
+   aug_vector_space_ = new CompoundVectorSpace(4, total_dim);
+   aug_vector_space_->SetCompSpace(0, *proto_x.OwnerSpace());
+   aug_vector_space_->SetCompSpace(1, *proto_s.OwnerSpace());
+   aug_vector_space_->SetCompSpace(2, *proto_c.OwnerSpace());
+   aug_vector_space_->SetCompSpace(3, *proto_d.OwnerSpace());
+
+   diag_ = aug_vector_space_->MakeNewCompoundVector();
+   precond_ = aug_vector_space_->MakeNewCompoundVector();
+   sol_ = aug_vector_space_->MakeNewCompoundVector();
+   r1_ = aug_vector_space_->MakeNewCompoundVector();
+   r2_ = aug_vector_space_->MakeNewCompoundVector();
+   y_ = aug_vector_space_->MakeNewCompoundVector();
+   v_ = aug_vector_space_->MakeNewCompoundVector();
+   w_ = aug_vector_space_->MakeNewCompoundVector();
+   w1_ = aug_vector_space_->MakeNewCompoundVector();
+   w2_ = aug_vector_space_->MakeNewCompoundVector();
+}
+
+void IterativeAugSystemSolver::SetupOperator(
+   const SymMatrix* W,
+   Number           W_factor,
+   const Vector*    D_x,
+   Number           delta_x,
+   const Vector*    D_s,
+   Number           delta_s,
+   const Matrix&    J_c,
+   const Vector*    D_c,
+   Number           delta_c,
+   const Matrix&    J_d,
+   const Vector*    D_d,
+   Number           delta_d
+)
+{
+   DBG_START_METH("IterativeAugSystemSolver::SetupOperator", dbg_verbosity);
+
+   W_ = W;
+   W_factor_ = W ? W_factor : 0.;
+   J_c_ = &J_c;
+   J_d_ = &J_d;
+
+   // Diagonal blocks of the augmented system
+   const Vector* D[4] = { D_x, D_s, D_c, D_d };
+   const Number delta[4] = { delta_x, delta_s, -delta_c, -delta_d };
+   for( Index i = 0; i < 4; i++ )
+   {
+      SmartPtr<Vector> diag_i = diag_->GetCompNonConst(i);
+      if( D[i] )
+      {
+         diag_i->Copy(*D[i]);
+         diag_i->AddScalar(delta[i]);
+      }
+      else
+      {
+         diag_i->Set(delta[i]);
+      }
+   }
+
+   // Preconditioner for the x and s blocks: inverse of the absolute
+   // values of the diagonal, bounded away from zero
+   SmartPtr<Vector> prec_x = precond_->GetCompNonConst(0);
+   SmartPtr<Vector> prec_s = precond_->GetCompNonConst(1);
+   prec_x->Copy(*diag_->GetComp(0));
+   if( W_factor_ != 0. )
+   {
+      AddHessianDiagonal(*W_, W_factor_, *prec_x);
+   }
+   prec_s->Copy(*diag_->GetComp(1));
+   for( Index i = 0; i < 2; i++ )
+   {
+      SmartPtr<Vector> prec_i = precond_->GetCompNonConst(i);
+      prec_i->ElementWiseAbs();
+      prec_i->AddScalar(1e-8 * Max(Number(1.), prec_i->Amax()));
+      prec_i->ElementWiseReciprocal();
+   }
+
+   // Preconditioner for the c and d blocks: inverse of the diagonal
+   // of |D_c - delta_c| + J_c diag(prec_x) J_c^T (and the same for d,
+   // including the contribution from the -I block of the slacks)
+   const Matrix* J[2] = { &J_c, &J_d };
+   for( Index i = 0; i < 2; i++ )
+   {
+      SmartPtr<Vector> prec_i = precond_->GetCompNonConst(i + 2);
+      prec_i->Copy(*diag_->GetComp(i + 2));
+      prec_i->ElementWiseAbs();
+
+      TripletView view;
+      DenseVector* dprec_i = dynamic_cast<DenseVector*>(GetRawPtr(prec_i));
+      const DenseVector* dprec_x = dynamic_cast<const DenseVector*>(GetRawPtr(prec_x));
+      if( dprec_i && dprec_x && GetTripletView(*J[i], view) )
+      {
+         Number* pvals = dprec_i->Values();
+         const Number* pxvals = dprec_x->ExpandedValues();
+         for( Index k = 0; k < view.nnz; k++ )
+         {
+            Number val = TripletValue(view, k);
+            pvals[view.irows[k] - 1] += val * val * pxvals[view.jcols[k] - 1];
+         }
+      }
+      else
+      {
+         // Without access to the entries, use the largest entry in
+         // each row as an estimate
+         SmartPtr<Vector> row_amax = prec_i->MakeNew();
+         J[i]->ComputeRowAMax(*row_amax);
+         row_amax->ElementWiseMultiply(*row_amax);
+         prec_i->Axpy(prec_x->Amax(), *row_amax);
+      }
+      if( i == 1 )
+      {
+         prec_i->Axpy(1., *prec_s);
+      }
+      prec_i->AddScalar(1e-8 * Max(Number(1.), prec_i->Amax()));
+      prec_i->ElementWiseReciprocal();
+   }
+}
+
+void IterativeAugSystemSolver::AddJacobianProducts(
+   const Matrix& J,
+   const Vector& x_x,
+   const Vector& x_c,
+   Vector&       y_x,
+   Vector&       y_c
+)
+{
+   TripletView view;
+   const DenseVector* dx_x = dynamic_cast<const DenseVector*>(&x_x);
+   const DenseVector* dx_c = dynamic_cast<const DenseVector*>(&x_c);
+   DenseVector* dy_x = dynamic_cast<DenseVector*>(&y_x);
+   DenseVector* dy_c = dynamic_cast<DenseVector*>(&y_c);
+   if( dx_x && dx_c && dy_x && dy_c && GetTripletView(J, view) )
+   {
+      // One pass over the nonzeros for both J x_x and J^T x_c
+      const Number* xx = dx_x->ExpandedValues();
+      const Number* xc = dx_c->ExpandedValues();
+      Number* yx = dy_x->Values();
+      Number* yc = dy_c->Values();
+      for( Index k = 0; k < view.nnz; k++ )
+      {
+         const Index irow = view.irows[k] - 1;
+         const Index jcol = view.jcols[k] - 1;
+         const Number val = TripletValue(view, k);
+         yc[irow] += val * xx[jcol];
+         yx[jcol] += val * xc[irow];
+      }
+      return;
+   }
+
+   J.TransMultVector(1., x_c, 1., y_x);
+   J.MultVector(1., x_x, 1., y_c);
+}
+
+void IterativeAugSystemSolver::ApplyOperator(
+   const CompoundVector& x,
+   CompoundVector&       y
+) const
+{
+   SmartPtr<const Vector> x_x = x.GetComp(0);
+   SmartPtr<const Vector> x_s = x.GetComp(1);
+   SmartPtr<const Vector> x_c = x.GetComp(2);
+   SmartPtr<const Vector> x_d = x.GetComp(3);
+   SmartPtr<Vector> y_x = y.GetCompNonConst(0);
+   SmartPtr<Vector> y_s = y.GetCompNonConst(1);
+   SmartPtr<Vector> y_c = y.GetCompNonConst(2);
+   SmartPtr<Vector> y_d = y.GetCompNonConst(3);
+
+   // Diagonal blocks
+   y_x->Copy(*x_x);
+   y_x->ElementWiseMultiply(*diag_->GetComp(0));
+   y_s->Copy(*x_s);
+   y_s->ElementWiseMultiply(*diag_->GetComp(1));
+   y_s->Axpy(-1., *x_d);
+   y_c->Copy(*x_c);
+   y_c->ElementWiseMultiply(*diag_->GetComp(2));
+   y_d->Copy(*x_d);
+   y_d->ElementWiseMultiply(*diag_->GetComp(3));
+   y_d->Axpy(-1., *x_s);
+
+   // Hessian and Jacobian blocks
+   if( W_factor_ != 0. )
+   {
+      W_->MultVector(W_factor_, *x_x, 1., *y_x);
+   }
+   AddJacobianProducts(*J_c_, *x_x, *x_c, *y_x, *y_c);
+   AddJacobianProducts(*J_d_, *x_x, *x_d, *y_x, *y_d);
+}
+
+ESymSolverStatus IterativeAugSystemSolver::Solve(
+   const SymMatrix* W,
+   Number           W_factor,
+   const Vector*    D_x,
+   Number           delta_x,
+   const Vector*    D_s,
+   Number           delta_s,
+   const Matrix*    J_c,
+   const Vector*    D_c,
+   Number           delta_c,
+   const Matrix*    J_d,
+   const Vector*    D_d,
+   Number           delta_d,
+   const Vector&    rhs_x,
+   const Vector&    rhs_s,
+   const Vector&    rhs_c,
+   const Vector&    rhs_d,
+   Vector&          sol_x,
+   Vector&          sol_s,
+   Vector&          sol_c,
+   Vector&          sol_d,
+   bool             check_NegEVals,
+   Index            /*numberOfNegEVals*/
+)
+{
+   DBG_START_METH("IterativeAugSystemSolver::Solve", dbg_verbosity);
+   DBG_ASSERT(J_c && J_d && "Currently, you MUST specify J_c and J_d in the augmented system");
+   DBG_ASSERT(!check_NegEVals && "IterativeAugSystemSolver does not provide inertia");
+   (void) check_NegEVals;
+
+   IpData().TimingStats().LinearSystemBackSolve().Start();
+
+   if( IsNull(aug_vector_space_) || GetRawPtr(aug_vector_space_->GetCompSpace(0)) != GetRawPtr(rhs_x.OwnerSpace())
+       || GetRawPtr(aug_vector_space_->GetCompSpace(1)) != GetRawPtr(rhs_s.OwnerSpace())
+       || GetRawPtr(aug_vector_space_->GetCompSpace(2)) != GetRawPtr(rhs_c.OwnerSpace())
+       || GetRawPtr(aug_vector_space_->GetCompSpace(3)) != GetRawPtr(rhs_d.OwnerSpace()) )
+   {
+      CreateWorkVectors(rhs_x, rhs_s, rhs_c, rhs_d);
+   }
+
+   SetupOperator(W, W_factor, D_x, delta_x, D_s, delta_s, *J_c, D_c, delta_c, *J_d, D_d, delta_d);
+
+   // Preconditioned MINRES (Paige and Saunders), starting from zero
+   r1_->GetCompNonConst(0)->Copy(rhs_x);
+   r1_->GetCompNonConst(1)->Copy(rhs_s);
+   r1_->GetCompNonConst(2)->Copy(rhs_c);
+   r1_->GetCompNonConst(3)->Copy(rhs_d);
+   sol_->Set(0.);
+
+   y_->Copy(*r1_);
+   y_->ElementWiseMultiply(*precond_);
+   Number beta1 = r1_->Dot(*y_);
+   DBG_ASSERT(beta1 >= 0.);
+   beta1 = sqrt(beta1);
+
+   bool converged = (beta1 == 0.);
+   Index iter = 0;
+   if( !converged )
+   {
+      r2_->Copy(*r1_);
+      w_->Set(0.);
+      w2_->Set(0.);
+
+      Number beta = beta1;
+      Number oldb = 0.;
+      Number dbar = 0.;
+      Number epsln = 0.;
+      Number phibar = beta1;
+      Number cs = -1.;
+      Number sn = 0.;
+
+      while( iter < max_iter_ )
+      {
+         iter++;
+
+         // Lanczos step
+         v_->AddOneVector(1. / beta, *y_, 0.);
+         ApplyOperator(*v_, *y_);
+         if( iter >= 2 )
+         {
+            y_->Axpy(-beta / oldb, *r1_);
+         }
+         Number alfa = v_->Dot(*y_);
+         y_->Axpy(-alfa / beta, *r2_);
+
+         SmartPtr<CompoundVector> tmp = r1_;
+         r1_ = r2_;
+         r2_ = y_;
+         y_ = tmp;
+         y_->Copy(*r2_);
+         y_->ElementWiseMultiply(*precond_);
+
+         oldb = beta;
+         beta = r2_->Dot(*y_);
+         DBG_ASSERT(beta >= 0.);
+         beta = sqrt(Max(beta, Number(0.)));
+
+         // Apply the previous rotation and compute the next one
+         Number oldeps = epsln;
+         Number delta = cs * dbar + sn * alfa;
+         Number gbar = sn * dbar - cs * alfa;
+         epsln = sn * beta;
+         dbar = -cs * beta;
+         Number gamma = sqrt(gbar * gbar + beta * beta);
+         gamma = Max(gamma, std::numeric_limits<Number>::epsilon());
+         cs = gbar / gamma;
+         sn = beta / gamma;
+         Number phi = cs * phibar;
+         phibar = sn * phibar;
+
+         // Update the search direction and the solution
+         tmp = w1_;
+         w1_ = w2_;
+         w2_ = w_;
+         w_ = tmp;
+         Number denom = 1. / gamma;
+         w_->AddTwoVectors(denom, *v_, -oldeps * denom, *w1_, 0.);
+         w_->Axpy(-delta * denom, *w2_);
+         sol_->Axpy(phi, *w_);
+
+         Jnlst().Printf(J_MOREDETAILED, J_LINEAR_ALGEBRA,
+                        "MINRES iteration %4" IPOPT_INDEX_FORMAT ": relative residual %e\n", iter, phibar / beta1);
+
+         if( phibar <= current_tol_ * beta1 || beta == 0. )
+         {
+            converged = true;
+            break;
+         }
+      }
+   }
+
+   sol_x.Copy(*sol_->GetComp(0));
+   sol_s.Copy(*sol_->GetComp(1));
+   sol_c.Copy(*sol_->GetComp(2));
+   sol_d.Copy(*sol_->GetComp(3));
+
+   IpData().TimingStats().LinearSystemBackSolve().End();
+
+   Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                  "MINRES %s after %" IPOPT_INDEX_FORMAT " iterations.\n", converged ? "converged" : "did not converge", iter);
+
+   if( !converged )
+   {
+      // Let the perturbation handler regularize the system
+      return SYMSOLVER_SINGULAR;
+   }
+   return SYMSOLVER_SUCCESS;
+}
+
+Index IterativeAugSystemSolver::NumberOfNegEVals() const
+{
+   DBG_ASSERT(false && "IterativeAugSystemSolver does not provide inertia");
+   return -1;
+}
+
+bool IterativeAugSystemSolver::ProvidesInertia() const
+{
+   return false;
+}
+
+bool IterativeAugSystemSolver::IncreaseQuality()
+{
+   if( current_tol_ <= min_tol_ )
+   {
+      return false;
+   }
+   current_tol_ = Max(min_tol_, 1e-2 * current_tol_);
+   Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                  "Decreasing MINRES tolerance to %e.\n", current_tol_);
+   return true;
+}
+
+} // namespace Ipopt
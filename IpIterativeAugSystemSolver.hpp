@@ -0,0 +1,209 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IP_ITERATIVEAUGSYSTEMSOLVER_HPP__
+#define __IP_ITERATIVEAUGSYSTEMSOLVER_HPP__
+
+#include "IpAugSystemSolver.hpp"
+#include "IpCompoundVector.hpp"
+
+namespace Ipopt
+{
+
+/** Matrix-free solver for the augmented system.
+ *
+ *  The augmented system is never assembled.  Instead, its product
+ *  with a vector is computed directly from W, J_c, J_d and the
+ *  diagonal blocks, with one pass over each block per product (the
+ *  products with J and J^T are fused if the Jacobians are given as
+ *  triplet matrices).  The system is solved by the MINRES method
+ *  with a positive definite block diagonal preconditioner, whose
+ *  constraint blocks approximate the diagonal of the Schur
+ *  complement.
+ *
+ *  Since no factorization is computed, this solver does not provide
+ *  the inertia of the system.
+ */
+class IterativeAugSystemSolver: public AugSystemSolver
+{
+public:
+   /**@name Constructors/Destructors */
+   ///@{
+   /** Default constructor */
+   IterativeAugSystemSolver();
+
+   /** Destructor */
+   virtual ~IterativeAugSystemSolver();
+   ///@}
+
+   bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   /** Solve the augmented system with MINRES for a given right hand
+    *  side.
+    */
+   virtual ESymSolverStatus Solve(
+      const SymMatrix* W,
+      Number           W_factor,
+      const Vector*    D_x,
+      Number           delta_x,
+      const Vector*    D_s,
+      Number           delta_s,
+      const Matrix*    J_c,
+      const Vector*    D_c,
+      Number           delta_c,
+      const Matrix*    J_d,
+      const Vector*    D_d,
+      Number           delta_d,
+      const Vector&    rhs_x,
+      const Vector&    rhs_s,
+      const Vector&    rhs_c,
+      const Vector&    rhs_d,
+      Vector&          sol_x,
+      Vector&          sol_s,
+      Vector&          sol_c,
+      Vector&          sol_d,
+      bool             check_NegEVals,
+      Index            numberOfNegEVals
+   );
+
+   /** Number of negative eigenvalues detected during last solve.
+    *
+    *  This solver does not compute the inertia, so this must not be
+    *  called.
+    */
+   virtual Index NumberOfNegEVals() const;
+
+   /** Query whether inertia is computed by linear solver.
+    *
+    * @return false
+    */
+   virtual bool ProvidesInertia() const;
+
+   /** Request to increase quality of solution for next solve.
+    *
+    *  Tightens the MINRES tolerance.
+    *
+    *  @return false, if the tightest tolerance is already used
+    */
+   virtual bool IncreaseQuality();
+
+   /** Methods for OptionsList */
+   ///@{
+   static void RegisterOptions(
+      SmartPtr<RegisteredOptions> roptions
+   );
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   IterativeAugSystemSolver(
+      const IterativeAugSystemSolver&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const IterativeAugSystemSolver&
+   );
+   ///@}
+
+   /** Create the space for the stacked (x,s,c,d) vectors and the
+    *  work vectors of MINRES.
+    */
+   void CreateWorkVectors(
+      const Vector& proto_x,
+      const Vector& proto_s,
+      const Vector& proto_c,
+      const Vector& proto_d
+   );
+
+   /** Compute the diagonal blocks D_? +/- delta_? of the augmented
+    *  system in diag_ and the inverse of the preconditioner in
+    *  precond_.
+    */
+   void SetupOperator(
+      const SymMatrix* W,
+      Number           W_factor,
+      const Vector*    D_x,
+      Number           delta_x,
+      const Vector*    D_s,
+      Number           delta_s,
+      const Matrix&    J_c,
+      const Vector*    D_c,
+      Number           delta_c,
+      const Matrix&    J_d,
+      const Vector*    D_d,
+      Number           delta_d
+   );
+
+   /** Compute y = K x for the augmented system matrix K */
+   void ApplyOperator(
+      const CompoundVector& x,
+      CompoundVector&       y
+   ) const;
+
+   /** Compute y += [J^T x_c; J x_x] in the x and c (or d) parts of y */
+   static void AddJacobianProducts(
+      const Matrix& J,
+      const Vector& x_x,
+      const Vector& x_c,
+      Vector&       y_x,
+      Vector&       y_c
+   );
+
+   /** @name Algorithmic parameters */
+   ///@{
+   /** Maximal number of MINRES iterations */
+   Index max_iter_;
+   /** Relative tolerance for the preconditioned residual */
+   Number tol_;
+   /** Tightest tolerance that IncreaseQuality may select */
+   Number min_tol_;
+   /** Tolerance used at the moment */
+   Number current_tol_;
+   ///@}
+
+   /** @name Current augmented system */
+   ///@{
+   const SymMatrix* W_;
+   Number W_factor_;
+   const Matrix* J_c_;
+   const Matrix* J_d_;
+   ///@}
+
+   /** Space for the stacked (x,s,c,d) vectors */
+   SmartPtr<CompoundVectorSpace> aug_vector_space_;
+
+   /** @name Work vectors */
+   ///@{
+   /** Diagonal of the blocks D_? +/- delta_? */
+   SmartPtr<CompoundVector> diag_;
+   /** Inverse of the diagonal preconditioner */
+   SmartPtr<CompoundVector> precond_;
+   SmartPtr<CompoundVector> sol_;
+   SmartPtr<CompoundVector> r1_;
+   SmartPtr<CompoundVector> r2_;
+   SmartPtr<CompoundVector> y_;
+   SmartPtr<CompoundVector> v_;
+   SmartPtr<CompoundVector> w_;
+   SmartPtr<CompoundVector> w1_;
+   SmartPtr<CompoundVector> w2_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
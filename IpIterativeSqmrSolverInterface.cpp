@@ -0,0 +1,695 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpIterativeSqmrSolverInterface.hpp"
+#include "IpBlas.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+// result of the most recent termination test, shared with the iterative Pardiso interface
+extern Ipopt::IterativeSolverTerminationTester::ETerminationTest test_result_;
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** Number of SQMR iterations without decrease of the residual after
+ *  which the iteration is considered to stagnate.
+ */
+static const Index sqmr_max_non_improvement = 25;
+
+/** Orders row indices by decreasing magnitude of the corresponding
+ *  entry in a dense work array.
+ */
+class LargerMagnitude
+{
+public:
+   LargerMagnitude(
+      const Number* vals
+   )
+      : vals_(vals)
+   { }
+
+   bool operator()(
+      Index i,
+      Index j
+   ) const
+   {
+      return std::abs(vals_[i]) > std::abs(vals_[j]);
+   }
+
+private:
+   const Number* vals_;
+};
+
+IterativeSqmrSolverInterface::IterativeSqmrSolverInterface(
+   IterativeSolverTerminationTester& normal_tester,
+   IterativeSolverTerminationTester& pd_tester
+)
+   : dim_(0),
+     nonzeros_(0),
+     a_(NULL),
+     negevals_(-1),
+     have_preconditioner_(false),
+     preconditioner_is_normal_(false),
+     initialized_(false),
+     normal_tester_(&normal_tester),
+     pd_tester_(&pd_tester)
+{
+   DBG_START_METH("IterativeSqmrSolverInterface::IterativeSqmrSolverInterface()", dbg_verbosity);
+}
+
+IterativeSqmrSolverInterface::~IterativeSqmrSolverInterface()
+{
+   DBG_START_METH("IterativeSqmrSolverInterface::~IterativeSqmrSolverInterface()",
+                  dbg_verbosity);
+
+   delete[] a_;
+}
+
+void IterativeSqmrSolverInterface::RegisterOptions(
+   SmartPtr<RegisteredOptions> roptions
+)
+{
+   roptions->AddLowerBoundedIntegerOption(
+      "sqmr_max_iter",
+      "Maximal number of SQMR iterations.",
+      1,
+      500,
+      "Only used if \"linear_solver\" is \"sqmr\". "
+      "The options for the normal step computation can be set separately with the prefix \"normal.\".",
+      true);
+   roptions->AddLowerBoundedNumberOption(
+      "ildl_dropping_factor",
+      "Dropping tolerance of the incomplete LDL^T preconditioner.",
+      0., false,
+      1e-3,
+      "Only used if \"linear_solver\" is \"sqmr\". "
+      "An entry of the factor is dropped if its magnitude is below this factor times the norm of its column "
+      "in the equilibrated matrix. "
+      "The options for the normal step computation can be set separately with the prefix \"normal.\".",
+      true);
+   roptions->AddLowerBoundedIntegerOption(
+      "ildl_max_col_fill",
+      "Maximal fill-in per column of the incomplete LDL^T preconditioner.",
+      0,
+      20,
+      "Only used if \"linear_solver\" is \"sqmr\". "
+      "A column of the factor keeps at most this many more entries than the corresponding column of the matrix. "
+      "The options for the normal step computation can be set separately with the prefix \"normal.\".",
+      true);
+   roptions->AddLowerBoundedNumberOption(
+      "ildl_pivot_tol",
+      "Smallest magnitude of a pivot in the incomplete LDL^T preconditioner.",
+      0., true,
+      1e-6,
+      "Only used if \"linear_solver\" is \"sqmr\". "
+      "Smaller pivots of the equilibrated matrix are replaced by this value with the same sign.",
+      true);
+   roptions->AddLowerBoundedIntegerOption(
+      "ildl_max_droptol_corrections",
+      "Maximal number of decreases of the dropping tolerance during one solve.",
+      0,
+      4,
+      "Only used if \"linear_solver\" is \"sqmr\". "
+      "If SQMR does not converge, the preconditioner is recomputed with a smaller dropping tolerance.",
+      true);
+}
+
+bool IterativeSqmrSolverInterface::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   // PD system
+   options.GetIntegerValue("sqmr_max_iter", sqmr_max_iter_, prefix);
+   options.GetNumericValue("ildl_dropping_factor", ildl_dropping_factor_, prefix);
+   options.GetIntegerValue("ildl_max_col_fill", ildl_max_col_fill_, prefix);
+   // Normal system
+   options.GetIntegerValue("sqmr_max_iter", normal_sqmr_max_iter_, prefix + "normal.");
+   options.GetNumericValue("ildl_dropping_factor", normal_ildl_dropping_factor_, prefix + "normal.");
+   options.GetIntegerValue("ildl_max_col_fill", normal_ildl_max_col_fill_, prefix + "normal.");
+
+   options.GetNumericValue("ildl_pivot_tol", ildl_pivot_tol_, prefix);
+   options.GetIntegerValue("ildl_max_droptol_corrections", ildl_max_droptol_corrections_, prefix);
+
+   // Reset all private data
+   dim_ = 0;
+   nonzeros_ = 0;
+   negevals_ = -1;
+   have_preconditioner_ = false;
+   initialized_ = false;
+   delete[] a_;
+   a_ = NULL;
+
+   ildl_dropping_factor_used_ = ildl_dropping_factor_;
+   normal_ildl_dropping_factor_used_ = normal_ildl_dropping_factor_;
+
+   decr_factor_ = 1. / 3.;
+
+   bool retval = normal_tester_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix);
+   if( retval )
+   {
+      retval = pd_tester_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix);
+   }
+
+   return retval;
+}
+
+ESymSolverStatus IterativeSqmrSolverInterface::InitializeStructure(
+   Index        dim,
+   Index        nonzeros,
+   const Index* /* ia */,
+   const Index* /* ja */
+)
+{
+   DBG_START_METH("IterativeSqmrSolverInterface::InitializeStructure", dbg_verbosity);
+   dim_ = dim;
+   nonzeros_ = nonzeros;
+
+   // Make space for storing the matrix elements
+   delete[] a_;
+   a_ = NULL;
+   a_ = new Number[nonzeros_];
+
+   scaling_.resize(dim_);
+   diag_.resize(dim_);
+   l_colptr_.resize(dim_ + 1);
+   next_pos_.resize(dim_);
+   list_head_.resize(dim_);
+   list_next_.resize(dim_);
+   marker_.resize(dim_);
+   pattern_.reserve(dim_);
+   work_.resize(dim_);
+   sqmr_x_.resize(dim_);
+   sqmr_r_.resize(dim_);
+   sqmr_res_.resize(dim_);
+   sqmr_q_.resize(dim_);
+   sqmr_t_.resize(dim_);
+   sqmr_d_.resize(dim_);
+   sqmr_ad_.resize(dim_);
+
+   have_preconditioner_ = false;
+   initialized_ = true;
+
+   return SYMSOLVER_SUCCESS;
+}
+
+Number* IterativeSqmrSolverInterface::GetValuesArrayPtr()
+{
+   DBG_ASSERT(initialized_);
+   DBG_ASSERT(a_);
+   return a_;
+}
+
+ESymSolverStatus IterativeSqmrSolverInterface::MultiSolve(
+   bool         new_matrix,
+   const Index* ia,
+   const Index* ja,
+   Index        nrhs,
+   Number*      rhs_vals,
+   bool         check_NegEVals,
+   Index        /* numberOfNegEVals */
+)
+{
+   DBG_START_METH("IterativeSqmrSolverInterface::MultiSolve", dbg_verbosity);
+   DBG_ASSERT(!check_NegEVals || ProvidesInertia());
+   DBG_ASSERT(initialized_);
+   (void) check_NegEVals;
+
+   // the preconditioner is computed in Solve, once it is known whether
+   // the system belongs to the normal or the primal-dual step
+   if( new_matrix )
+   {
+      have_preconditioner_ = false;
+   }
+
+   for( Index irhs = 0; irhs < nrhs; irhs++ )
+   {
+      ESymSolverStatus retval = Solve(ia, ja, rhs_vals + irhs * dim_);
+      if( retval != SYMSOLVER_SUCCESS )
+      {
+         return retval;
+      }
+   }
+
+   return SYMSOLVER_SUCCESS;
+}
+
+void IterativeSqmrSolverInterface::Factorization(
+   const Index* ia,
+   const Index* ja,
+   Number       droptol,
+   Index        max_col_fill
+)
+{
+   DBG_START_METH("IterativeSqmrSolverInterface::Factorization", dbg_verbosity);
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemFactorization().Start();
+   }
+
+   const Index n = dim_;
+
+   // Symmetric equilibration S = diag(1/sqrt(max_j |a_ij|))
+   for( Index i = 0; i < n; i++ )
+   {
+      Number rowmax = 0.;
+      for( Index p = ia[i]; p < ia[i + 1]; p++ )
+      {
+         rowmax = Max(rowmax, std::abs(a_[p]));
+      }
+      scaling_[i] = rowmax > 0. ? 1. / std::sqrt(rowmax) : 1.;
+   }
+
+   // Crout version of the threshold incomplete LDL^T factorization.
+   // The columns j < k with L(k,j) != 0 are found from linked lists:
+   // list_head_[k] starts the list of columns whose next unused row
+   // index (at position next_pos_[j]) is k.
+   l_rowind_.clear();
+   l_val_.clear();
+   l_rowind_.reserve(nonzeros_);
+   l_val_.reserve(nonzeros_);
+   std::fill(list_head_.begin(), list_head_.end(), -1);
+   std::fill(marker_.begin(), marker_.end(), -1);
+   l_colptr_[0] = 0;
+   negevals_ = 0;
+   Index n_modified_pivots = 0;
+
+   for( Index k = 0; k < n; k++ )
+   {
+      // Column k of the lower triangle of S A S
+      pattern_.clear();
+      Number pivot = 0.;
+      Number colnorm2 = 0.;
+      Index nnz_col = 0;
+      for( Index p = ia[k]; p < ia[k + 1]; p++ )
+      {
+         const Index i = ja[p];
+         if( i < k )
+         {
+            continue;
+         }
+         const Number val = scaling_[k] * a_[p] * scaling_[i];
+         colnorm2 += val * val;
+         if( i == k )
+         {
+            pivot += val;
+            continue;
+         }
+         if( marker_[i] != k )
+         {
+            marker_[i] = k;
+            work_[i] = 0.;
+            pattern_.push_back(i);
+            nnz_col++;
+         }
+         work_[i] += val;
+      }
+
+      // Updates from the previous columns
+      Index jnext;
+      for( Index j = list_head_[k]; j != -1; j = jnext )
+      {
+         jnext = list_next_[j];
+         const Index p0 = next_pos_[j];
+         DBG_ASSERT(l_rowind_[p0] == k);
+         const Number lkj = l_val_[p0];
+         const Number f = lkj * diag_[j];
+         pivot -= f * lkj;
+         const Index pend = l_colptr_[j + 1];
+         for( Index p = p0 + 1; p < pend; p++ )
+         {
+            const Index i = l_rowind_[p];
+            if( marker_[i] != k )
+            {
+               marker_[i] = k;
+               work_[i] = 0.;
+               pattern_.push_back(i);
+            }
+            work_[i] -= f * l_val_[p];
+         }
+         next_pos_[j] = p0 + 1;
+         if( p0 + 1 < pend )
+         {
+            const Index i = l_rowind_[p0 + 1];
+            list_next_[j] = list_head_[i];
+            list_head_[i] = j;
+         }
+      }
+
+      if( std::abs(pivot) < ildl_pivot_tol_ )
+      {
+         pivot = pivot < 0. ? -ildl_pivot_tol_ : ildl_pivot_tol_;
+         n_modified_pivots++;
+      }
+      if( pivot < 0. )
+      {
+         negevals_++;
+      }
+      diag_[k] = pivot;
+
+      // Dropping by magnitude, then by count
+      const Number dropval = droptol * std::sqrt(colnorm2);
+      Index nkeep = 0;
+      for( Index q = 0; q < (Index) pattern_.size(); q++ )
+      {
+         if( std::abs(work_[pattern_[q]]) > dropval )
+         {
+            pattern_[nkeep++] = pattern_[q];
+         }
+      }
+      const Index max_keep = nnz_col + max_col_fill;
+      if( nkeep > max_keep )
+      {
+         std::nth_element(pattern_.begin(), pattern_.begin() + max_keep, pattern_.begin() + nkeep,
+                          LargerMagnitude(&work_[0]));
+         nkeep = max_keep;
+      }
+      std::sort(pattern_.begin(), pattern_.begin() + nkeep);
+
+      const Index start = (Index) l_rowind_.size();
+      for( Index q = 0; q < nkeep; q++ )
+      {
+         const Index i = pattern_[q];
+         l_rowind_.push_back(i);
+         l_val_.push_back(work_[i] / pivot);
+      }
+      l_colptr_[k + 1] = start + nkeep;
+
+      if( nkeep > 0 )
+      {
+         const Index i = l_rowind_[start];
+         next_pos_[k] = start;
+         list_next_[k] = list_head_[i];
+         list_head_[i] = k;
+      }
+   }
+
+   Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                  "Incomplete LDL^T factorization with dropping tolerance %e: %" IPOPT_INDEX_FORMAT " nonzeros in L, %" IPOPT_INDEX_FORMAT " negative and %" IPOPT_INDEX_FORMAT " modified pivots.\n",
+                  droptol, l_colptr_[n], negevals_, n_modified_pivots);
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemFactorization().End();
+   }
+}
+
+void IterativeSqmrSolverInterface::ApplyPreconditioner(
+   const Number* x,
+   Number*       y
+) const
+{
+   const Index n = dim_;
+   for( Index i = 0; i < n; i++ )
+   {
+      y[i] = scaling_[i] * x[i];
+   }
+   // L z = y
+   for( Index k = 0; k < n; k++ )
+   {
+      const Number yk = y[k];
+      if( yk != 0. )
+      {
+         for( Index p = l_colptr_[k]; p < l_colptr_[k + 1]; p++ )
+         {
+            y[l_rowind_[p]] -= l_val_[p] * yk;
+         }
+      }
+   }
+   for( Index k = 0; k < n; k++ )
+   {
+      y[k] /= diag_[k];
+   }
+   // L^T z = y
+   for( Index k = n - 1; k >= 0; k-- )
+   {
+      Number yk = y[k];
+      for( Index p = l_colptr_[k]; p < l_colptr_[k + 1]; p++ )
+      {
+         yk -= l_val_[p] * y[l_rowind_[p]];
+      }
+      y[k] = yk;
+   }
+   for( Index i = 0; i < n; i++ )
+   {
+      y[i] *= scaling_[i];
+   }
+}
+
+void IterativeSqmrSolverInterface::MultMatrix(
+   const Index*  ia,
+   const Index*  ja,
+   const Number* x,
+   Number*       y
+) const
+{
+   for( Index i = 0; i < dim_; i++ )
+   {
+      Number yi = 0.;
+      for( Index p = ia[i]; p < ia[i + 1]; p++ )
+      {
+         yi += a_[p] * x[ja[p]];
+      }
+      y[i] = yi;
+   }
+}
+
+bool IterativeSqmrSolverInterface::Sqmr(
+   const Index*                      ia,
+   const Index*                      ja,
+   const Number*                     rhs,
+   Index                             max_iter,
+   IterativeSolverTerminationTester& tester
+)
+{
+   DBG_START_METH("IterativeSqmrSolverInterface::Sqmr", dbg_verbosity);
+
+   // the result of an earlier solve must not be taken for this one if
+   // the iteration stops before the first termination test
+   test_result_ = IterativeSolverTerminationTester::CONTINUE;
+
+   const Index n = dim_;
+   Number* x = &sqmr_x_[0];
+   Number* r = &sqmr_r_[0];
+   Number* res = &sqmr_res_[0];
+   Number* q = &sqmr_q_[0];
+   Number* t = &sqmr_t_[0];
+   Number* d = &sqmr_d_[0];
+   Number* ad = &sqmr_ad_[0];
+
+   const Number zero = 0.;
+   IpBlasCopy(n, &zero, 0, x, 1);
+   IpBlasCopy(n, &zero, 0, d, 1);
+   IpBlasCopy(n, &zero, 0, ad, 1);
+   IpBlasCopy(n, rhs, 1, r, 1);
+   IpBlasCopy(n, rhs, 1, res, 1);
+
+   const Number norm2_rhs = IpBlasNrm2(n, rhs, 1);
+   if( norm2_rhs == 0. )
+   {
+      test_result_ = IterativeSolverTerminationTester::OTHER_SATISFIED;
+      return true;
+   }
+
+   // r is the residual of the underlying Lanczos (BiCG) iterate and
+   // res = rhs - A x the residual of the QMR iterate x; the latter is
+   // updated through ad = A d without additional matrix products
+   Number tau = norm2_rhs;
+   Number theta = 0.;
+   ApplyPreconditioner(r, q);
+   Number rho = IpBlasDot(n, r, 1, q, 1);
+   Number best_resid = norm2_rhs;
+   Index non_improvement = 0;
+
+   for( Index iter = 1; iter <= max_iter; iter++ )
+   {
+      MultMatrix(ia, ja, q, t);
+      const Number sigma = IpBlasDot(n, q, 1, t, 1);
+      if( sigma == 0. || rho == 0. )
+      {
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "SQMR breakdown in iteration %" IPOPT_INDEX_FORMAT ".\n", iter);
+         return false;
+      }
+      const Number alpha = rho / sigma;
+      IpBlasAxpy(n, -alpha, t, 1, r, 1);
+
+      const Number theta_new = IpBlasNrm2(n, r, 1) / tau;
+      const Number c2 = 1. / (1. + theta_new * theta_new);
+      tau *= theta_new * std::sqrt(c2);
+      const Number coef = c2 * theta * theta;
+      for( Index i = 0; i < n; i++ )
+      {
+         d[i] = coef * d[i] + c2 * alpha * q[i];
+         ad[i] = coef * ad[i] + c2 * alpha * t[i];
+         x[i] += d[i];
+         res[i] -= ad[i];
+      }
+      theta = theta_new;
+
+      test_result_ = tester.TestTermination(n, x, res, iter, norm2_rhs);
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Termination Tester Result = %d.\n", test_result_);
+      if( test_result_ != IterativeSolverTerminationTester::CONTINUE )
+      {
+         return true;
+      }
+
+      const Number norm2_resid = IpBlasNrm2(n, res, 1);
+      if( norm2_resid < best_resid )
+      {
+         best_resid = norm2_resid;
+         non_improvement = 0;
+      }
+      else if( ++non_improvement >= sqmr_max_non_improvement )
+      {
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "SQMR stagnates in iteration %" IPOPT_INDEX_FORMAT ".\n", iter);
+         return false;
+      }
+
+      // t is not needed anymore and takes the preconditioned residual
+      ApplyPreconditioner(r, t);
+      const Number rho_new = IpBlasDot(n, r, 1, t, 1);
+      const Number beta = rho_new / rho;
+      for( Index i = 0; i < n; i++ )
+      {
+         q[i] = t[i] + beta * q[i];
+      }
+      rho = rho_new;
+   }
+
+   return false;
+}
+
+ESymSolverStatus IterativeSqmrSolverInterface::Solve(
+   const Index* ia,
+   const Index* ja,
+   Number*      rhs_vals
+)
+{
+   DBG_START_METH("IterativeSqmrSolverInterface::Solve", dbg_verbosity);
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().Start();
+   }
+
+   IterativeSolverTerminationTester* tester;
+   bool is_normal = false;
+   if( IsNull(InexData().normal_x()) && InexData().compute_normal() )
+   {
+      tester = GetRawPtr(normal_tester_);
+      is_normal = true;
+   }
+   else
+   {
+      tester = GetRawPtr(pd_tester_);
+   }
+
+   Number& droptol_used = is_normal ? normal_ildl_dropping_factor_used_ : ildl_dropping_factor_used_;
+   const Number droptol_max = is_normal ? normal_ildl_dropping_factor_ : ildl_dropping_factor_;
+   const Index max_iter = is_normal ? normal_sqmr_max_iter_ : sqmr_max_iter_;
+   const Index max_col_fill = is_normal ? normal_ildl_max_col_fill_ : ildl_max_col_fill_;
+   const char* step_name = is_normal ? "normal step" : "PD step";
+
+   Number droptol = droptol_used;
+   if( !have_preconditioner_ || preconditioner_is_normal_ != is_normal )
+   {
+      Factorization(ia, ja, droptol, max_col_fill);
+      have_preconditioner_ = true;
+      preconditioner_is_normal_ = is_normal;
+   }
+
+   const Index max_attempts = ildl_max_droptol_corrections_ + 1;
+   for( Index attempts = 1; ; attempts++ )
+   {
+      bool retval = tester->InitializeSolve();
+      ASSERT_EXCEPTION(retval, INTERNAL_ABORT, "tester->InitializeSolve(); returned false");
+
+      bool converged = Sqmr(ia, ja, rhs_vals, max_iter, *tester);
+      Index iterations_used = tester->GetSolverIterations();
+      tester->Clear();
+
+      if( converged )
+      {
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "Number of iterations in SQMR solver for %s = %" IPOPT_INDEX_FORMAT ".\n", step_name, iterations_used);
+         break;
+      }
+      if( attempts >= max_attempts )
+      {
+         Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                        "SQMR did not converge for %s after %" IPOPT_INDEX_FORMAT " iterations.\n", step_name, iterations_used);
+         break;
+      }
+
+      Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                     "SQMR did not converge for %s, decreasing dropping tolerance from %e to %e.\n", step_name, droptol,
+                     droptol * decr_factor_);
+      droptol *= decr_factor_;
+      Factorization(ia, ja, droptol, max_col_fill);
+   }
+
+   // go back up by one decrease for the next matrix
+   if( droptol < droptol_max )
+   {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Increasing dropping tolerance from %e to %e for next iteration (%s).\n", droptol,
+                     Min(droptol / decr_factor_, droptol_max), step_name);
+   }
+   droptol_used = Min(droptol / decr_factor_, droptol_max);
+
+   IpBlasCopy(dim_, &sqmr_x_[0], 1, rhs_vals, 1);
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().End();
+   }
+
+   if( test_result_ == IterativeSolverTerminationTester::MODIFY_HESSIAN )
+   {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Termination tester requests modification of Hessian\n");
+      return SYMSOLVER_WRONG_INERTIA;
+   }
+   if( test_result_ == IterativeSolverTerminationTester::TEST_2_SATISFIED )
+   {
+      // Termination Test 2 is satisfied, set the step for the primal
+      // iterates to zero
+      Index nvars = IpData().curr()->x()->Dim() + IpData().curr()->s()->Dim();
+      const Number zero = 0.;
+      IpBlasCopy(nvars, &zero, 0, rhs_vals, 1);
+   }
+   return SYMSOLVER_SUCCESS;
+}
+
+Index IterativeSqmrSolverInterface::NumberOfNegEVals() const
+{
+   DBG_START_METH("IterativeSqmrSolverInterface::NumberOfNegEVals", dbg_verbosity);
+   DBG_ASSERT(negevals_ >= 0);
+   return negevals_;
+}
+
+bool IterativeSqmrSolverInterface::IncreaseQuality()
+{
+   const Number min_droptol = 1e-10;
+   if( ildl_dropping_factor_used_ <= min_droptol && normal_ildl_dropping_factor_used_ <= min_droptol )
+   {
+      return false;
+   }
+   ildl_dropping_factor_used_ = Max(ildl_dropping_factor_used_ * decr_factor_, min_droptol);
+   normal_ildl_dropping_factor_used_ = Max(normal_ildl_dropping_factor_used_ * decr_factor_, min_droptol);
+   have_preconditioner_ = false;
+   return true;
+}
+
+} // namespace Ipopt
@@ -0,0 +1,299 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPITERATIVESQMRSOLVERINTERFACE_HPP__
+#define __IPITERATIVESQMRSOLVERINTERFACE_HPP__
+
+#include "IpSparseSymLinearSolverInterface.hpp"
+#include "IpInexactCq.hpp"
+#include "IpIterativeSolverTerminationTester.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Interface to an in-tree iterative solver for symmetric indefinite
+ *  systems, derived from SparseSymLinearSolverInterface.
+ *
+ *  The system is solved by the simplified QMR method (SQMR) of Freund
+ *  and Nachtigal, preconditioned by a threshold incomplete LDL^T
+ *  factorization with 1x1 pivots of the symmetrically equilibrated
+ *  matrix.  The iteration is stopped by the termination testers for
+ *  the normal and primal-dual step computations of the inexact
+ *  algorithm, which are called in every iteration in the same way as
+ *  by the iterative version of Pardiso.  If SQMR fails, the dropping
+ *  tolerance of the preconditioner is decreased and the solve is
+ *  repeated.
+ *
+ *  No complete factorization is computed, so this solver does not
+ *  provide the inertia of the matrix.
+ */
+class IterativeSqmrSolverInterface: public SparseSymLinearSolverInterface
+{
+public:
+   /** @name Constructor/Destructor */
+   ///@{
+   /** Constructor */
+   IterativeSqmrSolverInterface(
+      IterativeSolverTerminationTester& normal_tester,
+      IterativeSolverTerminationTester& pd_tester
+   );
+
+   /** Destructor */
+   virtual ~IterativeSqmrSolverInterface();
+   ///@}
+
+   bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   /** @name Methods for requesting solution of the linear system. */
+   ///@{
+   /** Method for initializing internal structures. */
+   virtual ESymSolverStatus InitializeStructure(
+      Index        dim,
+      Index        nonzeros,
+      const Index* ia,
+      const Index* ja
+   );
+
+   /** Method returning an internal array into which the nonzero
+    *  elements are to be stored.
+    */
+   virtual Number* GetValuesArrayPtr();
+
+   /** Solve operation for multiple right hand sides. */
+   virtual ESymSolverStatus MultiSolve(
+      bool         new_matrix,
+      const Index* ia,
+      const Index* ja,
+      Index        nrhs,
+      Number*      rhs_vals,
+      bool         check_NegEVals,
+      Index        numberOfNegEVals
+   );
+
+   /** Number of negative pivots in the most recent incomplete
+    *  factorization.
+    *
+    *  This is only an estimate of the number of negative eigenvalues.
+    */
+   virtual Index NumberOfNegEVals() const;
+   ///@}
+
+   //* @name Options of Linear solver */
+   ///@{
+   /** Request to increase quality of solution for next solve.
+    *
+    *  Decreases the dropping tolerance of the preconditioner.
+    */
+   virtual bool IncreaseQuality();
+
+   /** Query whether inertia is computed by linear solver.
+    *
+    *  @return false
+    */
+   virtual bool ProvidesInertia() const
+   {
+      return false;
+   }
+
+   /** Query of requested matrix type that the linear solver
+    *  understands.
+    */
+   EMatrixFormat MatrixFormat() const
+   {
+      return CSR_Full_Format_0_Offset;
+   }
+   ///@}
+
+   static void RegisterOptions(
+      SmartPtr<RegisteredOptions> roptions
+   );
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default Constructor */
+   IterativeSqmrSolverInterface();
+
+   /** Copy Constructor */
+   IterativeSqmrSolverInterface(
+      const IterativeSqmrSolverInterface&
+   );
+
+   /** Overloaded Assignment Operator */
+   void operator=(
+      const IterativeSqmrSolverInterface&
+   );
+   ///@}
+
+   /** @name Information about the matrix */
+   ///@{
+   /** Number of rows and columns of the matrix */
+   Index dim_;
+
+   /** Number of nonzeros of the matrix in full CSR representation. */
+   Index nonzeros_;
+
+   /** Array for storing the values of the matrix. */
+   Number* a_;
+   ///@}
+
+   /** @name Information about most recent factorization/solve */
+   ///@{
+   /** Number of negative pivots */
+   Index negevals_;
+   /** Flag indicating whether the preconditioner belongs to the
+    *  current matrix values.
+    */
+   bool have_preconditioner_;
+   /** Flag indicating whether the current preconditioner has been
+    *  computed for the normal step computation.
+    */
+   bool preconditioner_is_normal_;
+   ///@}
+
+   /** @name Solver specific options */
+   ///@{
+   Index sqmr_max_iter_;
+   Number ildl_dropping_factor_;
+   Index ildl_max_col_fill_;
+   Number ildl_pivot_tol_;
+   Index normal_sqmr_max_iter_;
+   Number normal_ildl_dropping_factor_;
+   Index normal_ildl_max_col_fill_;
+   /** Maximal number of decreases of drop tolerance during one solve. */
+   Index ildl_max_droptol_corrections_;
+   ///@}
+
+   /** Decrease factor for dropping tolerances */
+   Number decr_factor_;
+
+   /** Actually used dropping tolerances */
+   ///@{
+   Number ildl_dropping_factor_used_;
+   Number normal_ildl_dropping_factor_used_;
+   ///@}
+
+   /** @name Initialization flags */
+   ///@{
+   /** Flag indicating if internal data is initialized.
+    *
+    *  For initialization, this object needs to have seen a matrix.
+    */
+   bool initialized_;
+   ///@}
+
+   /** @name Incomplete LDL^T factorization of S A S.
+    *
+    *  L is unit lower triangular and stored by columns without the
+    *  diagonal; the row indices within a column are increasing.
+    */
+   ///@{
+   /** Symmetric scaling factors S */
+   std::vector<Number> scaling_;
+   /** Diagonal D */
+   std::vector<Number> diag_;
+   /** Column start positions of L */
+   std::vector<Index> l_colptr_;
+   /** Row indices of L */
+   std::vector<Index> l_rowind_;
+   /** Values of L */
+   std::vector<Number> l_val_;
+   ///@}
+
+   /** @name Work arrays for the factorization and SQMR */
+   ///@{
+   std::vector<Index> next_pos_;
+   std::vector<Index> list_head_;
+   std::vector<Index> list_next_;
+   std::vector<Index> marker_;
+   std::vector<Index> pattern_;
+   std::vector<Number> work_;
+   std::vector<Number> sqmr_x_;
+   std::vector<Number> sqmr_r_;
+   std::vector<Number> sqmr_res_;
+   std::vector<Number> sqmr_q_;
+   std::vector<Number> sqmr_t_;
+   std::vector<Number> sqmr_d_;
+   std::vector<Number> sqmr_ad_;
+   ///@}
+
+   /** @name Internal functions */
+   ///@{
+   /** Compute the incomplete LDL^T factorization of the current
+    *  matrix for the given dropping tolerance.
+    */
+   void Factorization(
+      const Index* ia,
+      const Index* ja,
+      Number       droptol,
+      Index        max_col_fill
+   );
+
+   /** Apply the inverse of the preconditioner, y = S (L D L^T)^{-1} S x */
+   void ApplyPreconditioner(
+      const Number* x,
+      Number*       y
+   ) const;
+
+   /** Compute y = A x */
+   void MultMatrix(
+      const Index*  ia,
+      const Index*  ja,
+      const Number* x,
+      Number*       y
+   ) const;
+
+   /** Run SQMR for one right hand side, calling the termination
+    *  tester in every iteration.
+    *
+    *  @return true, if the tester was satisfied or requested a
+    *  Hessian modification
+    */
+   bool Sqmr(
+      const Index*                      ia,
+      const Index*                      ja,
+      const Number*                     rhs,
+      Index                             max_iter,
+      IterativeSolverTerminationTester& tester
+   );
+
+   /** Run the iterative solve for one right hand side. */
+   ESymSolverStatus Solve(
+      const Index* ia,
+      const Index* ja,
+      Number*      rhs_vals
+   );
+   ///@}
+
+   /** Method to easily access Inexact data */
+   InexactData& InexData()
+   {
+      InexactData& inexact_data = static_cast<InexactData&>(IpData().AdditionalData());
+      DBG_ASSERT(dynamic_cast<InexactData*>(&IpData().AdditionalData()));
+      return inexact_data;
+   }
+
+   /** Termination tester for normal step computation */
+   SmartPtr<IterativeSolverTerminationTester> normal_tester_;
+
+   /** Termination tester for primal-dual step computation */
+   SmartPtr<IterativeSolverTerminationTester> pd_tester_;
+};
+
+} // namespace Ipopt
+
+#endif
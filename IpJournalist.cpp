@@ -6,6 +6,7 @@
 
 #include "IpoptConfig.h"
 #include "IpJournalist.hpp"
+#include "IpAsyncFileJournal.hpp"
 #include "IpDebug.hpp"
 
 #include <cstdio>
@@ -15,11 +16,14 @@ namespace Ipopt
 {
 
 Journalist::Journalist()
-{ }
+{
+   UpdateMaxLevels();
+}
 
 Journalist::~Journalist()
 {
    journals_.clear();
+   metrics_sinks_.clear();
 }
 
 void Journalist::Printf(
@@ -29,6 +33,11 @@ void Journalist::Printf(
    ...
 ) const
 {
+   if( !ProduceOutput(level, category) )
+   {
+      return;
+   }
+
    // wrap the arguments and pass to VPrintf
    va_list ap;
    va_start(ap, pformat);
@@ -121,6 +130,11 @@ void Journalist::PrintfIndented(
    ...
 ) const
 {
+   if( !ProduceOutput(level, category) )
+   {
+      return;
+   }
+
    // wrap the arguments and pass to VPrintfIndented
    va_list ap;
    va_start(ap, pformat);
@@ -228,19 +242,28 @@ void Journalist::VPrintfIndented(
    }
 }
 
-bool Journalist::ProduceOutput(
-   EJournalLevel    level,
-   EJournalCategory category
-) const
+void Journalist::UpdateMaxLevels() const
 {
-   for( Index i = 0; i < (Index) journals_.size(); i++ )
+   // The generation is taken before the levels are evaluated, so that a
+   // change of a print level during the update triggers another update
+   unsigned int generation = Journal::PrintLevelsGeneration();
+   for( Index category = 0; category < (Index) J_LAST_CATEGORY; category++ )
    {
-      if( journals_[i]->IsAccepted(category, level) )
+      Index max_level = (Index) J_INSUPPRESSIBLE - 1;
+      for( Index i = 0; i < (Index) journals_.size(); i++ )
       {
-         return true;
+         for( Index level = (Index) J_LAST_LEVEL - 1; level > max_level; level-- )
+         {
+            if( journals_[i]->IsAccepted((EJournalCategory) category, (EJournalLevel) level) )
+            {
+               max_level = level;
+               break;
+            }
+         }
       }
+      max_levels_[category].store(max_level, std::memory_order_relaxed);
    }
-   return false;
+   max_levels_generation_.store(generation, std::memory_order_release);
 }
 
 bool Journalist::AddJournal(
@@ -258,9 +281,31 @@ bool Journalist::AddJournal(
    }
 
    journals_.push_back(jrnl);
+   UpdateMaxLevels();
    return true;
 }
 
+SmartPtr<Journal> Journalist::AddFileJournal(
+   const std::string& journal_name,
+   const std::string& fname,
+   EJournalLevel      default_level,
+   bool               file_append,
+   EJournalWriter     writer
+)
+{
+   if( writer == J_WRITER_SYNC )
+   {
+      return AddFileJournal(journal_name, fname, default_level, file_append);
+   }
+
+   SmartPtr<AsyncFileJournal> temp = new AsyncFileJournal(journal_name, default_level, writer == J_WRITER_ASYNC_DROP);
+   if( temp->Open(fname.c_str(), file_append) && AddJournal(GetRawPtr(temp)) )
+   {
+      return GetRawPtr(temp);
+   }
+   return NULL;
+}
+
 SmartPtr<Journal> Journalist::AddFileJournal(
    const std::string& journal_name,
    const std::string& fname,
@@ -285,6 +330,20 @@ void Journalist::FlushBuffer() const
    {
       journals_[i]->FlushBuffer();
    }
+   for( Index i = 0; i < (Index) metrics_sinks_.size(); i++ )
+   {
+      metrics_sinks_[i]->Flush();
+   }
+}
+
+void Journalist::WriteMetrics(
+   const MetricsRecord& record
+) const
+{
+   for( Index i = 0; i < (Index) metrics_sinks_.size(); i++ )
+   {
+      metrics_sinks_[i]->Write(record);
+   }
 }
 
 SmartPtr<Journal> Journalist::GetJournal(
@@ -314,12 +373,70 @@ void Journalist::DeleteAllJournals()
       journals_[i] = NULL;
    }
    journals_.resize(0);
+   UpdateMaxLevels();
+}
+
+bool Journalist::AddMetricsSink(
+   const SmartPtr<MetricsSink> sink
+)
+{
+   DBG_ASSERT(IsValid(sink));
+
+   SmartPtr<MetricsSink> temp = GetMetricsSink(sink->Name());
+   DBG_ASSERT(IsNull(temp));
+   if( IsValid(temp) )
+   {
+      return false;
+   }
+
+   metrics_sinks_.push_back(sink);
+   return true;
+}
+
+SmartPtr<MetricsSink> Journalist::AddFileMetricsSink(
+   const std::string& sink_name,
+   const std::string& fname,
+   bool               file_append
+)
+{
+   SmartPtr<FileMetricsSink> temp = new FileMetricsSink(sink_name);
+
+   if( temp->Open(fname.c_str(), file_append) && AddMetricsSink(GetRawPtr(temp)) )
+   {
+      return GetRawPtr(temp);
+   }
+   return NULL;
+}
+
+SmartPtr<MetricsSink> Journalist::GetMetricsSink(
+   const std::string& sink_name
+)
+{
+   for( Index i = 0; i < (Index) metrics_sinks_.size(); i++ )
+   {
+      if( metrics_sinks_[i]->Name() == sink_name )
+      {
+         return metrics_sinks_[i];
+      }
+   }
+   return NULL;
+}
+
+void Journalist::DeleteAllMetricsSinks()
+{
+   for( Index i = 0; i < (Index) metrics_sinks_.size(); i++ )
+   {
+      metrics_sinks_[i]->Flush();
+   }
+   metrics_sinks_.resize(0);
 }
 
 ///////////////////////////////////////////////////////////////////////////
 //                 Implementation of the Journal class                   //
 ///////////////////////////////////////////////////////////////////////////
 
+std::atomic<unsigned int> Journal::print_levels_generation_(0);
+
 Journal::Journal(
    const std::string& name,
    EJournalLevel      default_level
@@ -359,6 +476,7 @@ void Journal::SetPrintLevel(
 )
 {
    print_levels_[(Index) category] = (Index) level;
+   print_levels_generation_++;
 }
 
 void Journal::SetAllPrintLevels(
@@ -369,6 +487,7 @@ void Journal::SetAllPrintLevels(
    {
       print_levels_[category] = (Index) level;
    }
+   print_levels_generation_++;
 }
 
 ///////////////////////////////////////////////////////////////////////////
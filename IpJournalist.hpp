@@ -11,7 +11,9 @@
 #include "IpTypes.hpp"
 #include "IpReferenced.hpp"
 #include "IpSmartPtr.hpp"
+#include "IpMetricsSink.hpp"
 
+#include <atomic>
 #include <cstdarg>
 #include <cstdio>
 #include <string>
@@ -84,6 +86,14 @@ enum EJournalCategory
    J_USER17,           /**< This can be used by the user's application*/
    J_LAST_CATEGORY
 };
+
+/** How a file journal writes its output. */
+enum EJournalWriter
+{
+   J_WRITER_SYNC = 0,  /**< write on the printing thread (FileJournal) */
+   J_WRITER_ASYNC,     /**< write from a background thread, wait if its queue is full (AsyncFileJournal) */
+   J_WRITER_ASYNC_DROP /**< write from a background thread, drop output if its queue is full (AsyncFileJournal) */
+};
 ///@}
 
 /** Class responsible for all message output.
@@ -193,6 +203,10 @@ public:
     *  This is useful if expensive computation would be required for
     *  a particular output.  The author code can check with this
     *  method if the computations are indeed required.
+    *
+    *  The answer is taken from the maximal accepted level per
+    *  category, which is recomputed only after journals have been
+    *  added or removed or print levels have been changed.
     */
    virtual bool ProduceOutput(
       EJournalLevel    level,
@@ -206,6 +220,21 @@ public:
     * program (e.g. written in Fortran)
     */
    virtual void FlushBuffer() const;
+
+   /** Method that returns true if there is a metrics sink.
+    *
+    *  Author code can check this before collecting the values of a
+    *  metrics record.
+    */
+   bool ProduceMetrics() const
+   {
+      return !metrics_sinks_.empty();
+   }
+
+   /** Method to send a record to all metrics sinks */
+   virtual void WriteMetrics(
+      const MetricsRecord& record
+   ) const;
    ///@}
 
    /**@name Reader Methods.
@@ -235,6 +264,20 @@ public:
       bool               file_append = false       /**< whether to append to file or truncate it (since 3.14.13) */
    );
 
+   /** Add a new journal for a file that is written by the given writer.
+    *
+    *  For J_WRITER_SYNC, this calls the method above.
+    *
+    *  @return the Journal pointer, or NULL if there was a problem creating a new Journal.
+    */
+   SmartPtr<Journal> AddFileJournal(
+      const std::string& location_name, /**< string identifier of the new Journal */
+      const std::string& fname,         /**< name of the file to which this Journal corresponds */
+      EJournalLevel      default_level, /**< default journal level used to initialize the printing level for all categories */
+      bool               file_append,   /**< whether to append to file or truncate it */
+      EJournalWriter     writer         /**< how the journal writes to the file */
+   );
+
    /** Get an existing journal.
     *
     *  You can use this method to change the acceptance criteria at runtime.
@@ -245,6 +288,29 @@ public:
 
    /** Delete all journals currently known by the journalist. */
    virtual void DeleteAllJournals();
+
+   /** Add a new metrics sink. */
+   virtual bool AddMetricsSink(
+      const SmartPtr<MetricsSink> sink
+   );
+
+   /** Add a new FileMetricsSink.
+    *
+    *  @return the sink, or NULL if there was a problem opening the file
+    */
+   virtual SmartPtr<MetricsSink> AddFileMetricsSink(
+      const std::string& sink_name,            /**< string identifier, which can be used to obtain the pointer to the new sink at a later point using the GetMetricsSink method */
+      const std::string& fname,                /**< name of the file to which the records are written; use "stdout" for stdout and use "stderr" for stderr */
+      bool               file_append = false   /**< whether to append to file or truncate it */
+   );
+
+   /** Get an existing metrics sink. */
+   virtual SmartPtr<MetricsSink> GetMetricsSink(
+      const std::string& sink_name
+   );
+
+   /** Delete all metrics sinks currently known by the journalist. */
+   virtual void DeleteAllMetricsSinks();
    ///@}
 
 private:
@@ -272,6 +338,27 @@ private:
    //** Private Data Members. */
    ///@{
    std::vector<SmartPtr<Journal> > journals_;
+   std::vector<SmartPtr<MetricsSink> > metrics_sinks_;
+   ///@}
+
+   /** @name Cache of the acceptance criteria of all journals
+    *
+    *  ProduceOutput may be called from several threads at once, all
+    *  of which may find the cache outdated and refresh it.  Therefore,
+    *  the cache fields are atomic, and the generation is stored only
+    *  after the levels, so that a thread that sees the new generation
+    *  also sees the new levels.
+    */
+   ///@{
+   /** Recompute the maximal accepted level per category */
+   void UpdateMaxLevels() const;
+
+   /** Highest level accepted by any journal for each category,
+    *  J_INSUPPRESSIBLE-1 if there is none
+    */
+   mutable std::atomic<Index> max_levels_[J_LAST_CATEGORY];
+   /** Value of Journal::PrintLevelsGeneration() when max_levels_ was computed */
+   mutable std::atomic<unsigned int> max_levels_generation_;
    ///@}
 };
 
@@ -316,7 +403,11 @@ public:
     *  and category. You should use the Journalist to print & flush instead
     */
    ///@{
-   /** Ask if a particular print level/category is accepted by the journal. */
+   /** Ask if a particular print level/category is accepted by the journal.
+    *
+    *  Journalists cache the answer, so it must only depend on the
+    *  print levels set by SetPrintLevel and SetAllPrintLevels.
+    */
    virtual bool IsAccepted(
       EJournalCategory category,
       EJournalLevel    level
@@ -405,8 +496,32 @@ private:
 
    /** vector of integers indicating the level for each category */
    Index print_levels_[J_LAST_CATEGORY];
+
+   /** Counter of print level changes of all journals */
+   static std::atomic<unsigned int> print_levels_generation_;
+
+public:
+   /** Number that changes whenever the print level of any journal is
+    *  changed, so that journalists know when to update their cache.
+    */
+   static unsigned int PrintLevelsGeneration()
+   {
+      return print_levels_generation_.load(std::memory_order_relaxed);
+   }
 };
 
+inline bool Journalist::ProduceOutput(
+   EJournalLevel    level,
+   EJournalCategory category
+) const
+{
+   if( max_levels_generation_.load(std::memory_order_acquire) != Journal::PrintLevelsGeneration() )
+   {
+      UpdateMaxLevels();
+   }
+   return (Index) level <= max_levels_[category].load(std::memory_order_relaxed);
+}
+
 /** FileJournal class.
  *
  *  This is a particular Journal implementation that
@@ -17,6 +17,32 @@ namespace Ipopt
 static const Index dbg_verbosity = 0;
 #endif
 
+/** Limited-memory data kept for a warm start.
+ *
+ *  The matrices and vectors are not changed by the updater once they
+ *  have been created, so that they can be shared with it.
+ */
+class LimMemWarmState: public ReferencedObject
+{
+public:
+   Index curr_lm_memory;
+   SmartPtr<MultiVectorMatrix> S;
+   SmartPtr<MultiVectorMatrix> Y;
+   SmartPtr<MultiVectorMatrix> Ypart;
+   SmartPtr<DenseVector> D;
+   SmartPtr<DenseGenMatrix> L;
+   Number sigma;
+   SmartPtr<MultiVectorMatrix> V;
+   SmartPtr<MultiVectorMatrix> U;
+   SmartPtr<DenseSymMatrix> SdotS;
+   bool SdotS_uptodate;
+   SmartPtr<const Vector> last_x;
+   SmartPtr<const Vector> last_grad_f;
+   SmartPtr<const Matrix> last_jac_c;
+   SmartPtr<const Matrix> last_jac_d;
+   Index lm_skipped_iter;
+};
+
 LimMemQuasiNewtonUpdater::LimMemQuasiNewtonUpdater(
    bool update_for_resto
 )
@@ -138,6 +164,67 @@ bool LimMemQuasiNewtonUpdater::InitializeImpl(
    return true;
 }
 
+SmartPtr<const ReferencedObject> LimMemQuasiNewtonUpdater::GetWarmState() const
+{
+   if( update_for_resto_ || IsNull(last_x_) )
+   {
+      return NULL;
+   }
+
+   SmartPtr<LimMemWarmState> state = new LimMemWarmState();
+   state->curr_lm_memory = curr_lm_memory_;
+   state->S = S_;
+   state->Y = Y_;
+   state->Ypart = Ypart_;
+   state->D = D_;
+   state->L = L_;
+   state->sigma = sigma_;
+   state->V = V_;
+   state->U = U_;
+   state->SdotS = SdotS_;
+   state->SdotS_uptodate = SdotS_uptodate_;
+   state->last_x = last_x_;
+   state->last_grad_f = last_grad_f_;
+   state->last_jac_c = last_jac_c_;
+   state->last_jac_d = last_jac_d_;
+   state->lm_skipped_iter = lm_skipped_iter_;
+   return ConstPtr(state);
+}
+
+void LimMemQuasiNewtonUpdater::SetWarmState(
+   const SmartPtr<const ReferencedObject>& state
+)
+{
+   DBG_START_METH("LimMemQuasiNewtonUpdater::SetWarmState",
+                  dbg_verbosity);
+
+   const LimMemWarmState* lm_state = dynamic_cast<const LimMemWarmState*>(GetRawPtr(state));
+   if( update_for_resto_ || lm_state == NULL )
+   {
+      return;
+   }
+
+   curr_lm_memory_ = lm_state->curr_lm_memory;
+   S_ = lm_state->S;
+   Y_ = lm_state->Y;
+   Ypart_ = lm_state->Ypart;
+   D_ = lm_state->D;
+   L_ = lm_state->L;
+   sigma_ = lm_state->sigma;
+   V_ = lm_state->V;
+   U_ = lm_state->U;
+   SdotS_ = lm_state->SdotS;
+   SdotS_uptodate_ = lm_state->SdotS_uptodate;
+   last_x_ = lm_state->last_x;
+   last_grad_f_ = lm_state->last_grad_f;
+   last_jac_c_ = lm_state->last_jac_c;
+   last_jac_d_ = lm_state->last_jac_d;
+   lm_skipped_iter_ = lm_state->lm_skipped_iter;
+
+   Jnlst().Printf(J_DETAILED, J_HESSIAN_APPROXIMATION,
+                  "Restored limited-memory history with %" IPOPT_INDEX_FORMAT " pairs from warm state.\n", curr_lm_memory_);
+}
+
 void LimMemQuasiNewtonUpdater::UpdateHessian()
 {
    DBG_START_METH("LimMemQuasiNewtonUpdater::UpdateHessian",
@@ -43,6 +43,18 @@ public:
    /** Update the Hessian based on the current information in IpData. */
    virtual void UpdateHessian();
 
+   /** The internal data for a warm start are the stored pairs of the
+    *  limited-memory update, together with the data at the last
+    *  iterate.
+    *
+    *  Nothing is kept for the restoration phase.
+    */
+   virtual SmartPtr<const ReferencedObject> GetWarmState() const;
+
+   virtual void SetWarmState(
+      const SmartPtr<const ReferencedObject>& state
+   );
+
    /** Methods for OptionsList */
    ///@{
    static void RegisterOptions(
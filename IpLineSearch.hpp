@@ -78,6 +78,31 @@ public:
     */
    virtual bool ActivateFallbackMechanism() = 0;
 
+   /** @name Methods for warm starts from the state of a previous
+    *  optimization
+    */
+   ///@{
+   /** Return the internal data that should be kept for a warm start,
+    *  or NULL if there is none.
+    *
+    *  The returned object must not be changed by later iterations.
+    */
+   virtual SmartPtr<const ReferencedObject> GetWarmState() const
+   {
+      return NULL;
+   }
+
+   /** Restore the internal data from an object returned by
+    *  GetWarmState.
+    *
+    *  This is called after the initialization of the iterates.
+    */
+   virtual void SetWarmState(
+      const SmartPtr<const ReferencedObject>& /*state*/
+   )
+   { }
+   ///@}
+
 private:
    /**@name Default Compiler Generated Methods
     * (Hidden to avoid implicit creation/calling).
@@ -9,6 +9,7 @@
 #include "IpLinearSolvers.h"
 #include "IpRegOptions.hpp"
 #include "IpTSymLinearSolver.hpp"
+#include "IpRuizTSymScalingMethod.hpp"
 
 #include "IpMa27TSolverInterface.hpp"
 #include "IpMa57TSolverInterface.hpp"
@@ -16,6 +17,8 @@
 #include "IpMa86SolverInterface.hpp"
 #include "IpMa97SolverInterface.hpp"
 #include "IpMa28TDependencyDetector.hpp"
+#include "IpLuTDependencyDetector.hpp"
+#include "IpOutOfCoreLdlSolverInterface.hpp"
 #include "IpPardisoSolverInterface.hpp"
 #ifdef IPOPT_HAS_PARDISO_MKL
 #include "IpPardisoMKLSolverInterface.hpp"
@@ -43,6 +46,7 @@ void RegisterOptions_LinearSolvers(
 {
    roptions->SetRegisteringCategory("Linear Solver");
    TSymLinearSolver::RegisterOptions(roptions);
+   RuizTSymScalingMethod::RegisterOptions(roptions);
 
    IpoptLinearSolver availablesolvers = IpoptGetAvailableLinearSolvers(false);
 
@@ -119,6 +123,12 @@ void RegisterOptions_LinearSolvers(
    }
 #endif
 
+   roptions->SetRegisteringCategory("OOC-LDL Linear Solver");
+   OutOfCoreLdlSolverInterface::RegisterOptions(roptions);
+
+   roptions->SetRegisteringCategory("LU Dependency Detector");
+   LuTDependencyDetector::RegisterOptions(roptions);
+
 #if ((defined(COINHSL_HAS_MA28) && !defined(IPOPT_SINGLE)) || (defined(COINHSL_HAS_MA28S) && defined(IPOPT_SINGLE))) && defined(F77_FUNC)
    roptions->SetRegisteringCategory("MA28 Linear Solver");
    Ma28TDependencyDetector::RegisterOptions(roptions);
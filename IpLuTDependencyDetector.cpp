@@ -0,0 +1,363 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpLuTDependencyDetector.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <functional>
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+LuTDependencyDetector::LuTDependencyDetector()
+   : pivtol_(0.1),
+     dependency_tol_(1e-8)
+{ }
+
+void LuTDependencyDetector::RegisterOptions(
+   SmartPtr<RegisteredOptions> roptions
+)
+{
+   roptions->AddBoundedNumberOption(
+      "lu_dependency_pivtol",
+      "Pivot tolerance for the LU dependency detector.",
+      0.0, true,
+      1., false,
+      0.1,
+      "A pivot is chosen among the entries of a reduced row whose absolute value is at least this value times "
+      "the largest absolute value in the row. "
+      "Smaller values reduce the fill-in, larger values make the detection more reliable.",
+      true);
+   roptions->AddLowerBoundedNumberOption(
+      "lu_dependency_tol",
+      "Tolerance for declaring a row dependent in the LU dependency detector.",
+      0.0, true,
+      1e-8,
+      "A row is considered linearly dependent on the previous rows if the largest absolute value of the row after "
+      "the elimination is at most this value times the largest absolute value of the original row.",
+      true);
+}
+
+bool LuTDependencyDetector::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   options.GetNumericValue("lu_dependency_pivtol", pivtol_, prefix);
+   options.GetNumericValue("lu_dependency_tol", dependency_tol_, prefix);
+   return true;
+}
+
+bool LuTDependencyDetector::DetermineDependentRows(
+   Index             n_rows,
+   Index             n_cols,
+   Index             n_jac_nz,
+   Number*           jac_c_vals,
+   Index*            jac_c_iRow,
+   Index*            jac_c_jCol,
+   std::list<Index>& c_deps
+)
+{
+   DBG_START_METH("LuTDependencyDetector::DetermineDependentRows",
+                  dbg_verbosity);
+
+   c_deps.clear();
+   if( n_rows == 0 )
+   {
+      return true;
+   }
+
+   // Store the matrix row-wise with 0-based indices
+   std::vector<Index> row_start(n_rows + 1, 0);
+   for( Index i = 0; i < n_jac_nz; i++ )
+   {
+      DBG_ASSERT(jac_c_iRow[i] >= 1 && jac_c_iRow[i] <= n_rows);
+      DBG_ASSERT(jac_c_jCol[i] >= 1 && jac_c_jCol[i] <= n_cols);
+      row_start[jac_c_iRow[i]]++;
+   }
+   for( Index i = 0; i < n_rows; i++ )
+   {
+      row_start[i + 1] += row_start[i];
+   }
+   std::vector<Index> col(n_jac_nz);
+   std::vector<Number> val(n_jac_nz);
+   {
+      std::vector<Index> pos(row_start.begin(), row_start.end() - 1);
+      for( Index i = 0; i < n_jac_nz; i++ )
+      {
+         Index p = pos[jac_c_iRow[i] - 1]++;
+         col[p] = jac_c_jCol[i] - 1;
+         val[p] = jac_c_vals[i];
+      }
+   }
+
+   // Split the rows into blocks that do not share a column, using a
+   // union-find structure over the rows
+   std::vector<Index> parent(n_rows);
+   for( Index i = 0; i < n_rows; i++ )
+   {
+      parent[i] = i;
+   }
+   std::vector<Index> col_row(n_cols, -1);
+   std::vector<Index> col_count(n_cols, 0);
+   for( Index i = 0; i < n_rows; i++ )
+   {
+      for( Index p = row_start[i]; p < row_start[i + 1]; p++ )
+      {
+         Index j = col[p];
+         col_count[j]++;
+         if( col_row[j] == -1 )
+         {
+            col_row[j] = i;
+            continue;
+         }
+         // unite the sets of row i and of the first row in column j
+         Index r1 = i;
+         while( parent[r1] != r1 )
+         {
+            parent[r1] = parent[parent[r1]];
+            r1 = parent[r1];
+         }
+         Index r2 = col_row[j];
+         while( parent[r2] != r2 )
+         {
+            parent[r2] = parent[parent[r2]];
+            r2 = parent[r2];
+         }
+         if( r1 != r2 )
+         {
+            // keep the smaller row as the root, so that the blocks
+            // are numbered by their first row
+            parent[std::max(r1, r2)] = std::min(r1, r2);
+         }
+      }
+   }
+
+   // Number the blocks and sort the rows by block, keeping the
+   // original order within a block
+   std::vector<Index> block(n_rows);
+   Index n_blocks = 0;
+   for( Index i = 0; i < n_rows; i++ )
+   {
+      Index r = i;
+      while( parent[r] != r )
+      {
+         r = parent[r];
+      }
+      parent[i] = r;
+      block[i] = (r == i) ? n_blocks++ : block[r];
+   }
+   std::vector<Index> block_start(n_blocks + 1, 0);
+   for( Index i = 0; i < n_rows; i++ )
+   {
+      block_start[block[i] + 1]++;
+   }
+   for( Index b = 0; b < n_blocks; b++ )
+   {
+      block_start[b + 1] += block_start[b];
+   }
+   std::vector<Index> block_rows(n_rows);
+   {
+      std::vector<Index> pos(block_start.begin(), block_start.end() - 1);
+      for( Index i = 0; i < n_rows; i++ )
+      {
+         block_rows[pos[block[i]]++] = i;
+      }
+   }
+
+   // Every column belongs to at most one block, so that the position
+   // of a column within its block can be stored in one array
+   std::vector<Index> col_local(n_cols, -1);
+   std::vector<Index> block_cols(n_blocks, 0);
+   for( Index k = 0; k < n_rows; k++ )
+   {
+      Index i = block_rows[k];
+      for( Index p = row_start[i]; p < row_start[i + 1]; p++ )
+      {
+         if( col_local[col[p]] == -1 )
+         {
+            col_local[col[p]] = block_cols[block[i]]++;
+         }
+      }
+   }
+
+   std::vector<std::vector<Index> > block_deps(n_blocks);
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(dynamic, 1) if( n_blocks > 1 )
+#endif
+   for( Index b = 0; b < n_blocks; b++ )
+   {
+      FactorizeBlock(block_start[b + 1] - block_start[b], &block_rows[block_start[b]], block_cols[b], row_start, col,
+                     val, col_local, col_count, block_deps[b]);
+   }
+
+   for( Index b = 0; b < n_blocks; b++ )
+   {
+      c_deps.insert(c_deps.end(), block_deps[b].begin(), block_deps[b].end());
+   }
+   c_deps.sort();
+
+   Jnlst().Printf(J_DETAILED, J_INITIALIZATION,
+                  "LU dependency detector found %" IPOPT_INDEX_FORMAT " dependent rows among %" IPOPT_INDEX_FORMAT " rows in %" IPOPT_INDEX_FORMAT " blocks.\n",
+                  (Index) c_deps.size(), n_rows, n_blocks);
+
+   return true;
+}
+
+void LuTDependencyDetector::FactorizeBlock(
+   Index                      n_block_rows,
+   const Index*               rows,
+   Index                      n_block_cols,
+   const std::vector<Index>&  row_start,
+   const std::vector<Index>&  col,
+   const std::vector<Number>& val,
+   const std::vector<Index>&  col_local,
+   const std::vector<Index>&  col_count,
+   std::vector<Index>&        deps
+) const
+{
+   // Work space for the row that is currently reduced: its values,
+   // the positions of its nonzeros, and a marker for the positions
+   std::vector<Number> work(n_block_cols, 0.);
+   std::vector<Index> pattern;
+   std::vector<bool> in_pattern(n_block_cols, false);
+   // Number of nonzeros in the column of each position
+   std::vector<Index> count(n_block_cols);
+   for( Index k = 0; k < n_block_rows; k++ )
+   {
+      for( Index p = row_start[rows[k]]; p < row_start[rows[k] + 1]; p++ )
+      {
+         count[col_local[col[p]]] = col_count[col[p]];
+      }
+   }
+
+   // The accepted rows after the elimination, with their pivots
+   std::vector<Index> pivot_of_col(n_block_cols, -1);
+   std::vector<Index> pivot_col;
+   std::vector<Number> pivot_val;
+   std::vector<Index> factor_start(1, 0);
+   std::vector<Index> factor_col;
+   std::vector<Number> factor_val;
+
+   // The accepted rows that still have to be used for the elimination
+   // of the current row; they must be used in the order in which they
+   // were accepted, since each of them is zero in the pivot columns of
+   // the rows accepted before.  A row is entered when its pivot column
+   // enters the pattern, and hence only once.
+   std::vector<Index> heap;
+
+   for( Index k = 0; k < n_block_rows; k++ )
+   {
+      Index i = rows[k];
+
+      for( Index p = row_start[i]; p < row_start[i + 1]; p++ )
+      {
+         Index j = col_local[col[p]];
+         if( !in_pattern[j] )
+         {
+            in_pattern[j] = true;
+            pattern.push_back(j);
+         }
+         work[j] += val[p];
+      }
+
+      Number row_max = 0.;
+      for( size_t q = 0; q < pattern.size(); q++ )
+      {
+         Index j = pattern[q];
+         row_max = std::max(row_max, std::abs(work[j]));
+         if( pivot_of_col[j] != -1 )
+         {
+            heap.push_back(pivot_of_col[j]);
+            std::push_heap(heap.begin(), heap.end(), std::greater<Index>());
+         }
+      }
+
+      while( !heap.empty() )
+      {
+         std::pop_heap(heap.begin(), heap.end(), std::greater<Index>());
+         Index f = heap.back();
+         heap.pop_back();
+         Number mult = work[pivot_col[f]] / pivot_val[f];
+         work[pivot_col[f]] = 0.;
+         if( mult == 0. )
+         {
+            continue;
+         }
+         for( Index p = factor_start[f]; p < factor_start[f + 1]; p++ )
+         {
+            Index j = factor_col[p];
+            if( !in_pattern[j] )
+            {
+               in_pattern[j] = true;
+               pattern.push_back(j);
+               if( pivot_of_col[j] != -1 )
+               {
+                  heap.push_back(pivot_of_col[j]);
+                  std::push_heap(heap.begin(), heap.end(), std::greater<Index>());
+               }
+            }
+            work[j] -= mult * factor_val[p];
+         }
+      }
+
+      Number reduced_max = 0.;
+      for( size_t q = 0; q < pattern.size(); q++ )
+      {
+         reduced_max = std::max(reduced_max, std::abs(work[pattern[q]]));
+      }
+
+      if( reduced_max <= dependency_tol_ * row_max )
+      {
+         deps.push_back(i);
+      }
+      else
+      {
+         // choose the pivot among the sufficiently large entries in
+         // the column with the fewest nonzeros
+         Index piv = -1;
+         for( size_t q = 0; q < pattern.size(); q++ )
+         {
+            Index j = pattern[q];
+            Number a = std::abs(work[j]);
+            if( a < pivtol_ * reduced_max )
+            {
+               continue;
+            }
+            if( piv == -1 || count[j] < count[piv] || (count[j] == count[piv] && a > std::abs(work[piv])) )
+            {
+               piv = j;
+            }
+         }
+         DBG_ASSERT(piv != -1 && pivot_of_col[piv] == -1);
+
+         pivot_of_col[piv] = (Index) pivot_col.size();
+         pivot_col.push_back(piv);
+         pivot_val.push_back(work[piv]);
+         for( size_t q = 0; q < pattern.size(); q++ )
+         {
+            Index j = pattern[q];
+            if( j != piv && work[j] != 0. )
+            {
+               factor_col.push_back(j);
+               factor_val.push_back(work[j]);
+            }
+         }
+         factor_start.push_back((Index) factor_col.size());
+      }
+
+      for( size_t q = 0; q < pattern.size(); q++ )
+      {
+         work[pattern[q]] = 0.;
+         in_pattern[pattern[q]] = false;
+      }
+      pattern.clear();
+   }
+}
+
+} // namespace Ipopt
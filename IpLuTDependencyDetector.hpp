@@ -0,0 +1,123 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPLUTDEPENDENCYDETECTOR_HPP__
+#define __IPLUTDEPENDENCYDETECTOR_HPP__
+
+#include "IpTDependencyDetector.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Native detector for linearly dependent rows in the constraint
+ *  Jacobian, based on a sparse LU factorization with threshold
+ *  pivoting.
+ *
+ *  The rows are processed one after the other.  Each row is reduced
+ *  by the rows that have been accepted before, and it is declared
+ *  dependent if the largest entry of the reduced row is not larger
+ *  than lu_dependency_tol times the largest entry of the original
+ *  row.  Otherwise, the row is accepted, with a pivot chosen among
+ *  the entries that are at least lu_dependency_pivtol times the
+ *  largest entry, preferring columns with few nonzeros to limit the
+ *  fill-in.
+ *
+ *  Rows that do not share a column, directly or through other rows,
+ *  are independent of each other.  The matrix is therefore split
+ *  into such blocks, which are factorized in parallel.
+ */
+class LuTDependencyDetector: public TDependencyDetector
+{
+public:
+   /** @name Constructor/Destructor */
+   ///@{
+   LuTDependencyDetector();
+
+   virtual ~LuTDependencyDetector()
+   { }
+   ///@}
+
+   /** Has to be called to initialize and reset these objects. */
+   virtual bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   /** Method determining the number of linearly dependent rows in
+    *  the matrix and the indices of those rows.
+    *
+    *  The matrix is given in "Triplet" format with 1-based indices.
+    *  Entries that appear several times are added.
+    */
+   virtual bool DetermineDependentRows(
+      Index             n_rows,
+      Index             n_cols,
+      Index             n_jac_nz,
+      Number*           jac_c_vals,
+      Index*            jac_c_iRow,
+      Index*            jac_c_jCol,
+      std::list<Index>& c_deps
+   );
+
+   /** This must be called to make the options for this class known */
+   static void RegisterOptions(
+      SmartPtr<RegisteredOptions> roptions
+   );
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Copy Constructor */
+   LuTDependencyDetector(
+      const LuTDependencyDetector&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const LuTDependencyDetector&
+   );
+   ///@}
+
+   /** Determine the dependent rows of one block.
+    *
+    *  The n_block_rows rows of the block are given in rows, and refer
+    *  to the row-wise storage of the matrix in row_start, col, and
+    *  val.  col_local maps a column to its position within the block,
+    *  which has n_block_cols columns, and col_count gives the number
+    *  of nonzeros in each column.  The dependent rows are appended to
+    *  deps.
+    */
+   void FactorizeBlock(
+      Index                      n_block_rows,
+      const Index*               rows,
+      Index                      n_block_cols,
+      const std::vector<Index>&  row_start,
+      const std::vector<Index>&  col,
+      const std::vector<Number>& val,
+      const std::vector<Index>&  col_local,
+      const std::vector<Index>&  col_count,
+      std::vector<Index>&        deps
+   ) const;
+
+   /** @name Algorithmic parameters */
+   ///@{
+   /** Relative pivot tolerance */
+   Number pivtol_;
+
+   /** Relative tolerance below which a reduced row is considered zero */
+   Number dependency_tol_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
@@ -655,6 +655,7 @@ ESymSolverStatus Ma27TSolverInterface::Factorization(
    if( HaveIpData() )
    {
       IpData().TimingStats().LinearSystemFactorization().End();
+      IpData().Set_info_factorization_size((Number) nonzeros_, (Number) INFO[8]);
    }
    if( !skip_inertia_check_ && check_NegEVals && (numberOfNegEVals != negevals_) )
    {
@@ -0,0 +1,206 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpMetricsSink.hpp"
+#include "IpUtils.hpp"
+
+#include <cstring>
+
+namespace Ipopt
+{
+
+void MetricsRecord::AddNumber(
+   const std::string& key,
+   Number             value
+)
+{
+   fields_.push_back(Field());
+   fields_.back().key = key;
+   fields_.back().type = NUMBER_FIELD;
+   fields_.back().number = value;
+}
+
+void MetricsRecord::AddInteger(
+   const std::string& key,
+   Index              value
+)
+{
+   fields_.push_back(Field());
+   fields_.back().key = key;
+   fields_.back().type = INTEGER_FIELD;
+   fields_.back().integer = value;
+}
+
+void MetricsRecord::AddBool(
+   const std::string& key,
+   bool               value
+)
+{
+   fields_.push_back(Field());
+   fields_.back().key = key;
+   fields_.back().type = BOOL_FIELD;
+   fields_.back().integer = value ? 1 : 0;
+}
+
+void MetricsRecord::AddString(
+   const std::string& key,
+   const std::string& value
+)
+{
+   fields_.push_back(Field());
+   fields_.back().key = key;
+   fields_.back().type = STRING_FIELD;
+   fields_.back().string = value;
+}
+
+FileMetricsSink::FileMetricsSink(
+   const std::string& name,
+   size_t             buffer_size
+)
+   : MetricsSink(name),
+     file_(NULL),
+     buffer_size_(buffer_size)
+{
+   buffer_.reserve(buffer_size_ + 1024);
+}
+
+FileMetricsSink::~FileMetricsSink()
+{
+   Flush();
+   if( file_ && file_ != stdout && file_ != stderr )
+   {
+      // close the file
+      fclose(file_);
+   }
+   file_ = NULL;
+}
+
+bool FileMetricsSink::Open(
+   const char* fname,
+   bool        file_append
+)
+{
+   Flush();
+   if( file_ && file_ != stdout && file_ != stderr )
+   {
+      // file already opened, close it
+      fclose(file_);
+   }
+   file_ = NULL;
+
+   if( strcmp("stdout", fname) == 0 )
+   {
+      file_ = stdout;
+   }
+   else if( strcmp("stderr", fname) == 0 )
+   {
+      file_ = stderr;
+   }
+   else
+   {
+      file_ = fopen(fname, file_append ? "a" : "w");
+   }
+
+   return file_ != NULL;
+}
+
+void FileMetricsSink::AppendJsonString(
+   const std::string& str
+)
+{
+   buffer_ += '"';
+   for( size_t i = 0; i < str.size(); i++ )
+   {
+      char c = str[i];
+      if( c == '"' || c == '\\' )
+      {
+         buffer_ += '\\';
+         buffer_ += c;
+      }
+      else if( (unsigned char) c < 0x20 )
+      {
+         char buf[8];
+         Snprintf(buf, sizeof(buf), "\\u%04x", (unsigned int) c);
+         buffer_ += buf;
+      }
+      else
+      {
+         buffer_ += c;
+      }
+   }
+   buffer_ += '"';
+}
+
+void FileMetricsSink::Write(
+   const MetricsRecord& record
+)
+{
+   if( file_ == NULL )
+   {
+      return;
+   }
+
+   const std::vector<MetricsRecord::Field>& fields = record.Fields();
+   char buf[32];
+   buffer_ += '{';
+   for( size_t i = 0; i < fields.size(); i++ )
+   {
+      const MetricsRecord::Field& field = fields[i];
+      if( i > 0 )
+      {
+         buffer_ += ',';
+      }
+      AppendJsonString(field.key);
+      buffer_ += ':';
+      switch( field.type )
+      {
+         case MetricsRecord::NUMBER_FIELD:
+            // JSON has no representation of inf and nan
+            if( IsFiniteNumber(field.number) )
+            {
+               Snprintf(buf, sizeof(buf), "%.10g", field.number);
+               buffer_ += buf;
+            }
+            else
+            {
+               buffer_ += "null";
+            }
+            break;
+         case MetricsRecord::INTEGER_FIELD:
+            Snprintf(buf, sizeof(buf), "%" IPOPT_INDEX_FORMAT, field.integer);
+            buffer_ += buf;
+            break;
+         case MetricsRecord::BOOL_FIELD:
+            buffer_ += field.integer ? "true" : "false";
+            break;
+         case MetricsRecord::STRING_FIELD:
+            AppendJsonString(field.string);
+            break;
+      }
+   }
+   buffer_ += "}\n";
+
+   if( buffer_.size() >= buffer_size_ )
+   {
+      fwrite(buffer_.data(), 1, buffer_.size(), file_);
+      buffer_.clear();
+   }
+}
+
+void FileMetricsSink::Flush()
+{
+   if( file_ == NULL )
+   {
+      buffer_.clear();
+      return;
+   }
+   if( !buffer_.empty() )
+   {
+      fwrite(buffer_.data(), 1, buffer_.size(), file_);
+      buffer_.clear();
+   }
+   fflush(file_);
+}
+
+} // namespace Ipopt
@@ -0,0 +1,238 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPMETRICSSINK_HPP__
+#define __IPMETRICSSINK_HPP__
+
+#include "IpTypes.hpp"
+#include "IpReferenced.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Ipopt
+{
+
+/** A record of named values, e.g., the quantities of one iteration.
+ *
+ *  The fields are kept in the order in which they were added.  Keys of
+ *  grouped values, like the times of the timed tasks, are composed with
+ *  a dot, e.g., "time.LinearSystemFactorization".
+ */
+class IPOPTLIB_EXPORT MetricsRecord
+{
+public:
+   /** Type of the value of a field */
+   enum FieldType
+   {
+      NUMBER_FIELD = 0,
+      INTEGER_FIELD,
+      BOOL_FIELD,
+      STRING_FIELD
+   };
+
+   /** A named value */
+   struct Field
+   {
+      std::string key;
+      FieldType type;
+      Number number;
+      Index integer;
+      std::string string;
+   };
+
+   /** Constructor.
+    *
+    *  @param type kind of the record, stored in the field "type"
+    */
+   MetricsRecord(
+      const std::string& type
+   )
+   {
+      AddString("type", type);
+   }
+
+   /** @name Methods to add fields */
+   ///@{
+   void AddNumber(
+      const std::string& key,
+      Number             value
+   );
+
+   void AddInteger(
+      const std::string& key,
+      Index              value
+   );
+
+   void AddBool(
+      const std::string& key,
+      bool               value
+   );
+
+   void AddString(
+      const std::string& key,
+      const std::string& value
+   );
+   ///@}
+
+   /** The fields of the record */
+   const std::vector<Field>& Fields() const
+   {
+      return fields_;
+   }
+
+private:
+   std::vector<Field> fields_;
+};
+
+/** Base class for receivers of metrics records.
+ *
+ *  Metrics sinks are added to the Journalist like Journals.  Solver
+ *  components send structured records, e.g., one per iteration, to all
+ *  sinks of the Journalist, so that monitoring does not need to parse
+ *  the text output.
+ */
+class IPOPTLIB_EXPORT MetricsSink: public ReferencedObject
+{
+public:
+   /** Constructor. */
+   MetricsSink(
+      const std::string& name
+   )
+      : name_(name)
+   { }
+
+   /** Destructor. */
+   virtual ~MetricsSink()
+   { }
+
+   /** Get the name of the sink */
+   const std::string& Name() const
+   {
+      return name_;
+   }
+
+   /** Receive a record */
+   virtual void Write(
+      const MetricsRecord& record
+   ) = 0;
+
+   /** Pass buffered records on */
+   virtual void Flush()
+   { }
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default Constructor */
+   MetricsSink();
+
+   /** Copy Constructor */
+   MetricsSink(
+      const MetricsSink&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const MetricsSink&
+   );
+   ///@}
+
+   /** Name of the sink */
+   std::string name_;
+};
+
+/** MetricsSink that writes the records to a file in the NDJSON format,
+ *  i.e., one JSON object per line.
+ *
+ *  The formatted records are collected in a buffer, which is written to
+ *  the file only when it is full or when the sink is flushed, so that
+ *  the solver does not wait for the file system in every iteration.
+ */
+class IPOPTLIB_EXPORT FileMetricsSink: public MetricsSink
+{
+public:
+   /** Constructor.
+    *
+    *  @param name        name of the sink
+    *  @param buffer_size number of bytes that are collected before they
+    *                     are written to the file
+    */
+   FileMetricsSink(
+      const std::string& name,
+      size_t             buffer_size = 65536
+   );
+
+   /** Destructor; writes the buffer and closes the file */
+   virtual ~FileMetricsSink();
+
+   /** Open the output file.
+    *
+    *  @param fname       name of the file; "stdout" and "stderr" are
+    *                     the standard streams
+    *  @param file_append whether to append to the file instead of
+    *                     truncating it
+    *
+    *  @return false, if the file could not be opened
+    */
+   bool Open(
+      const char* fname,
+      bool        file_append = false
+   );
+
+   virtual void Write(
+      const MetricsRecord& record
+   );
+
+   virtual void Flush();
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   FileMetricsSink(
+      const FileMetricsSink&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const FileMetricsSink&
+   );
+   ///@}
+
+   /** Append a string as JSON string literal to the buffer */
+   void AppendJsonString(
+      const std::string& str
+   );
+
+   /** The output file */
+   FILE* file_;
+
+   /** Formatted records that have not been written yet */
+   std::string buffer_;
+
+   /** Size of the buffer at which it is written to the file */
+   size_t buffer_size_;
+};
+
+} // namespace Ipopt
+
+#endif
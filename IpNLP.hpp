@@ -16,6 +16,8 @@
 #include "IpAlgTypes.hpp"
 #include "IpReturnCodes.hpp"
 
+#include <vector>
+
 namespace Ipopt
 {
 // forward declarations
@@ -171,6 +173,52 @@ public:
    ) = 0;
    ///@}
 
+   /** @name Evaluation at several points in concurrent threads */
+   ///@{
+   /** Query whether Eval_f_c_d_Concurrent and
+    *  Eval_grad_f_jac_c_jac_d_Concurrent are implemented.
+    */
+   virtual bool ProvidesConcurrentEvaluation() const
+   {
+      return false;
+   }
+
+   /** Evaluate the objective function and the equality and inequality
+    *  constraints at several points.
+    *
+    *  The values at x[i] are returned in f[i], c[i], and d[i], which
+    *  have been created by the caller, and success[i] is set to false
+    *  if an evaluation at x[i] failed.  An implementation may evaluate
+    *  the points in concurrent threads.
+    */
+   virtual void Eval_f_c_d_Concurrent(
+      const std::vector<SmartPtr<const Vector> >& /*x*/,
+      std::vector<Number>&                        /*f*/,
+      std::vector<SmartPtr<Vector> >&             /*c*/,
+      std::vector<SmartPtr<Vector> >&             /*d*/,
+      std::vector<bool>&                          /*success*/
+   )
+   { }
+
+   /** Evaluate the gradient of the objective function and the
+    *  Jacobians of the equality and inequality constraints at several
+    *  points.
+    *
+    *  The values at x[i] are returned in grad_f[i], jac_c[i], and
+    *  jac_d[i], which have been created by the caller, and success[i]
+    *  is set to false if an evaluation at x[i] failed.  An
+    *  implementation may evaluate the points in concurrent threads.
+    */
+   virtual void Eval_grad_f_jac_c_jac_d_Concurrent(
+      const std::vector<SmartPtr<const Vector> >& /*x*/,
+      std::vector<SmartPtr<Vector> >&             /*grad_f*/,
+      std::vector<SmartPtr<Matrix> >&             /*jac_c*/,
+      std::vector<SmartPtr<Matrix> >&             /*jac_d*/,
+      std::vector<bool>&                          /*success*/
+   )
+   { }
+   ///@}
+
    /** @name NLP solution routines.
     * Have default dummy implementations that can be overloaded.
     */
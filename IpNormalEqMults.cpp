@@ -0,0 +1,416 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpNormalEqMults.hpp"
+
+#include <cmath>
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** Minimal number of Jacobian nonzeros for which the products with
+ *  the Jacobian are computed in parallel.
+ */
+static const Index min_parallel_normal_eq_entries = 50000;
+
+NormalEqMultipliers::NormalEqMultipliers(
+   const SmartPtr<EqMultiplierCalculator>& fallback
+)
+   : EqMultiplierCalculator(),
+     fallback_(fallback),
+     max_iter_(1000),
+     tol_(1e-12),
+     m_c_(-1),
+     m_d_(-1),
+     n_x_(-1)
+{ }
+
+void NormalEqMultipliers::RegisterOptions(
+   SmartPtr<RegisteredOptions> roptions
+)
+{
+   roptions->AddLowerBoundedIntegerOption(
+      "normal_eq_mults_max_iter",
+      "Maximal number of conjugate gradient iterations for the least-square multipliers.",
+      1,
+      1000,
+      "Only used if \"least_square_mults_method\" is \"normal-equations\". "
+      "If the tolerance is not reached within this number of iterations, the multipliers are computed from the "
+      "augmented system instead.",
+      true);
+   roptions->AddLowerBoundedNumberOption(
+      "normal_eq_mults_tol",
+      "Relative tolerance for the conjugate gradient solution of the normal equations for the least-square multipliers.",
+      0., true,
+      1e-12,
+      "Only used if \"least_square_mults_method\" is \"normal-equations\". "
+      "The conjugate gradient method stops when the norm of the residual of the normal equations has been reduced by "
+      "this factor.",
+      true);
+}
+
+bool NormalEqMultipliers::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   options.GetIntegerValue("normal_eq_mults_max_iter", max_iter_, prefix);
+   options.GetNumericValue("normal_eq_mults_tol", tol_, prefix);
+
+   // the structure of the Jacobians might be different in a new
+   // optimization run
+   jac_c_space_ = NULL;
+   jac_d_space_ = NULL;
+
+   if( IsValid(fallback_) )
+   {
+      return fallback_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix);
+   }
+   return true;
+}
+
+void NormalEqMultipliers::InitializeStructure(
+   const Matrix& J_c,
+   const Matrix& J_d
+)
+{
+   DBG_START_METH("NormalEqMultipliers::InitializeStructure",
+                  dbg_verbosity);
+   DBG_ASSERT(J_c.NCols() == J_d.NCols());
+
+   jac_c_space_ = J_c.OwnerSpace();
+   jac_d_space_ = J_d.OwnerSpace();
+   m_c_ = J_c.NRows();
+   m_d_ = J_d.NRows();
+   n_x_ = J_c.NCols();
+   Index m = m_c_ + m_d_;
+
+   jac_c_fill_plan_ = new TripletFillPlan();
+   jac_c_fill_plan_->Initialize(J_c);
+   jac_d_fill_plan_ = new TripletFillPlan();
+   jac_d_fill_plan_->Initialize(J_d);
+   Index nnz_c = jac_c_fill_plan_->NumberEntries();
+   Index nnz = nnz_c + jac_d_fill_plan_->NumberEntries();
+
+   // Triplet structure of the stacked Jacobian, with 1-based indices
+   std::vector<Index> irow(nnz);
+   std::vector<Index> jcol(nnz);
+   if( nnz_c > 0 )
+   {
+      jac_c_fill_plan_->FillRowCol(J_c, &irow[0], &jcol[0]);
+   }
+   if( nnz > nnz_c )
+   {
+      jac_d_fill_plan_->FillRowCol(J_d, &irow[nnz_c], &jcol[nnz_c]);
+   }
+   for( Index k = nnz_c; k < nnz; k++ )
+   {
+      irow[k] += m_c_;
+   }
+
+   // Sort the entries by row
+   std::vector<Index> entry_start(m + 1, 0);
+   for( Index k = 0; k < nnz; k++ )
+   {
+      DBG_ASSERT(irow[k] >= 1 && irow[k] <= m);
+      DBG_ASSERT(jcol[k] >= 1 && jcol[k] <= n_x_);
+      entry_start[irow[k]]++;
+   }
+   for( Index i = 0; i < m; i++ )
+   {
+      entry_start[i + 1] += entry_start[i];
+   }
+   std::vector<Index> row_entry(nnz);
+   {
+      std::vector<Index> pos(entry_start.begin(), entry_start.end() - 1);
+      for( Index k = 0; k < nnz; k++ )
+      {
+         row_entry[pos[irow[k] - 1]++] = k;
+      }
+   }
+
+   // Merge the entries with the same position into one slot, so that
+   // the slots are numbered row by row
+   slot_of_entry_.resize(nnz);
+   row_start_.assign(m + 1, 0);
+   row_col_.clear();
+   std::vector<Index> slot_in_col(n_x_, -1);
+   for( Index i = 0; i < m; i++ )
+   {
+      row_start_[i] = (Index) row_col_.size();
+      for( Index p = entry_start[i]; p < entry_start[i + 1]; p++ )
+      {
+         Index k = row_entry[p];
+         Index j = jcol[k] - 1;
+         if( slot_in_col[j] < row_start_[i] )
+         {
+            slot_in_col[j] = (Index) row_col_.size();
+            row_col_.push_back(j);
+         }
+         slot_of_entry_[k] = slot_in_col[j];
+      }
+   }
+   Index nslots = (Index) row_col_.size();
+   row_start_[m] = nslots;
+
+   // Store the slots also column-wise
+   col_start_.assign(n_x_ + 1, 0);
+   for( Index s = 0; s < nslots; s++ )
+   {
+      col_start_[row_col_[s] + 1]++;
+   }
+   for( Index j = 0; j < n_x_; j++ )
+   {
+      col_start_[j + 1] += col_start_[j];
+   }
+   col_slot_.resize(nslots);
+   col_row_.resize(nslots);
+   {
+      std::vector<Index> pos(col_start_.begin(), col_start_.end() - 1);
+      for( Index i = 0; i < m; i++ )
+      {
+         for( Index s = row_start_[i]; s < row_start_[i + 1]; s++ )
+         {
+            Index p = pos[row_col_[s]]++;
+            col_slot_[p] = s;
+            col_row_[p] = i;
+         }
+      }
+   }
+
+   entry_val_.resize(nnz);
+   slot_val_.resize(nslots);
+}
+
+bool NormalEqMultipliers::CalculateMultipliers(
+   Vector& y_c,
+   Vector& y_d
+)
+{
+   DBG_START_METH("NormalEqMultipliers::CalculateMultipliers",
+                  dbg_verbosity);
+
+   SmartPtr<const Matrix> J_c = IpCq().curr_jac_c();
+   SmartPtr<const Matrix> J_d = IpCq().curr_jac_d();
+   SmartPtr<const Vector> grad_f = IpCq().curr_grad_f();
+   SmartPtr<const Vector> z_L = IpData().curr()->z_L();
+   SmartPtr<const Vector> z_U = IpData().curr()->z_U();
+   SmartPtr<const Vector> v_L = IpData().curr()->v_L();
+   SmartPtr<const Vector> v_U = IpData().curr()->v_U();
+
+   // Compute the right hand side, as for the augmented system
+   SmartPtr<Vector> rhs_x = grad_f->MakeNew();
+   rhs_x->Copy(*grad_f);
+   IpNLP().Px_L()->MultVector(1., *z_L, -1., *rhs_x);
+   IpNLP().Px_U()->MultVector(-1., *z_U, 1., *rhs_x);
+
+   SmartPtr<Vector> rhs_s = IpData().curr()->s()->MakeNew();
+   IpNLP().Pd_L()->MultVector(1., *v_L, 0., *rhs_s);
+   IpNLP().Pd_U()->MultVector(-1., *v_U, 1., *rhs_s);
+
+   if( GetRawPtr(J_c->OwnerSpace()) != GetRawPtr(jac_c_space_)
+       || GetRawPtr(J_d->OwnerSpace()) != GetRawPtr(jac_d_space_) )
+   {
+      InitializeStructure(*J_c, *J_d);
+   }
+
+   // Current values of the stacked Jacobian
+   Index nnz_c = jac_c_fill_plan_->NumberEntries();
+   Index nnz = (Index) entry_val_.size();
+   if( nnz_c > 0 )
+   {
+      jac_c_fill_plan_->FillValues(*J_c, &entry_val_[0]);
+   }
+   if( nnz > nnz_c )
+   {
+      jac_d_fill_plan_->FillValues(*J_d, &entry_val_[nnz_c]);
+   }
+   Index nslots = (Index) slot_val_.size();
+   for( Index s = 0; s < nslots; s++ )
+   {
+      slot_val_[s] = 0.;
+   }
+   for( Index k = 0; k < nnz; k++ )
+   {
+      slot_val_[slot_of_entry_[k]] += entry_val_[k];
+   }
+
+   std::vector<Number> rhs_x_vals(n_x_);
+   std::vector<Number> rhs_s_vals(m_d_);
+   TripletHelper::FillValuesFromVector(n_x_, *rhs_x, n_x_ > 0 ? &rhs_x_vals[0] : NULL);
+   TripletHelper::FillValuesFromVector(m_d_, *rhs_s, m_d_ > 0 ? &rhs_s_vals[0] : NULL);
+
+   std::vector<Number> y(m_c_ + m_d_);
+   if( !SolveNormalEquations(n_x_ > 0 ? &rhs_x_vals[0] : NULL, m_d_ > 0 ? &rhs_s_vals[0] : NULL, y) )
+   {
+      if( IsValid(fallback_) )
+      {
+         Jnlst().Printf(J_DETAILED, J_INITIALIZATION,
+                        "Normal equations for least-square multipliers not solved, using fallback.\n");
+         return fallback_->CalculateMultipliers(y_c, y_d);
+      }
+      return false;
+   }
+
+   TripletHelper::PutValuesInVector(m_c_, m_c_ > 0 ? &y[0] : NULL, y_c);
+   TripletHelper::PutValuesInVector(m_d_, m_d_ > 0 ? &y[m_c_] : NULL, y_d);
+
+   DBG_PRINT_VECTOR(2, "sol_c", y_c);
+   DBG_PRINT_VECTOR(2, "sol_d", y_d);
+
+   return true;
+}
+
+void NormalEqMultipliers::ApplyNormalMatrix(
+   const std::vector<Number>& p,
+   std::vector<Number>&       t,
+   std::vector<Number>&       q
+) const
+{
+   Index m = m_c_ + m_d_;
+#ifdef _OPENMP
+   Index nslots = (Index) slot_val_.size();
+#endif
+
+   // t = J^T p, one column per thread
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(static) if( nslots >= min_parallel_normal_eq_entries )
+#endif
+   for( Index j = 0; j < n_x_; j++ )
+   {
+      Number sum = 0.;
+      for( Index p_col = col_start_[j]; p_col < col_start_[j + 1]; p_col++ )
+      {
+         sum += slot_val_[col_slot_[p_col]] * p[col_row_[p_col]];
+      }
+      t[j] = sum;
+   }
+
+   // q = J t, one row per thread; the -I block for the slacks adds p
+   // to the rows of J_d
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(static) if( nslots >= min_parallel_normal_eq_entries )
+#endif
+   for( Index i = 0; i < m; i++ )
+   {
+      Number sum = 0.;
+      for( Index s = row_start_[i]; s < row_start_[i + 1]; s++ )
+      {
+         sum += slot_val_[s] * t[row_col_[s]];
+      }
+      q[i] = (i < m_c_) ? sum : sum + p[i];
+   }
+}
+
+bool NormalEqMultipliers::SolveNormalEquations(
+   const Number*        rhs_x,
+   const Number*        rhs_s,
+   std::vector<Number>& y
+)
+{
+   DBG_START_METH("NormalEqMultipliers::SolveNormalEquations",
+                  dbg_verbosity);
+
+   Index m = m_c_ + m_d_;
+
+   // Right hand side A r and the inverse of the diagonal of A A^T
+   std::vector<Number> r(m);
+   std::vector<Number> precond(m);
+   for( Index i = 0; i < m; i++ )
+   {
+      Number sum = 0.;
+      Number diag = 0.;
+      for( Index s = row_start_[i]; s < row_start_[i + 1]; s++ )
+      {
+         sum += slot_val_[s] * rhs_x[row_col_[s]];
+         diag += slot_val_[s] * slot_val_[s];
+      }
+      if( i >= m_c_ )
+      {
+         sum -= rhs_s[i - m_c_];
+         diag += 1.;
+      }
+      r[i] = sum;
+      // rows of J_c without nonzeros do not take part
+      precond[i] = (diag > 0.) ? 1. / diag : 0.;
+   }
+
+   for( Index i = 0; i < m; i++ )
+   {
+      y[i] = 0.;
+   }
+
+   // Preconditioned conjugate gradient method, starting from zero
+   std::vector<Number> z(m);
+   std::vector<Number> p(m);
+   std::vector<Number> q(m);
+   std::vector<Number> t(n_x_);
+   Number rz = 0.;
+   Number rnrm0 = 0.;
+   for( Index i = 0; i < m; i++ )
+   {
+      z[i] = precond[i] * r[i];
+      p[i] = z[i];
+      rz += r[i] * z[i];
+      rnrm0 += r[i] * r[i];
+   }
+   rnrm0 = std::sqrt(rnrm0);
+
+   Number rnrm = rnrm0;
+   Index iter = 0;
+   while( rnrm > tol_ * rnrm0 )
+   {
+      if( iter == max_iter_ )
+      {
+         Jnlst().Printf(J_MOREDETAILED, J_INITIALIZATION,
+                        "Normal equations: no convergence after %" IPOPT_INDEX_FORMAT " CG iterations, relative residual %e\n",
+                        iter, rnrm / rnrm0);
+         return false;
+      }
+      iter++;
+
+      ApplyNormalMatrix(p, t, q);
+      Number pq = 0.;
+      for( Index i = 0; i < m; i++ )
+      {
+         pq += p[i] * q[i];
+      }
+      if( !(pq > 0.) )
+      {
+         // A A^T is singular in the direction p
+         return false;
+      }
+
+      Number alpha = rz / pq;
+      Number rz_new = 0.;
+      rnrm = 0.;
+      for( Index i = 0; i < m; i++ )
+      {
+         y[i] += alpha * p[i];
+         r[i] -= alpha * q[i];
+         z[i] = precond[i] * r[i];
+         rz_new += r[i] * z[i];
+         rnrm += r[i] * r[i];
+      }
+      rnrm = std::sqrt(rnrm);
+
+      Number beta = rz_new / rz;
+      rz = rz_new;
+      for( Index i = 0; i < m; i++ )
+      {
+         p[i] = z[i] + beta * p[i];
+      }
+   }
+
+   Jnlst().Printf(J_MOREDETAILED, J_INITIALIZATION,
+                  "Normal equations: %" IPOPT_INDEX_FORMAT " CG iterations, relative residual %e\n", iter,
+                  rnrm0 > 0. ? rnrm / rnrm0 : 0.);
+
+   return true;
+}
+
+} // namespace Ipopt
@@ -0,0 +1,182 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPNORMALEQMULTS_HPP__
+#define __IPNORMALEQMULTS_HPP__
+
+#include "IpEqMultCalculator.hpp"
+#include "IpTripletHelper.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Class for calculator for the least-square equality constraint
+ *  multipliers that works on the constraint Jacobian alone.
+ *
+ *  With A = [J_c 0; J_d -I] and r the part of the gradient of the
+ *  Lagrangian that does not depend on y_c and y_d, the least-square
+ *  estimates are the solution of the normal equations
+ *  (A A^T) y = A r.  These are solved by the conjugate gradient
+ *  method with a Jacobi preconditioner, applying A and A^T through a
+ *  row-wise and a column-wise copy of the Jacobians.  Thus, no
+ *  augmented system is assembled, analyzed, or factorized.
+ *
+ *  If the conjugate gradient method does not converge, the
+ *  calculation is passed on to the fallback calculator, if one has
+ *  been given.
+ */
+class NormalEqMultipliers: public EqMultiplierCalculator
+{
+public:
+   /**@name Constructors / Destructors */
+   ///@{
+   /** Constructor.
+    *
+    *  The fallback calculator is used if the normal equations could
+    *  not be solved; it may be NULL.
+    */
+   NormalEqMultipliers(
+      const SmartPtr<EqMultiplierCalculator>& fallback
+   );
+
+   /** Destructor */
+   virtual ~NormalEqMultipliers()
+   { }
+   ///@}
+
+   virtual bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   /** This method computes the least-square estimates for y_c and
+    *  y_d at the current point.
+    *
+    *  @return false, if the normal equations could not be solved and
+    *  the fallback calculator failed or is not given
+    */
+   virtual bool CalculateMultipliers(
+      Vector& y_c,
+      Vector& y_d
+   );
+
+   /** This must be called to make the options for this class known */
+   static void RegisterOptions(
+      SmartPtr<RegisteredOptions> roptions
+   );
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Default Constructor */
+   NormalEqMultipliers();
+
+   /** Copy Constructor */
+   NormalEqMultipliers(
+      const NormalEqMultipliers&
+   );
+
+   void operator=(
+      const NormalEqMultipliers&
+   );
+   ///@}
+
+   /** Set up the row-wise and column-wise storage of the stacked
+    *  Jacobian [J_c; J_d], in which entries that appear several times
+    *  in the triplet format are merged into one.
+    */
+   void InitializeStructure(
+      const Matrix& J_c,
+      const Matrix& J_d
+   );
+
+   /** Solve the normal equations with the current values of the
+    *  stacked Jacobian in slot_val_.
+    *
+    *  rhs_x and rhs_s are the x and s parts of r, and the solution is
+    *  returned in y.
+    *
+    *  @return false, if the conjugate gradient method did not converge
+    */
+   bool SolveNormalEquations(
+      const Number*        rhs_x,
+      const Number*        rhs_s,
+      std::vector<Number>& y
+   );
+
+   /** Compute q = A A^T p, using t as work space for A^T p */
+   void ApplyNormalMatrix(
+      const std::vector<Number>& p,
+      std::vector<Number>&       t,
+      std::vector<Number>&       q
+   ) const;
+
+   /** Calculator used if the normal equations could not be solved */
+   SmartPtr<EqMultiplierCalculator> fallback_;
+
+   /** @name Algorithmic parameters */
+   ///@{
+   /** Maximal number of conjugate gradient iterations */
+   Index max_iter_;
+
+   /** Relative tolerance for the residual of the normal equations */
+   Number tol_;
+   ///@}
+
+   /** @name Storage of the stacked Jacobian
+    *
+    *  Every distinct position in [J_c; J_d] is a slot.  The slots
+    *  are numbered row by row.
+    */
+   ///@{
+   /** Space of J_c for which the structure has been set up */
+   SmartPtr<const MatrixSpace> jac_c_space_;
+   /** Space of J_d for which the structure has been set up */
+   SmartPtr<const MatrixSpace> jac_d_space_;
+   /** Plan for obtaining the triplet entries of J_c */
+   SmartPtr<TripletFillPlan> jac_c_fill_plan_;
+   /** Plan for obtaining the triplet entries of J_d */
+   SmartPtr<TripletFillPlan> jac_d_fill_plan_;
+   /** Number of rows of J_c */
+   Index m_c_;
+   /** Number of rows of J_d */
+   Index m_d_;
+   /** Number of columns of the Jacobians */
+   Index n_x_;
+   /** Slot of every triplet entry of J_c, followed by those of J_d */
+   std::vector<Index> slot_of_entry_;
+   /** Start of the slots of every row */
+   std::vector<Index> row_start_;
+   /** Column of every slot */
+   std::vector<Index> row_col_;
+   /** Start of every column in col_slot_ and col_row_ */
+   std::vector<Index> col_start_;
+   /** Slots in every column */
+   std::vector<Index> col_slot_;
+   /** Rows of the slots in every column */
+   std::vector<Index> col_row_;
+   ///@}
+
+   /** @name Work space */
+   ///@{
+   /** Values of the triplet entries of J_c, followed by those of J_d */
+   std::vector<Number> entry_val_;
+   /** Values of the slots */
+   std::vector<Number> slot_val_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
@@ -113,6 +113,26 @@ void OrigIpoptNLP::RegisterOptions(
       false,
       "Activating this option will cause Ipopt to ask for the Hessian of the Lagrangian function "
       "only once from the NLP and reuse this information later.");
+   roptions->AddLowerBoundedIntegerOption(
+      "function_cache_size",
+      "Number of points for which the values of the objective and constraint functions are kept.",
+      1,
+      8,
+      "The function values at a point are looked up in this cache before the NLP is asked to evaluate them, "
+      "so that points to which the line search returns (e.g., after a watchdog phase or a rejected soft restoration step) "
+      "are not evaluated again. "
+      "At least \"concurrent_trial_points\" values are kept.",
+      true);
+   roptions->AddLowerBoundedIntegerOption(
+      "derivative_cache_size",
+      "Number of points for which the objective gradient and the constraint Jacobians are kept.",
+      1,
+      4,
+      "The first derivatives at a point are looked up in this cache before the NLP is asked to evaluate them. "
+      "The default keeps the derivatives at the iterate from which a watchdog phase with at most "
+      "\"watchdog_trial_iter_max\" = 3 trial iterations was started. "
+      "Each additional entry requires the memory of one gradient and one copy of the constraint Jacobians.",
+      true);
    roptions->SetRegisteringCategory("Hessian Approximation");
    roptions->AddStringOption2(
       "hessian_approximation",
@@ -152,6 +172,9 @@ bool OrigIpoptNLP::Initialize(
    options.GetBoolValue("jac_c_constant", jac_c_constant_, prefix);
    options.GetBoolValue("jac_d_constant", jac_d_constant_, prefix);
    options.GetBoolValue("hessian_constant", hessian_constant_, prefix);
+   options.GetIntegerValue("concurrent_trial_points", concurrent_trial_points_, prefix);
+   options.GetIntegerValue("function_cache_size", function_cache_size_, prefix);
+   options.GetIntegerValue("derivative_cache_size", derivative_cache_size_, prefix);
 
    // Reset the function evaluation counters (for warm start)
    f_evals_ = 0;
@@ -161,15 +184,32 @@ bool OrigIpoptNLP::Initialize(
    d_evals_ = 0;
    jac_d_evals_ = 0;
    h_evals_ = 0;
+   f_cache_hits_ = 0;
+   grad_f_cache_hits_ = 0;
+   c_cache_hits_ = 0;
+   jac_c_cache_hits_ = 0;
+   d_cache_hits_ = 0;
+   jac_d_cache_hits_ = 0;
+
+   prefetched_f_.clear();
+   prefetched_c_.clear();
+   prefetched_d_.clear();
+
+   // Reset the caches of the function values and first derivatives.
+   // This is also done for a warm start with the same structure, so
+   // that changes of the cache sizes take effect.
+   // The caches for f, c, and d keep the values for at least all
+   // trial points that the line search evaluates concurrently.
+   Index function_cache_size = Max(function_cache_size_, concurrent_trial_points_);
+   f_cache_.Clear(function_cache_size);
+   grad_f_cache_.Clear(derivative_cache_size_);
+   c_cache_.Clear(function_cache_size);
+   jac_c_cache_.Clear(derivative_cache_size_);
+   d_cache_.Clear(function_cache_size);
+   jac_d_cache_.Clear(derivative_cache_size_);
 
    if( !warm_start_same_structure_ )
    {
-      // Reset all caches.
-      grad_f_cache_.Clear();
-      c_cache_.Clear();
-      jac_c_cache_.Clear();
-      d_cache_.Clear();
-      jac_d_cache_.Clear();
       // If the hessian is constant, we want two hessians to be
       // cached, one for regular iterations and one for restoration
       // phase
@@ -500,6 +540,10 @@ Number OrigIpoptNLP::f(
       ret = NLP_scaling()->apply_obj_scaling(ret);
       f_cache_.AddCachedResult1Dep(ret, &x);
    }
+   else if( !TakePrefetched(prefetched_f_, x) )
+   {
+      f_cache_hits_++;
+   }
 
    return ret;
 }
@@ -538,6 +582,10 @@ SmartPtr<const Vector> OrigIpoptNLP::grad_f(
       retValue = NLP_scaling()->apply_grad_obj_scaling(ConstPtr(unscaled_grad_f));
       grad_f_cache_.AddCachedResult1Dep(retValue, dep);
    }
+   else
+   {
+      grad_f_cache_hits_++;
+   }
 
    return retValue;
 }
@@ -551,6 +599,83 @@ SmartPtr<const Vector> OrigIpoptNLP::grad_f(
    return NULL;
 }
 
+void OrigIpoptNLP::EvaluateConcurrently(
+   const std::vector<SmartPtr<const Vector> >& x
+)
+{
+   DBG_START_METH("OrigIpoptNLP::EvaluateConcurrently", dbg_verbosity);
+
+   Index npoints = (Index) x.size();
+   std::vector<SmartPtr<const Vector> > unscaled_x(npoints);
+   std::vector<Number> unscaled_f(npoints);
+   std::vector<SmartPtr<Vector> > unscaled_c(npoints);
+   std::vector<SmartPtr<Vector> > unscaled_d(npoints);
+   std::vector<bool> success(npoints);
+   // Values of an earlier step that were never looked up are not counted anymore
+   prefetched_f_.clear();
+   prefetched_c_.clear();
+   prefetched_d_.clear();
+   for( Index i = 0; i < npoints; i++ )
+   {
+      unscaled_x[i] = get_unscaled_x(*x[i]);
+      unscaled_c[i] = c_space_->MakeNew();
+      unscaled_d[i] = d_space_->MakeNew();
+   }
+
+   f_evals_ += npoints;
+   if( c_space_->Dim() > 0 )
+   {
+      c_evals_ += npoints;
+   }
+   if( d_space_->Dim() > 0 )
+   {
+      d_evals_ += npoints;
+   }
+   // The time for the concurrent evaluations is accounted to the
+   // objective function, since the share of each function is unknown
+   timing_statistics_.f_eval_time().Start();
+   nlp_->Eval_f_c_d_Concurrent(unscaled_x, unscaled_f, unscaled_c, unscaled_d, success);
+   timing_statistics_.f_eval_time().End();
+
+   for( Index i = 0; i < npoints; i++ )
+   {
+      if( !success[i] || !IsFiniteNumber(unscaled_f[i]) || !IsFiniteNumber(unscaled_c[i]->Nrm2())
+          || !IsFiniteNumber(unscaled_d[i]->Nrm2()) )
+      {
+         DBG_PRINT((1, "evaluation at point %" IPOPT_INDEX_FORMAT " failed\n", i));
+         continue;
+      }
+      f_cache_.AddCachedResult1Dep(NLP_scaling()->apply_obj_scaling(unscaled_f[i]), GetRawPtr(x[i]));
+      prefetched_f_.push_back(x[i]->GetTag());
+      if( c_space_->Dim() > 0 )
+      {
+         c_cache_.AddCachedResult1Dep(NLP_scaling()->apply_vector_scaling_c(ConstPtr(unscaled_c[i])), *x[i]);
+         prefetched_c_.push_back(x[i]->GetTag());
+      }
+      if( d_space_->Dim() > 0 )
+      {
+         d_cache_.AddCachedResult1Dep(NLP_scaling()->apply_vector_scaling_d(ConstPtr(unscaled_d[i])), *x[i]);
+         prefetched_d_.push_back(x[i]->GetTag());
+      }
+   }
+}
+
+bool OrigIpoptNLP::TakePrefetched(
+   std::vector<TaggedObject::Tag>& prefetched,
+   const Vector&                   x
+)
+{
+   for( size_t i = 0; i < prefetched.size(); i++ )
+   {
+      if( prefetched[i] == x.GetTag() )
+      {
+         prefetched.erase(prefetched.begin() + i);
+         return true;
+      }
+   }
+   return false;
+}
+
 SmartPtr<const Vector> OrigIpoptNLP::c(
    const Vector& x
 )
@@ -591,6 +716,10 @@ SmartPtr<const Vector> OrigIpoptNLP::c(
          retValue = NLP_scaling()->apply_vector_scaling_c(ConstPtr(unscaled_c));
          c_cache_.AddCachedResult1Dep(retValue, x);
       }
+      else if( !TakePrefetched(prefetched_c_, x) )
+      {
+         c_cache_hits_++;
+      }
    }
 
    return retValue;
@@ -640,6 +769,10 @@ SmartPtr<const Vector> OrigIpoptNLP::d(
          retValue = NLP_scaling()->apply_vector_scaling_d(ConstPtr(unscaled_d));
          d_cache_.AddCachedResult1Dep(retValue, x);
       }
+      else if( !TakePrefetched(prefetched_d_, x) )
+      {
+         d_cache_hits_++;
+      }
    }
 
    return retValue;
@@ -693,6 +826,10 @@ SmartPtr<const Matrix> OrigIpoptNLP::jac_c(
          retValue = NLP_scaling()->apply_jac_c_scaling(ConstPtr(unscaled_jac_c));
          jac_c_cache_.AddCachedResult1Dep(retValue, GetRawPtr(dep));
       }
+      else
+      {
+         jac_c_cache_hits_++;
+      }
    }
 
    return retValue;
@@ -748,6 +885,10 @@ SmartPtr<const Matrix> OrigIpoptNLP::jac_d(
          retValue = NLP_scaling()->apply_jac_d_scaling(ConstPtr(unscaled_jac_d));
          jac_d_cache_.AddCachedResult1Dep(retValue, GetRawPtr(dep));
       }
+      else
+      {
+         jac_d_cache_hits_++;
+      }
    }
 
    return retValue;
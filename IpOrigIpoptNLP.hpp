@@ -185,6 +185,15 @@ public:
     */
    virtual SmartPtr<const SymMatrix> uninitialized_h();
 
+   virtual bool ProvidesConcurrentEvaluation() const
+   {
+      return nlp_->ProvidesConcurrentEvaluation();
+   }
+
+   virtual void EvaluateConcurrently(
+      const std::vector<SmartPtr<const Vector> >& x
+   );
+
    /** Scaled lower bounds on x */
    virtual SmartPtr<const Vector> x_L() const
    {
@@ -343,6 +352,41 @@ public:
    }
    ///@}
 
+   /** @name Counters for the number of requests that were answered
+    *  from the caches of the function values and first derivatives.
+    *
+    *  Together with the number of evaluations, these give the hit
+    *  rates of the caches.  The first lookup of a value that was
+    *  computed in advance by EvaluateConcurrently is not counted,
+    *  since it takes the place of an evaluation.
+    */
+   ///@{
+   Index f_cache_hits() const
+   {
+      return f_cache_hits_;
+   }
+   Index grad_f_cache_hits() const
+   {
+      return grad_f_cache_hits_;
+   }
+   Index c_cache_hits() const
+   {
+      return c_cache_hits_;
+   }
+   Index jac_c_cache_hits() const
+   {
+      return jac_c_cache_hits_;
+   }
+   Index d_cache_hits() const
+   {
+      return d_cache_hits_;
+   }
+   Index jac_d_cache_hits() const
+   {
+      return jac_d_cache_hits_;
+   }
+   ///@}
+
    /** Solution Routines - overloaded from IpoptNLP */
    ///@{
    void FinalizeSolution(
@@ -527,6 +571,16 @@ private:
    SmartPtr<const Vector> get_unscaled_x(
       const Vector& x
    );
+
+   /** Remove the tag of x from the tags of prefetched points.
+    *
+    *  Returns true if it was there, i.e., if this is the first
+    *  lookup of a value computed by EvaluateConcurrently.
+    */
+   static bool TakePrefetched(
+      std::vector<TaggedObject::Tag>& prefetched,
+      const Vector&                   x
+   );
    ///@}
 
    /** @name Algorithmic parameters */
@@ -576,6 +630,20 @@ private:
 
    /** Flag indicating if we need to ask for Hessian only once */
    bool hessian_constant_;
+
+   /** Number of trial points that the line search evaluates
+    *  concurrently; the caches for f, c, and d hold at least this
+    *  many results.
+    */
+   Index concurrent_trial_points_;
+
+   /** Number of points for which the values of f, c, and d are cached */
+   Index function_cache_size_;
+
+   /** Number of points for which the gradient of f and the Jacobians
+    *  of c and d are cached
+    */
+   Index derivative_cache_size_;
    ///@}
 
    /** @name Counters for the function evaluations */
@@ -589,6 +657,25 @@ private:
    Index h_evals_;
    ///@}
 
+   /** @name Counters for the cache hits */
+   ///@{
+   Index f_cache_hits_;
+   Index grad_f_cache_hits_;
+   Index c_cache_hits_;
+   Index jac_c_cache_hits_;
+   Index d_cache_hits_;
+   Index jac_d_cache_hits_;
+   ///@}
+
+   /** @name Tags of the points at which f, c, and d were evaluated by
+    *  EvaluateConcurrently, but not looked up yet
+    */
+   ///@{
+   std::vector<TaggedObject::Tag> prefetched_f_;
+   std::vector<TaggedObject::Tag> prefetched_c_;
+   std::vector<TaggedObject::Tag> prefetched_d_;
+   ///@}
+
    /** Flag indicating if initialization method has been called */
    bool initialized_;
 
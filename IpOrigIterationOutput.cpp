@@ -167,6 +167,12 @@ void OrigIterationOutput::WriteOutput()
       IpData().Inc_info_iters_since_header();
    }
 
+   if( !IpData().info_skip_output() && Jnlst().ProduceMetrics() )
+   {
+      WriteIterationMetrics(false, iter, unscaled_f, inf_pr, inf_du, mu, dnrm, regu_x, alpha_dual, alpha_primal, alpha_primal_char,
+                            ls_count, info_string);
+   }
+
    //////////////////////////////////////////////////////////////////////
    //           Now if desired more detail on the iterates             //
    //////////////////////////////////////////////////////////////////////
@@ -0,0 +1,1341 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpOutOfCoreLdlSolverInterface.hpp"
+#include "IpBlas.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** Rows whose diagonal entry is at most this factor times the largest
+ *  off-diagonal entry are paired with a neighbor for the ordering.
+ */
+static const Number pairing_threshold = 1e-4;
+
+OutOfCoreLdlSolverInterface::OutOfCoreLdlSolverInterface()
+   : dim_(0),
+     nonzeros_(0),
+     a_(NULL),
+     memory_limit_(0),
+     block_size_(0),
+     pivtol_(0.),
+     nemin_(1),
+     negevals_(-1),
+     have_symbolic_(false),
+     nsuper_(0),
+     factor_nonzeros_(0.)
+{
+   DBG_START_METH("OutOfCoreLdlSolverInterface::OutOfCoreLdlSolverInterface()", dbg_verbosity);
+}
+
+OutOfCoreLdlSolverInterface::~OutOfCoreLdlSolverInterface()
+{
+   DBG_START_METH("OutOfCoreLdlSolverInterface::~OutOfCoreLdlSolverInterface()", dbg_verbosity);
+   delete[] a_;
+}
+
+void OutOfCoreLdlSolverInterface::RegisterOptions(
+   SmartPtr<RegisteredOptions> roptions
+)
+{
+   roptions->AddLowerBoundedNumberOption(
+      "oocldl_memory_limit",
+      "Memory limit for the factor of the out-of-core LDL^T solver (in MB).",
+      0., true,
+      2048.,
+      "If the factor does not fit into this limit, it is kept in a scratch file, "
+      "and only the blocks of the factor that are currently needed are held in memory.");
+   roptions->AddStringOption1(
+      "oocldl_scratch_dir",
+      "Directory for the scratch file of the out-of-core LDL^T solver.",
+      "",
+      "*", "Any existing directory",
+      "If not set, the temporary directory of the system is used.");
+   roptions->AddLowerBoundedNumberOption(
+      "oocldl_block_size",
+      "Size of the blocks in which the out-of-core LDL^T solver reads and writes the factor (in MB).",
+      0., true,
+      4.,
+      "A block consists of the panels of consecutive supernodes; a panel that is larger than this size forms a block by itself. "
+      "The memory limit should hold at least a few blocks.");
+   roptions->AddBoundedNumberOption(
+      "oocldl_pivtol",
+      "Pivot tolerance for the out-of-core LDL^T solver.",
+      0., true,
+      1., true,
+      1e-12,
+      "Pivots smaller than this value times the largest entry of the matrix are perturbed, "
+      "and the matrix is reported as singular.");
+   roptions->AddLowerBoundedIntegerOption(
+      "oocldl_nemin",
+      "Node amalgamation parameter of the out-of-core LDL^T solver.",
+      1,
+      16,
+      "Two supernodes in the elimination tree are merged if the result has at most oocldl_nemin columns.");
+}
+
+bool OutOfCoreLdlSolverInterface::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   Number value;
+   options.GetNumericValue("oocldl_memory_limit", value, prefix);
+   memory_limit_ = (size_t) (value * 1048576.);
+   options.GetNumericValue("oocldl_block_size", value, prefix);
+   block_size_ = (size_t) (value * 1048576.);
+   options.GetStringValue("oocldl_scratch_dir", scratch_dir_, prefix);
+   options.GetNumericValue("oocldl_pivtol", pivtol_, prefix);
+   options.GetIntegerValue("oocldl_nemin", nemin_, prefix);
+
+   // Reset all private data
+   dim_ = 0;
+   nonzeros_ = 0;
+   negevals_ = -1;
+   have_symbolic_ = false;
+   delete[] a_;
+   a_ = NULL;
+   store_.Clear();
+
+   return true;
+}
+
+ESymSolverStatus OutOfCoreLdlSolverInterface::InitializeStructure(
+   Index        dim,
+   Index        nonzeros,
+   const Index* /* ia */,
+   const Index* /* ja */
+)
+{
+   DBG_START_METH("OutOfCoreLdlSolverInterface::InitializeStructure", dbg_verbosity);
+   dim_ = dim;
+   nonzeros_ = nonzeros;
+
+   // Make space for storing the matrix elements
+   delete[] a_;
+   a_ = NULL;
+   a_ = new Number[nonzeros_];
+
+   // The ordering depends on the values, so the symbolic
+   // factorization is postponed to the first factorization
+   have_symbolic_ = false;
+   store_.Clear();
+
+   return SYMSOLVER_SUCCESS;
+}
+
+Number* OutOfCoreLdlSolverInterface::GetValuesArrayPtr()
+{
+   DBG_START_METH("OutOfCoreLdlSolverInterface::GetValuesArrayPtr", dbg_verbosity);
+   DBG_ASSERT(a_);
+   return a_;
+}
+
+ESymSolverStatus OutOfCoreLdlSolverInterface::MultiSolve(
+   bool         new_matrix,
+   const Index* ia,
+   const Index* ja,
+   Index        nrhs,
+   Number*      rhs_vals,
+   bool         check_NegEVals,
+   Index        numberOfNegEVals
+)
+{
+   DBG_START_METH("OutOfCoreLdlSolverInterface::MultiSolve", dbg_verbosity);
+   DBG_ASSERT(!check_NegEVals || ProvidesInertia());
+
+   if( new_matrix || !have_symbolic_ )
+   {
+      if( !have_symbolic_ )
+      {
+         if( HaveIpData() )
+         {
+            IpData().TimingStats().LinearSystemSymbolicFactorization().Start();
+         }
+         bool retval = SymbolicFactorization(ia, ja);
+         if( HaveIpData() )
+         {
+            IpData().TimingStats().LinearSystemSymbolicFactorization().End();
+         }
+         if( !retval )
+         {
+            return SYMSOLVER_FATAL_ERROR;
+         }
+      }
+
+      if( HaveIpData() )
+      {
+         IpData().TimingStats().LinearSystemFactorization().Start();
+      }
+      ESymSolverStatus retval = Factorization(ia, ja, check_NegEVals, numberOfNegEVals);
+      if( HaveIpData() )
+      {
+         IpData().TimingStats().LinearSystemFactorization().End();
+         IpData().Set_info_factorization_size((Number) (nonzeros_ + dim_) / 2., factor_nonzeros_);
+      }
+      if( retval != SYMSOLVER_SUCCESS )
+      {
+         return retval;
+      }
+   }
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().Start();
+   }
+   bool solved = Solve(nrhs, rhs_vals);
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().LinearSystemBackSolve().End();
+   }
+
+   if( HaveIpData() )
+   {
+      IpData().TimingStats().UpdateLinearSolverPeakMemory((Number) store_.PeakResidentBytes());
+      IpData().TimingStats().AddLinearSolverDiskRead((Number) store_.BytesRead());
+      IpData().TimingStats().AddLinearSolverDiskWrite((Number) store_.BytesWritten());
+   }
+   store_.ResetStatistics();
+
+   return solved ? SYMSOLVER_SUCCESS : SYMSOLVER_FATAL_ERROR;
+}
+
+Index OutOfCoreLdlSolverInterface::NumberOfNegEVals() const
+{
+   DBG_START_METH("OutOfCoreLdlSolverInterface::NumberOfNegEVals", dbg_verbosity);
+   DBG_ASSERT(negevals_ >= 0);
+   return negevals_;
+}
+
+bool OutOfCoreLdlSolverInterface::SymbolicFactorization(
+   const Index* ia,
+   const Index* ja
+)
+{
+   DBG_START_METH("OutOfCoreLdlSolverInterface::SymbolicFactorization", dbg_verbosity);
+
+   const Index n = dim_;
+
+   // Pair each row with a (nearly) zero diagonal with the unpaired
+   // neighbor of largest magnitude, so that a 2x2 pivot can be formed
+   std::vector<Index> mate(n, -1);
+   for( Index i = 0; i < n; i++ )
+   {
+      Number diag = 0.;
+      Number offdiag = 0.;
+      for( Index p = ia[i]; p < ia[i + 1]; p++ )
+      {
+         if( ja[p] == i )
+         {
+            diag = std::abs(a_[p]);
+         }
+         else
+         {
+            offdiag = Max(offdiag, std::abs(a_[p]));
+         }
+      }
+      if( mate[i] >= 0 || diag > pairing_threshold * offdiag )
+      {
+         continue;
+      }
+      Index best = -1;
+      Number best_val = 0.;
+      for( Index p = ia[i]; p < ia[i + 1]; p++ )
+      {
+         Index j = ja[p];
+         if( j != i && mate[j] < 0 && std::abs(a_[p]) > best_val )
+         {
+            best = j;
+            best_val = std::abs(a_[p]);
+         }
+      }
+      if( best >= 0 )
+      {
+         mate[i] = best;
+         mate[best] = i;
+      }
+   }
+
+   // Contract the pairs; the row with the larger diagonal is the first
+   // member of a node
+   std::vector<Index> node(n);
+   std::vector<Index> first;
+   std::vector<Index> second;
+   std::vector<Index> weight;
+   for( Index i = 0; i < n; i++ )
+   {
+      if( mate[i] >= 0 && mate[i] < i )
+      {
+         continue;
+      }
+      node[i] = (Index) first.size();
+      if( mate[i] >= 0 )
+      {
+         node[mate[i]] = node[i];
+         // the row that triggered the pairing has the smaller diagonal
+         // and is eliminated second; find it by its diagonal entry
+         Number diag_i = 0.;
+         Number diag_j = 0.;
+         for( Index p = ia[i]; p < ia[i + 1]; p++ )
+         {
+            if( ja[p] == i )
+            {
+               diag_i = std::abs(a_[p]);
+            }
+         }
+         for( Index p = ia[mate[i]]; p < ia[mate[i] + 1]; p++ )
+         {
+            if( ja[p] == mate[i] )
+            {
+               diag_j = std::abs(a_[p]);
+            }
+         }
+         first.push_back(diag_i >= diag_j ? i : mate[i]);
+         second.push_back(diag_i >= diag_j ? mate[i] : i);
+         weight.push_back(2);
+      }
+      else
+      {
+         first.push_back(i);
+         second.push_back(-1);
+         weight.push_back(1);
+      }
+   }
+   const Index nn = (Index) first.size();
+
+   std::vector<Index> cia(nn + 1);
+   std::vector<Index> cja;
+   cja.reserve(nonzeros_);
+   {
+      std::vector<Index> marker(nn, -1);
+      for( Index v = 0; v < nn; v++ )
+      {
+         cia[v] = (Index) cja.size();
+         marker[v] = v;
+         for( Index m = 0; m < 2; m++ )
+         {
+            Index i = (m == 0 ? first[v] : second[v]);
+            if( i < 0 )
+            {
+               continue;
+            }
+            for( Index p = ia[i]; p < ia[i + 1]; p++ )
+            {
+               Index w = node[ja[p]];
+               if( marker[w] != v )
+               {
+                  marker[w] = v;
+                  cja.push_back(w);
+               }
+            }
+         }
+      }
+      cia[nn] = (Index) cja.size();
+   }
+
+   std::vector<Index> order;
+   ApproximateMinimumDegree(cia, cja, weight, order);
+   cia.clear();
+   cja.clear();
+
+   perm_.resize(n);
+   iperm_.resize(n);
+   {
+      Index k = 0;
+      for( Index v = 0; v < nn; v++ )
+      {
+         perm_[k++] = first[order[v]];
+         if( second[order[v]] >= 0 )
+         {
+            perm_[k++] = second[order[v]];
+         }
+      }
+      DBG_ASSERT(k == n);
+   }
+   for( Index k = 0; k < n; k++ )
+   {
+      iperm_[perm_[k]] = k;
+   }
+
+   // Elimination tree of the permuted matrix
+   std::vector<Index> parent(n);
+   {
+      std::vector<Index> ancestor(n);
+      for( Index k = 0; k < n; k++ )
+      {
+         parent[k] = -1;
+         ancestor[k] = -1;
+         Index oc = perm_[k];
+         for( Index p = ia[oc]; p < ia[oc + 1]; p++ )
+         {
+            Index i = iperm_[ja[p]];
+            while( i != -1 && i < k )
+            {
+               Index next = ancestor[i];
+               ancestor[i] = k;
+               if( next == -1 )
+               {
+                  parent[i] = k;
+               }
+               i = next;
+            }
+         }
+      }
+   }
+
+   // Postorder the tree.  The children are visited in increasing
+   // order, so that the first member of a pair, which is the largest
+   // child of the second member, stays right in front of it.
+   {
+      std::vector<Index> child_head(n, -1);
+      std::vector<Index> child_next(n, -1);
+      for( Index k = n - 1; k >= 0; k-- )
+      {
+         if( parent[k] >= 0 )
+         {
+            child_next[k] = child_head[parent[k]];
+            child_head[parent[k]] = k;
+         }
+      }
+      std::vector<Index> post;
+      post.reserve(n);
+      std::vector<Index> stack;
+      for( Index r = 0; r < n; r++ )
+      {
+         if( parent[r] >= 0 )
+         {
+            continue;
+         }
+         stack.push_back(r);
+         while( !stack.empty() )
+         {
+            Index v = stack.back();
+            Index c = child_head[v];
+            if( c >= 0 )
+            {
+               child_head[v] = child_next[c];
+               stack.push_back(c);
+            }
+            else
+            {
+               stack.pop_back();
+               post.push_back(v);
+            }
+         }
+      }
+      DBG_ASSERT((Index) post.size() == n);
+
+      std::vector<Index> newlabel(n);
+      for( Index k = 0; k < n; k++ )
+      {
+         newlabel[post[k]] = k;
+      }
+      std::vector<Index> newparent(n);
+      for( Index k = 0; k < n; k++ )
+      {
+         iperm_[k] = perm_[post[k]];
+         newparent[newlabel[k]] = parent[k] >= 0 ? newlabel[parent[k]] : -1;
+      }
+      perm_.swap(iperm_);
+      parent.swap(newparent);
+      for( Index k = 0; k < n; k++ )
+      {
+         iperm_[perm_[k]] = k;
+      }
+   }
+
+   // Column counts of L, including the diagonal, from the row subtrees
+   std::vector<Index> colcount(n, 1);
+   {
+      std::vector<Index> marker(n, -1);
+      for( Index i = 0; i < n; i++ )
+      {
+         marker[i] = i;
+         Index oi = perm_[i];
+         for( Index p = ia[oi]; p < ia[oi + 1]; p++ )
+         {
+            Index j = iperm_[ja[p]];
+            while( j < i && marker[j] != i )
+            {
+               marker[j] = i;
+               colcount[j]++;
+               j = parent[j];
+            }
+         }
+      }
+   }
+
+   // Fundamental supernodes
+   std::vector<Index> start;
+   for( Index j = 0; j < n; j++ )
+   {
+      if( j == 0 || parent[j - 1] != j || colcount[j - 1] != colcount[j] + 1 )
+      {
+         start.push_back(j);
+      }
+   }
+   start.push_back(n);
+
+   // Amalgamation: merge a supernode into the following one if that is
+   // its parent and the result is small, or if a pair would be split
+   super_start_.clear();
+   for( size_t s = 0; s + 1 < start.size(); s++ )
+   {
+      Index f = start[s];
+      if( !super_start_.empty() )
+      {
+         Index cur = super_start_.back();
+         Index last = f - 1;
+         bool pair_split = mate[perm_[last]] == perm_[f];
+         if( parent[last] == f && (f - cur + start[s + 1] - f <= nemin_ || pair_split) )
+         {
+            continue;
+         }
+      }
+      super_start_.push_back(f);
+   }
+   nsuper_ = (Index) super_start_.size();
+   super_start_.push_back(n);
+   start.clear();
+
+   col_super_.resize(n);
+   for( Index s = 0; s < nsuper_; s++ )
+   {
+      for( Index j = super_start_[s]; j < super_start_[s + 1]; j++ )
+      {
+         col_super_[j] = s;
+      }
+   }
+
+   // Row structures of the supernodes: the structure of the matrix in
+   // the columns of the supernode, merged with the structures of the
+   // children
+   std::vector<Index> child_head(nsuper_, -1);
+   std::vector<Index> child_next(nsuper_, -1);
+   for( Index s = nsuper_ - 1; s >= 0; s-- )
+   {
+      Index p = parent[super_start_[s + 1] - 1];
+      if( p >= 0 )
+      {
+         Index t = col_super_[p];
+         child_next[s] = child_head[t];
+         child_head[t] = s;
+      }
+   }
+   super_rows_ptr_.resize(nsuper_ + 1);
+   super_rows_.clear();
+   {
+      std::vector<Index> marker(n, -1);
+      for( Index s = 0; s < nsuper_; s++ )
+      {
+         Index f = super_start_[s];
+         Index l = super_start_[s + 1];
+         size_t begin = super_rows_.size();
+         super_rows_ptr_[s] = begin;
+         for( Index j = f; j < l; j++ )
+         {
+            super_rows_.push_back(j);
+         }
+         for( Index j = f; j < l; j++ )
+         {
+            Index oj = perm_[j];
+            for( Index p = ia[oj]; p < ia[oj + 1]; p++ )
+            {
+               Index i = iperm_[ja[p]];
+               if( i >= l && marker[i] != s )
+               {
+                  marker[i] = s;
+                  super_rows_.push_back(i);
+               }
+            }
+         }
+         for( Index c = child_head[s]; c >= 0; c = child_next[c] )
+         {
+            for( size_t p = super_rows_ptr_[c]; p < super_rows_ptr_[c + 1]; p++ )
+            {
+               Index i = super_rows_[p];
+               if( i >= l && marker[i] != s )
+               {
+                  marker[i] = s;
+                  super_rows_.push_back(i);
+               }
+            }
+         }
+         std::sort(super_rows_.begin() + begin + (l - f), super_rows_.end());
+         super_rows_ptr_[s + 1] = super_rows_.size();
+      }
+   }
+
+   // Group the panels into blocks
+   super_block_.resize(nsuper_);
+   super_offset_.resize(nsuper_);
+   block_start_.clear();
+   std::vector<size_t> block_sizes;
+   size_t factor_size = 0;
+   for( Index s = 0; s < nsuper_; s++ )
+   {
+      size_t ncol = super_start_[s + 1] - super_start_[s];
+      size_t nrow = super_rows_ptr_[s + 1] - super_rows_ptr_[s];
+      size_t panel_size = ncol * nrow;
+      if( block_sizes.empty() || (block_sizes.back() + panel_size) * sizeof(Number) > block_size_ )
+      {
+         block_start_.push_back(s);
+         block_sizes.push_back(0);
+      }
+      super_block_[s] = (Index) block_sizes.size() - 1;
+      super_offset_[s] = block_sizes.back();
+      block_sizes.back() += panel_size;
+      factor_size += panel_size;
+   }
+   block_start_.push_back(nsuper_);
+   factor_nonzeros_ = (Number) factor_size;
+
+   if( !store_.Initialize(block_sizes, memory_limit_, scratch_dir_) )
+   {
+      Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
+                     "OOC-LDL: Could not create scratch file in directory \"%s\".\n", scratch_dir_.c_str());
+      return false;
+   }
+
+   Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                  "OOC-LDL: %" IPOPT_INDEX_FORMAT " supernodes in %d blocks, %.3g MB of factor, kept %s.\n",
+                  nsuper_, (int) block_sizes.size(), (Number) (factor_size * sizeof(Number)) / 1048576.,
+                  store_.InCore() ? "in core" : "out of core");
+
+   rows_.resize(super_rows_.size());
+   d_diag_.resize(n);
+   d_off_.resize(n);
+   piv_type_.resize(n);
+   map_.resize(n);
+   link_head_.resize(nsuper_);
+   link_next_.resize(nsuper_);
+   link_pos_.resize(nsuper_);
+
+   have_symbolic_ = true;
+   return true;
+}
+
+void OutOfCoreLdlSolverInterface::ApproximateMinimumDegree(
+   const std::vector<Index>& ia,
+   const std::vector<Index>& ja,
+   const std::vector<Index>& weight,
+   std::vector<Index>&       order
+) const
+{
+   DBG_START_METH("OutOfCoreLdlSolverInterface::ApproximateMinimumDegree", dbg_verbosity);
+
+   // Quotient graph: the uneliminated neighbors (variables) and the
+   // elements adjacent to each variable, and the variables of each
+   // element.  An element is identified with the variable whose
+   // elimination created it.
+   const Index nn = (Index) weight.size();
+   std::vector<std::vector<Index> > adj(nn);
+   std::vector<std::vector<Index> > elems(nn);
+   std::vector<std::vector<Index> > vars(nn);
+   std::vector<Index> elem_weight(nn, 0);
+   // 0: variable, 1: element, 2: absorbed element
+   std::vector<Index> status(nn, 0);
+
+   Index total_weight = 0;
+   std::vector<Index> degree(nn, 0);
+   for( Index v = 0; v < nn; v++ )
+   {
+      for( Index p = ia[v]; p < ia[v + 1]; p++ )
+      {
+         if( ja[p] != v )
+         {
+            adj[v].push_back(ja[p]);
+            degree[v] += weight[ja[p]];
+         }
+      }
+      total_weight += weight[v];
+   }
+
+   // Degree lists
+   std::vector<Index> head(total_weight + 1, -1);
+   std::vector<Index> next(nn, -1);
+   std::vector<Index> prev(nn, -1);
+   for( Index v = 0; v < nn; v++ )
+   {
+      next[v] = head[degree[v]];
+      if( next[v] >= 0 )
+      {
+         prev[next[v]] = v;
+      }
+      head[degree[v]] = v;
+   }
+
+   std::vector<Index> marker(nn, -1);
+   std::vector<Index> w(nn, 0);
+   std::vector<Index> w_marker(nn, -1);
+   std::vector<Index> lp;
+   order.clear();
+   order.reserve(nn);
+   Index remaining_weight = total_weight;
+   Index mindeg = 0;
+
+   for( Index step = 0; step < nn; step++ )
+   {
+      while( head[mindeg] < 0 )
+      {
+         mindeg++;
+      }
+      Index p = head[mindeg];
+      head[mindeg] = next[p];
+      if( next[p] >= 0 )
+      {
+         prev[next[p]] = -1;
+      }
+      order.push_back(p);
+      status[p] = 1;
+      remaining_weight -= weight[p];
+
+      // Variables of the new element: the neighbors of p and the
+      // variables of the elements adjacent to p, which are absorbed
+      marker[p] = step;
+      lp.clear();
+      for( size_t k = 0; k < adj[p].size(); k++ )
+      {
+         Index i = adj[p][k];
+         if( status[i] == 0 && marker[i] != step )
+         {
+            marker[i] = step;
+            lp.push_back(i);
+         }
+      }
+      for( size_t k = 0; k < elems[p].size(); k++ )
+      {
+         Index e = elems[p][k];
+         if( status[e] != 1 )
+         {
+            continue;
+         }
+         for( size_t m = 0; m < vars[e].size(); m++ )
+         {
+            Index i = vars[e][m];
+            if( status[i] == 0 && marker[i] != step )
+            {
+               marker[i] = step;
+               lp.push_back(i);
+            }
+         }
+         status[e] = 2;
+         std::vector<Index>().swap(vars[e]);
+      }
+      std::vector<Index>().swap(adj[p]);
+      std::vector<Index>().swap(elems[p]);
+      vars[p] = lp;
+      Index lp_weight = 0;
+      for( size_t k = 0; k < lp.size(); k++ )
+      {
+         lp_weight += weight[lp[k]];
+      }
+      elem_weight[p] = lp_weight;
+
+      // w(e) = |Le \ Lp| for all elements adjacent to variables in Lp
+      for( size_t k = 0; k < lp.size(); k++ )
+      {
+         Index i = lp[k];
+         for( size_t m = 0; m < elems[i].size(); m++ )
+         {
+            Index e = elems[i][m];
+            if( status[e] != 1 )
+            {
+               continue;
+            }
+            if( w_marker[e] != step )
+            {
+               w_marker[e] = step;
+               w[e] = elem_weight[e];
+            }
+            w[e] -= weight[i];
+         }
+      }
+
+      // Update the variables in Lp and their approximate degrees
+      for( size_t k = 0; k < lp.size(); k++ )
+      {
+         Index i = lp[k];
+
+         // remove i from its degree list
+         if( prev[i] >= 0 )
+         {
+            next[prev[i]] = next[i];
+         }
+         else
+         {
+            head[degree[i]] = next[i];
+         }
+         if( next[i] >= 0 )
+         {
+            prev[next[i]] = prev[i];
+         }
+
+         Index elem_sum = 0;
+         size_t nkeep = 0;
+         for( size_t m = 0; m < elems[i].size(); m++ )
+         {
+            Index e = elems[i][m];
+            if( status[e] == 1 )
+            {
+               elems[i][nkeep++] = e;
+               elem_sum += w[e];
+            }
+         }
+         elems[i].resize(nkeep);
+         elems[i].push_back(p);
+
+         Index ext_weight = 0;
+         nkeep = 0;
+         for( size_t m = 0; m < adj[i].size(); m++ )
+         {
+            Index j = adj[i][m];
+            if( status[j] == 0 && marker[j] != step )
+            {
+               adj[i][nkeep++] = j;
+               ext_weight += weight[j];
+            }
+         }
+         adj[i].resize(nkeep);
+
+         Index d = Min(remaining_weight - weight[i], degree[i] + lp_weight - weight[i]);
+         d = Min(d, ext_weight + lp_weight - weight[i] + elem_sum);
+         d = Max(d, 0);
+         degree[i] = d;
+
+         next[i] = head[d];
+         prev[i] = -1;
+         if( next[i] >= 0 )
+         {
+            prev[next[i]] = i;
+         }
+         head[d] = i;
+         mindeg = Min(mindeg, d);
+      }
+   }
+}
+
+ESymSolverStatus OutOfCoreLdlSolverInterface::Factorization(
+   const Index* ia,
+   const Index* ja,
+   bool         check_NegEVals,
+   Index        numberOfNegEVals
+)
+{
+   DBG_START_METH("OutOfCoreLdlSolverInterface::Factorization", dbg_verbosity);
+
+   Number anorm = 0.;
+   for( Index p = 0; p < nonzeros_; p++ )
+   {
+      anorm = Max(anorm, std::abs(a_[p]));
+   }
+   const Number tol = anorm > 0. ? pivtol_ * anorm : pivtol_;
+
+   rows_ = super_rows_;
+   for( Index s = 0; s < nsuper_; s++ )
+   {
+      link_head_[s] = -1;
+   }
+
+   negevals_ = 0;
+   Index nperturbed = 0;
+   const Index nblocks = (Index) block_start_.size() - 1;
+   for( Index b = 0; b < nblocks; b++ )
+   {
+      Number* data = store_.Acquire(b, true);
+      if( data == NULL && block_start_[b + 1] > block_start_[b] )
+      {
+         Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
+                        "OOC-LDL: Could not map block %" IPOPT_INDEX_FORMAT " of the factor.\n", b);
+         return SYMSOLVER_FATAL_ERROR;
+      }
+      for( Index s = block_start_[b]; s < block_start_[b + 1]; s++ )
+      {
+         const Index f = super_start_[s];
+         const Index l = super_start_[s + 1];
+         const Index ncol = l - f;
+         const Index nrow = (Index) (super_rows_ptr_[s + 1] - super_rows_ptr_[s]);
+         const Index* rows = &rows_[super_rows_ptr_[s]];
+         Number* panel = data + super_offset_[s];
+
+         // Start reading the blocks needed for the next supernodes
+         for( Index d = link_head_[s]; d >= 0; d = link_next_[d] )
+         {
+            store_.Prefetch(super_block_[d]);
+         }
+         if( s + 1 < nsuper_ )
+         {
+            for( Index d = link_head_[s + 1]; d >= 0; d = link_next_[d] )
+            {
+               store_.Prefetch(super_block_[d]);
+            }
+         }
+
+         // Assemble the columns of the matrix
+         for( size_t k = 0; k < (size_t) ncol * nrow; k++ )
+         {
+            panel[k] = 0.;
+         }
+         for( Index k = 0; k < nrow; k++ )
+         {
+            map_[rows[k]] = k;
+         }
+         for( Index c = 0; c < ncol; c++ )
+         {
+            Index oc = perm_[f + c];
+            Number* col = panel + (size_t) c * nrow;
+            for( Index p = ia[oc]; p < ia[oc + 1]; p++ )
+            {
+               Index i = iperm_[ja[p]];
+               if( i >= f )
+               {
+                  col[map_[i]] += a_[p];
+               }
+            }
+         }
+
+         // Updates from the descendants with rows in this supernode
+         Index d = link_head_[s];
+         link_head_[s] = -1;
+         while( d >= 0 )
+         {
+            Index d_next = link_next_[d];
+            Number* d_data = store_.Acquire(super_block_[d], false);
+            if( d_data == NULL )
+            {
+               store_.Release(b);
+               Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
+                              "OOC-LDL: Could not map block %" IPOPT_INDEX_FORMAT " of the factor.\n", super_block_[d]);
+               return SYMSOLVER_FATAL_ERROR;
+            }
+            const Number* d_panel = d_data + super_offset_[d];
+            const Index d_f = super_start_[d];
+            const Index d_ncol = super_start_[d + 1] - d_f;
+            const Index d_nrow = (Index) (super_rows_ptr_[d + 1] - super_rows_ptr_[d]);
+            const Index* d_rows = &rows_[super_rows_ptr_[d]];
+
+            Index p1 = (Index) link_pos_[d];
+            Index p2 = p1;
+            while( p2 < d_nrow && d_rows[p2] < l )
+            {
+               p2++;
+            }
+            const Index q = p2 - p1;
+            const Index m = d_nrow - p1;
+
+            // work = L_d[p1:p2,:] D_d
+            work_.resize((size_t) q * d_ncol);
+            for( Index k = 0; k < d_ncol; k++ )
+            {
+               const Number* lk = d_panel + (size_t) k * d_nrow + p1;
+               Number* tk = &work_[(size_t) k * q];
+               if( piv_type_[d_f + k] == 1 )
+               {
+                  Number dk = d_diag_[d_f + k];
+                  for( Index i = 0; i < q; i++ )
+                  {
+                     tk[i] = lk[i] * dk;
+                  }
+               }
+               else if( piv_type_[d_f + k] == 2 )
+               {
+                  Number a = d_diag_[d_f + k];
+                  Number bb = d_off_[d_f + k];
+                  Number c = d_diag_[d_f + k + 1];
+                  const Number* lk1 = lk + d_nrow;
+                  Number* tk1 = tk + q;
+                  for( Index i = 0; i < q; i++ )
+                  {
+                     tk[i] = lk[i] * a + lk1[i] * bb;
+                     tk1[i] = lk[i] * bb + lk1[i] * c;
+                  }
+               }
+            }
+
+            // update = L_d[p1:,:] work^T
+            update_.resize((size_t) m * q);
+            IpBlasGemm(false, true, m, q, d_ncol, 1., d_panel + p1, d_nrow, &work_[0], q, 0., &update_[0], m);
+
+            for( Index j = 0; j < q; j++ )
+            {
+               Number* col = panel + (size_t) map_[d_rows[p1 + j]] * nrow;
+               const Number* upd = &update_[(size_t) j * m];
+               for( Index i = 0; i < m; i++ )
+               {
+                  col[map_[d_rows[p1 + i]]] -= upd[i];
+               }
+            }
+            store_.Release(super_block_[d]);
+
+            if( p2 < d_nrow )
+            {
+               Index t = col_super_[d_rows[p2]];
+               link_pos_[d] = p2;
+               link_next_[d] = link_head_[t];
+               link_head_[t] = d;
+            }
+            d = d_next;
+         }
+
+         nperturbed += FactorizePanel(s, panel, tol);
+
+         if( nrow > ncol )
+         {
+            Index t = col_super_[rows[ncol]];
+            link_pos_[s] = ncol;
+            link_next_[s] = link_head_[t];
+            link_head_[t] = s;
+         }
+      }
+      store_.Release(b);
+   }
+
+   Jnlst().Printf(J_MOREDETAILED, J_LINEAR_ALGEBRA,
+                  "OOC-LDL: %" IPOPT_INDEX_FORMAT " negative eigenvalues, %" IPOPT_INDEX_FORMAT " perturbed pivots.\n",
+                  negevals_, nperturbed);
+
+   if( nperturbed > 0 )
+   {
+      return SYMSOLVER_SINGULAR;
+   }
+   if( check_NegEVals && negevals_ != numberOfNegEVals )
+   {
+      return SYMSOLVER_WRONG_INERTIA;
+   }
+   return SYMSOLVER_SUCCESS;
+}
+
+Index OutOfCoreLdlSolverInterface::FactorizePanel(
+   Index   s,
+   Number* panel,
+   Number  tol
+)
+{
+   const Number alpha = (1. + std::sqrt(17.)) / 8.;
+   const Index f = super_start_[s];
+   const Index ncol = super_start_[s + 1] - f;
+   const Index nrow = (Index) (super_rows_ptr_[s + 1] - super_rows_ptr_[s]);
+   Index* rows = &rows_[super_rows_ptr_[s]];
+#define P(i, j) panel[(size_t) (j) * nrow + (i)]
+
+   Index nperturbed = 0;
+   Index k = 0;
+   while( k < ncol )
+   {
+      // Bunch-Kaufman pivot selection within the diagonal block
+      Number akk = std::abs(P(k, k));
+      Number lambda = 0.;
+      Index r = -1;
+      for( Index i = k + 1; i < ncol; i++ )
+      {
+         if( std::abs(P(i, k)) > lambda )
+         {
+            lambda = std::abs(P(i, k));
+            r = i;
+         }
+      }
+      Index swap = -1;
+      bool twobytwo = false;
+      if( lambda > tol && akk < alpha * lambda )
+      {
+         Number sigma = 0.;
+         for( Index i = k; i < ncol; i++ )
+         {
+            if( i != r )
+            {
+               sigma = Max(sigma, std::abs(P(i, r)));
+            }
+         }
+         if( akk * sigma >= alpha * lambda * lambda )
+         {
+            // 1x1 pivot at k
+         }
+         else if( std::abs(P(r, r)) >= alpha * sigma )
+         {
+            swap = k;
+         }
+         else
+         {
+            swap = k + 1;
+            twobytwo = true;
+         }
+      }
+      if( swap >= 0 && swap != r )
+      {
+         for( Index i = 0; i < nrow; i++ )
+         {
+            std::swap(P(i, swap), P(i, r));
+         }
+         for( Index j = 0; j < ncol; j++ )
+         {
+            std::swap(P(swap, j), P(r, j));
+         }
+         std::swap(rows[swap], rows[r]);
+      }
+
+      if( !twobytwo )
+      {
+         Number dk = P(k, k);
+         if( std::abs(dk) < tol )
+         {
+            dk = dk < 0. ? -tol : tol;
+            nperturbed++;
+         }
+         if( dk < 0. )
+         {
+            negevals_++;
+         }
+         d_diag_[f + k] = dk;
+         piv_type_[f + k] = 1;
+         for( Index j = k + 1; j < ncol; j++ )
+         {
+            Number lj = P(j, k) / dk;
+            if( lj != 0. )
+            {
+               for( Index i = k + 1; i < nrow; i++ )
+               {
+                  P(i, j) -= lj * P(i, k);
+               }
+            }
+         }
+         for( Index i = k + 1; i < nrow; i++ )
+         {
+            P(i, k) /= dk;
+         }
+         k++;
+      }
+      else
+      {
+         Number a = P(k, k);
+         Number bb = P(k + 1, k);
+         Number c = P(k + 1, k + 1);
+         Number det = a * c - bb * bb;
+         if( det < 0. )
+         {
+            negevals_++;
+         }
+         else if( a + c < 0. )
+         {
+            negevals_ += 2;
+         }
+         d_diag_[f + k] = a;
+         d_diag_[f + k + 1] = c;
+         d_off_[f + k] = bb;
+         piv_type_[f + k] = 2;
+         piv_type_[f + k + 1] = 0;
+         for( Index j = k + 2; j < ncol; j++ )
+         {
+            Number lj0 = (P(j, k) * c - P(j, k + 1) * bb) / det;
+            Number lj1 = (P(j, k + 1) * a - P(j, k) * bb) / det;
+            if( lj0 != 0. || lj1 != 0. )
+            {
+               for( Index i = k + 2; i < nrow; i++ )
+               {
+                  P(i, j) -= lj0 * P(i, k) + lj1 * P(i, k + 1);
+               }
+            }
+         }
+         for( Index i = k + 2; i < nrow; i++ )
+         {
+            Number li0 = (P(i, k) * c - P(i, k + 1) * bb) / det;
+            Number li1 = (P(i, k + 1) * a - P(i, k) * bb) / det;
+            P(i, k) = li0;
+            P(i, k + 1) = li1;
+         }
+         P(k + 1, k) = 0.;
+         k += 2;
+      }
+   }
+#undef P
+
+   return nperturbed;
+}
+
+bool OutOfCoreLdlSolverInterface::Solve(
+   Index   nrhs,
+   Number* rhs_vals
+)
+{
+   DBG_START_METH("OutOfCoreLdlSolverInterface::Solve", dbg_verbosity);
+
+   const Index n = dim_;
+   const Index nblocks = (Index) block_start_.size() - 1;
+
+   x_.resize((size_t) n * nrhs);
+   for( Index q = 0; q < nrhs; q++ )
+   {
+      for( Index k = 0; k < n; k++ )
+      {
+         x_[(size_t) q * n + k] = rhs_vals[(size_t) q * n + perm_[k]];
+      }
+   }
+
+   // Forward substitution with L
+   for( Index b = 0; b < nblocks; b++ )
+   {
+      const Number* data = store_.Acquire(b, false);
+      if( data == NULL )
+      {
+         Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
+                        "OOC-LDL: Could not map block %" IPOPT_INDEX_FORMAT " of the factor.\n", b);
+         return false;
+      }
+      if( b + 1 < nblocks )
+      {
+         store_.Prefetch(b + 1);
+      }
+      for( Index s = block_start_[b]; s < block_start_[b + 1]; s++ )
+      {
+         const Index ncol = super_start_[s + 1] - super_start_[s];
+         const Index nrow = (Index) (super_rows_ptr_[s + 1] - super_rows_ptr_[s]);
+         const Index* rows = &rows_[super_rows_ptr_[s]];
+         const Number* panel = data + super_offset_[s];
+
+         work_.resize((size_t) nrow * nrhs);
+         for( Index q = 0; q < nrhs; q++ )
+         {
+            Number* w = &work_[(size_t) q * nrow];
+            const Number* x = &x_[(size_t) q * n];
+            for( Index i = 0; i < nrow; i++ )
+            {
+               w[i] = x[rows[i]];
+            }
+            for( Index k = 0; k < ncol; k++ )
+            {
+               Number wk = w[k];
+               if( wk != 0. )
+               {
+                  const Number* lk = panel + (size_t) k * nrow;
+                  for( Index i = k + 1; i < ncol; i++ )
+                  {
+                     w[i] -= lk[i] * wk;
+                  }
+               }
+            }
+         }
+         if( nrow > ncol )
+         {
+            IpBlasGemm(false, false, nrow - ncol, nrhs, ncol, -1., panel + ncol, nrow, &work_[0], nrow, 1., &work_[ncol], nrow);
+         }
+         for( Index q = 0; q < nrhs; q++ )
+         {
+            const Number* w = &work_[(size_t) q * nrow];
+            Number* x = &x_[(size_t) q * n];
+            for( Index i = 0; i < nrow; i++ )
+            {
+               x[rows[i]] = w[i];
+            }
+         }
+      }
+      store_.Release(b);
+   }
+
+   // Solve with D
+   for( Index s = 0; s < nsuper_; s++ )
+   {
+      const Index f = super_start_[s];
+      const Index ncol = super_start_[s + 1] - f;
+      const Index* rows = &rows_[super_rows_ptr_[s]];
+      for( Index k = 0; k < ncol; k++ )
+      {
+         if( piv_type_[f + k] == 1 )
+         {
+            for( Index q = 0; q < nrhs; q++ )
+            {
+               x_[(size_t) q * n + rows[k]] /= d_diag_[f + k];
+            }
+         }
+         else if( piv_type_[f + k] == 2 )
+         {
+            Number a = d_diag_[f + k];
+            Number bb = d_off_[f + k];
+            Number c = d_diag_[f + k + 1];
+            Number det = a * c - bb * bb;
+            for( Index q = 0; q < nrhs; q++ )
+            {
+               Number& x0 = x_[(size_t) q * n + rows[k]];
+               Number& x1 = x_[(size_t) q * n + rows[k + 1]];
+               Number y0 = (c * x0 - bb * x1) / det;
+               Number y1 = (a * x1 - bb * x0) / det;
+               x0 = y0;
+               x1 = y1;
+            }
+         }
+      }
+   }
+
+   // Backward substitution with L^T
+   for( Index b = nblocks - 1; b >= 0; b-- )
+   {
+      const Number* data = store_.Acquire(b, false);
+      if( data == NULL )
+      {
+         Jnlst().Printf(J_ERROR, J_LINEAR_ALGEBRA,
+                        "OOC-LDL: Could not map block %" IPOPT_INDEX_FORMAT " of the factor.\n", b);
+         return false;
+      }
+      if( b > 0 )
+      {
+         store_.Prefetch(b - 1);
+      }
+      for( Index s = block_start_[b + 1] - 1; s >= block_start_[b]; s-- )
+      {
+         const Index ncol = super_start_[s + 1] - super_start_[s];
+         const Index nrow = (Index) (super_rows_ptr_[s + 1] - super_rows_ptr_[s]);
+         const Index* rows = &rows_[super_rows_ptr_[s]];
+         const Number* panel = data + super_offset_[s];
+
+         work_.resize((size_t) nrow * nrhs);
+         for( Index q = 0; q < nrhs; q++ )
+         {
+            Number* w = &work_[(size_t) q * nrow];
+            const Number* x = &x_[(size_t) q * n];
+            for( Index i = 0; i < nrow; i++ )
+            {
+               w[i] = x[rows[i]];
+            }
+         }
+         if( nrow > ncol )
+         {
+            IpBlasGemm(true, false, ncol, nrhs, nrow - ncol, -1., panel + ncol, nrow, &work_[ncol], nrow, 1., &work_[0], nrow);
+         }
+         for( Index q = 0; q < nrhs; q++ )
+         {
+            Number* w = &work_[(size_t) q * nrow];
+            Number* x = &x_[(size_t) q * n];
+            for( Index k = ncol - 1; k >= 0; k-- )
+            {
+               const Number* lk = panel + (size_t) k * nrow;
+               Number wk = w[k];
+               for( Index i = k + 1; i < ncol; i++ )
+               {
+                  wk -= lk[i] * w[i];
+               }
+               w[k] = wk;
+               x[rows[k]] = wk;
+            }
+         }
+      }
+      store_.Release(b);
+   }
+
+   for( Index q = 0; q < nrhs; q++ )
+   {
+      for( Index k = 0; k < n; k++ )
+      {
+         rhs_vals[(size_t) q * n + perm_[k]] = x_[(size_t) q * n + k];
+      }
+   }
+
+   return true;
+}
+
+} // namespace Ipopt
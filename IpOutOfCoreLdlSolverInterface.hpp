@@ -0,0 +1,290 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPOUTOFCORELDLSOLVERINTERFACE_HPP__
+#define __IPOUTOFCORELDLSOLVERINTERFACE_HPP__
+
+#include "IpSparseSymLinearSolverInterface.hpp"
+#include "IpOutOfCorePanelStore.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Interface to an in-tree supernodal LDL^T factorization that keeps
+ *  the factor on disk if it does not fit into memory.
+ *
+ *  The symbolic analysis pairs rows with a (nearly) zero diagonal, as
+ *  the constraint rows of a KKT system, with a strongly coupled
+ *  neighbor, orders the pairs and the remaining rows by approximate
+ *  minimum degree, and computes an amalgamated supernodal structure in
+ *  which each pair lies in one supernode.  Since the pairing depends on
+ *  the matrix values, the analysis is done at the first factorization.
+ *
+ *  The factorization is left-looking.  The panel of a supernode is
+ *  factorized with Bunch-Kaufman pivoting restricted to its diagonal
+ *  block; pivots that are still too small are perturbed, in which case
+ *  the matrix is reported as singular.  The panels are grouped into
+ *  blocks that are kept by an OutOfCorePanelStore, which keeps them in
+ *  memory if the factor fits into the memory limit and otherwise
+ *  streams them through a memory-mapped scratch file.
+ *
+ *  Peak memory and the amount of disk I/O are reported to the timing
+ *  statistics.
+ */
+class OutOfCoreLdlSolverInterface: public SparseSymLinearSolverInterface
+{
+public:
+   /** @name Constructor/Destructor */
+   ///@{
+   /** Constructor */
+   OutOfCoreLdlSolverInterface();
+
+   /** Destructor */
+   virtual ~OutOfCoreLdlSolverInterface();
+   ///@}
+
+   bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   /** @name Methods for requesting solution of the linear system. */
+   ///@{
+   virtual ESymSolverStatus InitializeStructure(
+      Index        dim,
+      Index        nonzeros,
+      const Index* ia,
+      const Index* ja
+   );
+
+   virtual Number* GetValuesArrayPtr();
+
+   virtual ESymSolverStatus MultiSolve(
+      bool         new_matrix,
+      const Index* ia,
+      const Index* ja,
+      Index        nrhs,
+      Number*      rhs_vals,
+      bool         check_NegEVals,
+      Index        numberOfNegEVals
+   );
+
+   virtual Index NumberOfNegEVals() const;
+   ///@}
+
+   //* @name Options of Linear solver */
+   ///@{
+   /** Request to increase quality of solution for next solve.
+    *
+    *  The pivoting is fixed by the supernodal structure, so there is
+    *  nothing that could be tightened.
+    *
+    *  @return false
+    */
+   virtual bool IncreaseQuality()
+   {
+      return false;
+   }
+
+   virtual bool ProvidesInertia() const
+   {
+      return true;
+   }
+
+   EMatrixFormat MatrixFormat() const
+   {
+      return CSR_Full_Format_0_Offset;
+   }
+   ///@}
+
+   /** All data of the factorization is owned by this object. */
+   virtual bool ProvidesConcurrentFactorization() const
+   {
+      return true;
+   }
+
+   static void RegisterOptions(
+      SmartPtr<RegisteredOptions> roptions
+   );
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   OutOfCoreLdlSolverInterface(
+      const OutOfCoreLdlSolverInterface&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const OutOfCoreLdlSolverInterface&
+   );
+   ///@}
+
+   /** @name Information about the matrix */
+   ///@{
+   /** Number of rows and columns of the matrix */
+   Index dim_;
+
+   /** Number of nonzeros of the matrix in full CSR representation. */
+   Index nonzeros_;
+
+   /** Array for storing the values of the matrix. */
+   Number* a_;
+   ///@}
+
+   /** @name Solver specific options */
+   ///@{
+   /** Memory limit for the factor in bytes */
+   size_t memory_limit_;
+   /** Directory for the scratch file */
+   std::string scratch_dir_;
+   /** Target size of a block of panels in bytes */
+   size_t block_size_;
+   /** Relative pivot tolerance */
+   Number pivtol_;
+   /** Amalgamation parameter */
+   Index nemin_;
+   ///@}
+
+   /** @name Information about most recent factorization */
+   ///@{
+   /** Number of negative eigenvalues */
+   Index negevals_;
+   /** Whether the symbolic analysis has been done for the current
+    *  structure
+    */
+   bool have_symbolic_;
+   ///@}
+
+   /** @name Symbolic factorization.
+    *
+    *  All indices below are in the permuted numbering, unless noted
+    *  otherwise.
+    */
+   ///@{
+   /** Original index of the permuted row */
+   std::vector<Index> perm_;
+   /** Permuted index of the original row */
+   std::vector<Index> iperm_;
+   /** Number of supernodes */
+   Index nsuper_;
+   /** First column of each supernode, with an additional entry dim_ */
+   std::vector<Index> super_start_;
+   /** Supernode of each column */
+   std::vector<Index> col_super_;
+   /** Start of the row structure of each supernode in super_rows_ */
+   std::vector<size_t> super_rows_ptr_;
+   /** Row structures of the supernodes.
+    *
+    *  The columns of the supernode come first, followed by the rows
+    *  below the diagonal block in increasing order.
+    */
+   std::vector<Index> super_rows_;
+   /** Block of the panel of each supernode */
+   std::vector<Index> super_block_;
+   /** Offset of the panel of each supernode within its block */
+   std::vector<size_t> super_offset_;
+   /** First supernode of each block, with an additional entry nsuper_ */
+   std::vector<Index> block_start_;
+   /** Number of entries of all panels */
+   Number factor_nonzeros_;
+   ///@}
+
+   /** @name Numerical factorization. */
+   ///@{
+   /** Row structures after the pivoting within the diagonal blocks */
+   std::vector<Index> rows_;
+   /** Diagonal entries of D, by pivot position */
+   std::vector<Number> d_diag_;
+   /** Off-diagonal entries of the 2x2 blocks of D, stored at the
+    *  position of the first pivot
+    */
+   std::vector<Number> d_off_;
+   /** Pivot type: 1 for a 1x1 pivot, 2 for the first and 0 for the
+    *  second position of a 2x2 pivot
+    */
+   std::vector<Index> piv_type_;
+   /** Storage of the panels */
+   OutOfCorePanelStore store_;
+   ///@}
+
+   /** @name Work arrays */
+   ///@{
+   std::vector<Index> map_;
+   std::vector<Index> link_head_;
+   std::vector<Index> link_next_;
+   std::vector<size_t> link_pos_;
+   std::vector<Number> work_;
+   std::vector<Number> update_;
+   std::vector<Number> x_;
+   ///@}
+
+   /** @name Internal functions */
+   ///@{
+   /** Compute the ordering and the supernodal structure */
+   bool SymbolicFactorization(
+      const Index* ia,
+      const Index* ja
+   );
+
+   /** Compute the fill-reducing ordering of the matrix with the
+    *  paired rows contracted.
+    *
+    *  @param ia     row starts of the contracted graph
+    *  @param ja     column indices of the contracted graph, without
+    *                the diagonal
+    *  @param weight number of original rows of each node
+    *  @param order  on return, the nodes in elimination order
+    */
+   void ApproximateMinimumDegree(
+      const std::vector<Index>& ia,
+      const std::vector<Index>& ja,
+      const std::vector<Index>& weight,
+      std::vector<Index>&       order
+   ) const;
+
+   /** Factorize the matrix */
+   ESymSolverStatus Factorization(
+      const Index* ia,
+      const Index* ja,
+      bool         check_NegEVals,
+      Index        numberOfNegEVals
+   );
+
+   /** Factorize the diagonal block of a panel and compute the
+    *  subdiagonal part of L.
+    *
+    *  @return number of perturbed pivots
+    */
+   Index FactorizePanel(
+      Index   s,
+      Number* panel,
+      Number  tol
+   );
+
+   /** Solve with the factorization
+    *
+    *  @return false, if a block of the factor could not be mapped
+    */
+   bool Solve(
+      Index   nrhs,
+      Number* rhs_vals
+   );
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
@@ -0,0 +1,366 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpOutOfCorePanelStore.hpp"
+#include "IpDebug.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+namespace Ipopt
+{
+
+OutOfCorePanelStore::OutOfCorePanelStore()
+   : in_core_(true),
+     memory_limit_(0),
+     resident_bytes_(0),
+     peak_resident_bytes_(0),
+     bytes_read_(0),
+     bytes_written_(0),
+#ifdef _WIN32
+     file_handle_(INVALID_HANDLE_VALUE),
+     mapping_handle_(NULL)
+#else
+     fd_(-1)
+#endif
+{ }
+
+OutOfCorePanelStore::~OutOfCorePanelStore()
+{
+   Clear();
+}
+
+bool OutOfCorePanelStore::Initialize(
+   const std::vector<size_t>& block_sizes,
+   size_t                     memory_limit,
+   const std::string&         scratch_dir
+)
+{
+   Clear();
+
+   memory_limit_ = memory_limit;
+   peak_resident_bytes_ = 0;
+   ResetStatistics();
+
+   // Block offsets in the file must be multiples of the mapping granularity
+#ifdef _WIN32
+   SYSTEM_INFO sysinfo;
+   GetSystemInfo(&sysinfo);
+   const size_t granularity = sysinfo.dwAllocationGranularity;
+#else
+   const size_t granularity = (size_t) sysconf(_SC_PAGESIZE);
+#endif
+
+   size_t total_bytes = 0;
+   size_t file_bytes = 0;
+   blocks_.resize(block_sizes.size());
+   for( size_t b = 0; b < block_sizes.size(); b++ )
+   {
+      Block& block = blocks_[b];
+      block.bytes = block_sizes[b] * sizeof(Number);
+      block.data = NULL;
+      block.pins = 0;
+      block.dirty = false;
+      block.on_disk = false;
+      block.offset = file_bytes;
+      total_bytes += block.bytes;
+      file_bytes += (block.bytes + granularity - 1) / granularity * granularity;
+   }
+
+   in_core_ = (total_bytes <= memory_limit_);
+   if( in_core_ )
+   {
+      in_core_data_.resize(total_bytes / sizeof(Number));
+      size_t pos = 0;
+      for( size_t b = 0; b < blocks_.size(); b++ )
+      {
+         blocks_[b].data = in_core_data_.empty() ? NULL : &in_core_data_[pos];
+         pos += blocks_[b].bytes / sizeof(Number);
+      }
+      resident_bytes_ = total_bytes;
+      peak_resident_bytes_ = total_bytes;
+      return true;
+   }
+
+#ifdef _WIN32
+   char dir[MAX_PATH + 1];
+   if( scratch_dir.empty() )
+   {
+      if( GetTempPathA(MAX_PATH + 1, dir) == 0 )
+      {
+         return false;
+      }
+   }
+   else
+   {
+      strncpy(dir, scratch_dir.c_str(), MAX_PATH);
+      dir[MAX_PATH] = '\0';
+   }
+   char filename[MAX_PATH + 1];
+   if( GetTempFileNameA(dir, "ipo", 0, filename) == 0 )
+   {
+      return false;
+   }
+   // the file is deleted by the system when the handle is closed
+   HANDLE file = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                             FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+   if( file == INVALID_HANDLE_VALUE )
+   {
+      DeleteFileA(filename);
+      return false;
+   }
+   file_handle_ = file;
+   ULARGE_INTEGER size;
+   size.QuadPart = file_bytes;
+   mapping_handle_ = CreateFileMappingA(file, NULL, PAGE_READWRITE, size.HighPart, size.LowPart, NULL);
+   if( mapping_handle_ == NULL )
+   {
+      Clear();
+      return false;
+   }
+#else
+   std::string filename = scratch_dir;
+   if( filename.empty() )
+   {
+      const char* tmpdir = getenv("TMPDIR");
+      filename = tmpdir != NULL ? tmpdir : "/tmp";
+   }
+   filename += "/ipopt_ooc_XXXXXX";
+   std::vector<char> name(filename.begin(), filename.end());
+   name.push_back('\0');
+   fd_ = mkstemp(&name[0]);
+   if( fd_ < 0 )
+   {
+      return false;
+   }
+   // the file is deleted by the system when the descriptor is closed
+   unlink(&name[0]);
+   if( ftruncate(fd_, (off_t) file_bytes) != 0 )
+   {
+      Clear();
+      return false;
+   }
+#endif
+
+   resident_bytes_ = 0;
+   return true;
+}
+
+void OutOfCorePanelStore::Clear()
+{
+   if( !in_core_ )
+   {
+      for( size_t b = 0; b < blocks_.size(); b++ )
+      {
+         if( blocks_[b].data != NULL )
+         {
+            // no need to write back, the file is deleted
+            blocks_[b].dirty = false;
+            Evict(blocks_[b]);
+         }
+      }
+   }
+#ifdef _WIN32
+   if( mapping_handle_ != NULL )
+   {
+      CloseHandle(mapping_handle_);
+      mapping_handle_ = NULL;
+   }
+   if( file_handle_ != INVALID_HANDLE_VALUE )
+   {
+      CloseHandle(file_handle_);
+      file_handle_ = INVALID_HANDLE_VALUE;
+   }
+#else
+   if( fd_ >= 0 )
+   {
+      close(fd_);
+      fd_ = -1;
+   }
+#endif
+   blocks_.clear();
+   lru_.clear();
+   in_core_data_.clear();
+   in_core_ = true;
+   resident_bytes_ = 0;
+}
+
+bool OutOfCorePanelStore::Map(
+   Index block_nr
+)
+{
+   Block& block = blocks_[block_nr];
+   DBG_ASSERT(block.data == NULL);
+   if( block.bytes == 0 )
+   {
+      return true;
+   }
+#ifdef _WIN32
+   ULARGE_INTEGER offset;
+   offset.QuadPart = block.offset;
+   void* addr = MapViewOfFile(mapping_handle_, FILE_MAP_ALL_ACCESS, offset.HighPart, offset.LowPart, block.bytes);
+   if( addr == NULL )
+   {
+      return false;
+   }
+#else
+   void* addr = mmap(NULL, block.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, (off_t) block.offset);
+   if( addr == MAP_FAILED )
+   {
+      return false;
+   }
+#endif
+   block.data = (Number*) addr;
+   block.dirty = false;
+   block.lru_pos = lru_.insert(lru_.end(), block_nr);
+   if( block.on_disk )
+   {
+      bytes_read_ += block.bytes;
+   }
+   resident_bytes_ += block.bytes;
+   if( resident_bytes_ > peak_resident_bytes_ )
+   {
+      peak_resident_bytes_ = resident_bytes_;
+   }
+   return true;
+}
+
+void OutOfCorePanelStore::Evict(
+   Block& block
+)
+{
+   DBG_ASSERT(block.data != NULL);
+   DBG_ASSERT(block.pins == 0);
+#ifdef _WIN32
+   if( block.dirty )
+   {
+      FlushViewOfFile(block.data, block.bytes);
+   }
+   UnmapViewOfFile(block.data);
+#else
+   if( block.dirty )
+   {
+      msync(block.data, block.bytes, MS_SYNC);
+   }
+   munmap(block.data, block.bytes);
+   // drop the pages from the page cache, otherwise the memory is not freed
+   posix_fadvise(fd_, (off_t) block.offset, (off_t) block.bytes, POSIX_FADV_DONTNEED);
+#endif
+   if( block.dirty )
+   {
+      bytes_written_ += block.bytes;
+      block.on_disk = true;
+   }
+   lru_.erase(block.lru_pos);
+   block.data = NULL;
+   block.dirty = false;
+   resident_bytes_ -= block.bytes;
+}
+
+void OutOfCorePanelStore::MakeRoom(
+   size_t bytes
+)
+{
+   // only few blocks are pinned, so the first unpinned block is found quickly
+   std::list<Index>::iterator it = lru_.begin();
+   while( resident_bytes_ + bytes > memory_limit_ )
+   {
+      while( it != lru_.end() && blocks_[*it].pins > 0 )
+      {
+         ++it;
+      }
+      if( it == lru_.end() )
+      {
+         // everything in memory is pinned; exceed the limit
+         return;
+      }
+      Block& lru = blocks_[*it];
+      ++it;
+      Evict(lru);
+   }
+}
+
+Number* OutOfCorePanelStore::Acquire(
+   Index block,
+   bool  modify
+)
+{
+   DBG_ASSERT(block >= 0 && block < (Index) blocks_.size());
+   Block& blk = blocks_[block];
+   if( in_core_ )
+   {
+      return blk.data;
+   }
+   if( blk.data == NULL )
+   {
+      MakeRoom(blk.bytes);
+      if( !Map(block) )
+      {
+         return NULL;
+      }
+   }
+   else
+   {
+      // the block becomes the most recently used one
+      lru_.splice(lru_.end(), lru_, blk.lru_pos);
+   }
+   blk.pins++;
+   if( modify )
+   {
+      blk.dirty = true;
+   }
+   return blk.data;
+}
+
+void OutOfCorePanelStore::Release(
+   Index block
+)
+{
+   DBG_ASSERT(block >= 0 && block < (Index) blocks_.size());
+   if( in_core_ )
+   {
+      return;
+   }
+   DBG_ASSERT(blocks_[block].pins > 0);
+   blocks_[block].pins--;
+}
+
+void OutOfCorePanelStore::Prefetch(
+   Index block
+)
+{
+   DBG_ASSERT(block >= 0 && block < (Index) blocks_.size());
+   Block& blk = blocks_[block];
+   if( in_core_ || blk.data != NULL || !blk.on_disk )
+   {
+      return;
+   }
+#ifdef _WIN32
+   // map the block now and let the system read it in the background
+   MakeRoom(blk.bytes);
+   if( !Map(block) )
+   {
+      return;
+   }
+# if _WIN32_WINNT >= 0x0602
+   WIN32_MEMORY_RANGE_ENTRY range;
+   range.VirtualAddress = blk.data;
+   range.NumberOfBytes = blk.bytes;
+   PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+# endif
+#else
+   posix_fadvise(fd_, (off_t) blk.offset, (off_t) blk.bytes, POSIX_FADV_WILLNEED);
+#endif
+}
+
+} // namespace Ipopt
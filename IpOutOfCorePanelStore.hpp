@@ -0,0 +1,215 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPOUTOFCOREPANELSTORE_HPP__
+#define __IPOUTOFCOREPANELSTORE_HPP__
+
+#include "IpTypes.hpp"
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Storage for the panels of a sparse factorization that may not fit
+ *  into memory.
+ *
+ *  The panels are grouped into blocks, which are the unit of mapping
+ *  and eviction.  If all blocks fit into the memory limit, they are
+ *  kept in memory.  Otherwise they live in a scratch file and a block
+ *  is memory-mapped while it is needed.  When the mapped blocks exceed
+ *  the memory limit, the least recently used unpinned blocks are
+ *  written back and unmapped.  Blocks that will be needed soon can be
+ *  prefetched, so that reading them from disk overlaps computation.
+ *
+ *  The scratch file is deleted when the store is cleared.
+ */
+class OutOfCorePanelStore
+{
+public:
+   /**@name Constructors/Destructors */
+   ///@{
+   /** Default constructor */
+   OutOfCorePanelStore();
+
+   /** Destructor */
+   ~OutOfCorePanelStore();
+   ///@}
+
+   /** Set up the storage for blocks with the given number of entries.
+    *
+    *  @param block_sizes  number of Numbers in each block
+    *  @param memory_limit number of bytes that may be kept in memory
+    *  @param scratch_dir  directory for the scratch file; the system
+    *                      temporary directory if empty
+    *
+    *  @return false, if the scratch file could not be created
+    */
+   bool Initialize(
+      const std::vector<size_t>& block_sizes,
+      size_t                     memory_limit,
+      const std::string&         scratch_dir
+   );
+
+   /** Release all blocks and delete the scratch file */
+   void Clear();
+
+   /** Whether all blocks are kept in memory */
+   bool InCore() const
+   {
+      return in_core_;
+   }
+
+   /** Get access to a block and pin it in memory until Release is
+    *  called.
+    *
+    *  @param block  number of the block
+    *  @param modify whether the block will be changed
+    *
+    *  @return the data of the block, or NULL if it could not be mapped
+    */
+   Number* Acquire(
+      Index block,
+      bool  modify
+   );
+
+   /** Unpin a block obtained from Acquire */
+   void Release(
+      Index block
+   );
+
+   /** Start reading a block from disk, if it is not in memory */
+   void Prefetch(
+      Index block
+   );
+
+   /** @name Statistics in bytes */
+   ///@{
+   /** Largest number of bytes held in memory at the same time */
+   size_t PeakResidentBytes() const
+   {
+      return peak_resident_bytes_;
+   }
+
+   /** Bytes read from the scratch file since the last call of
+    *  ResetStatistics
+    */
+   size_t BytesRead() const
+   {
+      return bytes_read_;
+   }
+
+   /** Bytes written to the scratch file since the last call of
+    *  ResetStatistics
+    */
+   size_t BytesWritten() const
+   {
+      return bytes_written_;
+   }
+
+   /** Reset the counters for read and written bytes */
+   void ResetStatistics()
+   {
+      bytes_read_ = 0;
+      bytes_written_ = 0;
+   }
+   ///@}
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   OutOfCorePanelStore(
+      const OutOfCorePanelStore&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const OutOfCorePanelStore&
+   );
+   ///@}
+
+   /** State of one block */
+   struct Block
+   {
+      /** Offset in the scratch file in bytes */
+      size_t offset;
+      /** Size in bytes */
+      size_t bytes;
+      /** Mapped address, or NULL if the block is not in memory */
+      Number* data;
+      /** Number of Acquire calls without Release */
+      Index pins;
+      /** Position in the list of mapped blocks, if the block is mapped */
+      std::list<Index>::iterator lru_pos;
+      /** Whether the block has been changed since it was mapped */
+      bool dirty;
+      /** Whether the block has been written to the scratch file */
+      bool on_disk;
+   };
+
+   /** Map a block into memory
+    *
+    *  @return false, if the block could not be mapped
+    */
+   bool Map(
+      Index block_nr
+   );
+
+   /** Write back and unmap a block */
+   void Evict(
+      Block& block
+   );
+
+   /** Evict least recently used blocks until the resident blocks
+    *  leave room for the given number of bytes.
+    */
+   void MakeRoom(
+      size_t bytes
+   );
+
+   std::vector<Block> blocks_;
+
+   /** Mapped blocks, from the least to the most recently used */
+   std::list<Index> lru_;
+
+   bool in_core_;
+   /** Storage of all blocks if in core */
+   std::vector<Number> in_core_data_;
+
+   size_t memory_limit_;
+   size_t resident_bytes_;
+
+   /** @name Statistics */
+   ///@{
+   size_t peak_resident_bytes_;
+   size_t bytes_read_;
+   size_t bytes_written_;
+   ///@}
+
+   /** @name Scratch file */
+   ///@{
+#ifdef _WIN32
+   void* file_handle_;
+   void* mapping_handle_;
+#else
+   int fd_;
+#endif
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
@@ -23,7 +23,9 @@ PDFullSpaceSolver::PDFullSpaceSolver(
    : PDSystemSolver(),
      augSysSolver_(&augSysSolver),
      perturbHandler_(&perturbHandler),
-     dummy_cache_(1)
+     dummy_cache_(1),
+     aug_rhs_x_cache_(1),
+     aug_rhs_s_cache_(1)
 {
    DBG_START_METH("PDFullSpaceSolver::PDFullSpaceSolver", dbg_verbosity);
 }
@@ -33,6 +35,14 @@ PDFullSpaceSolver::~PDFullSpaceSolver()
    DBG_START_METH("PDFullSpaceSolver::~PDFullSpaceSolver()", dbg_verbosity);
 }
 
+void PDFullSpaceSolver::AddSpeculativeSolver(
+   AugSystemSolver& augSysSolver
+)
+{
+   DBG_ASSERT(&augSysSolver != GetRawPtr(augSysSolver_));
+   speculative_solvers_.push_back(&augSysSolver);
+}
+
 void PDFullSpaceSolver::RegisterOptions(
    SmartPtr<RegisteredOptions> roptions
 )
@@ -52,6 +62,17 @@ void PDFullSpaceSolver::RegisterOptions(
       10,
       "Iterative refinement (on the full unsymmetric system) is performed for each right hand side. "
       "This option determines the maximum number of iterative refinement steps.");
+   roptions->AddStringOption2(
+      "refinement_method",
+      "Method for the iterative refinement of the solution of the primal-dual system.",
+      "fixed-point",
+      "fixed-point", "classical iterative refinement by repeated back solves",
+      "fgmres", "FGMRES on the full unsymmetric system, preconditioned by the factorization",
+      "FGMRES can attain the requested accuracy with a strongly perturbed or inaccurate factorization, "
+      "e.g., for a small pivot tolerance or a factorization in single precision, "
+      "where the classical iterative refinement would fail and ask for a refactorization. "
+      "Each step counts as one step for \"max_refinement_steps\".",
+      true);
    roptions->AddLowerBoundedNumberOption(
       "residual_ratio_max",
       "Iterative refinement tolerance",
@@ -87,6 +108,21 @@ void PDFullSpaceSolver::RegisterOptions(
       "This tolerance is alpha_n in the paper by Zavala and Chiang (2014) and "
       "it determines when the direction is considered to be sufficiently positive. "
       "A value in the range of [1e-12, 1e-11] is recommended.");
+   roptions->AddLowerBoundedIntegerOption(
+      "speculative_inertia_factorizations",
+      "Number of additional factorizations that are computed concurrently after a wrong inertia.",
+      0,
+      0,
+      "If positive, then after a factorization of the primal-dual system had the wrong inertia, "
+      "the factorizations for this many further trial values of the Hessian perturbation are computed "
+      "concurrently with the one for the next trial value, each by its own instance of the linear solver. "
+      "The smallest trial value that gives the correct inertia is used. "
+      "This needs memory for the additional factorizations and a linear solver that allows to use "
+      "several instances in concurrent threads. "
+      "Currently, this is only the case for \"oocldl\". "
+      "For all other linear solvers, including \"cuda\", \"pardiso\", and \"pardisomkl\", this option has no effect. "
+      "It is not available for custom linear solvers, the iterative augmented system solver, "
+      "and limited-memory Hessian approximations.");
    roptions->AddStringOption2(
       "neg_curv_test_reg",
       "Whether to do the curvature test with the primal regularization (see Zavala and Chiang, 2014).",
@@ -113,6 +149,9 @@ bool PDFullSpaceSolver::InitializeImpl(
    options.GetNumericValue("residual_improvement_factor", residual_improvement_factor_, prefix);
    options.GetNumericValue("neg_curv_test_tol", neg_curv_test_tol_, prefix);
    options.GetBoolValue("neg_curv_test_reg", neg_curv_test_reg_, prefix);
+   std::string refinement_method;
+   options.GetStringValue("refinement_method", refinement_method, prefix);
+   fgmres_refinement_ = (refinement_method == "fgmres");
 
    // Reset internal flags and data
    augsys_improved_ = false;
@@ -122,6 +161,28 @@ bool PDFullSpaceSolver::InitializeImpl(
       return false;
    }
 
+   // The solvers for the speculative factorizations get their own data
+   // objects, since their linear solvers record timing statistics,
+   // factorization sizes, and info strings from concurrent threads,
+   // which are not synchronized.  These records are not reported.
+   // Before the factorizations, the current iterate and the iteration
+   // counter are passed on to these data objects (see
+   // SpeculativeFactorizations), since the linear solvers may read them,
+   // e.g., for the slack-based scaling of the linear system.
+   speculative_data_.resize(speculative_solvers_.size());
+   for( size_t i = 0; i < speculative_solvers_.size(); i++ )
+   {
+      speculative_data_[i] = new IpoptData();
+      if( !speculative_data_[i]->Initialize(Jnlst(), options, prefix) )
+      {
+         return false;
+      }
+      if( !speculative_solvers_[i]->Initialize(Jnlst(), IpNLP(), *speculative_data_[i], IpCq(), options, prefix) )
+      {
+         return false;
+      }
+   }
+
    return perturbHandler_->Initialize(Jnlst(), IpNLP(), IpData(), IpCq(), options, prefix);
 }
 
@@ -134,35 +195,59 @@ bool PDFullSpaceSolver::Solve(
    bool                  improve_solution /* = false */
 )
 {
-   DBG_START_METH("PDFullSpaceSolver::Solve", dbg_verbosity);
+   std::vector<SmartPtr<const IteratesVector> > rhsV(1);
+   rhsV[0] = &rhs;
+   std::vector<SmartPtr<IteratesVector> > resV(1);
+   resV[0] = &res;
+   return MultiSolve(alpha, beta, rhsV, resV, allow_inexact, improve_solution);
+}
+
+bool PDFullSpaceSolver::MultiSolve(
+   Number                                              alpha,
+   Number                                              beta,
+   const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+   std::vector<SmartPtr<IteratesVector> >&             resV,
+   bool                                                allow_inexact,
+   bool                                                improve_solution /* = false */
+)
+{
+   DBG_START_METH("PDFullSpaceSolver::MultiSolve", dbg_verbosity);
    DBG_ASSERT(!allow_inexact || !improve_solution);
    DBG_ASSERT(!improve_solution || beta == 0.);
+   DBG_ASSERT(rhsV.size() == resV.size());
 
    // Timing of PDSystem solver starts here
    IpData().TimingStats().PDSystemSolverTotal().Start();
 
-   DBG_PRINT_VECTOR(2, "rhs_x", *rhs.x());
-   DBG_PRINT_VECTOR(2, "rhs_s", *rhs.s());
-   DBG_PRINT_VECTOR(2, "rhs_c", *rhs.y_c());
-   DBG_PRINT_VECTOR(2, "rhs_d", *rhs.y_d());
-   DBG_PRINT_VECTOR(2, "rhs_zL", *rhs.z_L());
-   DBG_PRINT_VECTOR(2, "rhs_zU", *rhs.z_U());
-   DBG_PRINT_VECTOR(2, "rhs_vL", *rhs.v_L());
-   DBG_PRINT_VECTOR(2, "rhs_vU", *rhs.v_U());
-   DBG_PRINT_VECTOR(2, "res_x in", *res.x());
-   DBG_PRINT_VECTOR(2, "res_s in", *res.s());
-   DBG_PRINT_VECTOR(2, "res_c in", *res.y_c());
-   DBG_PRINT_VECTOR(2, "res_d in", *res.y_d());
-   DBG_PRINT_VECTOR(2, "res_zL in", *res.z_L());
-   DBG_PRINT_VECTOR(2, "res_zU in", *res.z_U());
-   DBG_PRINT_VECTOR(2, "res_vL in", *res.v_L());
-   DBG_PRINT_VECTOR(2, "res_vU in", *res.v_U());
+   const Index nrhs = (Index) rhsV.size();
+   for( Index irhs = 0; irhs < nrhs; irhs++ )
+   {
+      DBG_PRINT_VECTOR(2, "rhs_x", *rhsV[irhs]->x());
+      DBG_PRINT_VECTOR(2, "rhs_s", *rhsV[irhs]->s());
+      DBG_PRINT_VECTOR(2, "rhs_c", *rhsV[irhs]->y_c());
+      DBG_PRINT_VECTOR(2, "rhs_d", *rhsV[irhs]->y_d());
+      DBG_PRINT_VECTOR(2, "rhs_zL", *rhsV[irhs]->z_L());
+      DBG_PRINT_VECTOR(2, "rhs_zU", *rhsV[irhs]->z_U());
+      DBG_PRINT_VECTOR(2, "rhs_vL", *rhsV[irhs]->v_L());
+      DBG_PRINT_VECTOR(2, "rhs_vU", *rhsV[irhs]->v_U());
+      DBG_PRINT_VECTOR(2, "res_x in", *resV[irhs]->x());
+      DBG_PRINT_VECTOR(2, "res_s in", *resV[irhs]->s());
+      DBG_PRINT_VECTOR(2, "res_c in", *resV[irhs]->y_c());
+      DBG_PRINT_VECTOR(2, "res_d in", *resV[irhs]->y_d());
+      DBG_PRINT_VECTOR(2, "res_zL in", *resV[irhs]->z_L());
+      DBG_PRINT_VECTOR(2, "res_zU in", *resV[irhs]->z_U());
+      DBG_PRINT_VECTOR(2, "res_vL in", *resV[irhs]->v_L());
+      DBG_PRINT_VECTOR(2, "res_vU in", *resV[irhs]->v_U());
+   }
 
    // if beta is nonzero, keep a copy of the incoming values in res_ */
-   SmartPtr<IteratesVector> copy_res;
+   std::vector<SmartPtr<IteratesVector> > copy_resV(nrhs);
    if( beta != 0. )
    {
-      copy_res = res.MakeNewIteratesVectorCopy();
+      for( Index irhs = 0; irhs < nrhs; irhs++ )
+      {
+         copy_resV[irhs] = resV[irhs]->MakeNewIteratesVectorCopy();
+      }
    }
 
    // Receive data about matrix
@@ -212,7 +297,7 @@ bool PDFullSpaceSolver::Solve(
       {
          solve_retval = SolveOnce(resolve_with_better_quality, pretend_singular, *W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L,
                                   *Pd_U, *z_L, *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U, *slack_s_L, *slack_s_U, *sigma_x, *sigma_s, 1., 0.,
-                                  rhs, res);
+                                  rhsV, resV);
          resolve_with_better_quality = false;
          pretend_singular = false;
       }
@@ -231,53 +316,135 @@ bool PDFullSpaceSolver::Solve(
          // no safety checks required
          if( Jnlst().ProduceOutput(J_MOREDETAILED, J_LINEAR_ALGEBRA) )
          {
-            SmartPtr<IteratesVector> resid = res.MakeNewIteratesVector(true);
-            ComputeResiduals(*W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U, *z_L, *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U,
-                             *slack_s_L, *slack_s_U, *sigma_x, *sigma_s, alpha, beta, rhs, res, *resid);
+            for( Index irhs = 0; irhs < nrhs; irhs++ )
+            {
+               SmartPtr<IteratesVector> resid = resV[irhs]->MakeNewIteratesVector(true);
+               ComputeResiduals(*W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U, *z_L, *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U,
+                                *slack_s_L, *slack_s_U, *sigma_x, *sigma_s, alpha, beta, *rhsV[irhs], *resV[irhs], *resid);
+            }
          }
          break;
       }
 
-      // Get space for the residual
-      SmartPtr<IteratesVector> resid = res.MakeNewIteratesVector(true);
+      // Get space for the residuals
+      std::vector<SmartPtr<const IteratesVector> > residV(nrhs);
+      std::vector<Number> residual_ratio(nrhs);
+      for( Index irhs = 0; irhs < nrhs; irhs++ )
+      {
+         SmartPtr<IteratesVector> resid = resV[irhs]->MakeNewIteratesVector(true);
 
-      // ToDo don't to that after max refinement?
-      ComputeResiduals(*W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U, *z_L, *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U,
-                       *slack_s_L, *slack_s_U, *sigma_x, *sigma_s, alpha, beta, rhs, res, *resid);
+         // ToDo don't to that after max refinement?
+         ComputeResiduals(*W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U, *z_L, *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U,
+                          *slack_s_L, *slack_s_U, *sigma_x, *sigma_s, alpha, beta, *rhsV[irhs], *resV[irhs], *resid);
 
-      Number residual_ratio = ComputeResidualRatio(rhs, res, *resid);
-      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
-                     "residual_ratio = %e\n", residual_ratio);
-      Number residual_ratio_old = residual_ratio;
+         residual_ratio[irhs] = ComputeResidualRatio(*rhsV[irhs], *resV[irhs], *resid);
+         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                        "residual_ratio = %e\n", residual_ratio[irhs]);
+         residV[irhs] = ConstPtr(resid);
+      }
+      std::vector<Number> residual_ratio_old(residual_ratio);
 
       // Beginning of loop for iterative refinement
       Index num_iter_ref = 0;
       bool quit_refinement = false;
-      while( /* !allow_inexact &&*/ !quit_refinement   // allow_inexact is always false here
-                                    && (num_iter_ref < min_refinement_steps_ || residual_ratio > residual_ratio_max_) )
+      // right hand sides whose solutions are refined in the current step
+      std::vector<Index> refine;
+      while( /* !allow_inexact &&*/ !quit_refinement )   // allow_inexact is always false here
       {
+         refine.clear();
+         for( Index irhs = 0; irhs < nrhs; irhs++ )
+         {
+            if( num_iter_ref < min_refinement_steps_ || residual_ratio[irhs] > residual_ratio_max_ )
+            {
+               refine.push_back(irhs);
+            }
+         }
+         if( refine.empty() )
+         {
+            break;
+         }
 
-         // To the next back solve
-         solve_retval = SolveOnce(resolve_with_better_quality, false, *W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U, *z_L,
-                                  *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U, *slack_s_L, *slack_s_U, *sigma_x, *sigma_s, -1., 1., *resid, res);
-         ASSERT_EXCEPTION(solve_retval, INTERNAL_ABORT, "SolveOnce returns false during iterative refinement.");
+         if( fgmres_refinement_ )
+         {
+            // One FGMRES cycle with the remaining refinement steps for
+            // each right hand side; if it stops without success, the
+            // next cycle is a restart
+            Index steps = 0;
+            for( size_t k = 0; k < refine.size(); k++ )
+            {
+               Index irhs = refine[k];
+               SmartPtr<IteratesVector> resid = residV[irhs]->MakeNewIteratesVectorCopy();
+               steps = Max(steps, FGMRESRefinement(Max(Index(1), max_refinement_steps_ + 1 - num_iter_ref),
+                                                   min_refinement_steps_ - num_iter_ref, *W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U,
+                                                   *z_L, *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U, *slack_s_L, *slack_s_U, *sigma_x,
+                                                   *sigma_s, *rhsV[irhs], *resV[irhs], *resid, residual_ratio[irhs]));
+               residV[irhs] = ConstPtr(resid);
+            }
+            if( steps == 0 )
+            {
+               // the Krylov spaces cannot be extended, so treat this like
+               // the maximal number of refinement steps
+               num_iter_ref = max_refinement_steps_ + 1;
+            }
+            else
+            {
+               num_iter_ref += steps;
+            }
+         }
+         else
+         {
+            // To the next back solve
+            std::vector<SmartPtr<const IteratesVector> > refine_residV(refine.size());
+            std::vector<SmartPtr<IteratesVector> > refine_resV(refine.size());
+            for( size_t k = 0; k < refine.size(); k++ )
+            {
+               refine_residV[k] = residV[refine[k]];
+               refine_resV[k] = resV[refine[k]];
+            }
+            solve_retval = SolveOnce(resolve_with_better_quality, false, *W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U, *z_L,
+                                     *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U, *slack_s_L, *slack_s_U, *sigma_x, *sigma_s, -1., 1.,
+                                     refine_residV, refine_resV);
+            ASSERT_EXCEPTION(solve_retval, INTERNAL_ABORT, "SolveOnce returns false during iterative refinement.");
 
-         ComputeResiduals(*W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U, *z_L, *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U,
-                          *slack_s_L, *slack_s_U, *sigma_x, *sigma_s, alpha, beta, rhs, res, *resid);
+            for( size_t k = 0; k < refine.size(); k++ )
+            {
+               Index irhs = refine[k];
+               SmartPtr<IteratesVector> resid = resV[irhs]->MakeNewIteratesVector(true);
+               ComputeResiduals(*W, *J_c, *J_d, *Px_L, *Px_U, *Pd_L, *Pd_U, *z_L, *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U,
+                                *slack_s_L, *slack_s_U, *sigma_x, *sigma_s, alpha, beta, *rhsV[irhs], *resV[irhs], *resid);
 
-         residual_ratio = ComputeResidualRatio(rhs, res, *resid);
-         Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
-                        "residual_ratio = %e\n", residual_ratio);
+               residual_ratio[irhs] = ComputeResidualRatio(*rhsV[irhs], *resV[irhs], *resid);
+               Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                              "residual_ratio = %e\n", residual_ratio[irhs]);
+               residV[irhs] = ConstPtr(resid);
+               IpData().Inc_info_refinement_steps();
+            }
+
+            num_iter_ref++;
+         }
 
-         num_iter_ref++;
-         // Check if we have to give up on iterative refinement
-         if( residual_ratio > residual_ratio_max_ && num_iter_ref > min_refinement_steps_
-             && (num_iter_ref > max_refinement_steps_
-                 || residual_ratio > residual_improvement_factor_ * residual_ratio_old) )
+         // Check if we have to give up on iterative refinement; this is
+         // decided for the worst of the refined solutions, since all
+         // remedies modify the common matrix
+         bool refinement_failed = false;
+         Number worst_residual_ratio = 0.;
+         for( size_t k = 0; k < refine.size(); k++ )
+         {
+            Index irhs = refine[k];
+            if( residual_ratio[irhs] > residual_ratio_max_ && num_iter_ref > min_refinement_steps_
+                && (num_iter_ref > max_refinement_steps_
+                    || residual_ratio[irhs] > residual_improvement_factor_ * residual_ratio_old[irhs]) )
+            {
+               refinement_failed = true;
+            }
+            worst_residual_ratio = Max(worst_residual_ratio, residual_ratio[irhs]);
+            residual_ratio_old[irhs] = residual_ratio[irhs];
+         }
+         if( refinement_failed )
          {
 
             Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
-                           "Iterative refinement failed with residual_ratio = %e\n", residual_ratio);
+                           "Iterative refinement failed with residual_ratio = %e\n", worst_residual_ratio);
             quit_refinement = true;
 
             // Pretend singularity only once - if it didn't help, we
@@ -293,7 +460,7 @@ bool PDFullSpaceSolver::Solve(
                {
                   Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
                                  "Asking augmented system solver to improve quality of its solutions.\n");
-                  augsys_improved_ = augSysSolver_->IncreaseQuality();
+                  augsys_improved_ = IncreaseQuality();
                   if( augsys_improved_ )
                   {
                      IpData().Append_info_string("q");
@@ -320,7 +487,7 @@ bool PDFullSpaceSolver::Solve(
                   // let's only conclude that the current linear system
                   // including modifications is singular, if the residual is
                   // quite bad
-                  if( residual_ratio < residual_ratio_singular_ )
+                  if( worst_residual_ratio < residual_ratio_singular_ )
                   {
                      pretend_singular = false;
                      IpData().Append_info_string("S");
@@ -341,8 +508,6 @@ bool PDFullSpaceSolver::Solve(
                DBG_PRINT((1, "Resetting pretend_singular to false.\n"));
             }
          }
-
-         residual_ratio_old = residual_ratio;
       } // End of loop for iterative refinement
 
       done = !(resolve_with_better_quality) && !(pretend_singular);
@@ -350,30 +515,180 @@ bool PDFullSpaceSolver::Solve(
    } // End of loop for solving the linear system (incl. modifications)
 
    // Finally let's assemble the res result vectors
-   if( alpha != 0. )
+   for( Index irhs = 0; irhs < nrhs; irhs++ )
    {
-      res.Scal(alpha);
+      IteratesVector& res = *resV[irhs];
+      if( alpha != 0. )
+      {
+         res.Scal(alpha);
+      }
+
+      if( beta != 0. )
+      {
+         res.Axpy(beta, *copy_resV[irhs]);
+      }
+
+      DBG_PRINT_VECTOR(2, "res_x", *res.x());
+      DBG_PRINT_VECTOR(2, "res_s", *res.s());
+      DBG_PRINT_VECTOR(2, "res_c", *res.y_c());
+      DBG_PRINT_VECTOR(2, "res_d", *res.y_d());
+      DBG_PRINT_VECTOR(2, "res_zL", *res.z_L());
+      DBG_PRINT_VECTOR(2, "res_zU", *res.z_U());
+      DBG_PRINT_VECTOR(2, "res_vL", *res.v_L());
+      DBG_PRINT_VECTOR(2, "res_vU", *res.v_U());
    }
 
-   if( beta != 0. )
+   IpData().TimingStats().PDSystemSolverTotal().End();
+
+   return true;
+}
+
+bool PDFullSpaceSolver::BackSolve(
+   Number                alpha,
+   const IteratesVector& rhs,
+   IteratesVector&       res
+)
+{
+   DBG_START_METH("PDFullSpaceSolver::BackSolve", dbg_verbosity);
+
+   SmartPtr<const SymMatrix> W = IpData().W();
+   SmartPtr<const Matrix> J_c = IpCq().curr_jac_c();
+   SmartPtr<const Matrix> J_d = IpCq().curr_jac_d();
+   SmartPtr<const Vector> z_L = IpData().curr()->z_L();
+   SmartPtr<const Vector> z_U = IpData().curr()->z_U();
+   SmartPtr<const Vector> v_L = IpData().curr()->v_L();
+   SmartPtr<const Vector> v_U = IpData().curr()->v_U();
+   SmartPtr<const Vector> slack_x_L = IpCq().curr_slack_x_L();
+   SmartPtr<const Vector> slack_x_U = IpCq().curr_slack_x_U();
+   SmartPtr<const Vector> slack_s_L = IpCq().curr_slack_s_L();
+   SmartPtr<const Vector> slack_s_U = IpCq().curr_slack_s_U();
+   SmartPtr<const Vector> sigma_x = IpCq().curr_sigma_x();
+   SmartPtr<const Vector> sigma_s = IpCq().curr_sigma_s();
+
+   // The factorization can only be reused if the matrix has not changed
+   // since the most recent solve
+   std::vector<const TaggedObject*> deps;
+   GetSystemDependencies(*W, *J_c, *J_d, *z_L, *z_U, *v_L, *v_U, *slack_x_L, *slack_x_U, *slack_s_L, *slack_s_U, *sigma_x,
+                         *sigma_s, deps);
+   void* dummy = NULL;
+   if( !dummy_cache_.GetCachedResult(dummy, deps) )
+   {
+      return Solve(alpha, 0., rhs, res, true);
+   }
+
+   IpData().TimingStats().PDSystemSolverTotal().Start();
+
+   SmartPtr<const Matrix> Px_L = IpNLP().Px_L();
+   SmartPtr<const Matrix> Px_U = IpNLP().Px_U();
+   SmartPtr<const Matrix> Pd_L = IpNLP().Pd_L();
+   SmartPtr<const Matrix> Pd_U = IpNLP().Pd_U();
+
+   // The right hand sides of the augmented system for x and s are only
+   // computed if their ingredients changed since the previous call
+   SmartPtr<const Vector> augRhs_x;
+   std::vector<const TaggedObject*> rhs_deps(5);
+   rhs_deps[0] = GetRawPtr(rhs.x());
+   rhs_deps[1] = GetRawPtr(rhs.z_L());
+   rhs_deps[2] = GetRawPtr(rhs.z_U());
+   rhs_deps[3] = GetRawPtr(slack_x_L);
+   rhs_deps[4] = GetRawPtr(slack_x_U);
+   if( !aug_rhs_x_cache_.GetCachedResult(augRhs_x, rhs_deps) )
    {
-      res.Axpy(beta, *copy_res);
+      SmartPtr<Vector> tmp = rhs.x()->MakeNewCopy();
+      Px_L->AddMSinvZ(1.0, *slack_x_L, *rhs.z_L(), *tmp);
+      Px_U->AddMSinvZ(-1.0, *slack_x_U, *rhs.z_U(), *tmp);
+      augRhs_x = ConstPtr(tmp);
+      aug_rhs_x_cache_.AddCachedResult(augRhs_x, rhs_deps);
+   }
+
+   SmartPtr<const Vector> augRhs_s;
+   rhs_deps[0] = GetRawPtr(rhs.s());
+   rhs_deps[1] = GetRawPtr(rhs.v_L());
+   rhs_deps[2] = GetRawPtr(rhs.v_U());
+   rhs_deps[3] = GetRawPtr(slack_s_L);
+   rhs_deps[4] = GetRawPtr(slack_s_U);
+   if( !aug_rhs_s_cache_.GetCachedResult(augRhs_s, rhs_deps) )
+   {
+      SmartPtr<Vector> tmp = rhs.s()->MakeNewCopy();
+      Pd_L->AddMSinvZ(1.0, *slack_s_L, *rhs.v_L(), *tmp);
+      Pd_U->AddMSinvZ(-1.0, *slack_s_U, *rhs.v_U(), *tmp);
+      augRhs_s = ConstPtr(tmp);
+      aug_rhs_s_cache_.AddCachedResult(augRhs_s, rhs_deps);
+   }
+
+   Number delta_x;
+   Number delta_s;
+   Number delta_c;
+   Number delta_d;
+   perturbHandler_->CurrentPerturbation(delta_x, delta_s, delta_c, delta_d);
+
+   // The solution is computed directly in res and scaled at the end
+   IpData().TimingStats().PDSystemSolverSolveOnce().Start();
+   ESymSolverStatus retval = augSysSolver_->Solve(GetRawPtr(W), 1.0, GetRawPtr(sigma_x), delta_x, GetRawPtr(sigma_s),
+                             delta_s, GetRawPtr(J_c), NULL, delta_c, GetRawPtr(J_d), NULL, delta_d, *augRhs_x, *augRhs_s,
+                             *rhs.y_c(), *rhs.y_d(), *res.x_NonConst(), *res.s_NonConst(), *res.y_c_NonConst(),
+                             *res.y_d_NonConst(), false, 0);
+   if( retval != SYMSOLVER_SUCCESS )
+   {
+      IpData().TimingStats().PDSystemSolverSolveOnce().End();
+      IpData().TimingStats().PDSystemSolverTotal().End();
+      return false;
+   }
+
+   Px_L->SinvBlrmZMTdBr(-1., *slack_x_L, *rhs.z_L(), *z_L, *res.x(), *res.z_L_NonConst());
+   Px_U->SinvBlrmZMTdBr(1., *slack_x_U, *rhs.z_U(), *z_U, *res.x(), *res.z_U_NonConst());
+   Pd_L->SinvBlrmZMTdBr(-1., *slack_s_L, *rhs.v_L(), *v_L, *res.s(), *res.v_L_NonConst());
+   Pd_U->SinvBlrmZMTdBr(1., *slack_s_U, *rhs.v_U(), *v_U, *res.s(), *res.v_U_NonConst());
+   IpData().TimingStats().PDSystemSolverSolveOnce().End();
+
+   if( alpha != 1. )
+   {
+      res.Scal(alpha);
    }
 
    DBG_PRINT_VECTOR(2, "res_x", *res.x());
    DBG_PRINT_VECTOR(2, "res_s", *res.s());
    DBG_PRINT_VECTOR(2, "res_c", *res.y_c());
    DBG_PRINT_VECTOR(2, "res_d", *res.y_d());
-   DBG_PRINT_VECTOR(2, "res_zL", *res.z_L());
-   DBG_PRINT_VECTOR(2, "res_zU", *res.z_U());
-   DBG_PRINT_VECTOR(2, "res_vL", *res.v_L());
-   DBG_PRINT_VECTOR(2, "res_vU", *res.v_U());
 
    IpData().TimingStats().PDSystemSolverTotal().End();
 
    return true;
 }
 
+void PDFullSpaceSolver::GetSystemDependencies(
+   const SymMatrix&                  W,
+   const Matrix&                     J_c,
+   const Matrix&                     J_d,
+   const Vector&                     z_L,
+   const Vector&                     z_U,
+   const Vector&                     v_L,
+   const Vector&                     v_U,
+   const Vector&                     slack_x_L,
+   const Vector&                     slack_x_U,
+   const Vector&                     slack_s_L,
+   const Vector&                     slack_s_U,
+   const Vector&                     sigma_x,
+   const Vector&                     sigma_s,
+   std::vector<const TaggedObject*>& deps
+)
+{
+   deps.resize(13);
+   deps[0] = &W;
+   deps[1] = &J_c;
+   deps[2] = &J_d;
+   deps[3] = &z_L;
+   deps[4] = &z_U;
+   deps[5] = &v_L;
+   deps[6] = &v_U;
+   deps[7] = &slack_x_L;
+   deps[8] = &slack_x_U;
+   deps[9] = &slack_s_L;
+   deps[10] = &slack_s_U;
+   deps[11] = &sigma_x;
+   deps[12] = &sigma_s;
+}
+
 bool PDFullSpaceSolver::SolveOnce(
    bool                  resolve_with_better_quality,
    bool                  pretend_singular,
@@ -399,6 +714,40 @@ bool PDFullSpaceSolver::SolveOnce(
    const IteratesVector& rhs,
    IteratesVector&       res
 )
+{
+   std::vector<SmartPtr<const IteratesVector> > rhsV(1);
+   rhsV[0] = &rhs;
+   std::vector<SmartPtr<IteratesVector> > resV(1);
+   resV[0] = &res;
+   return SolveOnce(resolve_with_better_quality, pretend_singular, W, J_c, J_d, Px_L, Px_U, Pd_L, Pd_U, z_L, z_U, v_L, v_U,
+                    slack_x_L, slack_x_U, slack_s_L, slack_s_U, sigma_x, sigma_s, alpha, beta, rhsV, resV);
+}
+
+bool PDFullSpaceSolver::SolveOnce(
+   bool                                                resolve_with_better_quality,
+   bool                                                pretend_singular,
+   const SymMatrix&                                    W,
+   const Matrix&                                       J_c,
+   const Matrix&                                       J_d,
+   const Matrix&                                       Px_L,
+   const Matrix&                                       Px_U,
+   const Matrix&                                       Pd_L,
+   const Matrix&                                       Pd_U,
+   const Vector&                                       z_L,
+   const Vector&                                       z_U,
+   const Vector&                                       v_L,
+   const Vector&                                       v_U,
+   const Vector&                                       slack_x_L,
+   const Vector&                                       slack_x_U,
+   const Vector&                                       slack_s_L,
+   const Vector&                                       slack_s_U,
+   const Vector&                                       sigma_x,
+   const Vector&                                       sigma_s,
+   Number                                              alpha,
+   Number                                              beta,
+   const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+   std::vector<SmartPtr<IteratesVector> >&             resV
+)
 {
    // TO DO LIST:
    //
@@ -414,33 +763,49 @@ bool PDFullSpaceSolver::SolveOnce(
 
    IpData().TimingStats().PDSystemSolverSolveOnce().Start();
 
-   // Compute the right hand side for the augmented system formulation
-   SmartPtr<Vector> augRhs_x = rhs.x()->MakeNewCopy();
-   Px_L.AddMSinvZ(1.0, slack_x_L, *rhs.z_L(), *augRhs_x);
-   Px_U.AddMSinvZ(-1.0, slack_x_U, *rhs.z_U(), *augRhs_x);
-
-   SmartPtr<Vector> augRhs_s = rhs.s()->MakeNewCopy();
-   Pd_L.AddMSinvZ(1.0, slack_s_L, *rhs.v_L(), *augRhs_s);
-   Pd_U.AddMSinvZ(-1.0, slack_s_U, *rhs.v_U(), *augRhs_s);
-
-   // Get space into which we can put the solution of the augmented system
-   SmartPtr<IteratesVector> sol = res.MakeNewIteratesVector(true);
+   const Index nrhs = (Index) rhsV.size();
+   DBG_ASSERT(nrhs > 0);
+   DBG_ASSERT(nrhs == (Index) resV.size());
+   const IteratesVector& rhs = *rhsV[0];
+
+   // Compute the right hand sides for the augmented system formulation
+   // and get space into which we can put the solutions of the augmented
+   // system
+   std::vector<SmartPtr<const Vector> > augRhs_xV(nrhs);
+   std::vector<SmartPtr<const Vector> > augRhs_sV(nrhs);
+   std::vector<SmartPtr<const Vector> > rhs_cV(nrhs);
+   std::vector<SmartPtr<const Vector> > rhs_dV(nrhs);
+   std::vector<SmartPtr<IteratesVector> > solV(nrhs);
+   std::vector<SmartPtr<Vector> > sol_xV(nrhs);
+   std::vector<SmartPtr<Vector> > sol_sV(nrhs);
+   std::vector<SmartPtr<Vector> > sol_cV(nrhs);
+   std::vector<SmartPtr<Vector> > sol_dV(nrhs);
+   for( Index irhs = 0; irhs < nrhs; irhs++ )
+   {
+      SmartPtr<Vector> augRhs_x = rhsV[irhs]->x()->MakeNewCopy();
+      Px_L.AddMSinvZ(1.0, slack_x_L, *rhsV[irhs]->z_L(), *augRhs_x);
+      Px_U.AddMSinvZ(-1.0, slack_x_U, *rhsV[irhs]->z_U(), *augRhs_x);
+      augRhs_xV[irhs] = ConstPtr(augRhs_x);
+
+      SmartPtr<Vector> augRhs_s = rhsV[irhs]->s()->MakeNewCopy();
+      Pd_L.AddMSinvZ(1.0, slack_s_L, *rhsV[irhs]->v_L(), *augRhs_s);
+      Pd_U.AddMSinvZ(-1.0, slack_s_U, *rhsV[irhs]->v_U(), *augRhs_s);
+      augRhs_sV[irhs] = ConstPtr(augRhs_s);
+
+      rhs_cV[irhs] = rhsV[irhs]->y_c();
+      rhs_dV[irhs] = rhsV[irhs]->y_d();
+
+      solV[irhs] = resV[irhs]->MakeNewIteratesVector(true);
+      sol_xV[irhs] = solV[irhs]->x_NonConst();
+      sol_sV[irhs] = solV[irhs]->s_NonConst();
+      sol_cV[irhs] = solV[irhs]->y_c_NonConst();
+      sol_dV[irhs] = solV[irhs]->y_d_NonConst();
+   }
 
    // Now check whether any data has changed
-   std::vector<const TaggedObject*> deps(13);
-   deps[0] = &W;
-   deps[1] = &J_c;
-   deps[2] = &J_d;
-   deps[3] = &z_L;
-   deps[4] = &z_U;
-   deps[5] = &v_L;
-   deps[6] = &v_U;
-   deps[7] = &slack_x_L;
-   deps[8] = &slack_x_U;
-   deps[9] = &slack_s_L;
-   deps[10] = &slack_s_U;
-   deps[11] = &sigma_x;
-   deps[12] = &sigma_s;
+   std::vector<const TaggedObject*> deps;
+   GetSystemDependencies(W, J_c, J_d, z_L, z_U, v_L, v_U, slack_x_L, slack_x_U, slack_s_L, slack_s_U, sigma_x, sigma_s,
+                         deps);
    void* dummy = NULL;
    bool uptodate = dummy_cache_.GetCachedResult(dummy, deps);
    if( !uptodate )
@@ -472,9 +837,8 @@ bool PDFullSpaceSolver::SolveOnce(
       // method has already asked the augSysSolver to increase the
       // quality at the end solve, and we are now getting the solution
       // with that better quality
-      retval = augSysSolver_->Solve(&W, 1.0, &sigma_x, delta_x, &sigma_s, delta_s, &J_c, NULL, delta_c, &J_d, NULL,
-                                    delta_d, *augRhs_x, *augRhs_s, *rhs.y_c(), *rhs.y_d(), *sol->x_NonConst(), *sol->s_NonConst(),
-                                    *sol->y_c_NonConst(), *sol->y_d_NonConst(), false, 0);
+      retval = augSysSolver_->MultiSolve(&W, 1.0, &sigma_x, delta_x, &sigma_s, delta_s, &J_c, NULL, delta_c, &J_d, NULL,
+                                         delta_d, augRhs_xV, augRhs_sV, rhs_cV, rhs_dV, sol_xV, sol_sV, sol_cV, sol_dV, false, 0);
       if( retval != SYMSOLVER_SUCCESS )
       {
          IpData().TimingStats().PDSystemSolverSolveOnce().End();
@@ -516,9 +880,9 @@ bool PDFullSpaceSolver::SolveOnce(
             {
                check_inertia = false;
             }
-            retval = augSysSolver_->Solve(&W, 1.0, &sigma_x, delta_x, &sigma_s, delta_s, &J_c, NULL, delta_c, &J_d,
-                                          NULL, delta_d, *augRhs_x, *augRhs_s, *rhs.y_c(), *rhs.y_d(), *sol->x_NonConst(), *sol->s_NonConst(),
-                                          *sol->y_c_NonConst(), *sol->y_d_NonConst(), check_inertia, numberOfEVals);
+            retval = augSysSolver_->MultiSolve(&W, 1.0, &sigma_x, delta_x, &sigma_s, delta_s, &J_c, NULL, delta_c, &J_d,
+                                               NULL, delta_d, augRhs_xV, augRhs_sV, rhs_cV, rhs_dV, sol_xV, sol_sV, sol_cV, sol_dV,
+                                               check_inertia, numberOfEVals);
          }
          if( retval == SYMSOLVER_FATAL_ERROR )
          {
@@ -551,7 +915,7 @@ bool PDFullSpaceSolver::SolveOnce(
             {
                Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
                               "Asking augmented system solver to improve quality of its solutions.\n");
-               augsys_improved_ = augSysSolver_->IncreaseQuality();
+               augsys_improved_ = IncreaseQuality();
                if( augsys_improved_ )
                {
                   IpData().Append_info_string("q");
@@ -588,6 +952,21 @@ bool PDFullSpaceSolver::SolveOnce(
                IpData().TimingStats().PDSystemSolverSolveOnce().End();
                return false;
             }
+            if( retval == SYMSOLVER_WRONG_INERTIA && !speculative_solvers_.empty()
+                && augSysSolver_->ProvidesConcurrentFactorization() )
+            {
+               // Factorize the system for the next trial perturbations
+               // concurrently and skip those with the wrong inertia
+               pert_return = SpeculativeFactorizations(W, J_c, J_d, sigma_x, sigma_s, *augRhs_xV[0], *augRhs_sV[0], *rhs.y_c(),
+                                                       *rhs.y_d(), numberOfEVals, delta_x, delta_s, delta_c, delta_d, count);
+               if( !pert_return )
+               {
+                  Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                                 "PerturbForWrongInertia can't be done after speculative factorizations.\n");
+                  IpData().TimingStats().PDSystemSolverSolveOnce().End();
+                  return false;
+               }
+            }
          }
          else if (neg_curv_test_tol_ > 0.)
          {
@@ -596,31 +975,37 @@ bool PDFullSpaceSolver::SolveOnce(
             Index neg_values = augSysSolver_->NumberOfNegEVals();
             if (neg_values != numberOfEVals)
             {
-               // check if we have a direction of sufficient positive curvature
-               SmartPtr<Vector> x_tmp = sol->x()->MakeNew();
-               W.MultVector(1., *sol->x(), 0., *x_tmp);
-               Number xWx = x_tmp->Dot(*sol->x());
-               x_tmp->Copy(*sol->x());
-               x_tmp->ElementWiseMultiply(sigma_x);
-               xWx += x_tmp->Dot(*sol->x());
-               SmartPtr<Vector> s_tmp = sol->s()->MakeNewCopy();
-               s_tmp->ElementWiseMultiply(sigma_s);
-               xWx += s_tmp->Dot(*sol->s());
-               if (neg_curv_test_reg_)
+               // check if we have directions of sufficient positive curvature
+               bool sufficient_curvature = true;
+               for( Index irhs = 0; irhs < nrhs && sufficient_curvature; irhs++ )
                {
-                  x_tmp->Copy(*sol->x());
-                  x_tmp->Scal(delta_x);
-                  xWx += x_tmp->Dot(*sol->x());
+                  const IteratesVector& sol = *solV[irhs];
+                  SmartPtr<Vector> x_tmp = sol.x()->MakeNew();
+                  W.MultVector(1., *sol.x(), 0., *x_tmp);
+                  Number xWx = x_tmp->Dot(*sol.x());
+                  x_tmp->Copy(*sol.x());
+                  x_tmp->ElementWiseMultiply(sigma_x);
+                  xWx += x_tmp->Dot(*sol.x());
+                  SmartPtr<Vector> s_tmp = sol.s()->MakeNewCopy();
+                  s_tmp->ElementWiseMultiply(sigma_s);
+                  xWx += s_tmp->Dot(*sol.s());
+                  if (neg_curv_test_reg_)
+                  {
+                     x_tmp->Copy(*sol.x());
+                     x_tmp->Scal(delta_x);
+                     xWx += x_tmp->Dot(*sol.x());
 
-                  s_tmp->Copy(*sol->s());
-                  s_tmp->Scal(delta_s);
-                  xWx += s_tmp->Dot(*sol->s());
+                     s_tmp->Copy(*sol.s());
+                     s_tmp->Scal(delta_s);
+                     xWx += s_tmp->Dot(*sol.s());
+                  }
+                  Number xs_nrmsq = std::pow(sol.x()->Nrm2(), 2) + std::pow(sol.s()->Nrm2(), 2);
+                  Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                                 "In inertia heuristic: xWx = %e xx = %e\n",
+                                 xWx, xs_nrmsq);
+                  sufficient_curvature = (xWx >= neg_curv_test_tol_ * xs_nrmsq);
                }
-               Number xs_nrmsq = std::pow(sol->x()->Nrm2(), 2) + std::pow(sol->s()->Nrm2(), 2);
-               Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
-                              "In inertia heuristic: xWx = %e xx = %e\n",
-                              xWx, xs_nrmsq);
-               if (xWx < neg_curv_test_tol_ * xs_nrmsq)
+               if (!sufficient_curvature)
                {
                   Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
                                  "    -> Redo with modified matrix.\n");
@@ -649,20 +1034,158 @@ bool PDFullSpaceSolver::SolveOnce(
       IpData().setPDPert(delta_x, delta_s, delta_c, delta_d);
    }
 
-   // Compute the remaining sol Vectors
-   Px_L.SinvBlrmZMTdBr(-1., slack_x_L, *rhs.z_L(), z_L, *sol->x(), *sol->z_L_NonConst());
-   Px_U.SinvBlrmZMTdBr(1., slack_x_U, *rhs.z_U(), z_U, *sol->x(), *sol->z_U_NonConst());
-   Pd_L.SinvBlrmZMTdBr(-1., slack_s_L, *rhs.v_L(), v_L, *sol->s(), *sol->v_L_NonConst());
-   Pd_U.SinvBlrmZMTdBr(1., slack_s_U, *rhs.v_U(), v_U, *sol->s(), *sol->v_U_NonConst());
+   for( Index irhs = 0; irhs < nrhs; irhs++ )
+   {
+      const IteratesVector& rhs_i = *rhsV[irhs];
+      IteratesVector& sol = *solV[irhs];
+
+      // Compute the remaining sol Vectors
+      Px_L.SinvBlrmZMTdBr(-1., slack_x_L, *rhs_i.z_L(), z_L, *sol.x(), *sol.z_L_NonConst());
+      Px_U.SinvBlrmZMTdBr(1., slack_x_U, *rhs_i.z_U(), z_U, *sol.x(), *sol.z_U_NonConst());
+      Pd_L.SinvBlrmZMTdBr(-1., slack_s_L, *rhs_i.v_L(), v_L, *sol.s(), *sol.v_L_NonConst());
+      Pd_U.SinvBlrmZMTdBr(1., slack_s_U, *rhs_i.v_U(), v_U, *sol.s(), *sol.v_U_NonConst());
 
-   // Finally let's assemble the res result vectors
-   res.AddOneVector(alpha, *sol, beta);
+      // Finally let's assemble the res result vectors
+      resV[irhs]->AddOneVector(alpha, sol, beta);
+   }
 
    IpData().TimingStats().PDSystemSolverSolveOnce().End();
 
    return true;
 }
 
+bool PDFullSpaceSolver::SpeculativeFactorizations(
+   const SymMatrix& W,
+   const Matrix&    J_c,
+   const Matrix&    J_d,
+   const Vector&    sigma_x,
+   const Vector&    sigma_s,
+   const Vector&    proto_x,
+   const Vector&    proto_s,
+   const Vector&    proto_c,
+   const Vector&    proto_d,
+   Index            numberOfEVals,
+   Number&          delta_x,
+   Number&          delta_s,
+   Number&          delta_c,
+   Number&          delta_d,
+   Index&           count
+)
+{
+   DBG_START_METH("PDFullSpaceSolver::SpeculativeFactorizations", dbg_verbosity);
+
+   // pass the current iterate on to the data of the speculative solvers
+   for( size_t i = 0; i < speculative_data_.size(); i++ )
+   {
+      SmartPtr<IteratesVector> curr = IpData().curr()->MakeNewContainer();
+      speculative_data_[i]->set_trial(curr);
+      speculative_data_[i]->AcceptTrialPoint();
+      speculative_data_[i]->Set_iter_count(IpData().iter_count());
+   }
+
+   std::vector<Number> trial_delta_x;
+   std::vector<AugSystemSolver*> solvers;
+   std::vector<ESymSolverStatus> status;
+   for( ;; )
+   {
+      // the trial matrices are set up with the same perturbation for x and s
+      if( delta_s != delta_x )
+      {
+         return true;
+      }
+      // delta_c and delta_d of the trial matrices
+      const Number trial_delta_c = delta_c;
+      const Number trial_delta_d = delta_d;
+
+      // the first trial value is factorized by the augmented system
+      // solver, the following ones by the speculative solvers
+      Index ntrials = 1 + perturbHandler_->WrongInertiaTrials((Index) speculative_solvers_.size(), trial_delta_x);
+      if( ntrials == 1 )
+      {
+         return true;
+      }
+      trial_delta_x.insert(trial_delta_x.begin(), delta_x);
+      solvers.resize(ntrials);
+      solvers[0] = GetRawPtr(augSysSolver_);
+      for( Index i = 1; i < ntrials; i++ )
+      {
+         solvers[i] = GetRawPtr(speculative_solvers_[i - 1]);
+      }
+
+      Jnlst().Printf(J_MOREDETAILED, J_LINEAR_ALGEBRA,
+                     "Factorizing system concurrently for %" IPOPT_INDEX_FORMAT " values of delta_x from %e to %e\n", ntrials,
+                     trial_delta_x[0], trial_delta_x[ntrials - 1]);
+
+      // Setting up the systems accesses the shared matrices and vectors,
+      // so it is done serially
+      for( Index i = 0; i < ntrials; i++ )
+      {
+         solvers[i]->PrepareFactorization(&W, 1.0, &sigma_x, trial_delta_x[i], &sigma_s, trial_delta_x[i], &J_c, NULL,
+                                          delta_c, &J_d, NULL, delta_d, proto_x, proto_s, proto_c, proto_d);
+      }
+
+      status.resize(ntrials);
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static, 1) num_threads(ntrials)
+#endif
+      for( Index i = 0; i < ntrials; i++ )
+      {
+         // exceptions must not leave the parallel region; the trial
+         // value is then factorized again in the serial loop
+         try
+         {
+            status[i] = solvers[i]->FactorizePrepared(true, numberOfEVals);
+         }
+         catch( ... )
+         {
+            status[i] = SYMSOLVER_FATAL_ERROR;
+         }
+      }
+      count += ntrials - 1;
+
+      // Advance the perturbation handler past the trial values with too
+      // many negative eigenvalues, exactly as the serial loop would do.
+      // Anything else is left to the serial loop.
+      for( Index i = 0; i < ntrials; i++ )
+      {
+         if( status[i] != SYMSOLVER_WRONG_INERTIA || solvers[i]->NumberOfNegEVals() < numberOfEVals )
+         {
+            Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                           "Continuing with trial value %" IPOPT_INDEX_FORMAT " of %" IPOPT_INDEX_FORMAT " of the speculative factorizations.\n",
+                           i + 1, ntrials);
+            return true;
+         }
+         if( !perturbHandler_->PerturbForWrongInertia(delta_x, delta_s, delta_c, delta_d) )
+         {
+            return false;
+         }
+         if( i + 1 < ntrials
+             && (delta_x != trial_delta_x[i + 1] || delta_s != trial_delta_x[i + 1] || delta_c != trial_delta_c
+                 || delta_d != trial_delta_d) )
+         {
+            // the perturbation handler changed its strategy, so the
+            // remaining trial matrices have the wrong perturbation
+            return true;
+         }
+      }
+   }
+}
+
+bool PDFullSpaceSolver::IncreaseQuality()
+{
+   bool retval = augSysSolver_->IncreaseQuality();
+   if( retval )
+   {
+      // keep the speculative solvers in line, so that their inertia
+      // agrees with the one of the augmented system solver
+      for( size_t i = 0; i < speculative_solvers_.size(); i++ )
+      {
+         speculative_solvers_[i]->IncreaseQuality();
+      }
+   }
+   return retval;
+}
+
 void PDFullSpaceSolver::ComputeResiduals(
    const SymMatrix&      W,
    const Matrix&         J_c,
@@ -792,6 +1315,150 @@ void PDFullSpaceSolver::ComputeResiduals(
    IpData().TimingStats().ComputeResiduals().End();
 }
 
+Index PDFullSpaceSolver::FGMRESRefinement(
+   Index                 max_steps,
+   Index                 min_steps,
+   const SymMatrix&      W,
+   const Matrix&         J_c,
+   const Matrix&         J_d,
+   const Matrix&         Px_L,
+   const Matrix&         Px_U,
+   const Matrix&         Pd_L,
+   const Matrix&         Pd_U,
+   const Vector&         z_L,
+   const Vector&         z_U,
+   const Vector&         v_L,
+   const Vector&         v_U,
+   const Vector&         slack_x_L,
+   const Vector&         slack_x_U,
+   const Vector&         slack_s_L,
+   const Vector&         slack_s_U,
+   const Vector&         sigma_x,
+   const Vector&         sigma_s,
+   const IteratesVector& rhs,
+   IteratesVector&       res,
+   IteratesVector&       resid,
+   Number&               residual_ratio
+)
+{
+   DBG_START_METH("PDFullSpaceSolver::FGMRESRefinement", dbg_verbosity);
+   DBG_ASSERT(max_steps > 0);
+
+   // FGMRES is applied to K*d = -resid for the correction d of the
+   // initial solution x0 = res.  The operator K is applied by
+   // computing the residual for a zero right hand side, the
+   // preconditioner by a back solve with the factorization.
+   Number beta = resid.Nrm2();
+   if( beta == 0. )
+   {
+      return 0;
+   }
+   SmartPtr<const IteratesVector> x0 = res.MakeNewIteratesVectorCopy();
+   SmartPtr<IteratesVector> zero = rhs.MakeNewIteratesVector(true);
+   zero->Set(0.);
+
+   // Krylov basis V and preconditioned basis Z
+   std::vector<SmartPtr<IteratesVector> > V;
+   std::vector<SmartPtr<IteratesVector> > Z;
+   V.push_back(resid.MakeNewIteratesVectorCopy());
+   V[0]->Scal(-1. / beta);
+
+   // Hessenberg matrix (column-wise, transformed to upper triangular
+   // form by Givens rotations) and right hand side of the least
+   // squares problem
+   std::vector<Number> H((size_t) (max_steps + 1) * max_steps, 0.);
+   std::vector<Number> cs(max_steps);
+   std::vector<Number> sn(max_steps);
+   std::vector<Number> g(max_steps + 1, 0.);
+   std::vector<Number> y(max_steps);
+   g[0] = beta;
+
+   Index steps = 0;
+   Number residual_ratio_old = residual_ratio;
+   for( Index j = 0; j < max_steps; j++ )
+   {
+      Number* Hj = &H[(size_t) j * (max_steps + 1)];
+
+      Z.push_back(res.MakeNewIteratesVector(true));
+      bool solve_retval = SolveOnce(false, false, W, J_c, J_d, Px_L, Px_U, Pd_L, Pd_U, z_L, z_U, v_L, v_U, slack_x_L,
+                                    slack_x_U, slack_s_L, slack_s_U, sigma_x, sigma_s, 1., 0., *V[j], *Z[j]);
+      ASSERT_EXCEPTION(solve_retval, INTERNAL_ABORT, "SolveOnce returns false during iterative refinement.");
+
+      SmartPtr<IteratesVector> w = res.MakeNewIteratesVector(true);
+      ComputeResiduals(W, J_c, J_d, Px_L, Px_U, Pd_L, Pd_U, z_L, z_U, v_L, v_U, slack_x_L, slack_x_U, slack_s_L,
+                       slack_s_U, sigma_x, sigma_s, 1., 0., *zero, *Z[j], *w);
+
+      // modified Gram-Schmidt
+      for( Index i = 0; i <= j; i++ )
+      {
+         Hj[i] = w->Dot(*V[i]);
+         w->Axpy(-Hj[i], *V[i]);
+      }
+      Number hnext = w->Nrm2();
+
+      // apply the previous rotations and compute the new one
+      for( Index i = 0; i < j; i++ )
+      {
+         Number tmp = cs[i] * Hj[i] + sn[i] * Hj[i + 1];
+         Hj[i + 1] = -sn[i] * Hj[i] + cs[i] * Hj[i + 1];
+         Hj[i] = tmp;
+      }
+      Number r = std::sqrt(Hj[j] * Hj[j] + hnext * hnext);
+      if( r == 0. )
+      {
+         // K*Z[j] lies in the span of V; nothing to be gained anymore
+         Z.pop_back();
+         break;
+      }
+      cs[j] = Hj[j] / r;
+      sn[j] = hnext / r;
+      Hj[j] = r;
+      g[j + 1] = -sn[j] * g[j];
+      g[j] = cs[j] * g[j];
+
+      steps++;
+      IpData().Inc_info_refinement_steps();
+
+      // solution of the least squares problem and new iterate
+      for( Index i = j; i >= 0; i-- )
+      {
+         Number sum = g[i];
+         for( Index k = i + 1; k <= j; k++ )
+         {
+            sum -= H[(size_t) k * (max_steps + 1) + i] * y[k];
+         }
+         y[i] = sum / H[(size_t) i * (max_steps + 1) + i];
+      }
+      res.Copy(*x0);
+      for( Index i = 0; i <= j; i++ )
+      {
+         res.Axpy(y[i], *Z[i]);
+      }
+
+      ComputeResiduals(W, J_c, J_d, Px_L, Px_U, Pd_L, Pd_U, z_L, z_U, v_L, v_U, slack_x_L, slack_x_U, slack_s_L,
+                       slack_s_U, sigma_x, sigma_s, 1., 0., rhs, res, resid);
+      residual_ratio = ComputeResidualRatio(rhs, res, resid);
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "residual_ratio = %e (FGMRES step %" IPOPT_INDEX_FORMAT ")\n", residual_ratio, steps);
+
+      if( (residual_ratio <= residual_ratio_max_ && steps >= min_steps) || hnext == 0. )
+      {
+         break;
+      }
+      if( residual_ratio > residual_ratio_max_ && residual_ratio > residual_improvement_factor_ * residual_ratio_old )
+      {
+         // stagnation, most likely at the level of the rounding errors
+         break;
+      }
+      residual_ratio_old = residual_ratio;
+
+      w->Scal(1. / hnext);
+      V.push_back(w);
+   }
+
+   return steps;
+}
+
 Number PDFullSpaceSolver::ComputeResidualRatio(
    const IteratesVector& rhs,
    const IteratesVector& res,
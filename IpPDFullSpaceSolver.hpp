@@ -61,6 +61,51 @@ public:
       bool                  improve_solution = false
    );
 
+   /** Solve the primal dual system for several right hand sides.
+    *
+    *  All right hand sides are passed at once to the augmented system
+    *  solver, also during iterative refinement.
+    */
+   virtual bool MultiSolve(
+      Number                                              alpha,
+      Number                                              beta,
+      const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+      std::vector<SmartPtr<IteratesVector> >&             resV,
+      bool                                                allow_inexact = false,
+      bool                                                improve_solution = false
+   );
+
+   /** Solve the primal dual system with the matrix of the most recent
+    *  solve, without any checks of the solution quality.
+    *
+    *  If the matrix has not changed since the most recent solve, only
+    *  the back solve with the existing factorization is performed.
+    *  The right hand sides of the augmented system for x and s are
+    *  kept for the next call, so that they are not computed again if
+    *  only the c and d parts of rhs change.  Otherwise, this is the
+    *  same as Solve with allow_inexact set to true.
+    */
+   virtual bool BackSolve(
+      Number                alpha,
+      const IteratesVector& rhs,
+      IteratesVector&       res
+   );
+
+   /** Add a solver for speculative factorizations.
+    *
+    *  If the factorization of the primal-dual system has the wrong
+    *  inertia, the factorizations for the next trial values of delta_x
+    *  are computed concurrently, one by each of these solvers, while
+    *  the solver given in the constructor factorizes the system for the
+    *  next trial value.  The solver must be distinct from the other
+    *  solvers and must provide concurrent factorizations.  It is
+    *  initialized with its own IpoptData, so that the factorizations
+    *  do not interfere with the timing statistics of the algorithm.
+    */
+   void AddSpeculativeSolver(
+      AugSystemSolver& augSysSolver
+   );
+
    /** Methods for IpoptType */
    ///@{
    static void RegisterOptions(
@@ -95,6 +140,12 @@ private:
 
    /** Pointer to the Perturbation Handler. */
    SmartPtr<PDPerturbationHandler> perturbHandler_;
+
+   /** Solvers for the speculative factorizations */
+   std::vector<SmartPtr<AugSystemSolver> > speculative_solvers_;
+
+   /** Data objects of the solvers for the speculative factorizations */
+   std::vector<SmartPtr<IpoptData> > speculative_data_;
    ///@}
 
    /**@name Data about the correction made to the system */
@@ -102,6 +153,16 @@ private:
    /** A dummy cache to figure out if the deltas are still up to date */
    CachedResults<void*> dummy_cache_;
 
+   /** Right hand side of the augmented system for x in the most
+    *  recent back solve
+    */
+   CachedResults<SmartPtr<const Vector> > aug_rhs_x_cache_;
+
+   /** Right hand side of the augmented system for s in the most
+    *  recent back solve
+    */
+   CachedResults<SmartPtr<const Vector> > aug_rhs_s_cache_;
+
    /** Flag indicating if for the current matrix the solution quality
     *  of the augmented system solver has already been increased.
     */
@@ -137,8 +198,33 @@ private:
 
    /** Do curvature test with primal regularization */
    bool neg_curv_test_reg_;
+
+   /** Flag indicating whether iterative refinement is done by FGMRES
+    *  instead of fixed-point iterations.
+    */
+   bool fgmres_refinement_;
    ///@}
 
+   /** Collect the quantities that determine the matrix of the
+    *  primal-dual system, as dependencies for dummy_cache_.
+    */
+   static void GetSystemDependencies(
+      const SymMatrix&                  W,
+      const Matrix&                     J_c,
+      const Matrix&                     J_d,
+      const Vector&                     z_L,
+      const Vector&                     z_U,
+      const Vector&                     v_L,
+      const Vector&                     v_U,
+      const Vector&                     slack_x_L,
+      const Vector&                     slack_x_U,
+      const Vector&                     slack_s_L,
+      const Vector&                     slack_s_U,
+      const Vector&                     sigma_x,
+      const Vector&                     sigma_s,
+      std::vector<const TaggedObject*>& deps
+   );
+
    /** Internal function for a single backsolve (which will be used
     *  for iterative refinement on the outside).
     *
@@ -172,6 +258,74 @@ private:
       IteratesVector&       res
    );
 
+   /** Internal function for a single backsolve for several right hand
+    *  sides at once.
+    */
+   bool SolveOnce(
+      bool                                                resolve_unmodified,
+      bool                                                pretend_singular,
+      const SymMatrix&                                    W,
+      const Matrix&                                       J_c,
+      const Matrix&                                       J_d,
+      const Matrix&                                       Px_L,
+      const Matrix&                                       Px_U,
+      const Matrix&                                       Pd_L,
+      const Matrix&                                       Pd_U,
+      const Vector&                                       z_L,
+      const Vector&                                       z_U,
+      const Vector&                                       v_L,
+      const Vector&                                       v_U,
+      const Vector&                                       slack_x_L,
+      const Vector&                                       slack_x_U,
+      const Vector&                                       slack_s_L,
+      const Vector&                                       slack_s_U,
+      const Vector&                                       sigma_x,
+      const Vector&                                       sigma_s,
+      Number                                              alpha,
+      Number                                              beta,
+      const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+      std::vector<SmartPtr<IteratesVector> >&             resV
+   );
+
+   /** Internal function that factorizes the augmented system for
+    *  several trial values of delta_x concurrently.
+    *
+    *  Called after the factorization has the wrong inertia and the
+    *  perturbation handler has returned the next trial perturbation
+    *  in delta_x etc.  The factorizations for this and the following
+    *  trial values are computed concurrently, and the perturbation
+    *  handler is advanced, as in the serial loop, past all trial
+    *  values whose factorization has too many negative eigenvalues.
+    *  On return, delta_x etc. hold the smallest trial perturbation
+    *  that did not give too many negative eigenvalues; the augmented
+    *  system solver has already factorized the system, if that is the
+    *  first trial value.
+    *
+    *  @return false, if the perturbation becomes too large
+    */
+   bool SpeculativeFactorizations(
+      const SymMatrix& W,
+      const Matrix&    J_c,
+      const Matrix&    J_d,
+      const Vector&    sigma_x,
+      const Vector&    sigma_s,
+      const Vector&    proto_x,
+      const Vector&    proto_s,
+      const Vector&    proto_c,
+      const Vector&    proto_d,
+      Index            numberOfEVals,
+      Number&          delta_x,
+      Number&          delta_s,
+      Number&          delta_c,
+      Number&          delta_d,
+      Index&           count
+   );
+
+   /** Ask the augmented system solver, and the solvers for the
+    *  speculative factorizations, to increase the quality.
+    */
+   bool IncreaseQuality();
+
    /** Internal function for computing the residual (resid) given the
     * right hand side (rhs) and the solution of the system (res).
     */
@@ -200,6 +354,44 @@ private:
       IteratesVector&       resid
    );
 
+   /** Internal function for one cycle of iterative refinement by
+    *  FGMRES, preconditioned by the factorization of the augmented
+    *  system.
+    *
+    *  On input, res is the current solution and resid its residual.
+    *  At most max_steps steps are performed; the cycle stops early,
+    *  if at least min_steps steps have been done and residual_ratio
+    *  is not larger than residual_ratio_max_.  On output, res, resid,
+    *  and residual_ratio are those of the improved solution.
+    *
+    *  @return number of steps that have been performed
+    */
+   Index FGMRESRefinement(
+      Index                 max_steps,
+      Index                 min_steps,
+      const SymMatrix&      W,
+      const Matrix&         J_c,
+      const Matrix&         J_d,
+      const Matrix&         Px_L,
+      const Matrix&         Px_U,
+      const Matrix&         Pd_L,
+      const Matrix&         Pd_U,
+      const Vector&         z_L,
+      const Vector&         z_U,
+      const Vector&         v_L,
+      const Vector&         v_U,
+      const Vector&         slack_x_L,
+      const Vector&         slack_x_U,
+      const Vector&         slack_s_L,
+      const Vector&         slack_s_U,
+      const Vector&         sigma_x,
+      const Vector&         sigma_s,
+      const IteratesVector& rhs,
+      IteratesVector&       res,
+      IteratesVector&       resid,
+      Number&               residual_ratio
+   );
+
    /** Internal function for computing the ratio of the residual
     *  compared to the right hand side and solution.
     *
@@ -451,6 +451,41 @@ bool PDPerturbationHandler::PerturbForWrongInertia(
    return retval;
 }
 
+Index PDPerturbationHandler::WrongInertiaTrials(
+   Index                max_trials,
+   std::vector<Number>& delta_x
+) const
+{
+   DBG_START_METH("PDPerturbationHandler::WrongInertiaTrials",
+                  dbg_verbosity);
+
+   // repeat the increase of get_deltas_for_wrong_inertia; delta_x_last_
+   // only changes when the perturbation becomes too large
+   delta_x.clear();
+   Number delta = delta_x_curr_;
+   if( delta == 0. )
+   {
+      return 0;
+   }
+   while( (Index) delta_x.size() < max_trials )
+   {
+      if( delta_x_last_ == 0. || 1e5 * delta_x_last_ < delta )
+      {
+         delta = delta_xs_first_inc_fact_ * delta;
+      }
+      else
+      {
+         delta = delta_xs_inc_fact_ * delta;
+      }
+      if( delta > delta_xs_max_ )
+      {
+         break;
+      }
+      delta_x.push_back(delta);
+   }
+   return (Index) delta_x.size();
+}
+
 void PDPerturbationHandler::CurrentPerturbation(
    Number& delta_x,
    Number& delta_s,
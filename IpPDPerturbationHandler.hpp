@@ -9,6 +9,8 @@
 
 #include "IpAlgStrategy.hpp"
 
+#include <vector>
+
 namespace Ipopt
 {
 
@@ -79,6 +81,22 @@ public:
       Number& delta_c,
       Number& delta_d);
 
+   /** Values of delta_x that PerturbForWrongInertia would return next.
+    *
+    *  Determines the values of delta_x that successive calls of
+    *  PerturbForWrongInertia would return, if the factorizations for
+    *  the current and all these values had a wrong inertia.  The state
+    *  of the handler is not changed.  delta_s equals delta_x in these
+    *  perturbations and delta_c and delta_d stay the same.
+    *
+    *  @return the number of values stored in delta_x, which is smaller
+    *  than max_trials if delta_x would become too large
+    */
+   virtual Index WrongInertiaTrials(
+      Index                max_trials,
+      std::vector<Number>& delta_x
+   ) const;
+
    /** Just return the perturbation values that have been determined
     *  most recently.
     */
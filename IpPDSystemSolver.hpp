@@ -12,6 +12,8 @@
 #include "IpAlgStrategy.hpp"
 #include "IpIteratesVector.hpp"
 
+#include <vector>
+
 namespace Ipopt
 {
 
@@ -114,6 +116,56 @@ public:
       bool                  improve_solution = false
    ) = 0;
 
+   /** Solve the primal dual system for several right hand sides.
+    *
+    *  The arguments are as for Solve, where the solution for
+    *  rhsV[i] is returned in resV[i].  A derived class can overload
+    *  this method to pass all right hand sides at once to the linear
+    *  solver; the default implementation calls Solve for one right
+    *  hand side after the other.
+    */
+   virtual bool MultiSolve(
+      Number                                              alpha,
+      Number                                              beta,
+      const std::vector<SmartPtr<const IteratesVector> >& rhsV,
+      std::vector<SmartPtr<IteratesVector> >&             resV,
+      bool                                                allow_inexact = false,
+      bool                                                improve_solution = false
+   )
+   {
+      DBG_ASSERT(rhsV.size() == resV.size());
+      for( size_t i = 0; i < rhsV.size(); i++ )
+      {
+         if( !Solve(alpha, beta, *rhsV[i], *resV[i], allow_inexact, improve_solution) )
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   /** Solve the primal dual system with the matrix of the most recent
+    *  solve, without any checks of the solution quality.
+    *
+    *  This is meant for a sequence of right hand sides that differ only
+    *  in some of their parts, such as those of the second order
+    *  correction, in which only the c and d parts change.  A derived
+    *  class can then reuse the factorization of the matrix and the
+    *  quantities that depend only on the unchanged parts.  The result
+    *  is res = alpha * sol.  The default implementation calls Solve
+    *  with allow_inexact set to true.
+    *
+    *  @return false, if a solution could not be computed
+    */
+   virtual bool BackSolve(
+      Number                alpha,
+      const IteratesVector& rhs,
+      IteratesVector&       res
+   )
+   {
+      return Solve(alpha, 0., rhs, res, true);
+   }
+
 private:
    /**@name Default Compiler Generated Methods
     * (Hidden to avoid implicit creation/calling).
@@ -61,6 +61,7 @@ static const Index dbg_verbosity = 0;
 PardisoMKLSolverInterface::PardisoMKLSolverInterface()
    : a_(NULL),
      negevals_(-1),
+     factor_nonzeros_(0),
      initialized_(false),
      MAXFCT_(1),
      MNUM_(1),
@@ -472,6 +473,7 @@ ESymSolverStatus PardisoMKLSolverInterface::Factorization(
 
          Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
                         "Calling Pardiso for symbolic factorization.\n");
+         IPARM_[17] = -1; // report the number of nonzeros in the factor
          IPOPT_LAPACK_FUNC(pardiso, PARDISO)(PT_, &MAXFCT_, &MNUM_, &MTYPE_,
                                              &PHASE, &N, a_, ia, ja, &PERM,
                                              &NRHS, IPARM_, &MSGLVL_, &B, &X, &ERROR, DPARM_);
@@ -493,6 +495,7 @@ ESymSolverStatus PardisoMKLSolverInterface::Factorization(
          }
          have_symbolic_factorization_ = true;
          just_performed_symbolic_factorization = true;
+         factor_nonzeros_ = IPARM_[17];
 
          Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
                         "Memory in KB required for the symbolic factorization  = %" IPOPT_INDEX_FORMAT ".\n", IPARM_[14]);
@@ -553,6 +556,10 @@ ESymSolverStatus PardisoMKLSolverInterface::Factorization(
       }
 
       negevals_ = Max(IPARM_[22], numberOfNegEVals);
+      if( HaveIpData() && factor_nonzeros_ > 0 )
+      {
+         IpData().Set_info_factorization_size((Number) nonzeros_, (Number) factor_nonzeros_);
+      }
       if( IPARM_[13] != 0 )
       {
          Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
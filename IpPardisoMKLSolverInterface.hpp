@@ -113,6 +113,10 @@ private:
    ///@{
    /** Number of negative eigenvalues */
    Index negevals_;
+   /** Number of nonzeros in the factor, as predicted by the most
+    *  recent symbolic factorization
+    */
+   Index factor_nonzeros_;
    ///@}
 
    /** @name Solver specific options */
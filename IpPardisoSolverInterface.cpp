@@ -42,6 +42,7 @@ PardisoSolverInterface::PardisoSolverInterface(
    scale2(NULL),
 #endif
    negevals_(-1),
+   factor_nonzeros_(0),
    initialized_(false),
    MAXFCT_(1),
    MNUM_(1),
@@ -741,6 +742,7 @@ ESymSolverStatus PardisoSolverInterface::Factorization(
 
          Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
                         "Calling Pardiso for symbolic factorization.\n");
+         IPARM_[17] = -1; // report the number of nonzeros in the factor
          pardiso(PT_, &MAXFCT_, &MNUM_, &MTYPE_,
 #ifdef PARDISO_MATCHING_PREPROCESS
                  &PHASE, &N, a2_, ia2, ja2, &PERM,
@@ -766,6 +768,7 @@ ESymSolverStatus PardisoSolverInterface::Factorization(
          }
          have_symbolic_factorization_ = true;
          just_performed_symbolic_factorization = true;
+         factor_nonzeros_ = IPARM_[17];
 
          Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
                         "Memory in KB required for the symbolic factorization  = %" IPOPT_INDEX_FORMAT ".\n", IPARM_[14]);
@@ -837,6 +840,10 @@ ESymSolverStatus PardisoSolverInterface::Factorization(
       }
 
       negevals_ = Max(IPARM_[22], numberOfNegEVals);
+      if( HaveIpData() && factor_nonzeros_ > 0 )
+      {
+         IpData().Set_info_factorization_size((Number) nonzeros_, (Number) factor_nonzeros_);
+      }
       if( IPARM_[13] != 0 )
       {
          Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
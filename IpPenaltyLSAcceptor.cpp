@@ -300,6 +300,19 @@ bool PenaltyLSAcceptor::TrySecondOrderCorrection(
    SmartPtr<Vector> dms_soc = IpCq().curr_d_minus_s()->MakeNew();
    c_soc->Copy(*IpCq().curr_c());
    dms_soc->Copy(*IpCq().curr_d_minus_s());
+
+   // Only the c and d parts (and, for soc_method 1, the factor of the
+   // x and s parts) of the right hand side change between the SOC
+   // systems, which are solved by back solves with the factorization
+   // of the search direction computation
+   SmartPtr<IteratesVector> rhs = actual_delta->MakeNewContainer();
+   rhs->Set_x(*IpCq().curr_grad_lag_with_damping_x());
+   rhs->Set_s(*IpCq().curr_grad_lag_with_damping_s());
+   rhs->Set_z_L(*IpCq().curr_relaxed_compl_x_L());
+   rhs->Set_z_U(*IpCq().curr_relaxed_compl_x_U());
+   rhs->Set_v_L(*IpCq().curr_relaxed_compl_s_L());
+   rhs->Set_v_U(*IpCq().curr_relaxed_compl_s_U());
+   SmartPtr<IteratesVector> delta_soc = actual_delta->MakeNewIteratesVector(true);
    while( count_soc < max_soc_ && !accept && (count_soc == 0 || theta_trial <= kappa_soc_ * theta_soc_old) )
    {
       theta_soc_old = theta_trial;
@@ -312,42 +325,23 @@ bool PenaltyLSAcceptor::TrySecondOrderCorrection(
       dms_soc->AddOneVector(1.0, *IpCq().trial_d_minus_s(), alpha_primal_soc);
 
       // Compute the SOC search direction
-      SmartPtr<IteratesVector> delta_soc = actual_delta->MakeNewIteratesVector(true);
-      SmartPtr<IteratesVector> rhs = actual_delta->MakeNewContainer();
-
-      switch (soc_method_)
+      rhs->Set_y_c(*c_soc);
+      rhs->Set_y_d(*dms_soc);
+      if( soc_method_ == 1 )
       {
-         case 0:
-            rhs->Set_x(*IpCq().curr_grad_lag_with_damping_x());
-            rhs->Set_s(*IpCq().curr_grad_lag_with_damping_s());
-            rhs->Set_y_c(*c_soc);
-            rhs->Set_y_d(*dms_soc);
-            rhs->Set_z_L(*IpCq().curr_relaxed_compl_x_L());
-            rhs->Set_z_U(*IpCq().curr_relaxed_compl_x_U());
-            rhs->Set_v_L(*IpCq().curr_relaxed_compl_s_L());
-            rhs->Set_v_U(*IpCq().curr_relaxed_compl_s_U());
-            break;
-         case 1:
-            SmartPtr<Vector> x_soc =
-               IpCq().curr_grad_lag_with_damping_x()->MakeNew();
-            SmartPtr<Vector> s_soc =
-               IpCq().curr_grad_lag_with_damping_s()->MakeNew();
-            x_soc->Copy(*IpCq().curr_grad_lag_with_damping_x());
-            s_soc->Copy(*IpCq().curr_grad_lag_with_damping_s());
-            x_soc->Scal(alpha_primal_soc);
-            s_soc->Scal(alpha_primal_soc);
-
-            rhs->Set_x(*x_soc);
-            rhs->Set_s(*s_soc);
-            rhs->Set_y_c(*c_soc);
-            rhs->Set_y_d(*dms_soc);
-            rhs->Set_z_L(*IpCq().curr_relaxed_compl_x_L());
-            rhs->Set_z_U(*IpCq().curr_relaxed_compl_x_U());
-            rhs->Set_v_L(*IpCq().curr_relaxed_compl_s_L());
-            rhs->Set_v_U(*IpCq().curr_relaxed_compl_s_U());
-            break;
+         SmartPtr<Vector> x_soc =
+            IpCq().curr_grad_lag_with_damping_x()->MakeNew();
+         SmartPtr<Vector> s_soc =
+            IpCq().curr_grad_lag_with_damping_s()->MakeNew();
+         x_soc->Copy(*IpCq().curr_grad_lag_with_damping_x());
+         s_soc->Copy(*IpCq().curr_grad_lag_with_damping_s());
+         x_soc->Scal(alpha_primal_soc);
+         s_soc->Scal(alpha_primal_soc);
+
+         rhs->Set_x(*x_soc);
+         rhs->Set_s(*s_soc);
       }
-      bool retval = pd_solver_->Solve(-1.0, 0.0, *rhs, *delta_soc, true);
+      bool retval = pd_solver_->BackSolve(-1.0, *rhs, *delta_soc);
       if( !retval )
       {
          Jnlst().Printf(J_DETAILED, J_LINE_SEARCH,
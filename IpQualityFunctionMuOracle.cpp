@@ -5,6 +5,7 @@
 // Authors:  Carl Laird, Andreas Waechter            IBM    2004-11-12
 
 #include "IpQualityFunctionMuOracle.hpp"
+#include "IpTripletHelper.hpp"
 
 #include <cmath>
 #include <cstdio>
@@ -20,25 +21,6 @@ QualityFunctionMuOracle::QualityFunctionMuOracle(
 )
    : MuOracle(),
      pd_solver_(pd_solver),
-
-     tmp_step_x_L_(NULL),
-     tmp_step_x_U_(NULL),
-     tmp_step_s_L_(NULL),
-     tmp_step_s_U_(NULL),
-     tmp_step_z_L_(NULL),
-     tmp_step_z_U_(NULL),
-     tmp_step_v_L_(NULL),
-     tmp_step_v_U_(NULL),
-
-     tmp_slack_x_L_(NULL),
-     tmp_slack_x_U_(NULL),
-     tmp_slack_s_L_(NULL),
-     tmp_slack_s_U_(NULL),
-     tmp_z_L_(NULL),
-     tmp_z_U_(NULL),
-     tmp_v_L_(NULL),
-     tmp_v_U_(NULL),
-
      count_qf_evals_(0)
 {
    DBG_ASSERT(IsValid(pd_solver_));
@@ -160,35 +142,11 @@ bool QualityFunctionMuOracle::CalculateMu(
    DBG_START_METH("QualityFunctionMuOracle::CalculateMu",
                   dbg_verbosity);
 
-   ///////////////////////////////////////////////////////////////////////////
-   // Reserve memory for temporary vectors used in CalculateQualityFunction //
-   ///////////////////////////////////////////////////////////////////////////
-
-   tmp_step_x_L_ = IpNLP().x_L()->MakeNew();
-   tmp_step_x_U_ = IpNLP().x_U()->MakeNew();
-   tmp_step_s_L_ = IpNLP().d_L()->MakeNew();
-   tmp_step_s_U_ = IpNLP().d_U()->MakeNew();
-   tmp_step_z_L_ = IpNLP().x_L()->MakeNew();
-   tmp_step_z_U_ = IpNLP().x_U()->MakeNew();
-   tmp_step_v_L_ = IpNLP().d_L()->MakeNew();
-   tmp_step_v_U_ = IpNLP().d_U()->MakeNew();
-
-   tmp_slack_x_L_ = IpNLP().x_L()->MakeNew();
-   tmp_slack_x_U_ = IpNLP().x_U()->MakeNew();
-   tmp_slack_s_L_ = IpNLP().d_L()->MakeNew();
-   tmp_slack_s_U_ = IpNLP().d_U()->MakeNew();
-   tmp_z_L_ = IpNLP().x_L()->MakeNew();
-   tmp_z_U_ = IpNLP().x_U()->MakeNew();
-   tmp_v_L_ = IpNLP().d_L()->MakeNew();
-   tmp_v_U_ = IpNLP().d_U()->MakeNew();
-
-   /////////////////////////////////////
-   // Compute the affine scaling step //
-   /////////////////////////////////////
+   /////////////////////////////////////////////////////
+   // Compute the affine scaling and centering steps  //
+   /////////////////////////////////////////////////////
 
-   Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                  "Solving the Primal Dual System for the affine step\n");
-   // First get the right hand side
+   // First get the right hand side for the affine step
    SmartPtr<IteratesVector> rhs_aff = IpData().curr()->MakeNewIteratesVector(false);
    rhs_aff->Set_x(*IpCq().curr_grad_lag_x());
    rhs_aff->Set_s(*IpCq().curr_grad_lag_s());
@@ -202,29 +160,9 @@ bool QualityFunctionMuOracle::CalculateMu(
    // Get space for the affine scaling step
    SmartPtr<IteratesVector> step_aff = IpData().curr()->MakeNewIteratesVector(true);
 
-   // Now solve the primal-dual system to get the step.  We allow a
-   // somewhat inexact solution, iterative refinement will be done
-   // after mu is known
-   bool allow_inexact = true;
-   bool retval = pd_solver_->Solve(-1.0, 0.0, *rhs_aff, *step_aff, allow_inexact);
-   if( !retval )
-   {
-      Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                     "The linear system could not be solved for the affine step!\n");
-      return false;
-   }
-
-   DBG_PRINT_VECTOR(2, "step_aff", *step_aff);
-
-   /////////////////////////////////////
-   // Compute the pure centering step //
-   /////////////////////////////////////
-
    Number avrg_compl = IpCq().curr_avrg_compl();
 
-   Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                  "Solving the Primal Dual System for the centering step\n");
-   // First get the right hand side
+   // Right hand side for the pure centering step
    SmartPtr<IteratesVector> rhs_cen = IpData().curr()->MakeNewIteratesVector(true);
    rhs_cen->x_NonConst()->AddOneVector(-avrg_compl, *IpCq().grad_kappa_times_damping_x(), 0.);
    rhs_cen->s_NonConst()->AddOneVector(-avrg_compl, *IpCq().grad_kappa_times_damping_s(), 0.);
@@ -239,16 +177,29 @@ bool QualityFunctionMuOracle::CalculateMu(
    // Get space for the centering step
    SmartPtr<IteratesVector> step_cen = IpData().curr()->MakeNewIteratesVector(true);
 
-   // Now solve the primal-dual system to get the step
-   allow_inexact = true;
-   retval = pd_solver_->Solve(1.0, 0.0, *rhs_cen, *step_cen, allow_inexact);
+   Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
+                  "Solving the Primal Dual System for the affine and centering steps\n");
+   // Now solve the primal-dual system for both right hand sides at
+   // once.  We allow a somewhat inexact solution, iterative
+   // refinement will be done after mu is known.  The affine step is
+   // the solution for -rhs_aff, so it is negated afterwards.
+   std::vector<SmartPtr<const IteratesVector> > rhsV(2);
+   rhsV[0] = ConstPtr(rhs_aff);
+   rhsV[1] = ConstPtr(rhs_cen);
+   std::vector<SmartPtr<IteratesVector> > stepV(2);
+   stepV[0] = step_aff;
+   stepV[1] = step_cen;
+   bool allow_inexact = true;
+   bool retval = pd_solver_->MultiSolve(1.0, 0.0, rhsV, stepV, allow_inexact);
    if( !retval )
    {
       Jnlst().Printf(J_DETAILED, J_BARRIER_UPDATE,
-                     "The linear system could not be solved for the centering step!\n");
+                     "The linear system could not be solved for the affine and centering steps!\n");
       return false;
    }
+   step_aff->Scal(-1.);
 
+   DBG_PRINT_VECTOR(2, "step_aff", *step_aff);
    DBG_PRINT_VECTOR(2, "step_cen", *step_cen);
 
    // Start the timing for the quality function search here
@@ -269,16 +220,6 @@ bool QualityFunctionMuOracle::CalculateMu(
    // Compute some quantities used for the quality function evaluations
    // (This way we try to avoid retrieving numbers from cache...
 
-   curr_slack_x_L_ = IpCq().curr_slack_x_L();
-   curr_slack_x_U_ = IpCq().curr_slack_x_U();
-   curr_slack_s_L_ = IpCq().curr_slack_s_L();
-   curr_slack_s_U_ = IpCq().curr_slack_s_U();
-
-   curr_z_L_ = IpData().curr()->z_L();
-   curr_z_U_ = IpData().curr()->z_U();
-   curr_v_L_ = IpData().curr()->v_L();
-   curr_v_U_ = IpData().curr()->v_U();
-
    IpData().TimingStats().Task5().Start();
    switch( quality_function_norm_ )
    {
@@ -326,21 +267,23 @@ bool QualityFunctionMuOracle::CalculateMu(
    IpNLP().Pd_L()->TransMultVector(1., *step_cen->s(), 0., *step_cen_s_L);
    IpNLP().Pd_U()->TransMultVector(-1., *step_cen->s(), 0., *step_cen_s_U);
 
+   // Collect everything that is needed for the evaluations of the
+   // quality function in one array
+   PrepareQualityFunctionTerms(*step_aff_x_L, *step_aff_x_U, *step_aff_s_L, *step_aff_s_U, *step_aff->z_L(),
+                               *step_aff->z_U(), *step_aff->v_L(), *step_aff->v_U(), *step_cen_x_L, *step_cen_x_U, *step_cen_s_L,
+                               *step_cen_s_U, *step_cen->z_L(), *step_cen->z_U(), *step_cen->v_L(), *step_cen->v_U());
+
    Number sigma;
 
    // First we determine whether we want to search for a value of
    // sigma larger or smaller than 1.  For this, we estimate the
    // slope of the quality function at sigma=1.
-   Number qf_1 = CalculateQualityFunction(1., *step_aff_x_L, *step_aff_x_U, *step_aff_s_L, *step_aff_s_U,
-                                          *step_aff->y_c(), *step_aff->y_d(), *step_aff->z_L(), *step_aff->z_U(), *step_aff->v_L(), *step_aff->v_U(),
-                                          *step_cen_x_L, *step_cen_x_U, *step_cen_s_L, *step_cen_s_U, *step_cen->y_c(), *step_cen->y_d(), *step_cen->z_L(),
-                                          *step_cen->z_U(), *step_cen->v_L(), *step_cen->v_U());
-
    Number sigma_1minus = 1. - Max(Number(1e-4), quality_function_section_sigma_tol_);
-   Number qf_1minus = CalculateQualityFunction(sigma_1minus, *step_aff_x_L, *step_aff_x_U, *step_aff_s_L, *step_aff_s_U,
-                      *step_aff->y_c(), *step_aff->y_d(), *step_aff->z_L(), *step_aff->z_U(), *step_aff->v_L(), *step_aff->v_U(),
-                      *step_cen_x_L, *step_cen_x_U, *step_cen_s_L, *step_cen_s_U, *step_cen->y_c(), *step_cen->y_d(), *step_cen->z_L(),
-                      *step_cen->z_U(), *step_cen->v_L(), *step_cen->v_U());
+   Number sigmas[2] = { 1., sigma_1minus };
+   Number qfs[2];
+   CalculateQualityFunctions(2, sigmas, qfs);
+   Number qf_1 = qfs[0];
+   Number qf_1minus = qfs[1];
 
    if( qf_1minus > qf_1 )
    {
@@ -357,10 +300,7 @@ bool QualityFunctionMuOracle::CalculateMu(
       {
          // ToDo maybe we should use different tolerances for sigma>1
          sigma = PerformGoldenSection(sigma_up, -100., sigma_lo, qf_1, quality_function_section_sigma_tol_,
-                                      quality_function_section_qf_tol_, *step_aff_x_L, *step_aff_x_U, *step_aff_s_L, *step_aff_s_U,
-                                      *step_aff->y_c(), *step_aff->y_d(), *step_aff->z_L(), *step_aff->z_U(), *step_aff->v_L(), *step_aff->v_U(),
-                                      *step_cen_x_L, *step_cen_x_U, *step_cen_s_L, *step_cen_s_U, *step_cen->y_c(), *step_cen->y_d(),
-                                      *step_cen->z_L(), *step_cen->z_U(), *step_cen->v_L(), *step_cen->v_U());
+                                      quality_function_section_qf_tol_);
       }
    }
    else
@@ -377,10 +317,7 @@ bool QualityFunctionMuOracle::CalculateMu(
       else
       {
          sigma = PerformGoldenSection(sigma_up, qf_1minus, sigma_lo, -100., quality_function_section_sigma_tol_,
-                                      quality_function_section_qf_tol_, *step_aff_x_L, *step_aff_x_U, *step_aff_s_L, *step_aff_s_U,
-                                      *step_aff->y_c(), *step_aff->y_d(), *step_aff->z_L(), *step_aff->z_U(), *step_aff->v_L(), *step_aff->v_U(),
-                                      *step_cen_x_L, *step_cen_x_U, *step_cen_s_L, *step_cen_s_U, *step_cen->y_c(), *step_cen->y_d(),
-                                      *step_cen->z_L(), *step_cen->z_U(), *step_cen->v_L(), *step_cen->v_U());
+                                      quality_function_section_qf_tol_);
       }
    }
 
@@ -391,32 +328,19 @@ bool QualityFunctionMuOracle::CalculateMu(
 
    Number sigma_1 = sigma_max_;
    Number sigma_2 = 1e-9 / avrg_compl;
-   Number sigma_trace = sigma_1;
-   while (sigma_trace > sigma_2)
+   std::vector<Number> sigma_trace;
+   for( Number sigma_t = sigma_1; sigma_t > sigma_2; sigma_t /= 1.1 )
+   {
+      sigma_trace.push_back(sigma_t);
+   }
+   std::vector<Number> qf_trace(sigma_trace.size());
+   if( !sigma_trace.empty() )
    {
-      Number qf = CalculateQualityFunction(sigma_trace,
-                                           *step_aff_x_L,
-                                           *step_aff_x_U,
-                                           *step_aff_s_L,
-                                           *step_aff_s_U,
-                                           *step_aff->y_c(),
-                                           *step_aff->y_d(),
-                                           *step_aff->z_L(),
-                                           *step_aff->z_U(),
-                                           *step_aff->v_L(),
-                                           *step_aff->v_U(),
-                                           *step_cen_x_L,
-                                           *step_cen_x_U,
-                                           *step_cen_s_L,
-                                           *step_cen_s_U,
-                                           *step_cen->y_c(),
-                                           *step_cen->y_d(),
-                                           *step_cen->z_L(),
-                                           *step_cen->z_U(),
-                                           *step_cen->v_L(),
-                                           *step_cen->v_U());
-      fprintf(fid, "%9.2e %25.16e\n", sigma_trace, qf);
-      sigma_trace /= 1.1;
+      CalculateQualityFunctions((Index) sigma_trace.size(), &sigma_trace[0], &qf_trace[0]);
+   }
+   for( size_t i = 0; i < sigma_trace.size(); i++ )
+   {
+      fprintf(fid, "%9.2e %25.16e\n", sigma_trace[i], qf_trace[i]);
    }
    fclose(fid);
 #endif
@@ -441,32 +365,9 @@ bool QualityFunctionMuOracle::CalculateMu(
    IpData().set_delta(step);
    IpData().SetHaveDeltas(true);
 
-   ///////////////////////////////////////////////////////////////////////////
-   // Release memory for temporary vectors used in CalculateQualityFunction //
-   ///////////////////////////////////////////////////////////////////////////
-
-   tmp_step_x_L_ = NULL;
-   tmp_step_x_U_ = NULL;
-   tmp_step_s_L_ = NULL;
-   tmp_step_s_U_ = NULL;
-   tmp_step_z_L_ = NULL;
-   tmp_step_z_U_ = NULL;
-   tmp_step_v_L_ = NULL;
-   tmp_step_v_U_ = NULL;
-
-   tmp_slack_x_L_ = NULL;
-   tmp_slack_x_U_ = NULL;
-   tmp_slack_s_L_ = NULL;
-   tmp_slack_s_U_ = NULL;
-   tmp_z_L_ = NULL;
-   tmp_z_U_ = NULL;
-   tmp_v_L_ = NULL;
-   tmp_v_U_ = NULL;
-
-   curr_slack_x_L_ = NULL;
-   curr_slack_x_U_ = NULL;
-   curr_slack_s_L_ = NULL;
-   curr_slack_s_U_ = NULL;
+   // Release memory used in CalculateQualityFunctions
+   std::vector<Number>().swap(qf_terms_);
+   std::vector<Number>().swap(qf_work_);
 
    /*
    char ssigma[40];
@@ -484,14 +385,11 @@ bool QualityFunctionMuOracle::CalculateMu(
    return true;
 }
 
-Number QualityFunctionMuOracle::CalculateQualityFunction(
-   Number        sigma,
+void QualityFunctionMuOracle::PrepareQualityFunctionTerms(
    const Vector& step_aff_x_L,
    const Vector& step_aff_x_U,
    const Vector& step_aff_s_L,
    const Vector& step_aff_s_U,
-   const Vector& /*step_aff_y_c*/,
-   const Vector& /*step_aff_y_d*/,
    const Vector& step_aff_z_L,
    const Vector& step_aff_z_U,
    const Vector& step_aff_v_L,
@@ -500,198 +398,268 @@ Number QualityFunctionMuOracle::CalculateQualityFunction(
    const Vector& step_cen_x_U,
    const Vector& step_cen_s_L,
    const Vector& step_cen_s_U,
-   const Vector& /*step_cen_y_c*/,
-   const Vector& /*step_cen_y_d*/,
    const Vector& step_cen_z_L,
    const Vector& step_cen_z_U,
    const Vector& step_cen_v_L,
    const Vector& step_cen_v_U
 )
 {
-   DBG_START_METH("QualityFunctionMuOracle::CalculateQualityFunction",
+   DBG_START_METH("QualityFunctionMuOracle::PrepareQualityFunctionTerms",
                   dbg_verbosity);
-   count_qf_evals_++;
-
-   IpData().TimingStats().Task1().Start();
-   tmp_step_x_L_->AddTwoVectors(1., step_aff_x_L, sigma, step_cen_x_L, 0.);
-   tmp_step_x_U_->AddTwoVectors(1., step_aff_x_U, sigma, step_cen_x_U, 0.);
-   tmp_step_s_L_->AddTwoVectors(1., step_aff_s_L, sigma, step_cen_s_L, 0.);
-   tmp_step_s_U_->AddTwoVectors(1., step_aff_s_U, sigma, step_cen_s_U, 0.);
-   tmp_step_z_L_->AddTwoVectors(1., step_aff_z_L, sigma, step_cen_z_L, 0.);
-   tmp_step_z_U_->AddTwoVectors(1., step_aff_z_U, sigma, step_cen_z_U, 0.);
-   tmp_step_v_L_->AddTwoVectors(1., step_aff_v_L, sigma, step_cen_v_L, 0.);
-   tmp_step_v_U_->AddTwoVectors(1., step_aff_v_U, sigma, step_cen_v_U, 0.);
-   IpData().TimingStats().Task1().End();
-
-   // Compute the fraction-to-the-boundary step sizes
-   IpData().TimingStats().Task2().Start();
-   Number tau = IpData().curr_tau();
-   Number alpha_primal = IpCq().uncached_slack_frac_to_the_bound(tau, *tmp_step_x_L_, *tmp_step_x_U_, *tmp_step_s_L_,
-                         *tmp_step_s_U_);
-
-   Number alpha_dual = IpCq().uncached_dual_frac_to_the_bound(tau, *tmp_step_z_L_, *tmp_step_z_U_, *tmp_step_v_L_,
-                       *tmp_step_v_U_);
-   IpData().TimingStats().Task2().End();
 
-   Number xi = 0.; // centrality measure
+   Index n_x_L = step_aff_x_L.Dim();
+   Index n_x_U = step_aff_x_U.Dim();
+   Index n_s_L = step_aff_s_L.Dim();
+   DBG_ASSERT(n_x_L + n_x_U + n_s_L + step_aff_s_U.Dim() == n_comp_);
 
    IpData().TimingStats().Task1().Start();
-   tmp_slack_x_L_->AddTwoVectors(1., *curr_slack_x_L_, alpha_primal, *tmp_step_x_L_, 0.);
-   tmp_slack_x_U_->AddTwoVectors(1., *curr_slack_x_U_, alpha_primal, *tmp_step_x_U_, 0.);
-   tmp_slack_s_L_->AddTwoVectors(1., *curr_slack_s_L_, alpha_primal, *tmp_step_s_L_, 0.);
-   tmp_slack_s_U_->AddTwoVectors(1., *curr_slack_s_U_, alpha_primal, *tmp_step_s_U_, 0.);
-
-   tmp_z_L_->AddTwoVectors(1., *curr_z_L_, alpha_dual, *tmp_step_z_L_, 0.);
-   tmp_z_U_->AddTwoVectors(1., *curr_z_U_, alpha_dual, *tmp_step_z_U_, 0.);
-   tmp_v_L_->AddTwoVectors(1., *curr_v_L_, alpha_dual, *tmp_step_v_L_, 0.);
-   tmp_v_U_->AddTwoVectors(1., *curr_v_U_, alpha_dual, *tmp_step_v_U_, 0.);
+   qf_terms_.resize((size_t) QF_NTERMS * n_comp_);
+
+   Index offset = 0;
+   AppendQualityFunctionTerms(offset, *IpCq().curr_slack_x_L(), step_aff_x_L, step_cen_x_L,
+                              *IpData().curr()->z_L(), step_aff_z_L, step_cen_z_L);
+   offset += n_x_L;
+   AppendQualityFunctionTerms(offset, *IpCq().curr_slack_x_U(), step_aff_x_U, step_cen_x_U,
+                              *IpData().curr()->z_U(), step_aff_z_U, step_cen_z_U);
+   offset += n_x_U;
+   AppendQualityFunctionTerms(offset, *IpCq().curr_slack_s_L(), step_aff_s_L, step_cen_s_L,
+                              *IpData().curr()->v_L(), step_aff_v_L, step_cen_v_L);
+   offset += n_s_L;
+   AppendQualityFunctionTerms(offset, *IpCq().curr_slack_s_U(), step_aff_s_U, step_cen_s_U,
+                              *IpData().curr()->v_U(), step_aff_v_U, step_cen_v_U);
    IpData().TimingStats().Task1().End();
+}
 
-   IpData().TimingStats().Task3().Start();
-   tmp_slack_x_L_->ElementWiseMultiply(*tmp_z_L_);
-   tmp_slack_x_U_->ElementWiseMultiply(*tmp_z_U_);
-   tmp_slack_s_L_->ElementWiseMultiply(*tmp_v_L_);
-   tmp_slack_s_U_->ElementWiseMultiply(*tmp_v_U_);
-   IpData().TimingStats().Task3().End();
-
-   DBG_PRINT_VECTOR(2, "compl_x_L", *tmp_slack_x_L_);
-   DBG_PRINT_VECTOR(2, "compl_x_U", *tmp_slack_x_U_);
-   DBG_PRINT_VECTOR(2, "compl_s_L", *tmp_slack_s_L_);
-   DBG_PRINT_VECTOR(2, "compl_s_U", *tmp_slack_s_U_);
-
-   Number dual_inf = -1.;
-   Number primal_inf = -1.;
-   Number compl_inf = -1.;
+void QualityFunctionMuOracle::AppendQualityFunctionTerms(
+   Index         offset,
+   const Vector& slack,
+   const Vector& step_aff_slack,
+   const Vector& step_cen_slack,
+   const Vector& mult,
+   const Vector& step_aff_mult,
+   const Vector& step_cen_mult
+)
+{
+   Index dim = slack.Dim();
+   if( dim == 0 )
+   {
+      return;
+   }
 
-   IpData().TimingStats().Task5().Start();
-   switch( quality_function_norm_ )
+   const Vector* vecs[QF_NTERMS] = { &slack, &step_aff_slack, &step_cen_slack, &mult, &step_aff_mult, &step_cen_mult };
+   std::vector<Number> vals(dim);
+   Number* terms = &qf_terms_[(size_t) QF_NTERMS * offset];
+   for( Index k = 0; k < QF_NTERMS; k++ )
    {
-      case NM_NORM_1:
-         dual_inf = (1. - alpha_dual) * (curr_grad_lag_x_asum_ + curr_grad_lag_s_asum_);
+      DBG_ASSERT(vecs[k]->Dim() == dim);
+      TripletHelper::FillValuesFromVector(dim, *vecs[k], &vals[0]);
+      for( Index i = 0; i < dim; i++ )
+      {
+         terms[QF_NTERMS * i + k] = vals[i];
+      }
+   }
+}
 
-         primal_inf = (1. - alpha_primal) * (curr_c_asum_ + curr_d_minus_s_asum_);
+Number QualityFunctionMuOracle::CalculateQualityFunction(
+   Number sigma
+)
+{
+   Number qf;
+   CalculateQualityFunctions(1, &sigma, &qf);
+   return qf;
+}
 
-         compl_inf = tmp_slack_x_L_->Asum() + tmp_slack_x_U_->Asum() + tmp_slack_s_L_->Asum() + tmp_slack_s_U_->Asum();
+void QualityFunctionMuOracle::CalculateQualityFunctions(
+   Index         nsigma,
+   const Number* sigma,
+   Number*       qf
+)
+{
+   DBG_START_METH("QualityFunctionMuOracle::CalculateQualityFunctions",
+                  dbg_verbosity);
+   DBG_ASSERT(nsigma > 0);
+   DBG_ASSERT((Index) qf_terms_.size() == QF_NTERMS * n_comp_);
+   count_qf_evals_ += nsigma;
+
+   // For each sigma, qf_work_ holds the primal and dual step sizes,
+   // followed by the 1-norm, the squared 2-norm, the max-norm and the
+   // minimum of the resulting complementarities
+   const Index nwork = 6;
+   qf_work_.resize((size_t) nwork * nsigma);
+   Number* work = &qf_work_[0];
+   const Number* terms = n_comp_ > 0 ? &qf_terms_[0] : NULL;
 
-         dual_inf /= n_dual_;
-         if( n_pri_ > 0 )
-         {
-            primal_inf /= n_pri_;
-         }
-         DBG_ASSERT(n_comp_ > 0);
-         compl_inf /= n_comp_;
-         break;
-      case NM_NORM_2_SQUARED:
-         dual_inf = std::pow(1. - alpha_dual, 2) * (std::pow(curr_grad_lag_x_nrm2_, 2) + std::pow(curr_grad_lag_s_nrm2_, 2));
-         primal_inf = std::pow(1. - alpha_primal, 2) * (std::pow(curr_c_nrm2_, 2) + std::pow(curr_d_minus_s_nrm2_, 2));
-         compl_inf = std::pow(tmp_slack_x_L_->Nrm2(), 2) + std::pow(tmp_slack_x_U_->Nrm2(), 2) + std::pow(tmp_slack_s_L_->Nrm2(), 2)
-                     + std::pow(tmp_slack_s_U_->Nrm2(), 2);
-         dual_inf /= n_dual_;
-         if( n_pri_ > 0 )
+   // Compute the fraction-to-the-boundary step sizes
+   IpData().TimingStats().Task2().Start();
+   Number tau = IpData().curr_tau();
+   for( Index j = 0; j < nsigma; j++ )
+   {
+      work[nwork * j] = 1.;
+      work[nwork * j + 1] = 1.;
+   }
+   for( Index i = 0; i < n_comp_; i++ )
+   {
+      const Number* t = terms + QF_NTERMS * i;
+      for( Index j = 0; j < nsigma; j++ )
+      {
+         Number ds = t[1] + sigma[j] * t[2];
+         if( ds < 0. )
          {
-            primal_inf /= n_pri_;
+            work[nwork * j] = Min(work[nwork * j], -tau / ds * t[0]);
          }
-         DBG_ASSERT(n_comp_ > 0);
-         compl_inf /= n_comp_;
-         break;
-      case NM_NORM_MAX:
-         dual_inf = (1. - alpha_dual) * Max(curr_grad_lag_x_amax_, curr_grad_lag_s_amax_);
-         primal_inf = (1. - alpha_primal) * Max(curr_c_amax_, curr_d_minus_s_amax_);
-         compl_inf = Max(tmp_slack_x_L_->Amax(), tmp_slack_x_U_->Amax(), tmp_slack_s_L_->Amax(),
-                         tmp_slack_s_U_->Amax());
-         break;
-      case NM_NORM_2:
-         dual_inf = (1. - alpha_dual) * std::sqrt(std::pow(curr_grad_lag_x_nrm2_, 2) + std::pow(curr_grad_lag_s_nrm2_, 2));
-         primal_inf = (1. - alpha_primal) * std::sqrt(std::pow(curr_c_nrm2_, 2) + std::pow(curr_d_minus_s_nrm2_, 2));
-         compl_inf = std::sqrt(
-                        std::pow(tmp_slack_x_L_->Nrm2(), 2) + std::pow(tmp_slack_x_U_->Nrm2(), 2) + std::pow(tmp_slack_s_L_->Nrm2(), 2)
-                        + std::pow(tmp_slack_s_U_->Nrm2(), 2));
-         dual_inf /= std::sqrt((Number) n_dual_);
-         if( n_pri_ > 0 )
+         Number dz = t[4] + sigma[j] * t[5];
+         if( dz < 0. )
          {
-            primal_inf /= std::sqrt((Number) n_pri_);
+            work[nwork * j + 1] = Min(work[nwork * j + 1], -tau / dz * t[3]);
          }
-         DBG_ASSERT(n_comp_ > 0);
-         compl_inf /= std::sqrt((Number) n_comp_);
-         break;
-      default:
-         DBG_ASSERT(false && "Unknown value for quality_function_norm_");
+      }
    }
-   IpData().TimingStats().Task5().End();
-
-   Number quality_function = dual_inf + primal_inf + compl_inf;
+   IpData().TimingStats().Task2().End();
 
-   if( quality_function_centrality_ != CEN_NONE )
+   // Compute the complementarities at the trial points and aggregate them
+   IpData().TimingStats().Task3().Start();
+   for( Index j = 0; j < nsigma; j++ )
    {
-      IpData().TimingStats().Task4().Start();
-      xi = IpCq().CalcCentralityMeasure(*tmp_slack_x_L_, *tmp_slack_x_U_, *tmp_slack_s_L_, *tmp_slack_s_U_);
-      IpData().TimingStats().Task4().End();
+      work[nwork * j + 2] = 0.;
+      work[nwork * j + 3] = 0.;
+      work[nwork * j + 4] = 0.;
+      work[nwork * j + 5] = std::numeric_limits<Number>::max();
    }
-   switch( quality_function_centrality_ )
+   for( Index i = 0; i < n_comp_; i++ )
    {
-      case CEN_NONE:
-         //Nothing
-         break;
-      case CEN_LOG:
-         quality_function -= compl_inf * std::log(xi);
-         break;
-      case CEN_RECIPROCAL:
-         quality_function += compl_inf / xi;
-         break;
-      case CEN_CUBED_RECIPROCAL:
-         quality_function += compl_inf / std::pow(xi, 3);
-         break;
-      default:
-         DBG_ASSERT(false && "Unknown value for quality_function_centrality_");
+      const Number* t = terms + QF_NTERMS * i;
+      for( Index j = 0; j < nsigma; j++ )
+      {
+         Number* w = work + nwork * j;
+         Number compl_i = (t[0] + w[0] * (t[1] + sigma[j] * t[2])) * (t[3] + w[1] * (t[4] + sigma[j] * t[5]));
+         Number abs_compl_i = std::abs(compl_i);
+         w[2] += abs_compl_i;
+         w[3] += compl_i * compl_i;
+         w[4] = Max(w[4], abs_compl_i);
+         w[5] = Min(w[5], compl_i);
+      }
    }
+   IpData().TimingStats().Task3().End();
 
-   switch( quality_function_balancing_term_ )
+   for( Index j = 0; j < nsigma; j++ )
    {
-      case BT_NONE:
-         //Nothing
-         break;
-      case BT_CUBIC:
-         quality_function += std::pow(Max(Number(0.), Max(dual_inf, primal_inf) - compl_inf), 3);
-         break;
-      default:
-         DBG_ASSERT(false && "Unknown value for quality_function_balancing term_");
-   }
+      const Number* w = work + nwork * j;
+      Number alpha_primal = w[0];
+      Number alpha_dual = w[1];
+
+      Number dual_inf = -1.;
+      Number primal_inf = -1.;
+      Number compl_inf = -1.;
+
+      IpData().TimingStats().Task5().Start();
+      switch( quality_function_norm_ )
+      {
+         case NM_NORM_1:
+            dual_inf = (1. - alpha_dual) * (curr_grad_lag_x_asum_ + curr_grad_lag_s_asum_);
+
+            primal_inf = (1. - alpha_primal) * (curr_c_asum_ + curr_d_minus_s_asum_);
+
+            compl_inf = w[2];
+
+            dual_inf /= n_dual_;
+            if( n_pri_ > 0 )
+            {
+               primal_inf /= n_pri_;
+            }
+            DBG_ASSERT(n_comp_ > 0);
+            compl_inf /= n_comp_;
+            break;
+         case NM_NORM_2_SQUARED:
+            dual_inf = std::pow(1. - alpha_dual, 2) * (std::pow(curr_grad_lag_x_nrm2_, 2) + std::pow(curr_grad_lag_s_nrm2_, 2));
+            primal_inf = std::pow(1. - alpha_primal, 2) * (std::pow(curr_c_nrm2_, 2) + std::pow(curr_d_minus_s_nrm2_, 2));
+            compl_inf = w[3];
+            dual_inf /= n_dual_;
+            if( n_pri_ > 0 )
+            {
+               primal_inf /= n_pri_;
+            }
+            DBG_ASSERT(n_comp_ > 0);
+            compl_inf /= n_comp_;
+            break;
+         case NM_NORM_MAX:
+            dual_inf = (1. - alpha_dual) * Max(curr_grad_lag_x_amax_, curr_grad_lag_s_amax_);
+            primal_inf = (1. - alpha_primal) * Max(curr_c_amax_, curr_d_minus_s_amax_);
+            compl_inf = w[4];
+            break;
+         case NM_NORM_2:
+            dual_inf = (1. - alpha_dual) * std::sqrt(std::pow(curr_grad_lag_x_nrm2_, 2) + std::pow(curr_grad_lag_s_nrm2_, 2));
+            primal_inf = (1. - alpha_primal) * std::sqrt(std::pow(curr_c_nrm2_, 2) + std::pow(curr_d_minus_s_nrm2_, 2));
+            compl_inf = std::sqrt(w[3]);
+            dual_inf /= std::sqrt((Number) n_dual_);
+            if( n_pri_ > 0 )
+            {
+               primal_inf /= std::sqrt((Number) n_pri_);
+            }
+            DBG_ASSERT(n_comp_ > 0);
+            compl_inf /= std::sqrt((Number) n_comp_);
+            break;
+         default:
+            DBG_ASSERT(false && "Unknown value for quality_function_norm_");
+      }
+      IpData().TimingStats().Task5().End();
+
+      Number quality_function = dual_inf + primal_inf + compl_inf;
+
+      Number xi = 0.; // centrality measure
+      if( quality_function_centrality_ != CEN_NONE && n_comp_ > 0 )
+      {
+         IpData().TimingStats().Task4().Start();
+         DBG_ASSERT(w[5] > 0. && "There is a zero complementarity entry");
+         // The Min is for the case that the average complementarity
+         // is slighly smaller than the minimum, due to numerical roundoff
+         xi = Min(Number(1.), w[5] / (w[2] / n_comp_));
+         IpData().TimingStats().Task4().End();
+      }
+      switch( quality_function_centrality_ )
+      {
+         case CEN_NONE:
+            //Nothing
+            break;
+         case CEN_LOG:
+            quality_function -= compl_inf * std::log(xi);
+            break;
+         case CEN_RECIPROCAL:
+            quality_function += compl_inf / xi;
+            break;
+         case CEN_CUBED_RECIPROCAL:
+            quality_function += compl_inf / std::pow(xi, 3);
+            break;
+         default:
+            DBG_ASSERT(false && "Unknown value for quality_function_centrality_");
+      }
+
+      switch( quality_function_balancing_term_ )
+      {
+         case BT_NONE:
+            //Nothing
+            break;
+         case BT_CUBIC:
+            quality_function += std::pow(Max(Number(0.), Max(dual_inf, primal_inf) - compl_inf), 3);
+            break;
+         default:
+            DBG_ASSERT(false && "Unknown value for quality_function_balancing term_");
+      }
 
-   Jnlst().Printf(J_MOREDETAILED, J_BARRIER_UPDATE,
-                  "sigma = %8.2e d_inf = %18.12e p_inf = %18.12e cmpl = %18.12e q = %18.12e a_pri = %8.2e a_dual = %8.2e xi = %8.2e\n",
-                  sigma, dual_inf, primal_inf, compl_inf, quality_function, alpha_primal, alpha_dual, xi);
+      Jnlst().Printf(J_MOREDETAILED, J_BARRIER_UPDATE,
+                     "sigma = %8.2e d_inf = %18.12e p_inf = %18.12e cmpl = %18.12e q = %18.12e a_pri = %8.2e a_dual = %8.2e xi = %8.2e\n",
+                     sigma[j], dual_inf, primal_inf, compl_inf, quality_function, alpha_primal, alpha_dual, xi);
 
-   return quality_function;
-   //return compl_inf;
+      qf[j] = quality_function;
+   }
 }
 
 Number QualityFunctionMuOracle::PerformGoldenSection(
-   Number        sigma_up_in,
-   Number        q_up,
-   Number        sigma_lo_in,
-   Number        q_lo,
-   Number        sigma_tol,
-   Number        qf_tol,
-   const Vector& step_aff_x_L,
-   const Vector& step_aff_x_U,
-   const Vector& step_aff_s_L,
-   const Vector& step_aff_s_U,
-   const Vector& step_aff_y_c,
-   const Vector& step_aff_y_d,
-   const Vector& step_aff_z_L,
-   const Vector& step_aff_z_U,
-   const Vector& step_aff_v_L,
-   const Vector& step_aff_v_U,
-   const Vector& step_cen_x_L,
-   const Vector& step_cen_x_U,
-   const Vector& step_cen_s_L,
-   const Vector& step_cen_s_U,
-   const Vector& step_cen_y_c,
-   const Vector& step_cen_y_d,
-   const Vector& step_cen_z_L,
-   const Vector& step_cen_z_U,
-   const Vector& step_cen_v_L,
-   const Vector& step_cen_v_U
+   Number sigma_up_in,
+   Number q_up,
+   Number sigma_lo_in,
+   Number q_lo,
+   Number sigma_tol,
+   Number qf_tol
 )
 {
    Number sigma_up = ScaleSigma(sigma_up_in);
@@ -702,14 +670,11 @@ Number QualityFunctionMuOracle::PerformGoldenSection(
    Number sigma_mid1 = sigma_lo + gfac * (sigma_up - sigma_lo);
    Number sigma_mid2 = sigma_lo + (1. - gfac) * (sigma_up - sigma_lo);
 
-   Number qmid1 = CalculateQualityFunction(UnscaleSigma(sigma_mid1), step_aff_x_L, step_aff_x_U, step_aff_s_L,
-                                           step_aff_s_U, step_aff_y_c, step_aff_y_d, step_aff_z_L, step_aff_z_U, step_aff_v_L, step_aff_v_U, step_cen_x_L,
-                                           step_cen_x_U, step_cen_s_L, step_cen_s_U, step_cen_y_c, step_cen_y_d, step_cen_z_L, step_cen_z_U, step_cen_v_L,
-                                           step_cen_v_U);
-   Number qmid2 = CalculateQualityFunction(UnscaleSigma(sigma_mid2), step_aff_x_L, step_aff_x_U, step_aff_s_L,
-                                           step_aff_s_U, step_aff_y_c, step_aff_y_d, step_aff_z_L, step_aff_z_U, step_aff_v_L, step_aff_v_U, step_cen_x_L,
-                                           step_cen_x_U, step_cen_s_L, step_cen_s_U, step_cen_y_c, step_cen_y_d, step_cen_z_L, step_cen_z_U, step_cen_v_L,
-                                           step_cen_v_U);
+   Number sigmas[2] = { UnscaleSigma(sigma_mid1), UnscaleSigma(sigma_mid2) };
+   Number qfs[2];
+   CalculateQualityFunctions(2, sigmas, qfs);
+   Number qmid1 = qfs[0];
+   Number qmid2 = qfs[1];
 
    Index nsections = 0;
    while( (sigma_up - sigma_lo) >= sigma_tol * sigma_up
@@ -727,10 +692,7 @@ Number QualityFunctionMuOracle::PerformGoldenSection(
          sigma_mid1 = sigma_mid2;
          qmid1 = qmid2;
          sigma_mid2 = sigma_lo + (1. - gfac) * (sigma_up - sigma_lo);
-         qmid2 = CalculateQualityFunction(UnscaleSigma(sigma_mid2), step_aff_x_L, step_aff_x_U, step_aff_s_L,
-                                          step_aff_s_U, step_aff_y_c, step_aff_y_d, step_aff_z_L, step_aff_z_U, step_aff_v_L, step_aff_v_U,
-                                          step_cen_x_L, step_cen_x_U, step_cen_s_L, step_cen_s_U, step_cen_y_c, step_cen_y_d, step_cen_z_L,
-                                          step_cen_z_U, step_cen_v_L, step_cen_v_U);
+         qmid2 = CalculateQualityFunction(UnscaleSigma(sigma_mid2));
       }
       else
       {
@@ -739,10 +701,7 @@ Number QualityFunctionMuOracle::PerformGoldenSection(
          sigma_mid2 = sigma_mid1;
          qmid2 = qmid1;
          sigma_mid1 = sigma_lo + gfac * (sigma_up - sigma_lo);
-         qmid1 = CalculateQualityFunction(UnscaleSigma(sigma_mid1), step_aff_x_L, step_aff_x_U, step_aff_s_L,
-                                          step_aff_s_U, step_aff_y_c, step_aff_y_d, step_aff_z_L, step_aff_z_U, step_aff_v_L, step_aff_v_U,
-                                          step_cen_x_L, step_cen_x_U, step_cen_s_L, step_cen_s_U, step_cen_y_c, step_cen_y_d, step_cen_z_L,
-                                          step_cen_z_U, step_cen_v_L, step_cen_v_U);
+         qmid1 = CalculateQualityFunction(UnscaleSigma(sigma_mid1));
       }
    }
 
@@ -788,10 +747,7 @@ Number QualityFunctionMuOracle::PerformGoldenSection(
          Number qtmp;
          if( q_up < 0. )
          {
-            qtmp = CalculateQualityFunction(UnscaleSigma(sigma_up), step_aff_x_L, step_aff_x_U, step_aff_s_L,
-                                            step_aff_s_U, step_aff_y_c, step_aff_y_d, step_aff_z_L, step_aff_z_U, step_aff_v_L, step_aff_v_U,
-                                            step_cen_x_L, step_cen_x_U, step_cen_s_L, step_cen_s_U, step_cen_y_c, step_cen_y_d, step_cen_z_L,
-                                            step_cen_z_U, step_cen_v_L, step_cen_v_U);
+            qtmp = CalculateQualityFunction(UnscaleSigma(sigma_up));
          }
          else
          {
@@ -808,10 +764,7 @@ Number QualityFunctionMuOracle::PerformGoldenSection(
          Number qtmp;
          if( q_lo < 0. )
          {
-            qtmp = CalculateQualityFunction(UnscaleSigma(sigma_lo), step_aff_x_L, step_aff_x_U, step_aff_s_L,
-                                            step_aff_s_U, step_aff_y_c, step_aff_y_d, step_aff_z_L, step_aff_z_U, step_aff_v_L, step_aff_v_U,
-                                            step_cen_x_L, step_cen_x_U, step_cen_s_L, step_cen_s_U, step_cen_y_c, step_cen_y_d, step_cen_z_L,
-                                            step_cen_z_U, step_cen_v_L, step_cen_v_U);
+            qtmp = CalculateQualityFunction(UnscaleSigma(sigma_lo));
          }
          else
          {
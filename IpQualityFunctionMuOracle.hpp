@@ -11,6 +11,8 @@
 #include "IpPDSystemSolver.hpp"
 #include "IpIpoptCalculatedQuantities.hpp"
 
+#include <vector>
+
 namespace Ipopt
 {
 
@@ -112,15 +114,37 @@ private:
 
    /** Auxiliary function for computing the average complementarity
     *  at a point, given step sizes and step.
+    *
+    *  This uses the terms collected by PrepareQualityFunctionTerms.
     */
    Number CalculateQualityFunction(
-      Number        sigma,
+      Number sigma
+   );
+
+   /** Auxiliary function computing the quality function for several
+    *  values of sigma at once.
+    *
+    *  The terms of all complementarity pairs are read once for all
+    *  values in sigma, so that nsigma evaluations cost hardly more
+    *  memory traffic than one.  The values are returned in qf.
+    */
+   void CalculateQualityFunctions(
+      Index         nsigma,
+      const Number* sigma,
+      Number*       qf
+   );
+
+   /** Collect the terms of the quality function for all
+    *  complementarity pairs in qf_terms_.
+    *
+    *  The step_*_x_L etc. are the steps for the slacks, step_*_z_L
+    *  etc. those for the bound multipliers.
+    */
+   void PrepareQualityFunctionTerms(
       const Vector& step_aff_x_L,
       const Vector& step_aff_x_U,
       const Vector& step_aff_s_L,
       const Vector& step_aff_s_U,
-      const Vector& step_aff_y_c,
-      const Vector& step_aff_y_d,
       const Vector& step_aff_z_L,
       const Vector& step_aff_z_U,
       const Vector& step_aff_v_L,
@@ -129,42 +153,33 @@ private:
       const Vector& step_cen_x_U,
       const Vector& step_cen_s_L,
       const Vector& step_cen_s_U,
-      const Vector& step_cen_y_c,
-      const Vector& step_cen_y_d,
       const Vector& step_cen_z_L,
       const Vector& step_cen_z_U,
       const Vector& step_cen_v_L,
       const Vector& step_cen_v_U
    );
 
+   /** Append the terms for one block of complementarity pairs to
+    *  qf_terms_, starting at pair offset.
+    */
+   void AppendQualityFunctionTerms(
+      Index         offset,
+      const Vector& slack,
+      const Vector& step_aff_slack,
+      const Vector& step_cen_slack,
+      const Vector& mult,
+      const Vector& step_aff_mult,
+      const Vector& step_cen_mult
+   );
+
    /** Auxiliary function performing the golden section */
    Number PerformGoldenSection(
-      Number        sigma_up,
-      Number        q_up,
-      Number        sigma_lo,
-      Number        q_lo,
-      Number        sigma_tol,
-      Number        qf_tol,
-      const Vector& step_aff_x_L,
-      const Vector& step_aff_x_U,
-      const Vector& step_aff_s_L,
-      const Vector& step_aff_s_U,
-      const Vector& step_aff_y_c,
-      const Vector& step_aff_y_d,
-      const Vector& step_aff_z_L,
-      const Vector& step_aff_z_U,
-      const Vector& step_aff_v_L,
-      const Vector& step_aff_v_U,
-      const Vector& step_cen_x_L,
-      const Vector& step_cen_x_U,
-      const Vector& step_cen_s_L,
-      const Vector& step_cen_s_U,
-      const Vector& step_cen_y_c,
-      const Vector& step_cen_y_d,
-      const Vector& step_cen_z_L,
-      const Vector& step_cen_z_U,
-      const Vector& step_cen_v_L,
-      const Vector& step_cen_v_U
+      Number sigma_up,
+      Number q_up,
+      Number sigma_lo,
+      Number q_lo,
+      Number sigma_tol,
+      Number qf_tol
    );
 
    /** Auxiliary functions for scaling the sigma axis in the golden
@@ -246,28 +261,23 @@ private:
    Index quality_function_max_section_steps_;
    ///@}
 
-   /** @name Temporary work space vectors.
+   /** @name Work space for the quality function evaluations */
+   ///@{
+   /** Number of entries per complementarity pair in qf_terms_ */
+   static const Index QF_NTERMS = 6;
+
+   /** Terms of the quality function for all complementarity pairs.
     *
-    *  We use those to avoid repeated reallocation in CalculateQualityFunction.
+    *  The QF_NTERMS entries for the i-th pair start at QF_NTERMS*i;
+    *  they are the slack, its affine and centering steps, the bound
+    *  multiplier, and its affine and centering steps.
     */
-   ///@{
-   SmartPtr<Vector> tmp_step_x_L_;
-   SmartPtr<Vector> tmp_step_x_U_;
-   SmartPtr<Vector> tmp_step_s_L_;
-   SmartPtr<Vector> tmp_step_s_U_;
-   SmartPtr<Vector> tmp_step_z_L_;
-   SmartPtr<Vector> tmp_step_z_U_;
-   SmartPtr<Vector> tmp_step_v_L_;
-   SmartPtr<Vector> tmp_step_v_U_;
-
-   SmartPtr<Vector> tmp_slack_x_L_;
-   SmartPtr<Vector> tmp_slack_x_U_;
-   SmartPtr<Vector> tmp_slack_s_L_;
-   SmartPtr<Vector> tmp_slack_s_U_;
-   SmartPtr<Vector> tmp_z_L_;
-   SmartPtr<Vector> tmp_z_U_;
-   SmartPtr<Vector> tmp_v_L_;
-   SmartPtr<Vector> tmp_v_U_;
+   std::vector<Number> qf_terms_;
+
+   /** Step sizes and aggregated complementarities for the values of
+    *  sigma in CalculateQualityFunctions.
+    */
+   std::vector<Number> qf_work_;
    ///@}
 
    /* Counter for the qualify function evaluations */
@@ -285,16 +295,6 @@ private:
    Index n_pri_;
    Index n_comp_;
 
-   SmartPtr<const Vector> curr_slack_x_L_;
-   SmartPtr<const Vector> curr_slack_x_U_;
-   SmartPtr<const Vector> curr_slack_s_L_;
-   SmartPtr<const Vector> curr_slack_s_U_;
-
-   SmartPtr<const Vector> curr_z_L_;
-   SmartPtr<const Vector> curr_z_U_;
-   SmartPtr<const Vector> curr_v_L_;
-   SmartPtr<const Vector> curr_v_U_;
-
    Number curr_grad_lag_x_asum_;
    Number curr_grad_lag_s_asum_;
    Number curr_c_asum_;
@@ -103,6 +103,164 @@ bool RestoIpoptNLP::InitializeStructures(
 {
    DBG_START_METH("RestoIpoptNLP::InitializeStructures", 0);
    DBG_ASSERT(initialized_);
+
+   // The spaces only depend on the structure of the original
+   // problem, so they are created when the restoration phase is
+   // entered for the first time, and reused in later calls
+   bool new_structure = IsNull(x_space_);
+   if( new_structure )
+   {
+      CreateSpaces();
+   }
+
+   ///////////////////////////
+   // Create the bound data //
+   ///////////////////////////
+
+   // The bounds of the original problem might have been relaxed
+   // since the last call, so the bound vectors are always set up
+
+   // x_L
+   x_L_ = x_l_space_->MakeNewCompoundVector();
+   x_L_->SetComp(0, *orig_ip_nlp_->x_L()); // x >= x_L
+   x_L_->GetCompNonConst(1)->Set(0.0); // n_c >= 0
+   x_L_->GetCompNonConst(2)->Set(0.0); // p_c >= 0
+   x_L_->GetCompNonConst(3)->Set(0.0); // n_d >= 0
+   x_L_->GetCompNonConst(4)->Set(0.0); // p_d >= 0
+   DBG_PRINT_VECTOR(2, "resto_x_L", *x_L_);
+
+   // x_U
+   x_U_ = x_u_space_->MakeNewCompoundVector();
+   x_U_->SetComp(0, *orig_ip_nlp_->x_U());
+
+   // d_L
+   d_L_ = d_l_space_->MakeNewCompoundVector();
+   d_L_->SetComp(0, *orig_ip_nlp_->d_L());
+
+   // d_U
+   d_U_ = d_u_space_->MakeNewCompoundVector();
+   d_U_->SetComp(0, *orig_ip_nlp_->d_U());
+
+   if( new_structure )
+   {
+      // Px_L
+      Px_L_ = px_l_space_->MakeNewCompoundMatrix();
+      Px_L_->SetComp(0, 0, *orig_ip_nlp_->Px_L());
+      // Identities are auto-created (true flag passed into SetCompSpace)
+
+      // Px_U
+      Px_U_ = px_u_space_->MakeNewCompoundMatrix();
+      Px_U_->SetComp(0, 0, *orig_ip_nlp_->Px_U());
+      // Remaining matrices will be zero'ed out
+
+      // Pd_L
+      //Pd_L_ = orig_ip_nlp_->Pd_L();
+      Pd_L_ = pd_l_space_->MakeNewCompoundMatrix();
+      Pd_L_->SetComp(0, 0, *orig_ip_nlp_->Pd_L());
+
+      // Pd_U
+      //Pd_U_ = orig_ip_nlp_->Pd_U();
+      Pd_U_ = pd_u_space_->MakeNewCompoundMatrix();
+      Pd_U_->SetComp(0, 0, *orig_ip_nlp_->Pd_U());
+
+      // Getting the NLP scaling
+
+      SmartPtr<const MatrixSpace> scaled_jac_c_space;
+      SmartPtr<const MatrixSpace> scaled_jac_d_space;
+      SmartPtr<const SymMatrixSpace> scaled_h_space;
+      NLP_scaling()->DetermineScaling(GetRawPtr(x_space_), c_space_, d_space_, GetRawPtr(jac_c_space_),
+                                      GetRawPtr(jac_d_space_), GetRawPtr(h_space_), scaled_jac_c_space, scaled_jac_d_space, scaled_h_space, *Px_L_,
+                                      *x_L_, *Px_U_, *x_U_);
+      // For now we assume that no scaling is done inside the NLP_Scaling
+      DBG_ASSERT(scaled_jac_c_space == jac_c_space_);
+      DBG_ASSERT(scaled_jac_d_space == jac_d_space_);
+      DBG_ASSERT(scaled_h_space == h_space_);
+   }
+
+   /////////////////////////////////////////////////////////////////////////
+   // Create and initialize the vectors for the restoration phase problem //
+   /////////////////////////////////////////////////////////////////////////
+
+   // Vector x
+   SmartPtr<CompoundVector> comp_x = x_space_->MakeNewCompoundVector();
+   if( init_x )
+   {
+      comp_x->GetCompNonConst(0)->Copy(*orig_ip_data_->curr()->x());
+      comp_x->GetCompNonConst(1)->Set(1.0);
+      comp_x->GetCompNonConst(2)->Set(1.0);
+      comp_x->GetCompNonConst(3)->Set(1.0);
+      comp_x->GetCompNonConst(4)->Set(1.0);
+   }
+   x = GetRawPtr(comp_x);
+
+   // Vector y_c
+   y_c = c_space_->MakeNew();
+   if( init_y_c )
+   {
+      y_c->Set(0.0);  // ToDo
+   }
+
+   // Vector y_d
+   y_d = d_space_->MakeNew();
+   if( init_y_d )
+   {
+      y_d->Set(0.0);
+   }
+
+   // Vector z_L
+   z_L = x_l_space_->MakeNew();
+   if( init_z_L )
+   {
+      z_L->Set(1.0);
+   }
+
+   // Vector z_U
+   z_U = x_u_space_->MakeNew();
+   if( init_z_U )
+   {
+      z_U->Set(1.0);
+   }
+
+   // Vector v_L
+   v_L = d_l_space_->MakeNew();
+
+   // Vector v_U
+   v_U = d_u_space_->MakeNew();
+
+   // Initialize other data needed by the restoration nlp.  x_ref is
+   // the point to reference to which we based the regularization
+   // term
+   SmartPtr<Vector> x_ref = x_space_->GetCompSpace(0)->MakeNew();
+   x_ref->Copy(*orig_ip_data_->curr()->x());
+   x_ref_ = x_ref;
+
+   SmartPtr<Vector> dr_x = x_ref->MakeNew();
+   dr_x->Set(1.0);
+   SmartPtr<Vector> tmp = dr_x->MakeNew();
+   tmp->Copy(*x_ref_);
+   dr_x->ElementWiseMax(*tmp);
+   tmp->Scal(-1.);
+   dr_x->ElementWiseMax(*tmp);
+   dr_x->ElementWiseReciprocal();
+   dr_x_ = dr_x;
+   DBG_PRINT_VECTOR(2, "dr_x_", *dr_x_);
+
+   // dr_x^2
+   SmartPtr<Vector> dr2_x = dr_x->MakeNewCopy();
+   dr2_x->ElementWiseMultiply(*dr_x_);
+   dr2_x_ = dr2_x;
+
+   SmartPtr<DiagMatrix> DR2_x = DR2_x_space_->MakeNewDiagMatrix();
+   DR2_x->SetDiag(*dr2_x_);
+   DR2_x_ = DR2_x;
+
+   return true;
+}
+
+void RestoIpoptNLP::CreateSpaces()
+{
+   DBG_START_METH("RestoIpoptNLP::CreateSpaces", dbg_verbosity);
+
    ///////////////////////////////////////////////////////////
    // Get the vector/matrix spaces for the original problem //
    ///////////////////////////////////////////////////////////
@@ -294,7 +452,7 @@ bool RestoIpoptNLP::InitializeStructures(
    h_space_->SetBlockDim(3, orig_d_space->Dim());
    h_space_->SetBlockDim(4, orig_d_space->Dim());
 
-   SmartPtr<DiagMatrixSpace> DR2_x_space = new DiagMatrixSpace(orig_x_space->Dim());
+   DR2_x_space_ = new DiagMatrixSpace(orig_x_space->Dim());
    if( hessian_approximation_ == LIMITED_MEMORY )
    {
       const LowRankUpdateSymMatrixSpace* LR_h_space = static_cast<const LowRankUpdateSymMatrixSpace*>(GetRawPtr(
@@ -308,147 +466,10 @@ bool RestoIpoptNLP::InitializeStructures(
    {
       SmartPtr<SumSymMatrixSpace> sumsym_mat_space = new SumSymMatrixSpace(orig_x_space->Dim(), 2);
       sumsym_mat_space->SetTermSpace(0, *orig_h_space);
-      sumsym_mat_space->SetTermSpace(1, *DR2_x_space);
+      sumsym_mat_space->SetTermSpace(1, *DR2_x_space_);
       h_space_->SetCompSpace(0, 0, *sumsym_mat_space, true);
       // All remaining blocks are zero'ed out
    }
-
-   ///////////////////////////
-   // Create the bound data //
-   ///////////////////////////
-
-   // x_L
-   x_L_ = x_l_space_->MakeNewCompoundVector();
-   x_L_->SetComp(0, *orig_ip_nlp_->x_L()); // x >= x_L
-   x_L_->GetCompNonConst(1)->Set(0.0); // n_c >= 0
-   x_L_->GetCompNonConst(2)->Set(0.0); // p_c >= 0
-   x_L_->GetCompNonConst(3)->Set(0.0); // n_d >= 0
-   x_L_->GetCompNonConst(4)->Set(0.0); // p_d >= 0
-   DBG_PRINT_VECTOR(2, "resto_x_L", *x_L_);
-
-   // x_U
-   x_U_ = x_u_space_->MakeNewCompoundVector();
-   x_U_->SetComp(0, *orig_ip_nlp_->x_U());
-
-   // d_L
-   d_L_ = d_l_space_->MakeNewCompoundVector();
-   d_L_->SetComp(0, *orig_ip_nlp_->d_L());
-
-   // d_U
-   d_U_ = d_u_space_->MakeNewCompoundVector();
-   d_U_->SetComp(0, *orig_ip_nlp_->d_U());
-
-   // Px_L
-   Px_L_ = px_l_space_->MakeNewCompoundMatrix();
-   Px_L_->SetComp(0, 0, *orig_ip_nlp_->Px_L());
-   // Identities are auto-created (true flag passed into SetCompSpace)
-
-   // Px_U
-   Px_U_ = px_u_space_->MakeNewCompoundMatrix();
-   Px_U_->SetComp(0, 0, *orig_ip_nlp_->Px_U());
-   // Remaining matrices will be zero'ed out
-
-   // Pd_L
-   //Pd_L_ = orig_ip_nlp_->Pd_L();
-   Pd_L_ = pd_l_space_->MakeNewCompoundMatrix();
-   Pd_L_->SetComp(0, 0, *orig_ip_nlp_->Pd_L());
-
-   // Pd_U
-   //Pd_U_ = orig_ip_nlp_->Pd_U();
-   Pd_U_ = pd_u_space_->MakeNewCompoundMatrix();
-   Pd_U_->SetComp(0, 0, *orig_ip_nlp_->Pd_U());
-
-   // Getting the NLP scaling
-
-   SmartPtr<const MatrixSpace> scaled_jac_c_space;
-   SmartPtr<const MatrixSpace> scaled_jac_d_space;
-   SmartPtr<const SymMatrixSpace> scaled_h_space;
-   NLP_scaling()->DetermineScaling(GetRawPtr(x_space_), c_space_, d_space_, GetRawPtr(jac_c_space_),
-                                   GetRawPtr(jac_d_space_), GetRawPtr(h_space_), scaled_jac_c_space, scaled_jac_d_space, scaled_h_space, *Px_L_,
-                                   *x_L_, *Px_U_, *x_U_);
-   // For now we assume that no scaling is done inside the NLP_Scaling
-   DBG_ASSERT(scaled_jac_c_space == jac_c_space_);
-   DBG_ASSERT(scaled_jac_d_space == jac_d_space_);
-   DBG_ASSERT(scaled_h_space == h_space_);
-
-   /////////////////////////////////////////////////////////////////////////
-   // Create and initialize the vectors for the restoration phase problem //
-   /////////////////////////////////////////////////////////////////////////
-
-   // Vector x
-   SmartPtr<CompoundVector> comp_x = x_space_->MakeNewCompoundVector();
-   if( init_x )
-   {
-      comp_x->GetCompNonConst(0)->Copy(*orig_ip_data_->curr()->x());
-      comp_x->GetCompNonConst(1)->Set(1.0);
-      comp_x->GetCompNonConst(2)->Set(1.0);
-      comp_x->GetCompNonConst(3)->Set(1.0);
-      comp_x->GetCompNonConst(4)->Set(1.0);
-   }
-   x = GetRawPtr(comp_x);
-
-   // Vector y_c
-   y_c = c_space_->MakeNew();
-   if( init_y_c )
-   {
-      y_c->Set(0.0);  // ToDo
-   }
-
-   // Vector y_d
-   y_d = d_space_->MakeNew();
-   if( init_y_d )
-   {
-      y_d->Set(0.0);
-   }
-
-   // Vector z_L
-   z_L = x_l_space_->MakeNew();
-   if( init_z_L )
-   {
-      z_L->Set(1.0);
-   }
-
-   // Vector z_U
-   z_U = x_u_space_->MakeNew();
-   if( init_z_U )
-   {
-      z_U->Set(1.0);
-   }
-
-   // Vector v_L
-   v_L = d_l_space_->MakeNew();
-
-   // Vector v_U
-   v_U = d_u_space_->MakeNew();
-
-   // Initialize other data needed by the restoration nlp.  x_ref is
-   // the point to reference to which we based the regularization
-   // term
-   SmartPtr<Vector> x_ref = orig_x_space->MakeNew();
-   x_ref->Copy(*orig_ip_data_->curr()->x());
-   x_ref_ = x_ref;
-
-   SmartPtr<Vector> dr_x = orig_x_space->MakeNew();
-   dr_x->Set(1.0);
-   SmartPtr<Vector> tmp = dr_x->MakeNew();
-   tmp->Copy(*x_ref_);
-   dr_x->ElementWiseMax(*tmp);
-   tmp->Scal(-1.);
-   dr_x->ElementWiseMax(*tmp);
-   dr_x->ElementWiseReciprocal();
-   dr_x_ = dr_x;
-   DBG_PRINT_VECTOR(2, "dr_x_", *dr_x_);
-
-   // dr_x^2
-   SmartPtr<Vector> dr2_x = dr_x->MakeNewCopy();
-   dr2_x->ElementWiseMultiply(*dr_x_);
-   dr2_x_ = dr2_x;
-
-   SmartPtr<DiagMatrix> DR2_x = DR2_x_space->MakeNewDiagMatrix();
-   DR2_x->SetDiag(*dr2_x_);
-   DR2_x_ = DR2_x;
-
-   return true;
 }
 
 Number RestoIpoptNLP::f(
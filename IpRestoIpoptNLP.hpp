@@ -65,7 +65,13 @@ public:
       const std::string& prefix
    );
 
-   /** Initialize (create) structures for the iteration data */
+   /** Initialize (create) structures for the iteration data.
+    *
+    *  The vector and matrix spaces are only created in the first
+    *  call.  Later calls reuse them, so that the restoration phase
+    *  problem keeps its structure, and only the bounds, the new
+    *  iterates, and the reference point are set up.
+    */
    virtual bool InitializeStructures(
       SmartPtr<Vector>& x,
       bool              init_x,
@@ -404,6 +410,8 @@ private:
    SmartPtr<CompoundMatrixSpace> jac_d_space_;
 
    SmartPtr<CompoundSymMatrixSpace> h_space_;
+
+   SmartPtr<DiagMatrixSpace> DR2_x_space_;
    ///@}
 
    /**@name Storage for Model Quantities */
@@ -455,6 +463,11 @@ private:
    SmartPtr<const Vector> x_ref_;
    ///@}
 
+   /** Create the vector and matrix spaces of the restoration phase
+    *  problem from those of the original problem.
+    */
+   void CreateSpaces();
+
    /**@name Default Compiler Generated Methods
     * (Hidden to avoid implicit creation/calling).
     *
@@ -171,6 +171,12 @@ void RestoIterationOutput::WriteOutput()
       IpData().Inc_info_iters_since_header();
    }
 
+   if( Jnlst().ProduceMetrics() )
+   {
+      WriteIterationMetrics(true, iter, f, inf_pr, inf_du, mu, dnrm, regu_x, alpha_dual, alpha_primal, alpha_primal_char,
+                            ls_count, info_string);
+   }
+
    //////////////////////////////////////////////////////////////////////
    //           Now if desired more detail on the iterates             //
    //////////////////////////////////////////////////////////////////////
@@ -8,6 +8,7 @@
 #include "IpCompoundVector.hpp"
 #include "IpRestoIpoptNLP.hpp"
 #include "IpDefaultIterateInitializer.hpp"
+#include "IpTimingTracer.hpp"
 
 namespace Ipopt
 {
@@ -98,6 +99,12 @@ bool MinC_1NrmRestorationPhase::InitializeImpl(
 
    count_restorations_ = 0;
 
+   // Create the restoration phase NLP etc objects, which are used for
+   // all calls of the restoration phase in this optimization
+   resto_ip_data_ = new IpoptData(NULL);
+   resto_ip_nlp_ = new RestoIpoptNLP(IpNLP(), IpData(), IpCq());
+   resto_ip_cq_ = new IpoptCalculatedQuantities(resto_ip_nlp_, resto_ip_data_);
+
    bool retvalue = true;
    if( IsValid(eq_mult_calculator_) )
    {
@@ -118,11 +125,12 @@ bool MinC_1NrmRestorationPhase::PerformRestoration()
 
    DBG_ASSERT(IpCq().curr_constraint_violation() > 0.);
 
-   // ToDo set those up during initialize?
-   // Create the restoration phase NLP etc objects
-   SmartPtr<IpoptData> resto_ip_data = new IpoptData(NULL);
-   SmartPtr<IpoptNLP> resto_ip_nlp = new RestoIpoptNLP(IpNLP(), IpData(), IpCq());
-   SmartPtr<IpoptCalculatedQuantities> resto_ip_cq = new IpoptCalculatedQuantities(resto_ip_nlp, resto_ip_data);
+   // The restoration phase NLP etc objects have been created in
+   // InitializeImpl and are reused for every call
+   if( IsValid(IpData().TimingStats().Tracer()) )
+   {
+      resto_ip_data_->TimingStats().SetTracer(IpData().TimingStats().Tracer(), "Restoration.");
+   }
 
    if( max_wall_time_ < 1e20 )
    {
@@ -175,17 +183,29 @@ bool MinC_1NrmRestorationPhase::PerformRestoration()
    }
 
    // Initialize the restoration phase algorithm
-   resto_alg_->Initialize(Jnlst(), *resto_ip_nlp, *resto_ip_data, *resto_ip_cq, *actual_resto_options, "resto.");
+   resto_alg_->Initialize(Jnlst(), *resto_ip_nlp_, *resto_ip_data_, *resto_ip_cq_, *actual_resto_options, "resto.");
+
+   if( count_restorations_ == 1 )
+   {
+      // The restoration phase problem keeps its structure in later
+      // calls, so that the calculated quantities can keep their work
+      // vectors, unless the user chose otherwise
+      std::string warm_start_same_structure;
+      if( !resto_options_->GetStringValue("warm_start_same_structure", warm_start_same_structure, "resto.") )
+      {
+         resto_options_->SetStringValue("resto.warm_start_same_structure", "yes", true, true);
+      }
+   }
 
    // Set iteration counter and info field for the restoration phase
-   resto_ip_data->Set_iter_count(IpData().iter_count() + 1);
-   resto_ip_data->Set_info_regu_x(IpData().info_regu_x());
-   resto_ip_data->Set_info_alpha_primal(IpData().info_alpha_primal());
-   resto_ip_data->Set_info_alpha_primal_char(IpData().info_alpha_primal_char());
-   resto_ip_data->Set_info_alpha_dual(IpData().info_alpha_dual());
-   resto_ip_data->Set_info_ls_count(IpData().info_ls_count());
-   resto_ip_data->Set_info_iters_since_header(IpData().info_iters_since_header());
-   resto_ip_data->Set_info_last_output(IpData().info_last_output());
+   resto_ip_data_->Set_iter_count(IpData().iter_count() + 1);
+   resto_ip_data_->Set_info_regu_x(IpData().info_regu_x());
+   resto_ip_data_->Set_info_alpha_primal(IpData().info_alpha_primal());
+   resto_ip_data_->Set_info_alpha_primal_char(IpData().info_alpha_primal_char());
+   resto_ip_data_->Set_info_alpha_dual(IpData().info_alpha_dual());
+   resto_ip_data_->Set_info_ls_count(IpData().info_ls_count());
+   resto_ip_data_->Set_info_iters_since_header(IpData().info_iters_since_header());
+   resto_ip_data_->Set_info_last_output(IpData().info_last_output());
 
    // Call the optimization algorithm to solve the restoration phase
    // problem
@@ -195,7 +215,7 @@ bool MinC_1NrmRestorationPhase::PerformRestoration()
 
    if( resto_status != SUCCESS )
    {
-      SmartPtr<const IteratesVector> resto_curr = resto_ip_data->curr();
+      SmartPtr<const IteratesVector> resto_curr = resto_ip_data_->curr();
       if( IsValid(resto_curr) )
       {
          // In case of a failure, we still copy the values of primal and
@@ -255,13 +275,13 @@ bool MinC_1NrmRestorationPhase::PerformRestoration()
          Jnlst().Printf(J_DETAILED, J_LINE_SEARCH,
                         "\n\nOptimal solution found! \n");
          Jnlst().Printf(J_DETAILED, J_LINE_SEARCH,
-                        "Optimal Objective Value = %.16E\n", resto_ip_cq->curr_f());
+                        "Optimal Objective Value = %.16E\n", resto_ip_cq_->curr_f());
          Jnlst().Printf(J_DETAILED, J_LINE_SEARCH,
-                        "Number of Iterations = %" IPOPT_INDEX_FORMAT "\n", resto_ip_data->iter_count());
+                        "Number of Iterations = %" IPOPT_INDEX_FORMAT "\n", resto_ip_data_->iter_count());
       }
       if( Jnlst().ProduceOutput(J_VECTOR, J_LINE_SEARCH) )
       {
-         resto_ip_data->curr()->Print(Jnlst(), J_VECTOR, J_LINE_SEARCH, "curr");
+         resto_ip_data_->curr()->Print(Jnlst(), J_VECTOR, J_LINE_SEARCH, "curr");
       }
 
       retval = 0;
@@ -343,11 +363,11 @@ bool MinC_1NrmRestorationPhase::PerformRestoration()
    {
       // Copy the results into the trial fields;. They will be
       // accepted later in the full algorithm
-      SmartPtr<const Vector> resto_curr_x = resto_ip_data->curr()->x();
+      SmartPtr<const Vector> resto_curr_x = resto_ip_data_->curr()->x();
       SmartPtr<const CompoundVector> cx = static_cast<const CompoundVector*>(GetRawPtr(resto_curr_x));
       DBG_ASSERT(dynamic_cast<const CompoundVector*>(GetRawPtr(resto_curr_x)));
 
-      SmartPtr<const Vector> resto_curr_s = resto_ip_data->curr()->s();
+      SmartPtr<const Vector> resto_curr_s = resto_ip_data_->curr()->s();
       SmartPtr<const CompoundVector> cs = static_cast<const CompoundVector*>(GetRawPtr(resto_curr_s));
       DBG_ASSERT(dynamic_cast<const CompoundVector*>(GetRawPtr(resto_curr_s)));
 
@@ -424,12 +444,12 @@ bool MinC_1NrmRestorationPhase::PerformRestoration()
       DBG_PRINT_VECTOR(2, "y_c", *IpData().curr()->y_c());
       DBG_PRINT_VECTOR(2, "y_d", *IpData().curr()->y_d());
 
-      IpData().Set_iter_count(resto_ip_data->iter_count() - 1);
+      IpData().Set_iter_count(resto_ip_data_->iter_count() - 1);
       // Skip the next line, because it would just replicate the first
       // on during the restoration phase.
       IpData().Set_info_skip_output(true);
-      IpData().Set_info_iters_since_header(resto_ip_data->info_iters_since_header());
-      IpData().Set_info_last_output(resto_ip_data->info_last_output());
+      IpData().Set_info_iters_since_header(resto_ip_data_->info_iters_since_header());
+      IpData().Set_info_last_output(resto_ip_data_->info_last_output());
    }
 
    return (retval == 0);
@@ -87,6 +87,18 @@ private:
     */
    SmartPtr<OptionsList> resto_options_;
 
+   /** @name Restoration phase problem
+    *
+    *  These objects are created once in InitializeImpl and reused
+    *  every time the restoration phase is entered, so that only the
+    *  iterates and the reference point have to be set up again.
+    */
+   ///@{
+   SmartPtr<IpoptData> resto_ip_data_;
+   SmartPtr<IpoptNLP> resto_ip_nlp_;
+   SmartPtr<IpoptCalculatedQuantities> resto_ip_cq_;
+   ///@}
+
    /** @name Algorithmic parameters */
    ///@{
    Number constr_mult_reset_threshold_;
@@ -0,0 +1,245 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpoptConfig.h"
+#include "IpRuizTSymScalingMethod.hpp"
+
+#include <cmath>
+
+namespace Ipopt
+{
+#if IPOPT_VERBOSITY > 0
+static const Index dbg_verbosity = 0;
+#endif
+
+/** Minimal number of triplet entries for which the row norms are
+ *  computed in parallel.
+ */
+static const Index min_parallel_scaling_entries = 50000;
+
+RuizTSymScalingMethod::RuizTSymScalingMethod()
+   : max_iter_(20),
+     tol_(1e-2),
+     n_(-1),
+     nnz_(-1)
+{ }
+
+void RuizTSymScalingMethod::RegisterOptions(
+   SmartPtr<RegisteredOptions> roptions
+)
+{
+   roptions->AddLowerBoundedIntegerOption(
+      "ruiz_scaling_max_iter",
+      "Maximal number of sweeps of the Ruiz equilibration of the linear system.",
+      1,
+      20,
+      "This is only used if \"linear_system_scaling\" is \"ruiz\".",
+      true);
+   roptions->AddLowerBoundedNumberOption(
+      "ruiz_scaling_tol",
+      "Tolerance for the Ruiz equilibration of the linear system.",
+      0.0, true,
+      1e-2,
+      "The equilibration stops when the infinity-norms of all nonzero rows of the scaled matrix differ from one "
+      "by at most this value. "
+      "This is only used if \"linear_system_scaling\" is \"ruiz\".",
+      true);
+}
+
+bool RuizTSymScalingMethod::InitializeImpl(
+   const OptionsList& options,
+   const std::string& prefix
+)
+{
+   options.GetIntegerValue("ruiz_scaling_max_iter", max_iter_, prefix);
+   options.GetNumericValue("ruiz_scaling_tol", tol_, prefix);
+
+   // the structure of the matrix might be different in a new
+   // optimization run
+   n_ = -1;
+   nnz_ = -1;
+   factors_.clear();
+
+   return true;
+}
+
+void RuizTSymScalingMethod::InitializeStructure(
+   Index        n,
+   Index        nnz,
+   const Index* airn,
+   const Index* ajcn
+)
+{
+   DBG_START_METH("RuizTSymScalingMethod::InitializeStructure",
+                  dbg_verbosity);
+
+   n_ = n;
+   nnz_ = nnz;
+
+   // Sort the entries by the row of their lower triangular position
+   std::vector<Index> lower_start(n + 1, 0);
+   for( Index k = 0; k < nnz; k++ )
+   {
+      DBG_ASSERT(airn[k] >= 1 && airn[k] <= n);
+      DBG_ASSERT(ajcn[k] >= 1 && ajcn[k] <= n);
+      lower_start[Max(airn[k], ajcn[k])]++;
+   }
+   for( Index i = 0; i < n; i++ )
+   {
+      lower_start[i + 1] += lower_start[i];
+   }
+   std::vector<Index> lower_entry(nnz);
+   {
+      std::vector<Index> pos(lower_start.begin(), lower_start.end() - 1);
+      for( Index k = 0; k < nnz; k++ )
+      {
+         lower_entry[pos[Max(airn[k], ajcn[k]) - 1]++] = k;
+      }
+   }
+
+   // Merge the entries with the same position into one slot
+   slot_of_entry_.resize(nnz);
+   std::vector<Index> slot_row;
+   std::vector<Index> slot_col;
+   std::vector<Index> slot_in_col(n, -1);
+   for( Index i = 0; i < n; i++ )
+   {
+      Index first_slot = (Index) slot_row.size();
+      for( Index p = lower_start[i]; p < lower_start[i + 1]; p++ )
+      {
+         Index k = lower_entry[p];
+         Index j = Min(airn[k], ajcn[k]) - 1;
+         if( slot_in_col[j] < first_slot )
+         {
+            slot_in_col[j] = (Index) slot_row.size();
+            slot_row.push_back(i);
+            slot_col.push_back(j);
+         }
+         slot_of_entry_[k] = slot_in_col[j];
+      }
+   }
+   Index nslots = (Index) slot_row.size();
+
+   // Store the slots row-wise for both triangular parts
+   row_start_.assign(n + 1, 0);
+   for( Index s = 0; s < nslots; s++ )
+   {
+      row_start_[slot_row[s] + 1]++;
+      if( slot_col[s] != slot_row[s] )
+      {
+         row_start_[slot_col[s] + 1]++;
+      }
+   }
+   for( Index i = 0; i < n; i++ )
+   {
+      row_start_[i + 1] += row_start_[i];
+   }
+   row_slot_.resize(row_start_[n]);
+   row_col_.resize(row_start_[n]);
+   {
+      std::vector<Index> pos(row_start_.begin(), row_start_.end() - 1);
+      for( Index s = 0; s < nslots; s++ )
+      {
+         Index p = pos[slot_row[s]]++;
+         row_slot_[p] = s;
+         row_col_[p] = slot_col[s];
+         if( slot_col[s] != slot_row[s] )
+         {
+            p = pos[slot_col[s]]++;
+            row_slot_[p] = s;
+            row_col_[p] = slot_row[s];
+         }
+      }
+   }
+
+   slot_val_.resize(nslots);
+   row_norm_.resize(n);
+   factors_.assign(n, 1.);
+}
+
+bool RuizTSymScalingMethod::ComputeSymTScalingFactors(
+   Index         n,
+   Index         nnz,
+   const Index*  airn,
+   const Index*  ajcn,
+   const Number* a,
+   Number*       scaling_factors
+)
+{
+   DBG_START_METH("RuizTSymScalingMethod::ComputeSymTScalingFactors",
+                  dbg_verbosity);
+
+   if( n != n_ || nnz != nnz_ )
+   {
+      InitializeStructure(n, nnz, airn, ajcn);
+   }
+
+   Index nslots = (Index) slot_val_.size();
+   for( Index s = 0; s < nslots; s++ )
+   {
+      slot_val_[s] = 0.;
+   }
+   for( Index k = 0; k < nnz; k++ )
+   {
+      slot_val_[slot_of_entry_[k]] += a[k];
+   }
+   for( Index s = 0; s < nslots; s++ )
+   {
+      slot_val_[s] = std::abs(slot_val_[s]);
+   }
+
+   Index iter = 0;
+   Number max_dev = 0.;
+   while( true )
+   {
+      // Row norms of the matrix scaled with the current factors
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) if( nnz >= min_parallel_scaling_entries )
+#endif
+      for( Index i = 0; i < n; i++ )
+      {
+         Number row_max = 0.;
+         for( Index p = row_start_[i]; p < row_start_[i + 1]; p++ )
+         {
+            row_max = Max(row_max, slot_val_[row_slot_[p]] * factors_[row_col_[p]]);
+         }
+         row_norm_[i] = row_max * factors_[i];
+      }
+
+      max_dev = 0.;
+      for( Index i = 0; i < n; i++ )
+      {
+         if( row_norm_[i] > 0. )
+         {
+            max_dev = Max(max_dev, std::abs(1. - row_norm_[i]));
+         }
+      }
+      if( max_dev <= tol_ || iter == max_iter_ )
+      {
+         break;
+      }
+
+      iter++;
+      for( Index i = 0; i < n; i++ )
+      {
+         if( row_norm_[i] > 0. )
+         {
+            factors_[i] /= std::sqrt(row_norm_[i]);
+         }
+      }
+   }
+
+   Jnlst().Printf(J_MOREDETAILED, J_LINEAR_ALGEBRA,
+                  "Ruiz scaling: %" IPOPT_INDEX_FORMAT " sweeps, max. deviation of row norms from one %e\n", iter,
+                  max_dev);
+
+   for( Index i = 0; i < n; i++ )
+   {
+      scaling_factors[i] = factors_[i];
+   }
+
+   return true;
+}
+
+} // namespace Ipopt
@@ -0,0 +1,135 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPRUIZTSYMSCALINGMETHOD_HPP__
+#define __IPRUIZTSYMSCALINGMETHOD_HPP__
+
+#include "IpUtils.hpp"
+#include "IpTSymScalingMethod.hpp"
+
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Class for the method for computing scaling factors for symmetric
+ *  matrices in triplet format, using the symmetric Ruiz
+ *  equilibration.
+ *
+ *  In each sweep, the scaling factor of every row is divided by the
+ *  square root of the infinity-norm of that row in the currently
+ *  scaled matrix.  The sweeps stop as soon as all nonzero rows have
+ *  an infinity-norm within ruiz_scaling_tol of one, or after
+ *  ruiz_scaling_max_iter sweeps.  The row norms of a sweep are
+ *  computed in parallel.
+ *
+ *  The sweeps start from the scaling factors of the previous call,
+ *  which typically are close to the new ones, so that only few sweeps
+ *  are needed once the iterates settle down.
+ */
+class RuizTSymScalingMethod: public TSymScalingMethod
+{
+public:
+   /** @name Constructor/Destructor */
+   ///@{
+   RuizTSymScalingMethod();
+
+   virtual ~RuizTSymScalingMethod()
+   { }
+   ///@}
+
+   virtual bool InitializeImpl(
+      const OptionsList& options,
+      const std::string& prefix
+   );
+
+   /** Method for computing the symmetric scaling factors, given the
+    *  symmetric matrix in triplet (MA27) format.
+    */
+   virtual bool ComputeSymTScalingFactors(
+      Index         n,
+      Index         nnz,
+      const Index*  airn,
+      const Index*  ajcn,
+      const Number* a,
+      Number*       scaling_factors
+   );
+
+   /** This must be called to make the options for this class known */
+   static void RegisterOptions(
+      SmartPtr<RegisteredOptions> roptions
+   );
+
+private:
+   /**@name Default Compiler Generated Methods (Hidden to avoid
+    * implicit creation/calling).  These methods are not implemented
+    * and we do not want the compiler to implement them for us, so we
+    * declare them private and do not define them. This ensures that
+    * they will not be implicitly created/called. */
+   ///@{
+   /** Copy Constructor */
+   RuizTSymScalingMethod(
+      const RuizTSymScalingMethod&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const RuizTSymScalingMethod&
+   );
+   ///@}
+
+   /** Set up the row-wise storage of the symmetric matrix, in which
+    *  entries that appear several times in the triplet arrays are
+    *  merged into one.
+    */
+   void InitializeStructure(
+      Index        n,
+      Index        nnz,
+      const Index* airn,
+      const Index* ajcn
+   );
+
+   /** @name Algorithmic parameters */
+   ///@{
+   /** Maximal number of equilibration sweeps */
+   Index max_iter_;
+
+   /** Tolerance for the deviation of the scaled row norms from one */
+   Number tol_;
+   ///@}
+
+   /** @name Row-wise storage of the matrix
+    *
+    *  Every distinct position in the lower triangular part is a slot.
+    *  A slot of an off-diagonal position appears in both of its rows.
+    */
+   ///@{
+   /** Dimension of the matrix, or -1 if the structure is not yet known */
+   Index n_;
+   /** Number of triplet entries */
+   Index nnz_;
+   /** Slot of every triplet entry */
+   std::vector<Index> slot_of_entry_;
+   /** Start of every row in row_slot_ and row_col_ */
+   std::vector<Index> row_start_;
+   /** Slots in every row */
+   std::vector<Index> row_slot_;
+   /** Columns of the slots in every row */
+   std::vector<Index> row_col_;
+   ///@}
+
+   /** @name Work space */
+   ///@{
+   /** Absolute values of the slots */
+   std::vector<Number> slot_val_;
+   /** Infinity-norms of the rows of the scaled matrix */
+   std::vector<Number> row_norm_;
+   /** Scaling factors of the most recent call */
+   std::vector<Number> factors_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
@@ -253,6 +253,57 @@ public:
    {
       return SYMSOLVER_FATAL_ERROR;
    }
+   ///@}
+
+   /** Query whether several objects of this linear solver can
+    *  factorize their matrices in concurrent threads.
+    *
+    *  This requires that InitializeStructure and MultiSolve only
+    *  access data owned by the object, and no global state of the
+    *  underlying library.  Only solvers for which this has been
+    *  verified should return true.
+    */
+   virtual bool ProvidesConcurrentFactorization() const
+   {
+      return false;
+   }
+
+   /** @name Methods related to factorizations in single precision
+    *
+    *  The values of the matrix are still given to this object in
+    *  double precision by means of GetValuesArrayPtr.  A linear
+    *  solver that provides single precision converts them and
+    *  computes the factorization and the solves in single
+    *  precision; the caller is responsible for refining the
+    *  solution in double precision.
+    */
+   ///@{
+   /** Query whether MultiSolveSingle is implemented by this linear solver. */
+   virtual bool ProvidesSinglePrecision() const
+   {
+      return false;
+   }
+
+   /** Solve operation for multiple right hand sides in single precision.
+    *
+    *  The arguments and return values are as for MultiSolve, but the
+    *  right hand sides and solutions are given in single precision.
+    *  A call of MultiSolve after MultiSolveSingle (or vice versa) is
+    *  always made with new_matrix=true.
+    */
+   virtual ESymSolverStatus MultiSolveSingle(
+      bool         /*new_matrix*/,
+      const Index* /*ia*/,
+      const Index* /*ja*/,
+      Index        /*nrhs*/,
+      float*       /*rhs_vals*/,
+      bool         /*check_NegEVals*/,
+      Index        /*numberOfNegEVals*/
+   )
+   {
+      return SYMSOLVER_FATAL_ERROR;
+   }
+   ///@}
 };
 
 } // namespace Ipopt
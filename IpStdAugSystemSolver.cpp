@@ -552,4 +552,61 @@ bool StdAugSystemSolver::IncreaseQuality()
    return linsolver_->IncreaseQuality();
 }
 
+bool StdAugSystemSolver::ProvidesConcurrentFactorization() const
+{
+   return linsolver_->ProvidesConcurrentFactorization();
+}
+
+void StdAugSystemSolver::PrepareFactorization(
+   const SymMatrix* W,
+   Number           W_factor,
+   const Vector*    D_x,
+   Number           delta_x,
+   const Vector*    D_s,
+   Number           delta_s,
+   const Matrix*    J_c,
+   const Vector*    D_c,
+   Number           delta_c,
+   const Matrix*    J_d,
+   const Vector*    D_d,
+   Number           delta_d,
+   const Vector&    proto_x,
+   const Vector&    proto_s,
+   const Vector&    proto_c,
+   const Vector&    proto_d
+)
+{
+   DBG_START_METH("StdAugSystemSolver::PrepareFactorization", dbg_verbosity);
+   DBG_ASSERT(J_c && J_d && "Currently, you MUST specify J_c and J_d in the augmented system");
+   DBG_ASSERT(W_factor == 0.0 || W_factor == 1.0);
+
+   IpData().TimingStats().StdAugSystemSolverMultiSolve().Start();
+
+   if( !IsValid(augmented_system_) )
+   {
+      DBG_ASSERT(W);
+      CreateAugmentedSpace(*W, *J_c, *J_d, proto_x, proto_s, proto_c, proto_d);
+      CreateAugmentedSystem(W, W_factor, D_x, delta_x, D_s, delta_s, *J_c, D_c, delta_c, *J_d, D_d, delta_d, proto_x,
+                            proto_s, proto_c, proto_d);
+   }
+   else if( AugmentedSystemRequiresChange(W, W_factor, D_x, delta_x, D_s, delta_s, *J_c, D_c, delta_c, *J_d, D_d, delta_d) )
+   {
+      CreateAugmentedSystem(W, W_factor, D_x, delta_x, D_s, delta_s, *J_c, D_c, delta_c, *J_d, D_d, delta_d, proto_x,
+                            proto_s, proto_c, proto_d);
+   }
+
+   linsolver_->PrepareFactorization(*augmented_system_);
+
+   IpData().TimingStats().StdAugSystemSolverMultiSolve().End();
+}
+
+ESymSolverStatus StdAugSystemSolver::FactorizePrepared(
+   bool  check_NegEVals,
+   Index numberOfNegEVals
+)
+{
+   DBG_ASSERT(IsValid(augmented_system_));
+   return linsolver_->FactorizePrepared(check_NegEVals, numberOfNegEVals);
+}
+
 } // namespace Ipopt
@@ -96,6 +96,32 @@ public:
     */
    virtual bool IncreaseQuality();
 
+   virtual bool ProvidesConcurrentFactorization() const;
+
+   virtual void PrepareFactorization(
+      const SymMatrix* W,
+      Number           W_factor,
+      const Vector*    D_x,
+      Number           delta_x,
+      const Vector*    D_s,
+      Number           delta_s,
+      const Matrix*    J_c,
+      const Vector*    D_c,
+      Number           delta_c,
+      const Matrix*    J_d,
+      const Vector*    D_d,
+      Number           delta_d,
+      const Vector&    proto_x,
+      const Vector&    proto_s,
+      const Vector&    proto_c,
+      const Vector&    proto_d
+   );
+
+   virtual ESymSolverStatus FactorizePrepared(
+      bool  check_NegEVals,
+      Index numberOfNegEVals
+   );
+
 private:
    /**@name Default Compiler Generated Methods
     * (Hidden to avoid implicit creation/calling).
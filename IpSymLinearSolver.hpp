@@ -134,6 +134,41 @@ public:
     */
    virtual bool ProvidesInertia() const = 0;
    ///@}
+
+   /** @name Factorization in concurrent threads
+    *
+    *  PrepareFactorization passes the values of a matrix to the linear
+    *  solver without factorizing it.  FactorizePrepared then computes
+    *  the factorization and only accesses data that is owned by this
+    *  solver object, so that several solver objects can factorize
+    *  their matrices in concurrent threads.  A subsequent MultiSolve
+    *  with the same matrix only performs the backsolves.
+    */
+   ///@{
+   /** Query whether PrepareFactorization and FactorizePrepared are implemented. */
+   virtual bool ProvidesConcurrentFactorization() const
+   {
+      return false;
+   }
+
+   /** Pass the values of a matrix to the linear solver. */
+   virtual void PrepareFactorization(
+      const SymMatrix& /*A*/
+   )
+   { }
+
+   /** Factorize the matrix given to PrepareFactorization.
+    *
+    *  The return values are those of MultiSolve.
+    */
+   virtual ESymSolverStatus FactorizePrepared(
+      bool  /*check_NegEVals*/,
+      Index /*numberOfNegEVals*/
+   )
+   {
+      return SYMSOLVER_FATAL_ERROR;
+   }
+   ///@}
 };
 
 } // namespace Ipopt
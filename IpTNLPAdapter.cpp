@@ -15,6 +15,7 @@
 #include "IpSymTMatrix.hpp"
 #include "IpTDependencyDetector.hpp"
 #include "IpTSymDependencyDetector.hpp"
+#include "IpLuTDependencyDetector.hpp"
 #include "IpTripletToCSRConverter.hpp"
 
 #ifdef IPOPT_HAS_HSL
@@ -115,6 +116,8 @@ void TNLPAdapter::RegisterOptions(
    std::vector<std::string> descrs;
    options.push_back("none");
    descrs.push_back("don't check; no extra work at beginning");
+   options.push_back("lu");
+   descrs.push_back("use the native sparse LU factorization with threshold pivoting");
 #ifdef IPOPT_HAS_MUMPS
    options.push_back("mumps");
    descrs.push_back("use MUMPS");
@@ -266,6 +269,11 @@ bool TNLPAdapter::ProcessOptions(
    options.GetBoolValue("dependency_detection_with_rhs", dependency_detection_with_rhs_, prefix);
    std::string dependency_detector;
    options.GetStringValue("dependency_detector", dependency_detector, prefix);
+   if( dependency_detector == "lu" )
+   {
+      dependency_detector_ = new LuTDependencyDetector();
+   }
+
 #ifdef IPOPT_HAS_MUMPS
    if( dependency_detector == "mumps" )
    {
@@ -1903,6 +1911,215 @@ bool TNLPAdapter::Eval_d(
    return false;
 }
 
+void TNLPAdapter::Eval_f_c_d_Concurrent(
+   const std::vector<SmartPtr<const Vector> >& x,
+   std::vector<Number>&                        f,
+   std::vector<SmartPtr<Vector> >&             c,
+   std::vector<SmartPtr<Vector> >&             d,
+   std::vector<bool>&                          success
+)
+{
+   Index npoints = (Index) x.size();
+   DBG_ASSERT((Index) f.size() == npoints);
+   DBG_ASSERT((Index) c.size() == npoints);
+   DBG_ASSERT((Index) d.size() == npoints);
+   DBG_ASSERT((Index) success.size() == npoints);
+
+   // Everything that touches tagged or reference counted objects is
+   // done outside of the parallel loop
+   std::vector<Number> full_x((size_t) npoints * n_full_x_);
+   std::vector<Number> full_g((size_t) npoints * n_full_g_ + 1);
+   std::vector<Number*> c_values(npoints);
+   std::vector<Number*> d_values(npoints);
+   for( Index i = 0; i < npoints; i++ )
+   {
+      ResortX(*x[i], &full_x[(size_t) i * n_full_x_]);
+      c_values[i] = static_cast<DenseVector*>(GetRawPtr(c[i]))->Values();
+      DBG_ASSERT(dynamic_cast<DenseVector*>(GetRawPtr(c[i])));
+      d_values[i] = static_cast<DenseVector*>(GetRawPtr(d[i]))->Values();
+      DBG_ASSERT(dynamic_cast<DenseVector*>(GetRawPtr(d[i])));
+   }
+
+   // ok[i] is 1 if the evaluation at point i succeeded, 0 if it
+   // failed, and -1 if the TNLP threw an exception
+   std::vector<int> ok(npoints);
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(static, 1) num_threads(npoints)
+#endif
+   for( Index i = 0; i < npoints; i++ )
+   {
+      // exceptions must not leave the parallel region
+      try
+      {
+         Number* xi = &full_x[(size_t) i * n_full_x_];
+         Number* gi = &full_g[(size_t) i * n_full_g_];
+         ok[i] = tnlp_->eval_f(n_full_x_, xi, true, f[i]);
+         if( ok[i] && n_full_g_ > 0 )
+         {
+            ok[i] = tnlp_->eval_g(n_full_x_, xi, true, n_full_g_, gi);
+         }
+      }
+      catch( ... )
+      {
+         ok[i] = -1;
+      }
+   }
+
+   const Index* c_pos = P_c_g_->ExpandedPosIndices();
+   Index n_c_no_fixed = P_c_g_->NCols();
+   const Index* d_pos = P_d_g_->ExpandedPosIndices();
+   Index n_d = P_d_g_->NCols();
+   for( Index i = 0; i < npoints; i++ )
+   {
+      if( ok[i] < 0 )
+      {
+         // evaluate the point again serially, so that an exception of
+         // the TNLP is passed on as in the regular evaluation
+         success[i] = Eval_f(*x[i], f[i]) && Eval_c(*x[i], *c[i]) && Eval_d(*x[i], *d[i]);
+         continue;
+      }
+      success[i] = (ok[i] != 0);
+      if( !success[i] )
+      {
+         continue;
+      }
+      const Number* xi = &full_x[(size_t) i * n_full_x_];
+      const Number* gi = &full_g[(size_t) i * n_full_g_];
+      for( Index j = 0; j < n_c_no_fixed; j++ )
+      {
+         c_values[i][j] = gi[c_pos[j]] - c_rhs_[j];
+      }
+      if( fixed_variable_treatment_ == MAKE_CONSTRAINT )
+      {
+         for( Index j = 0; j < n_x_fixed_; j++ )
+         {
+            c_values[i][n_c_no_fixed + j] = xi[x_fixed_map_[j]] - c_rhs_[n_c_no_fixed + j];
+         }
+      }
+      for( Index j = 0; j < n_d; j++ )
+      {
+         d_values[i][j] = gi[d_pos[j]];
+      }
+   }
+
+   // The TNLP has seen other points since the last regular evaluation
+   x_tag_for_iterates_ = 0;
+}
+
+void TNLPAdapter::Eval_grad_f_jac_c_jac_d_Concurrent(
+   const std::vector<SmartPtr<const Vector> >& x,
+   std::vector<SmartPtr<Vector> >&             grad_f,
+   std::vector<SmartPtr<Matrix> >&             jac_c,
+   std::vector<SmartPtr<Matrix> >&             jac_d,
+   std::vector<bool>&                          success
+)
+{
+   Index npoints = (Index) x.size();
+   DBG_ASSERT((Index) grad_f.size() == npoints);
+   DBG_ASSERT((Index) jac_c.size() == npoints);
+   DBG_ASSERT((Index) jac_d.size() == npoints);
+   DBG_ASSERT((Index) success.size() == npoints);
+
+   if( gradient_approximation_ != OBJGRAD_EXACT || jacobian_approximation_ != JAC_EXACT )
+   {
+      // the finite difference approximations work on the members of
+      // this object
+      for( Index i = 0; i < npoints; i++ )
+      {
+         success[i] = Eval_grad_f(*x[i], *grad_f[i]) && Eval_jac_c(*x[i], *jac_c[i]) && Eval_jac_d(*x[i], *jac_d[i]);
+      }
+      return;
+   }
+
+   // Everything that touches tagged or reference counted objects is
+   // done outside of the parallel loop
+   std::vector<Number> full_x((size_t) npoints * n_full_x_);
+   std::vector<Number> full_grad_f((size_t) npoints * n_full_x_ + 1);
+   std::vector<Number> full_jac_g((size_t) npoints * nz_full_jac_g_ + 1);
+   std::vector<Number*> grad_f_values(npoints);
+   std::vector<Number*> jac_c_values(npoints);
+   std::vector<Number*> jac_d_values(npoints);
+   for( Index i = 0; i < npoints; i++ )
+   {
+      ResortX(*x[i], &full_x[(size_t) i * n_full_x_]);
+      grad_f_values[i] = static_cast<DenseVector*>(GetRawPtr(grad_f[i]))->Values();
+      DBG_ASSERT(dynamic_cast<DenseVector*>(GetRawPtr(grad_f[i])));
+      jac_c_values[i] = static_cast<GenTMatrix*>(GetRawPtr(jac_c[i]))->Values();
+      DBG_ASSERT(dynamic_cast<GenTMatrix*>(GetRawPtr(jac_c[i])));
+      jac_d_values[i] = static_cast<GenTMatrix*>(GetRawPtr(jac_d[i]))->Values();
+      DBG_ASSERT(dynamic_cast<GenTMatrix*>(GetRawPtr(jac_d[i])));
+   }
+
+   // ok[i] is 1 if the evaluation at point i succeeded, 0 if it
+   // failed, and -1 if the TNLP threw an exception
+   std::vector<int> ok(npoints);
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(static, 1) num_threads(npoints)
+#endif
+   for( Index i = 0; i < npoints; i++ )
+   {
+      // exceptions must not leave the parallel region
+      try
+      {
+         Number* xi = &full_x[(size_t) i * n_full_x_];
+         ok[i] = tnlp_->eval_grad_f(n_full_x_, xi, true, &full_grad_f[(size_t) i * n_full_x_]);
+         if( ok[i] && n_full_g_ > 0 )
+         {
+            ok[i] = tnlp_->eval_jac_g(n_full_x_, xi, true, n_full_g_, nz_full_jac_g_, NULL, NULL,
+                                      &full_jac_g[(size_t) i * nz_full_jac_g_]);
+         }
+      }
+      catch( ... )
+      {
+         ok[i] = -1;
+      }
+   }
+
+   const Index* x_pos = NULL;
+   if( IsValid(P_x_full_x_) )
+   {
+      x_pos = P_x_full_x_->ExpandedPosIndices();
+   }
+   Index n_x = grad_f.empty() ? 0 : grad_f[0]->Dim();
+   for( Index i = 0; i < npoints; i++ )
+   {
+      if( ok[i] < 0 )
+      {
+         // evaluate the point again serially, so that an exception of
+         // the TNLP is passed on as in the regular evaluation
+         success[i] = Eval_grad_f(*x[i], *grad_f[i]) && Eval_jac_c(*x[i], *jac_c[i]) && Eval_jac_d(*x[i], *jac_d[i]);
+         continue;
+      }
+      success[i] = (ok[i] != 0);
+      if( !success[i] )
+      {
+         continue;
+      }
+      const Number* gi = &full_grad_f[(size_t) i * n_full_x_];
+      const Number* ji = &full_jac_g[(size_t) i * nz_full_jac_g_];
+      for( Index j = 0; j < n_x; j++ )
+      {
+         grad_f_values[i][j] = gi[x_pos != NULL ? x_pos[j] : j];
+      }
+      for( Index j = 0; j < nz_jac_c_no_extra_; j++ )
+      {
+         jac_c_values[i][j] = ji[jac_idx_map_[j]];
+      }
+      if( fixed_variable_treatment_ == MAKE_CONSTRAINT )
+      {
+         const Number one = 1.;
+         IpBlasCopy(n_x_fixed_, &one, 0, &jac_c_values[i][nz_jac_c_no_extra_], 1);
+      }
+      for( Index j = 0; j < nz_jac_d_; j++ )
+      {
+         jac_d_values[i][j] = ji[jac_idx_map_[nz_jac_c_no_extra_ + j]];
+      }
+   }
+
+   // The TNLP has seen other points since the last regular evaluation
+   x_tag_for_iterates_ = 0;
+}
+
 bool TNLPAdapter::Eval_jac_d(
    const Vector& x,
    Matrix&       jac_d
@@ -186,6 +186,47 @@ public:
       SymMatrix&    h
    );
 
+   /** Returns true.
+    *
+    *  Eval_f_c_d_Concurrent calls eval_f and eval_g, and
+    *  Eval_grad_f_jac_c_jac_d_Concurrent calls eval_grad_f and
+    *  eval_jac_g of the TNLP in concurrent threads, so this must only
+    *  be used if these are thread safe.
+    */
+   virtual bool ProvidesConcurrentEvaluation() const
+   {
+      return true;
+   }
+
+   /** Evaluate f, c, and d at several points in concurrent threads.
+    *
+    *  Each thread uses its own copies of the full x and g arrays, and
+    *  eval_f and eval_g are called with new_x=true.
+    */
+   virtual void Eval_f_c_d_Concurrent(
+      const std::vector<SmartPtr<const Vector> >& x,
+      std::vector<Number>&                        f,
+      std::vector<SmartPtr<Vector> >&             c,
+      std::vector<SmartPtr<Vector> >&             d,
+      std::vector<bool>&                          success
+   );
+
+   /** Evaluate grad_f, jac_c, and jac_d at several points in
+    *  concurrent threads.
+    *
+    *  Each thread uses its own copies of the full x, gradient, and
+    *  Jacobian arrays, and eval_grad_f and eval_jac_g are called with
+    *  new_x=true.  If derivatives are approximated by finite
+    *  differences, the points are evaluated one after the other.
+    */
+   virtual void Eval_grad_f_jac_c_jac_d_Concurrent(
+      const std::vector<SmartPtr<const Vector> >& x,
+      std::vector<SmartPtr<Vector> >&             grad_f,
+      std::vector<SmartPtr<Matrix> >&             jac_c,
+      std::vector<SmartPtr<Matrix> >&             jac_d,
+      std::vector<bool>&                          success
+   );
+
    virtual void GetScalingParameters(
       const SmartPtr<const VectorSpace> x_space,
       const SmartPtr<const VectorSpace> c_space,
@@ -7,6 +7,8 @@
 #include "IpTSymLinearSolver.hpp"
 #include "IpTripletHelper.hpp"
 #include "IpBlas.hpp"
+#include "IpDenseVector.hpp"
+#include "IpCompoundVector.hpp"
 
 namespace Ipopt
 {
@@ -29,7 +31,10 @@ TSymLinearSolver::TSymLinearSolver(
      scaling_method_(scaling_method),
      scaling_factors_(NULL),
      airn_(NULL),
-     ajcn_(NULL)
+     ajcn_(NULL),
+     rhs_workspace_(NULL),
+     rhs_vals_(NULL),
+     rhs_vals_capacity_(0)
 {
    DBG_START_METH("TSymLinearSolver::TSymLinearSolver()", dbg_verbosity);
    DBG_ASSERT(IsValid(solver_interface));
@@ -42,6 +47,7 @@ TSymLinearSolver::~TSymLinearSolver()
    delete[] airn_;
    delete[] ajcn_;
    delete[] scaling_factors_;
+   delete[] rhs_workspace_;
 }
 
 void TSymLinearSolver::RegisterOptions(
@@ -56,6 +62,17 @@ void TSymLinearSolver::RegisterOptions(
       "This can be quite expensive. "
       "Choosing \"yes\" means that the algorithm will start the scaling method only "
       "when the solutions to the linear system seem not good, and then use it until the end.");
+   roptions->AddBoolOption(
+      "mixed_precision_factorization",
+      "Flag indicating whether the factorization of the linear system is computed in single precision.",
+      false,
+      "If enabled, the matrix is factorized and the back solves are done in single precision, "
+      "while the residuals and the iterative refinement are still computed in double precision. "
+      "This halves the memory required for the factors. "
+      "When the iterative refinement cannot attain the requested accuracy, "
+      "the factorization switches to double precision until the end. "
+      "This is only supported by some linear solvers and ignored otherwise.",
+      true);
 }
 
 bool TSymLinearSolver::InitializeImpl(
@@ -73,6 +90,13 @@ bool TSymLinearSolver::InitializeImpl(
    }
    // This option is registered by OrigIpoptNLP
    options.GetBoolValue("warm_start_same_structure", warm_start_same_structure_, prefix);
+   options.GetBoolValue("mixed_precision_factorization", single_precision_, prefix);
+   if( single_precision_ && !solver_interface_->ProvidesSinglePrecision() )
+   {
+      Jnlst().Printf(J_WARNING, J_LINEAR_ALGEBRA,
+                     "The chosen linear solver does not support mixed_precision_factorization; ignoring option.\n");
+      single_precision_ = false;
+   }
 
    bool retval;
    if( HaveIpData() )
@@ -198,35 +222,23 @@ ESymSolverStatus TSymLinearSolver::MultiSolve(
 
    // Retrieve the right hand sides and scale if required
    Index nrhs = (Index) rhsV.size();
-   Number* rhs_vals = new Number[dim_ * nrhs];
+   ReserveRhsWorkspace(dim_ * nrhs);
+   Number* rhs_vals = rhs_vals_;
+   const bool print_rhs_sol = Jnlst().ProduceOutput(J_MOREMATRIX, J_LINEAR_ALGEBRA);
    for( Index irhs = 0; irhs < nrhs; irhs++ )
    {
-      TripletHelper::FillValuesFromVector(dim_, *rhsV[irhs], &rhs_vals[irhs * (dim_)]);
-      if( Jnlst().ProduceOutput(J_MOREMATRIX, J_LINEAR_ALGEBRA) )
+      GatherRhs(*rhsV[irhs], &rhs_vals[irhs * (dim_)]);
+      if( print_rhs_sol )
       {
          Jnlst().Printf(J_MOREMATRIX, J_LINEAR_ALGEBRA,
-                        "Right hand side %" IPOPT_INDEX_FORMAT " in TSymLinearSolver:\n", irhs);
+                        "Right hand side %" IPOPT_INDEX_FORMAT " in TSymLinearSolver%s:\n", irhs,
+                        use_scaling_ ? " (scaled)" : "");
          for( Index i = 0; i < dim_; i++ )
          {
             Jnlst().Printf(J_MOREMATRIX, J_LINEAR_ALGEBRA,
                            "Trhs[%5" IPOPT_INDEX_FORMAT ",%5" IPOPT_INDEX_FORMAT "] = %23.16e\n", irhs, i, rhs_vals[irhs * (dim_) + i]);
          }
       }
-      if( use_scaling_ )
-      {
-         if( HaveIpData() )
-         {
-            IpData().TimingStats().LinearSystemScaling().Start();
-         }
-         for( Index i = 0; i < dim_; i++ )
-         {
-            rhs_vals[irhs * (dim_) + i] *= scaling_factors_[i];
-         }
-         if( HaveIpData() )
-         {
-            IpData().TimingStats().LinearSystemScaling().End();
-         }
-      }
    }
 
    bool done = false;
@@ -259,7 +271,7 @@ ESymSolverStatus TSymLinearSolver::MultiSolve(
          }
       }
 
-      retval = solver_interface_->MultiSolve(new_matrix, ia, ja, nrhs, rhs_vals, check_NegEVals, numberOfNegEVals);
+      retval = SolverInterfaceMultiSolve(new_matrix, ia, ja, nrhs, rhs_vals, check_NegEVals, numberOfNegEVals);
       if( retval == SYMSOLVER_CALL_AGAIN )
       {
          DBG_PRINT((1, "Solver interface asks to be called again.\n"));
@@ -277,37 +289,21 @@ ESymSolverStatus TSymLinearSolver::MultiSolve(
    {
       for( Index irhs = 0; irhs < nrhs; irhs++ )
       {
-         if( use_scaling_ )
-         {
-            if( HaveIpData() )
-            {
-               IpData().TimingStats().LinearSystemScaling().Start();
-            }
-            for( Index i = 0; i < dim_; i++ )
-            {
-               rhs_vals[irhs * (dim_) + i] *= scaling_factors_[i];
-            }
-            if( HaveIpData() )
-            {
-               IpData().TimingStats().LinearSystemScaling().End();
-            }
-         }
-         if( Jnlst().ProduceOutput(J_MOREMATRIX, J_LINEAR_ALGEBRA) )
+         if( print_rhs_sol )
          {
             Jnlst().Printf(J_MOREMATRIX, J_LINEAR_ALGEBRA,
-                           "Solution %" IPOPT_INDEX_FORMAT " in TSymLinearSolver:\n", irhs);
+                           "Solution %" IPOPT_INDEX_FORMAT " in TSymLinearSolver%s:\n", irhs,
+                           use_scaling_ ? " (scaled)" : "");
             for( Index i = 0; i < dim_; i++ )
             {
                Jnlst().Printf(J_MOREMATRIX, J_LINEAR_ALGEBRA,
                               "Tsol[%5" IPOPT_INDEX_FORMAT ",%5" IPOPT_INDEX_FORMAT "] = %23.16e\n", irhs, i, rhs_vals[irhs * (dim_) + i]);
             }
          }
-         TripletHelper::PutValuesInVector(dim_, &rhs_vals[irhs * (dim_)], *solV[irhs]);
+         ScatterSol(&rhs_vals[irhs * (dim_)], *solV[irhs]);
       }
    }
 
-   delete[] rhs_vals;
-
    return retval;
 }
 
@@ -327,14 +323,16 @@ ESymSolverStatus TSymLinearSolver::InitializeStructure(
    {
 
       dim_ = sym_A.Dim();
-      nonzeros_triplet_ = TripletHelper::GetNumberEntries(sym_A);
+      triplet_fill_plan_ = new TripletFillPlan();
+      triplet_fill_plan_->Initialize(sym_A);
+      nonzeros_triplet_ = triplet_fill_plan_->NumberEntries();
 
       delete[] airn_;
       delete[] ajcn_;
       airn_ = new Index[nonzeros_triplet_];
       ajcn_ = new Index[nonzeros_triplet_];
 
-      TripletHelper::FillRowCol(nonzeros_triplet_, sym_A, airn_, ajcn_);
+      triplet_fill_plan_->FillRowCol(sym_A, airn_, ajcn_);
 
       // If the solver wants the compressed format, the converter has to
       // be initialized
@@ -420,6 +418,112 @@ ESymSolverStatus TSymLinearSolver::InitializeStructure(
    return retval;
 }
 
+bool TSymLinearSolver::ProvidesConcurrentFactorization() const
+{
+   return IsValid(solver_interface_) && solver_interface_->ProvidesConcurrentFactorization();
+}
+
+void TSymLinearSolver::PrepareFactorization(
+   const SymMatrix& sym_A
+)
+{
+   DBG_START_METH("TSymLinearSolver::PrepareFactorization", dbg_verbosity);
+
+   if( !initialized_ )
+   {
+      if( InitializeStructure(sym_A) != SYMSOLVER_SUCCESS )
+      {
+         // let the next MultiSolve report the failure
+         atag_ = 0;
+         return;
+      }
+   }
+   DBG_ASSERT(nonzeros_triplet_ == TripletHelper::GetNumberEntries(sym_A));
+
+   GiveMatrixToSolver(true, sym_A);
+   atag_ = sym_A.GetTag();
+
+   // the interface is asked for a solve with a zero right hand side,
+   // since not every linear solver accepts zero right hand sides
+   ReserveRhsWorkspace(dim_);
+   for( Index i = 0; i < dim_; i++ )
+   {
+      rhs_vals_[i] = 0.;
+   }
+}
+
+ESymSolverStatus TSymLinearSolver::FactorizePrepared(
+   bool  check_NegEVals,
+   Index numberOfNegEVals
+)
+{
+   DBG_START_METH("TSymLinearSolver::FactorizePrepared", dbg_verbosity);
+   DBG_ASSERT(!check_NegEVals || ProvidesInertia());
+
+   if( !initialized_ || atag_ == 0 )
+   {
+      return SYMSOLVER_FATAL_ERROR;
+   }
+
+   // this may run concurrently with other solver objects, so neither
+   // the matrix nor the timing statistics of the converter are accessed
+   const Index* ia;
+   const Index* ja;
+   if( matrix_format_ == SparseSymLinearSolverInterface::Triplet_Format )
+   {
+      ia = airn_;
+      ja = ajcn_;
+   }
+   else
+   {
+      ia = triplet_to_csr_converter_->IA();
+      ja = triplet_to_csr_converter_->JA();
+   }
+
+   ESymSolverStatus retval = SolverInterfaceMultiSolve(true, ia, ja, 1, rhs_vals_, check_NegEVals, numberOfNegEVals);
+   if( retval != SYMSOLVER_SUCCESS )
+   {
+      // the next MultiSolve has to give the matrix to the solver again,
+      // e.g., after the interface asked to be called again
+      atag_ = 0;
+   }
+   return retval;
+}
+
+ESymSolverStatus TSymLinearSolver::SolverInterfaceMultiSolve(
+   bool         new_matrix,
+   const Index* ia,
+   const Index* ja,
+   Index        nrhs,
+   Number*      rhs_vals,
+   bool         check_NegEVals,
+   Index        numberOfNegEVals
+)
+{
+   if( !single_precision_ )
+   {
+      return solver_interface_->MultiSolve(new_matrix, ia, ja, nrhs, rhs_vals, check_NegEVals, numberOfNegEVals);
+   }
+
+   const Index len = dim_ * nrhs;
+   rhs_vals_single_.resize(len);
+   float* rhs_single = rhs_vals_single_.empty() ? NULL : &rhs_vals_single_[0];
+   for( Index i = 0; i < len; i++ )
+   {
+      rhs_single[i] = (float) rhs_vals[i];
+   }
+   ESymSolverStatus retval = solver_interface_->MultiSolveSingle(new_matrix, ia, ja, nrhs, rhs_single, check_NegEVals,
+                             numberOfNegEVals);
+   if( retval == SYMSOLVER_SUCCESS )
+   {
+      for( Index i = 0; i < len; i++ )
+      {
+         rhs_vals[i] = rhs_single[i];
+      }
+   }
+   return retval;
+}
+
 Index TSymLinearSolver::NumberOfNegEVals() const
 {
    DBG_START_METH("TSymLinearSolver::NumberOfNegEVals", dbg_verbosity);
@@ -430,6 +534,20 @@ bool TSymLinearSolver::IncreaseQuality()
 {
    DBG_START_METH("TSymLinearSolver::IncreaseQuality", dbg_verbosity);
 
+   if( single_precision_ )
+   {
+      Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
+                     "Switching to factorization in double precision.\n");
+      if( HaveIpData() )
+      {
+         IpData().Append_info_string("Fd");
+      }
+      single_precision_ = false;
+      // make sure that the matrix is factorized again
+      atag_ = 0;
+      return true;
+   }
+
    if( IsValid(scaling_method_) && !use_scaling_ && linear_scaling_on_demand_ )
    {
       Jnlst().Printf(J_DETAILED, J_LINEAR_ALGEBRA,
@@ -471,7 +589,8 @@ void TSymLinearSolver::GiveMatrixToSolver(
    }
 
    //DBG_PRINT_MATRIX(3, "Aunscaled", sym_A);
-   TripletHelper::FillValues(nonzeros_triplet_, sym_A, atriplet);
+   DBG_ASSERT(IsValid(triplet_fill_plan_));
+   triplet_fill_plan_->FillValues(sym_A, atriplet);
    if( DBG_VERBOSITY() >= 3 )
    {
       for( Index i = 0; i < nonzeros_triplet_; i++ )
@@ -532,6 +651,177 @@ void TSymLinearSolver::GiveMatrixToSolver(
 
 }
 
+void TSymLinearSolver::ReserveRhsWorkspace(
+   Index len
+)
+{
+   if( len <= rhs_vals_capacity_ )
+   {
+      return;
+   }
+
+   // Align the workspace to a cache line, so that the solver
+   // interfaces can use vectorized kernels on it
+   const size_t alignment = 64;
+   const Index pad = (Index) (alignment / sizeof(Number));
+   delete[] rhs_workspace_;
+   rhs_workspace_ = new Number[len + pad];
+   size_t misalign = reinterpret_cast<size_t>(rhs_workspace_) % alignment;
+   rhs_vals_ = rhs_workspace_;
+   if( misalign != 0 )
+   {
+      rhs_vals_ = reinterpret_cast<Number*>(reinterpret_cast<char*>(rhs_workspace_) + (alignment - misalign));
+   }
+   rhs_vals_capacity_ = len;
+}
+
+void TSymLinearSolver::UpdateRhsLayout(
+   const Vector& vec
+)
+{
+   // Vectors from the same space have the same component structure,
+   // so the layout only needs to be recomputed if the space changes
+   if( IsValid(rhs_layout_space_) && GetRawPtr(rhs_layout_space_) == GetRawPtr(vec.OwnerSpace()) )
+   {
+      return;
+   }
+
+   DBG_PRINT((1, "Computing new right hand side layout.\n"));
+   rhs_layout_.clear();
+   std::vector<Index> path;
+   Index offset = 0;
+   AppendRhsSegments(vec, path, offset);
+   DBG_ASSERT(offset == dim_);
+   rhs_layout_space_ = vec.OwnerSpace();
+}
+
+void TSymLinearSolver::AppendRhsSegments(
+   const Vector&       vec,
+   std::vector<Index>& path,
+   Index&              offset
+)
+{
+   if( dynamic_cast<const DenseVector*>(&vec) )
+   {
+      if( vec.Dim() > 0 )
+      {
+         RhsSegment seg;
+         seg.path = path;
+         seg.offset = offset;
+         seg.dim = vec.Dim();
+         rhs_layout_.push_back(seg);
+      }
+      offset += vec.Dim();
+      return;
+   }
+
+   const CompoundVector* cv = dynamic_cast<const CompoundVector*>(&vec);
+   if( cv )
+   {
+      for( Index i = 0; i < cv->NComps(); i++ )
+      {
+         path.push_back(i);
+         AppendRhsSegments(*cv->GetComp(i), path, offset);
+         path.pop_back();
+      }
+      return;
+   }
+
+   THROW_EXCEPTION(UNKNOWN_VECTOR_TYPE, "Unknown vector type passed to TSymLinearSolver::MultiSolve");
+}
+
+void TSymLinearSolver::GatherRhs(
+   const Vector& vec,
+   Number*       values
+)
+{
+   DBG_ASSERT(dim_ == vec.Dim());
+   UpdateRhsLayout(vec);
+
+   const Number* scaling = use_scaling_ ? scaling_factors_ : NULL;
+   for( std::vector<RhsSegment>::const_iterator seg = rhs_layout_.begin(); seg != rhs_layout_.end(); ++seg )
+   {
+      const Vector* comp = &vec;
+      for( std::vector<Index>::const_iterator i = seg->path.begin(); i != seg->path.end(); ++i )
+      {
+         comp = GetRawPtr(static_cast<const CompoundVector*>(comp)->GetComp(*i));
+      }
+      DBG_ASSERT(dynamic_cast<const DenseVector*>(comp));
+      const DenseVector* dv = static_cast<const DenseVector*>(comp);
+
+      Number* vals = values + seg->offset;
+      const Index dim = seg->dim;
+      if( dv->IsHomogeneous() )
+      {
+         const Number scalar = dv->Scalar();
+         if( scaling )
+         {
+            const Number* sc = scaling + seg->offset;
+            for( Index j = 0; j < dim; j++ )
+            {
+               vals[j] = scalar * sc[j];
+            }
+         }
+         else
+         {
+            IpBlasCopy(dim, &scalar, 0, vals, 1);
+         }
+      }
+      else
+      {
+         const Number* dv_vals = dv->Values();
+         if( scaling )
+         {
+            const Number* sc = scaling + seg->offset;
+            for( Index j = 0; j < dim; j++ )
+            {
+               vals[j] = dv_vals[j] * sc[j];
+            }
+         }
+         else
+         {
+            IpBlasCopy(dim, dv_vals, 1, vals, 1);
+         }
+      }
+   }
+}
+
+void TSymLinearSolver::ScatterSol(
+   const Number* values,
+   Vector&       vec
+)
+{
+   DBG_ASSERT(dim_ == vec.Dim());
+   UpdateRhsLayout(vec);
+
+   const Number* scaling = use_scaling_ ? scaling_factors_ : NULL;
+   for( std::vector<RhsSegment>::const_iterator seg = rhs_layout_.begin(); seg != rhs_layout_.end(); ++seg )
+   {
+      Vector* comp = &vec;
+      for( std::vector<Index>::const_iterator i = seg->path.begin(); i != seg->path.end(); ++i )
+      {
+         comp = GetRawPtr(static_cast<CompoundVector*>(comp)->GetCompNonConst(*i));
+      }
+      DBG_ASSERT(dynamic_cast<DenseVector*>(comp));
+      Number* dv_vals = static_cast<DenseVector*>(comp)->Values();
+
+      const Number* vals = values + seg->offset;
+      const Index dim = seg->dim;
+      if( scaling )
+      {
+         const Number* sc = scaling + seg->offset;
+         for( Index j = 0; j < dim; j++ )
+         {
+            dv_vals[j] = vals[j] * sc[j];
+         }
+      }
+      else
+      {
+         IpBlasCopy(dim, vals, 1, dv_vals, 1);
+      }
+   }
+}
+
 bool TSymLinearSolver::ProvidesDegeneracyDetection() const
 {
    return solver_interface_->ProvidesDegeneracyDetection();
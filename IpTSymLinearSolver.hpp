@@ -12,6 +12,7 @@
 #include "IpTSymScalingMethod.hpp"
 #include "IpSymMatrix.hpp"
 #include "IpTripletToCSRConverter.hpp"
+#include "IpTripletHelper.hpp"
 #include <vector>
 #include <list>
 
@@ -75,6 +76,20 @@ public:
    virtual bool ProvidesInertia() const;
    ///@}
 
+   /** @name Factorization in concurrent threads */
+   ///@{
+   virtual bool ProvidesConcurrentFactorization() const;
+
+   virtual void PrepareFactorization(
+      const SymMatrix& A
+   );
+
+   virtual ESymSolverStatus FactorizePrepared(
+      bool  check_NegEVals,
+      Index numberOfNegEVals
+   );
+   ///@}
+
    /** @name Methods related to the detection of linearly dependent
     *  rows in a matrix
     */
@@ -191,16 +206,63 @@ private:
     *  the compressed representation.
     */
    SmartPtr<TripletToCSRConverter> triplet_to_csr_converter_;
+   /** Block decomposition of the matrix for filling the triplet
+    *  arrays.
+    */
+   SmartPtr<TripletFillPlan> triplet_fill_plan_;
    /** Flag indicating what matrix data format the solver requires. */
    SparseSymLinearSolverInterface::EMatrixFormat matrix_format_;
    ///@}
 
+   /** @name Workspace for right hand sides and solutions */
+   ///@{
+   /** Part of the flattened right hand side that is stored in one
+    *  DenseVector.
+    *
+    *  The DenseVector is reached from the right hand side by
+    *  following the component indices in path through the nested
+    *  CompoundVectors.
+    */
+   struct RhsSegment
+   {
+      std::vector<Index> path;
+      Index              offset;
+      Index              dim;
+   };
+   /** Vector space for which rhs_layout_ has been computed. */
+   SmartPtr<const VectorSpace> rhs_layout_space_;
+   /** Flattening plan for vectors in rhs_layout_space_. */
+   std::vector<RhsSegment> rhs_layout_;
+   /** Memory block holding rhs_vals_ (not aligned). */
+   Number* rhs_workspace_;
+   /** Aligned array for the right hand sides and solutions that are
+    *  passed to the solver interface.
+    *
+    *  It only grows, so that it is not reallocated for every
+    *  back solve.
+    */
+   Number* rhs_vals_;
+   /** Number of entries that fit into rhs_vals_. */
+   Index rhs_vals_capacity_;
+   /** Right hand sides and solutions in single precision, if the
+    *  factorization is computed in single precision.
+    */
+   std::vector<float> rhs_vals_single_;
+   ///@}
+
    /** @name Algorithmic parameters */
    ///@{
    /** Flag indicating whether the TNLP with identical structure has
     *  already been solved before.
     */
    bool warm_start_same_structure_;
+   /** Flag indicating whether the factorization is currently computed
+    *  in single precision.
+    *
+    *  This is switched off for good if a better quality of the
+    *  solution is requested.
+    */
+   bool single_precision_;
    ///@}
 
    /** @name Internal functions */
@@ -221,6 +283,54 @@ private:
       bool             new_matrix,
       const SymMatrix& sym_A
    );
+
+   /** Call MultiSolve or MultiSolveSingle of the solver interface,
+    *  depending on single_precision_.
+    *
+    *  rhs_vals are always given in double precision.
+    */
+   ESymSolverStatus SolverInterfaceMultiSolve(
+      bool         new_matrix,
+      const Index* ia,
+      const Index* ja,
+      Index        nrhs,
+      Number*      rhs_vals,
+      bool         check_NegEVals,
+      Index        numberOfNegEVals
+   );
+
+   /** Make sure that rhs_vals_ can hold at least len entries. */
+   void ReserveRhsWorkspace(
+      Index len
+   );
+
+   /** Make sure that rhs_layout_ describes the structure of vec. */
+   void UpdateRhsLayout(
+      const Vector& vec
+   );
+
+   /** Append the DenseVector segments of vec to rhs_layout_. */
+   void AppendRhsSegments(
+      const Vector&       vec,
+      std::vector<Index>& path,
+      Index&              offset
+   );
+
+   /** Copy the entries of vec into values, multiplied by the scaling
+    *  factors if scaling is used.
+    */
+   void GatherRhs(
+      const Vector& vec,
+      Number*       values
+   );
+
+   /** Copy values into vec, multiplied by the scaling factors if
+    *  scaling is used.
+    */
+   void ScatterSol(
+      const Number* values,
+      Vector&       vec
+   );
    ///@}
 };
 
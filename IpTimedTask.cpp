@@ -0,0 +1,29 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpTimedTask.hpp"
+#include "IpTimingTracer.hpp"
+
+namespace Ipopt
+{
+
+void TimedTask::SetTracer(
+   TimingTracer*      tracer,
+   const std::string& name
+)
+{
+   DBG_ASSERT(!start_called_);
+   tracer_ = tracer;
+   trace_name_ = tracer != NULL ? tracer->RegisterName(name) : -1;
+}
+
+void TimedTask::RecordTraceEvent(
+   bool   begin,
+   Number walltime
+)
+{
+   tracer_->Record(trace_name_, begin, walltime);
+}
+
+} // namespace Ipopt
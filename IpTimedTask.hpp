@@ -9,8 +9,13 @@
 
 #include "IpUtils.hpp"
 
+#include <string>
+
 namespace Ipopt
 {
+
+class TimingTracer;
+
 /** This class is used to collect timing information for a particular task. */
 class IPOPTLIB_EXPORT TimedTask
 {
@@ -23,10 +28,15 @@ public:
       total_cputime_(0.),
       total_systime_(0.),
       total_walltime_(0.),
+      tracer_(NULL),
+      trace_name_(-1),
       enabled_(true),
+      fine_grained_(false),
       start_called_(false),
       end_called_(true)
-   {}
+   {
+      ResetCallStatistics();
+   }
 
    /** Default destructor */
    ~TimedTask()
@@ -49,6 +59,36 @@ public:
       enabled_ = false;
    }
 
+   /** Mark the task as fine-grained.
+    *
+    *  A fine-grained task is short and called often, so only the
+    *  wallclock time is measured, which is cheap to query.  CPU and
+    *  system time are not sampled and remain zero.
+    */
+   void SetFineGrained(
+      bool fine_grained
+   )
+   {
+      DBG_ASSERT(!start_called_);
+      fine_grained_ = fine_grained;
+   }
+
+   bool IsFineGrained() const
+   {
+      return fine_grained_;
+   }
+
+   /** Record begin and end of the task with a tracer.
+    *
+    *  @param tracer tracer that records the events, or NULL to stop
+    *                tracing; the tracer must live as long as it is set
+    *  @param name   name of the events
+    */
+   void SetTracer(
+      TimingTracer*      tracer,
+      const std::string& name
+   );
+
    /** Method for resetting time to zero. */
    void Reset()
    {
@@ -57,6 +97,7 @@ public:
       total_walltime_ = 0.;
       start_called_ = false;
       end_called_ = true;
+      ResetCallStatistics();
    }
 
    /** Method that is called before execution of the task. */
@@ -71,9 +112,15 @@ public:
       DBG_ASSERT(!start_called_);
       end_called_ = false;
       start_called_ = true;
-      start_cputime_ = CpuTime();
-      start_systime_ = SysTime();
+      if( !fine_grained_ )
+      {
+         CpuAndSysTime(start_cputime_, start_systime_);
+      }
       start_walltime_ = WallclockTime();
+      if( tracer_ != NULL )
+      {
+         RecordTraceEvent(true, start_walltime_);
+      }
    }
 
    /** Method that is called after execution of the task. */
@@ -86,11 +133,7 @@ public:
 
       DBG_ASSERT(!end_called_);
       DBG_ASSERT(start_called_);
-      end_called_ = true;
-      start_called_ = false;
-      total_cputime_ += CpuTime() - start_cputime_;
-      total_systime_ += SysTime() - start_systime_;
-      total_walltime_ += WallclockTime() - start_walltime_;
+      Stop();
    }
 
    /** Method that is called after execution of the task for which
@@ -105,11 +148,7 @@ public:
       }
       if( start_called_ )
       {
-         end_called_ = true;
-         start_called_ = false;
-         total_cputime_ += CpuTime() - start_cputime_;
-         total_systime_ += SysTime() - start_systime_;
-         total_walltime_ += WallclockTime() - start_walltime_;
+         Stop();
       }
       DBG_ASSERT(end_called_);
    }
@@ -135,6 +174,44 @@ public:
       return total_walltime_;
    }
 
+   /** @name Statistics of the wallclock times of single calls */
+   ///@{
+   /** Number of buckets of the histogram.
+    *
+    *  Bucket 0 counts calls shorter than 1 microsecond, bucket k
+    *  calls between 10^(k-7) and 10^(k-6) seconds, and the last bucket
+    *  calls of 1 second and longer.
+    */
+   static const Index NumHistogramBuckets = 8;
+
+   /// number of completed calls since the last reset
+   Index NumCalls() const
+   {
+      return num_calls_;
+   }
+
+   /// shortest wallclock time of a single call, 0 if there was none
+   Number MinWallclockTime() const
+   {
+      return num_calls_ > 0 ? min_walltime_ : 0.;
+   }
+
+   /// longest wallclock time of a single call
+   Number MaxWallclockTime() const
+   {
+      return max_walltime_;
+   }
+
+   /// number of calls in a histogram bucket
+   Index HistogramCount(
+      Index bucket
+   ) const
+   {
+      DBG_ASSERT(bucket >= 0 && bucket < NumHistogramBuckets);
+      return histogram_[bucket];
+   }
+   ///@}
+
    /** Method returning start CPU time for started task.
     * @since 3.14.0
     */
@@ -192,6 +269,62 @@ private:
    void operator=(const TimedTask&);
    ///@}
 
+   /** Record the end of a call */
+   void Stop()
+   {
+      end_called_ = true;
+      start_called_ = false;
+      if( !fine_grained_ )
+      {
+         Number cputime;
+         Number systime;
+         CpuAndSysTime(cputime, systime);
+         total_cputime_ += cputime - start_cputime_;
+         total_systime_ += systime - start_systime_;
+      }
+      Number end_walltime = WallclockTime();
+      if( tracer_ != NULL )
+      {
+         RecordTraceEvent(false, end_walltime);
+      }
+      Number walltime = end_walltime - start_walltime_;
+      total_walltime_ += walltime;
+
+      num_calls_++;
+      if( walltime < min_walltime_ )
+      {
+         min_walltime_ = walltime;
+      }
+      if( walltime > max_walltime_ )
+      {
+         max_walltime_ = walltime;
+      }
+      Index bucket = 0;
+      for( Number limit = 1e-6; bucket < NumHistogramBuckets - 1 && walltime >= limit; limit *= 10. )
+      {
+         bucket++;
+      }
+      histogram_[bucket]++;
+   }
+
+   /** Pass a begin or end event to the tracer */
+   void RecordTraceEvent(
+      bool   begin,
+      Number walltime
+   );
+
+   /** Reset number of calls, min/max, and histogram */
+   void ResetCallStatistics()
+   {
+      num_calls_ = 0;
+      min_walltime_ = 1e300;
+      max_walltime_ = 0.;
+      for( Index i = 0; i < NumHistogramBuckets; i++ )
+      {
+         histogram_[i] = 0;
+      }
+   }
+
    /** CPU time at beginning of task. */
    Number start_cputime_;
    /** Total CPU time for task measured so far. */
@@ -205,9 +338,24 @@ private:
    /** Total wall clock time for task measured so far. */
    Number total_walltime_;
 
+   /** @name Statistics of single calls */
+   ///@{
+   Index num_calls_;
+   Number min_walltime_;
+   Number max_walltime_;
+   Index histogram_[NumHistogramBuckets];
+   ///@}
+
+   /** @name Tracing of begin and end events */
+   ///@{
+   TimingTracer* tracer_;
+   Index trace_name_;
+   ///@}
+
    /** @name status fields */
    ///@{
    bool enabled_;
+   bool fine_grained_;
    bool start_called_;
    bool end_called_;
    ///@}
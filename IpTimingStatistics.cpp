@@ -5,10 +5,38 @@
 // Authors:  Andreas Waechter          IBM    2005-09-19
 
 #include "IpTimingStatistics.hpp"
+#include "IpTimingTracer.hpp"
 
 namespace Ipopt
 {
 
+TimingStatistics::TimingStatistics()
+   : LinearSolverPeakMemory_(0.),
+     LinearSolverDiskRead_(0.),
+     LinearSolverDiskWrite_(0.)
+{ }
+
+TimingStatistics::~TimingStatistics()
+{ }
+
+void TimingStatistics::SetFineGrainedTimes(
+   bool fine_grained
+)
+{
+   // tasks that are short and called often
+   ComputeResiduals_.SetFineGrained(fine_grained);
+   LinearSystemBackSolve_.SetFineGrained(fine_grained);
+   LinearSystemStructureConverter_.SetFineGrained(fine_grained);
+   LinearSystemStructureConverterInit_.SetFineGrained(fine_grained);
+   f_eval_time_.SetFineGrained(fine_grained);
+   grad_f_eval_time_.SetFineGrained(fine_grained);
+   c_eval_time_.SetFineGrained(fine_grained);
+   jac_c_eval_time_.SetFineGrained(fine_grained);
+   d_eval_time_.SetFineGrained(fine_grained);
+   jac_d_eval_time_.SetFineGrained(fine_grained);
+   h_eval_time_.SetFineGrained(fine_grained);
+}
+
 bool TimingStatistics::IsFunctionEvaluationTimeEnabled() const
 {
    return f_eval_time_.IsEnabled() || grad_f_eval_time_.IsEnabled() || c_eval_time_.IsEnabled()
@@ -37,122 +65,145 @@ Number TimingStatistics::TotalFunctionEvaluationWallclockTime() const
           + jac_d_eval_time_.TotalWallclockTime() + h_eval_time_.TotalWallclockTime();
 }
 
+const TimingStatistics::TimedTaskEntry TimingStatistics::timed_tasks_[] =
+{
+   { "OverallAlgorithm", "OverallAlgorithm", 0, &TimingStatistics::OverallAlgorithm_ },
+   { "PrintProblemStatistics", "PrintProblemStatistics", 1, &TimingStatistics::PrintProblemStatistics_ },
+   { "InitializeIterates", "InitializeIterates", 1, &TimingStatistics::InitializeIterates_ },
+   { "UpdateHessian", "UpdateHessian", 1, &TimingStatistics::UpdateHessian_ },
+   { "OutputIteration", "OutputIteration", 1, &TimingStatistics::OutputIteration_ },
+   { "UpdateBarrierParameter", "UpdateBarrierParameter", 1, &TimingStatistics::UpdateBarrierParameter_ },
+   { "ComputeSearchDirection", "ComputeSearchDirection", 1, &TimingStatistics::ComputeSearchDirection_ },
+   { "ComputeAcceptableTrialPoint", "ComputeAcceptableTrialPoint", 1, &TimingStatistics::ComputeAcceptableTrialPoint_ },
+   { "AcceptTrialPoint", "AcceptTrialPoint", 1, &TimingStatistics::AcceptTrialPoint_ },
+   { "CheckConvergence", "CheckConvergence", 1, &TimingStatistics::CheckConvergence_ },
+   { "PDSystemSolverTotal", "PDSystemSolverTotal", 0, &TimingStatistics::PDSystemSolverTotal_ },
+   { "PDSystemSolverSolveOnce", "PDSystemSolverSolveOnce", 1, &TimingStatistics::PDSystemSolverSolveOnce_ },
+   { "ComputeResiduals", "ComputeResiduals", 1, &TimingStatistics::ComputeResiduals_ },
+   { "StdAugSystemSolverMultiSolve", "StdAugSystemSolverMultiSolve", 1, &TimingStatistics::StdAugSystemSolverMultiSolve_ },
+   { "LinearSystemScaling", "LinearSystemScaling", 1, &TimingStatistics::LinearSystemScaling_ },
+   { "LinearSystemSymbolicFactorization", "LinearSystemSymbolicFactorization", 1, &TimingStatistics::LinearSystemSymbolicFactorization_ },
+   { "LinearSystemFactorization", "LinearSystemFactorization", 1, &TimingStatistics::LinearSystemFactorization_ },
+   { "LinearSystemBackSolve", "LinearSystemBackSolve", 1, &TimingStatistics::LinearSystemBackSolve_ },
+   { "LinearSystemStructureConverter", "LinearSystemStructureConverter", 1, &TimingStatistics::LinearSystemStructureConverter_ },
+   { "LinearSystemStructureConverterInit", "LinearSystemStructureConverterInit", 2, &TimingStatistics::LinearSystemStructureConverterInit_ },
+   { "QualityFunctionSearch", "QualityFunctionSearch", 0, &TimingStatistics::QualityFunctionSearch_ },
+   { "TryCorrector", "TryCorrector", 0, &TimingStatistics::TryCorrector_ },
+   { "Task1", "Task1", 0, &TimingStatistics::Task1_ },
+   { "Task2", "Task2", 0, &TimingStatistics::Task2_ },
+   { "Task3", "Task3", 0, &TimingStatistics::Task3_ },
+   { "Task4", "Task4", 0, &TimingStatistics::Task4_ },
+   { "Task5", "Task5", 0, &TimingStatistics::Task5_ },
+   { "Task6", "Task6", 0, &TimingStatistics::Task6_ },
+   { NULL, "Function Evaluations", 0, NULL },
+   { "f_eval_time", "Objective function", 1, &TimingStatistics::f_eval_time_ },
+   { "grad_f_eval_time", "Objective function gradient", 1, &TimingStatistics::grad_f_eval_time_ },
+   { "c_eval_time", "Equality constraints", 1, &TimingStatistics::c_eval_time_ },
+   { "d_eval_time", "Inequality constraints", 1, &TimingStatistics::d_eval_time_ },
+   { "jac_c_eval_time", "Equality constraint Jacobian", 1, &TimingStatistics::jac_c_eval_time_ },
+   { "jac_d_eval_time", "Inequality constraint Jacobian", 1, &TimingStatistics::jac_d_eval_time_ },
+   { "h_eval_time", "Lagrangian Hessian", 1, &TimingStatistics::h_eval_time_ }
+};
+
+const Index TimingStatistics::num_timed_tasks_ = (Index) (sizeof(timed_tasks_) / sizeof(timed_tasks_[0]));
+
 /** Method for enabling all timed tasked. */
 void TimingStatistics::EnableTimes()
 {
-   OverallAlgorithm_.IsEnabled();
-   PrintProblemStatistics_.Enable();
-   InitializeIterates_.Enable();
-   UpdateHessian_.Enable();
-   OutputIteration_.Enable();
-   UpdateBarrierParameter_.Enable();
-   ComputeSearchDirection_.Enable();
-   ComputeAcceptableTrialPoint_.Enable();
-   AcceptTrialPoint_.Enable();
-   CheckConvergence_.Enable();
-   PDSystemSolverTotal_.Enable();
-   PDSystemSolverSolveOnce_.Enable();
-   ComputeResiduals_.Enable();
-   StdAugSystemSolverMultiSolve_.Enable();
-   LinearSystemScaling_.Enable();
-   LinearSystemSymbolicFactorization_.Enable();
-   LinearSystemFactorization_.Enable();
-   LinearSystemBackSolve_.Enable();
-   LinearSystemStructureConverter_.Enable();
-   LinearSystemStructureConverterInit_.Enable();
-   QualityFunctionSearch_.Enable();
-   TryCorrector_.Enable();
-   Task1_.Enable();
-   Task2_.Enable();
-   Task3_.Enable();
-   Task4_.Enable();
-   Task5_.Enable();
-   Task6_.Enable();
-   f_eval_time_.Enable();
-   grad_f_eval_time_.Enable();
-   c_eval_time_.Enable();
-   d_eval_time_.Enable();
-   jac_c_eval_time_.Enable();
-   jac_d_eval_time_.Enable();
-   h_eval_time_.Enable();
+   // OverallAlgorithm is enabled or disabled separately
+   for( Index i = 0; i < num_timed_tasks_; i++ )
+   {
+      if( timed_tasks_[i].task != NULL && timed_tasks_[i].task != &TimingStatistics::OverallAlgorithm_ )
+      {
+         (this->*timed_tasks_[i].task).Enable();
+      }
+   }
 }
 
 /** Method for disabling all timed tasks except for OverallAlgorithm */
 void TimingStatistics::DisableTimes()
 {
-   PrintProblemStatistics_.Disable();
-   InitializeIterates_.Disable();
-   UpdateHessian_.Disable();
-   OutputIteration_.Disable();
-   UpdateBarrierParameter_.Disable();
-   ComputeSearchDirection_.Disable();
-   ComputeAcceptableTrialPoint_.Disable();
-   AcceptTrialPoint_.Disable();
-   CheckConvergence_.Disable();
-   PDSystemSolverTotal_.Disable();
-   PDSystemSolverSolveOnce_.Disable();
-   ComputeResiduals_.Disable();
-   StdAugSystemSolverMultiSolve_.Disable();
-   LinearSystemScaling_.Disable();
-   LinearSystemSymbolicFactorization_.Disable();
-   LinearSystemFactorization_.Disable();
-   LinearSystemBackSolve_.Disable();
-   LinearSystemStructureConverter_.Disable();
-   LinearSystemStructureConverterInit_.Disable();
-   QualityFunctionSearch_.Disable();
-   TryCorrector_.Disable();
-   Task1_.Disable();
-   Task2_.Disable();
-   Task3_.Disable();
-   Task4_.Disable();
-   Task5_.Disable();
-   Task6_.Disable();
-   f_eval_time_.Disable();
-   grad_f_eval_time_.Disable();
-   c_eval_time_.Disable();
-   d_eval_time_.Disable();
-   jac_c_eval_time_.Disable();
-   jac_d_eval_time_.Disable();
-   h_eval_time_.Disable();
+   for( Index i = 0; i < num_timed_tasks_; i++ )
+   {
+      if( timed_tasks_[i].task != NULL && timed_tasks_[i].task != &TimingStatistics::OverallAlgorithm_ )
+      {
+         (this->*timed_tasks_[i].task).Disable();
+      }
+   }
 }
 
 void TimingStatistics::ResetTimes()
 {
-   OverallAlgorithm_.Reset();
-   PrintProblemStatistics_.Reset();
-   InitializeIterates_.Reset();
-   UpdateHessian_.Reset();
-   OutputIteration_.Reset();
-   UpdateBarrierParameter_.Reset();
-   ComputeSearchDirection_.Reset();
-   ComputeAcceptableTrialPoint_.Reset();
-   AcceptTrialPoint_.Reset();
-   CheckConvergence_.Reset();
-   PDSystemSolverTotal_.Reset();
-   PDSystemSolverSolveOnce_.Reset();
-   ComputeResiduals_.Reset();
-   StdAugSystemSolverMultiSolve_.Reset();
-   LinearSystemScaling_.Reset();
-   LinearSystemSymbolicFactorization_.Reset();
-   LinearSystemFactorization_.Reset();
-   LinearSystemBackSolve_.Reset();
-   LinearSystemStructureConverter_.Reset();
-   LinearSystemStructureConverterInit_.Reset();
-   QualityFunctionSearch_.Reset();
-   TryCorrector_.Reset();
-   Task1_.Reset();
-   Task2_.Reset();
-   Task3_.Reset();
-   Task4_.Reset();
-   Task5_.Reset();
-   Task6_.Reset();
-   f_eval_time_.Reset();
-   grad_f_eval_time_.Reset();
-   c_eval_time_.Reset();
-   d_eval_time_.Reset();
-   jac_c_eval_time_.Reset();
-   jac_d_eval_time_.Reset();
-   h_eval_time_.Reset();
+   for( Index i = 0; i < num_timed_tasks_; i++ )
+   {
+      if( timed_tasks_[i].task != NULL )
+      {
+         (this->*timed_tasks_[i].task).Reset();
+      }
+   }
+   LinearSolverPeakMemory_ = 0.;
+   LinearSolverDiskRead_ = 0.;
+   LinearSolverDiskWrite_ = 0.;
+}
+
+void TimingStatistics::SetTracer(
+   const SmartPtr<TimingTracer>& tracer,
+   const std::string&            prefix
+)
+{
+   tracer_ = tracer;
+
+   for( Index i = 0; i < num_timed_tasks_; i++ )
+   {
+      if( timed_tasks_[i].task != NULL )
+      {
+         (this->*timed_tasks_[i].task).SetTracer(GetRawPtr(tracer), prefix + timed_tasks_[i].name);
+      }
+   }
+}
+
+SmartPtr<TimingTracer> TimingStatistics::Tracer() const
+{
+   return tracer_;
+}
+
+void TimingStatistics::GetTimedTasks(
+   std::vector<std::pair<const char*, const TimedTask*> >& tasks
+) const
+{
+   tasks.clear();
+   for( Index i = 0; i < num_timed_tasks_; i++ )
+   {
+      if( timed_tasks_[i].task != NULL )
+      {
+         tasks.push_back(std::make_pair(timed_tasks_[i].name, &(this->*timed_tasks_[i].task)));
+      }
+   }
+}
+
+/** Print the total times of a task, if it is enabled */
+static void PrintTimedTask(
+   const Journalist&                                       jnlst,
+   EJournalLevel                                           level,
+   EJournalCategory                                        category,
+   const std::string&                                      label,
+   const TimedTask&                                        task,
+   std::vector<std::pair<std::string, const TimedTask*> >& printed
+)
+{
+   if( !task.IsEnabled() )
+   {
+      return;
+   }
+   if( task.IsFineGrained() )
+   {
+      jnlst.Printf(level, category, "%s: %10s (sys: %10s wall: %10.3f)\n", label.c_str(), "-", "-", task.TotalWallclockTime());
+   }
+   else
+   {
+      jnlst.Printf(level, category, "%s: %10.3f (sys: %10.3f wall: %10.3f)\n", label.c_str(), task.TotalCpuTime(), task.TotalSysTime(), task.TotalWallclockTime());
+   }
+   printed.push_back(std::make_pair(label, &task));
 }
 
 void TimingStatistics::PrintAllTimingStatistics(
@@ -166,125 +217,101 @@ void TimingStatistics::PrintAllTimingStatistics(
       return;
    }
 
-   if( OverallAlgorithm_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   "OverallAlgorithm....................: %10.3f (sys: %10.3f wall: %10.3f)\n", OverallAlgorithm_.TotalCpuTime(), OverallAlgorithm_.TotalSysTime(), OverallAlgorithm_.TotalWallclockTime());
-   else
+   // tasks that have been printed, for the table of call statistics
+   std::vector<std::pair<std::string, const TimedTask*> > printed;
+
+   Index group = 0;
+   while( group < num_timed_tasks_ )
    {
-      jnlst.Printf(level, category, "OverallAlgorithm\n");
+      const TimedTaskEntry& head = timed_tasks_[group];
+
+      // sum the times of the enabled tasks of the group
+      Index end = group + 1;
+      bool enabled = false;
+      bool fine_grained = false;
+      Number cpu_time = 0.;
+      Number sys_time = 0.;
+      Number wall_time = 0.;
+      for( ; end < num_timed_tasks_ && timed_tasks_[end].indent > 0; end++ )
+      {
+         const TimedTask& task = this->*timed_tasks_[end].task;
+         if( task.IsEnabled() )
+         {
+            enabled = true;
+            fine_grained = fine_grained || task.IsFineGrained();
+            cpu_time += task.TotalCpuTime();
+            sys_time += task.TotalSysTime();
+            wall_time += task.TotalWallclockTime();
+         }
+      }
+
+      for( Index i = group; i < end; i++ )
+      {
+         const TimedTaskEntry& entry = timed_tasks_[i];
+         std::string label(entry.indent, ' ');
+         label += entry.label;
+         if( label.size() < 36 )
+         {
+            label.append(36 - label.size(), '.');
+         }
+
+         if( entry.task == NULL )
+         {
+            if( !enabled )
+            {
+               continue;
+            }
+            if( fine_grained )
+            {
+               // only the wallclock time is measured for some tasks
+               jnlst.Printf(level, category, "%s: %10s (sys: %10s wall: %10.3f)\n", label.c_str(), "-", "-", wall_time);
+            }
+            else
+            {
+               jnlst.Printf(level, category, "%s: %10.3f (sys: %10.3f wall: %10.3f)\n", label.c_str(), cpu_time, sys_time, wall_time);
+            }
+         }
+         else if( i == group && !(this->*entry.task).IsEnabled() && enabled )
+         {
+            jnlst.Printf(level, category, "%s\n", entry.label);
+         }
+         else
+         {
+            PrintTimedTask(jnlst, level, category, label, this->*entry.task, printed);
+         }
+      }
+
+      if( head.task == &TimingStatistics::PDSystemSolverTotal_ )
+      {
+         if( LinearSolverPeakMemory_ > 0. )
+            jnlst.Printf(level, category,
+                         " LinearSolverPeakMemory (MB)........: %10.3f\n", LinearSolverPeakMemory_ / 1048576.);
+         if( LinearSolverDiskRead_ > 0. || LinearSolverDiskWrite_ > 0. )
+            jnlst.Printf(level, category,
+                         " LinearSolverDiskIO (MB)............: %10.3f (read: %10.3f write: %10.3f)\n", (LinearSolverDiskRead_ + LinearSolverDiskWrite_) / 1048576., LinearSolverDiskRead_ / 1048576., LinearSolverDiskWrite_ / 1048576.);
+      }
+
+      group = end;
    }
-   if( PrintProblemStatistics_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " PrintProblemStatistics.............: %10.3f (sys: %10.3f wall: %10.3f)\n", PrintProblemStatistics_.TotalCpuTime(), PrintProblemStatistics_.TotalSysTime(), PrintProblemStatistics_.TotalWallclockTime());
-   if( InitializeIterates_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " InitializeIterates.................: %10.3f (sys: %10.3f wall: %10.3f)\n", InitializeIterates_.TotalCpuTime(), InitializeIterates_.TotalSysTime(), InitializeIterates_.TotalWallclockTime());
-   if( UpdateHessian_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " UpdateHessian......................: %10.3f (sys: %10.3f wall: %10.3f)\n", UpdateHessian_.TotalCpuTime(), UpdateHessian_.TotalSysTime(), UpdateHessian_.TotalWallclockTime());
-   if( OutputIteration_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " OutputIteration....................: %10.3f (sys: %10.3f wall: %10.3f)\n", OutputIteration_.TotalCpuTime(), OutputIteration_.TotalSysTime(), OutputIteration_.TotalWallclockTime());
-   if( UpdateBarrierParameter_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " UpdateBarrierParameter.............: %10.3f (sys: %10.3f wall: %10.3f)\n", UpdateBarrierParameter_.TotalCpuTime(), UpdateBarrierParameter_.TotalSysTime(), UpdateBarrierParameter_.TotalWallclockTime());
-   if( ComputeSearchDirection_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " ComputeSearchDirection.............: %10.3f (sys: %10.3f wall: %10.3f)\n", ComputeSearchDirection_.TotalCpuTime(), ComputeSearchDirection_.TotalSysTime(), ComputeSearchDirection_.TotalWallclockTime());
-   if( ComputeAcceptableTrialPoint_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " ComputeAcceptableTrialPoint........: %10.3f (sys: %10.3f wall: %10.3f)\n", ComputeAcceptableTrialPoint_.TotalCpuTime(), ComputeAcceptableTrialPoint_.TotalSysTime(), ComputeAcceptableTrialPoint_.TotalWallclockTime());
-   if( AcceptTrialPoint_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " AcceptTrialPoint...................: %10.3f (sys: %10.3f wall: %10.3f)\n", AcceptTrialPoint_.TotalCpuTime(), AcceptTrialPoint_.TotalSysTime(), AcceptTrialPoint_.TotalWallclockTime());
-   if( CheckConvergence_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " CheckConvergence...................: %10.3f (sys: %10.3f wall: %10.3f)\n", CheckConvergence_.TotalCpuTime(), CheckConvergence_.TotalSysTime(), CheckConvergence_.TotalWallclockTime());
 
-   if( PDSystemSolverTotal_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   "PDSystemSolverTotal.................: %10.3f (sys: %10.3f wall: %10.3f)\n", PDSystemSolverTotal_.TotalCpuTime(), PDSystemSolverTotal_.TotalSysTime(), PDSystemSolverTotal_.TotalWallclockTime());
-   else if( PDSystemSolverSolveOnce_.IsEnabled() || ComputeResiduals_.IsEnabled() || StdAugSystemSolverMultiSolve_.IsEnabled() || LinearSystemScaling_.IsEnabled() || LinearSystemSymbolicFactorization_.IsEnabled() || LinearSystemFactorization_.IsEnabled() || LinearSystemBackSolve_.IsEnabled() || LinearSystemStructureConverter_.IsEnabled() || LinearSystemStructureConverterInit_.IsEnabled() )
+   jnlst.Printf(level, category,
+                "\nCalls and wallclock time per call (sec) of the tasks above:\n"
+                "                                         calls        min       mean        max    <1us   <10us  <100us    <1ms   <10ms  <100ms     <1s    >=1s\n");
+   for( size_t i = 0; i < printed.size(); i++ )
    {
-      jnlst.Printf(level, category, "PDSystemSolverTotal\n");
+      const TimedTask& task = *printed[i].second;
+      if( task.NumCalls() == 0 )
+      {
+         continue;
+      }
+      jnlst.Printf(level, category, "%s: %8" IPOPT_INDEX_FORMAT " %10.3e %10.3e %10.3e", printed[i].first.c_str(), task.NumCalls(),
+                   task.MinWallclockTime(), task.TotalWallclockTime() / task.NumCalls(), task.MaxWallclockTime());
+      for( Index b = 0; b < TimedTask::NumHistogramBuckets; b++ )
+      {
+         jnlst.Printf(level, category, " %7" IPOPT_INDEX_FORMAT, task.HistogramCount(b));
+      }
+      jnlst.Printf(level, category, "\n");
    }
-   if( PDSystemSolverSolveOnce_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " PDSystemSolverSolveOnce............: %10.3f (sys: %10.3f wall: %10.3f)\n", PDSystemSolverSolveOnce_.TotalCpuTime(), PDSystemSolverSolveOnce_.TotalSysTime(), PDSystemSolverSolveOnce_.TotalWallclockTime());
-   if( ComputeResiduals_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " ComputeResiduals...................: %10.3f (sys: %10.3f wall: %10.3f)\n", ComputeResiduals_.TotalCpuTime(), ComputeResiduals_.TotalSysTime(), ComputeResiduals_.TotalWallclockTime());
-   if( StdAugSystemSolverMultiSolve_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " StdAugSystemSolverMultiSolve.......: %10.3f (sys: %10.3f wall: %10.3f)\n", StdAugSystemSolverMultiSolve_.TotalCpuTime(), StdAugSystemSolverMultiSolve_.TotalSysTime(), StdAugSystemSolverMultiSolve_.TotalWallclockTime());
-   if( LinearSystemScaling_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " LinearSystemScaling................: %10.3f (sys: %10.3f wall: %10.3f)\n", LinearSystemScaling_.TotalCpuTime(), LinearSystemScaling_.TotalSysTime(), LinearSystemScaling_.TotalWallclockTime());
-   if( LinearSystemSymbolicFactorization_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " LinearSystemSymbolicFactorization..: %10.3f (sys: %10.3f wall: %10.3f)\n", LinearSystemSymbolicFactorization_.TotalCpuTime(), LinearSystemSymbolicFactorization_.TotalSysTime(), LinearSystemSymbolicFactorization_.TotalWallclockTime());
-   if( LinearSystemFactorization_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " LinearSystemFactorization..........: %10.3f (sys: %10.3f wall: %10.3f)\n", LinearSystemFactorization_.TotalCpuTime(), LinearSystemFactorization_.TotalSysTime(), LinearSystemFactorization_.TotalWallclockTime());
-   if( LinearSystemBackSolve_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " LinearSystemBackSolve..............: %10.3f (sys: %10.3f wall: %10.3f)\n", LinearSystemBackSolve_.TotalCpuTime(), LinearSystemBackSolve_.TotalSysTime(), LinearSystemBackSolve_.TotalWallclockTime());
-   if( LinearSystemStructureConverter_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " LinearSystemStructureConverter.....: %10.3f (sys: %10.3f wall: %10.3f)\n", LinearSystemStructureConverter_.TotalCpuTime(), LinearSystemStructureConverter_.TotalSysTime(), LinearSystemStructureConverter_.TotalWallclockTime());
-   if( LinearSystemStructureConverterInit_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   "  LinearSystemStructureConverterInit: %10.3f (sys: %10.3f wall: %10.3f)\n", LinearSystemStructureConverterInit_.TotalCpuTime(), LinearSystemStructureConverterInit_.TotalSysTime(), LinearSystemStructureConverterInit_.TotalWallclockTime());
-
-   if( QualityFunctionSearch_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   "QualityFunctionSearch...............: %10.3f (sys: %10.3f wall: %10.3f)\n", QualityFunctionSearch_.TotalCpuTime(), QualityFunctionSearch_.TotalSysTime(), QualityFunctionSearch_.TotalWallclockTime());
-   if( TryCorrector_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   "TryCorrector........................: %10.3f (sys: %10.3f wall: %10.3f)\n", TryCorrector_.TotalCpuTime(), TryCorrector_.TotalSysTime(), TryCorrector_.TotalWallclockTime());
-   if( Task1_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   "Task1...............................: %10.3f (sys: %10.3f wall: %10.3f)\n", Task1_.TotalCpuTime(), Task1_.TotalSysTime(), Task1_.TotalWallclockTime());
-   if( Task2_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   "Task2...............................: %10.3f (sys: %10.3f wall: %10.3f)\n", Task2_.TotalCpuTime(), Task2_.TotalSysTime(), Task2_.TotalWallclockTime());
-   if( Task3_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   "Task3...............................: %10.3f (sys: %10.3f wall: %10.3f)\n", Task3_.TotalCpuTime(), Task3_.TotalSysTime(), Task3_.TotalWallclockTime());
-   if( Task4_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   "Task4...............................: %10.3f (sys: %10.3f wall: %10.3f)\n", Task4_.TotalCpuTime(), Task4_.TotalSysTime(), Task4_.TotalWallclockTime());
-   if( Task5_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   "Task5...............................: %10.3f (sys: %10.3f wall: %10.3f)\n", Task5_.TotalCpuTime(), Task5_.TotalSysTime(), Task5_.TotalWallclockTime());
-   if( Task6_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   "Task6...............................: %10.3f (sys: %10.3f wall: %10.3f)\n", Task6_.TotalCpuTime(), Task6_.TotalSysTime(), Task6_.TotalWallclockTime());
-
-   if( IsFunctionEvaluationTimeEnabled() )
-      jnlst.Printf(level, category,
-                   "Function Evaluations................: %10.3f (sys: %10.3f wall: %10.3f)\n", TotalFunctionEvaluationCpuTime(), TotalFunctionEvaluationSysTime(), TotalFunctionEvaluationWallclockTime());
-   if( f_eval_time_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " Objective function.................: %10.3f (sys: %10.3f wall: %10.3f)\n", f_eval_time_.TotalCpuTime(), f_eval_time_.TotalSysTime(), f_eval_time_.TotalWallclockTime());
-   if( grad_f_eval_time_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " Objective function gradient........: %10.3f (sys: %10.3f wall: %10.3f)\n", grad_f_eval_time_.TotalCpuTime(), grad_f_eval_time_.TotalSysTime(), grad_f_eval_time_.TotalWallclockTime());
-   if( c_eval_time_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " Equality constraints...............: %10.3f (sys: %10.3f wall: %10.3f)\n", c_eval_time_.TotalCpuTime(), c_eval_time_.TotalSysTime(), c_eval_time_.TotalWallclockTime());
-   if( d_eval_time_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " Inequality constraints.............: %10.3f (sys: %10.3f wall: %10.3f)\n", d_eval_time_.TotalCpuTime(), d_eval_time_.TotalSysTime(), d_eval_time_.TotalWallclockTime());
-   if( jac_c_eval_time_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " Equality constraint Jacobian.......: %10.3f (sys: %10.3f wall: %10.3f)\n", jac_c_eval_time_.TotalCpuTime(), jac_c_eval_time_.TotalSysTime(), jac_c_eval_time_.TotalWallclockTime());
-   if( jac_d_eval_time_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " Inequality constraint Jacobian.....: %10.3f (sys: %10.3f wall: %10.3f)\n", jac_d_eval_time_.TotalCpuTime(), jac_d_eval_time_.TotalSysTime(), jac_d_eval_time_.TotalWallclockTime());
-   if( h_eval_time_.IsEnabled() )
-      jnlst.Printf(level, category,
-                   " Lagrangian Hessian.................: %10.3f (sys: %10.3f wall: %10.3f)\n", h_eval_time_.TotalCpuTime(), h_eval_time_.TotalSysTime(), h_eval_time_.TotalWallclockTime());
 }
 
 } // namespace Ipopt
@@ -11,6 +11,9 @@
 #include "IpJournalist.hpp"
 #include "IpTimedTask.hpp"
 
+#include <utility>
+#include <vector>
+
 namespace Ipopt
 {
 /** This class collects all timing statistics for Ipopt.
@@ -21,30 +24,116 @@ public:
    /**@name Constructors/Destructors */
    ///@{
    /** Default constructor. */
-   TimingStatistics()
-   { }
+   TimingStatistics();
 
    /** Destructor */
-   virtual ~TimingStatistics()
-   { }
+   virtual ~TimingStatistics();
    ///@}
 
    /// Whether timing of function evaluation has been enabled
    /// @since 3.14.0
    bool IsFunctionEvaluationTimeEnabled() const;
    /// total CPU time spend in function evaluation
+   ///
+   /// zero if only the wallclock time of the evaluations is measured,
+   /// see SetFineGrainedTimes()
    /// @since 3.14.0
    Number TotalFunctionEvaluationCpuTime() const;
    /// total system time spend in function evaluation
+   ///
+   /// zero if only the wallclock time of the evaluations is measured,
+   /// see SetFineGrainedTimes()
    /// @since 3.14.0
    Number TotalFunctionEvaluationSysTime() const;
    /// total wall-clock time spend in function evaluation
    /// @since 3.14.0
    Number TotalFunctionEvaluationWallclockTime() const;
 
+   /** @name Memory and I/O statistics of the linear solver
+    *
+    *  These are reported by linear solvers that keep (parts of) the
+    *  factor on disk.  All numbers are in bytes.
+    */
+   ///@{
+   /** Record the memory currently used by the linear solver; the
+    *  maximum over all calls is kept.
+    */
+   void UpdateLinearSolverPeakMemory(
+      Number bytes
+   )
+   {
+      if( bytes > LinearSolverPeakMemory_ )
+      {
+         LinearSolverPeakMemory_ = bytes;
+      }
+   }
+
+   /** Add to the number of bytes read from disk by the linear solver */
+   void AddLinearSolverDiskRead(
+      Number bytes
+   )
+   {
+      LinearSolverDiskRead_ += bytes;
+   }
+
+   /** Add to the number of bytes written to disk by the linear solver */
+   void AddLinearSolverDiskWrite(
+      Number bytes
+   )
+   {
+      LinearSolverDiskWrite_ += bytes;
+   }
+
+   Number LinearSolverPeakMemory() const
+   {
+      return LinearSolverPeakMemory_;
+   }
+
+   Number LinearSolverDiskRead() const
+   {
+      return LinearSolverDiskRead_;
+   }
+
+   Number LinearSolverDiskWrite() const
+   {
+      return LinearSolverDiskWrite_;
+   }
+   ///@}
+
    /** Method for resetting all times. */
    void ResetTimes();
 
+   /** Mark the tasks that are short and called often, i.e., the
+    *  function evaluations, back solves, residual computations, and
+    *  structure conversions, as fine-grained.
+    *
+    *  Only the wallclock time is measured for fine-grained tasks, see
+    *  TimedTask::SetFineGrained().
+    */
+   void SetFineGrainedTimes(
+      bool fine_grained
+   );
+
+   /** Record begin and end events of all timed tasks with a tracer.
+    *
+    *  @param tracer tracer that records the events, or NULL to stop
+    *                tracing
+    *  @param prefix prefix for the names of the events, e.g., to
+    *                distinguish the tasks of the restoration phase
+    */
+   void SetTracer(
+      const SmartPtr<TimingTracer>& tracer,
+      const std::string&            prefix = ""
+   );
+
+   /** Get the names of all timed tasks together with the tasks */
+   void GetTimedTasks(
+      std::vector<std::pair<const char*, const TimedTask*> >& tasks
+   ) const;
+
+   /** Tracer that records the timed tasks, or NULL if tracing is off */
+   SmartPtr<TimingTracer> Tracer() const;
+
    /** Method for enabling all timed tasked.
     * @since 3.14.0
     */
@@ -316,6 +405,39 @@ private:
    TimedTask jac_d_eval_time_;
    TimedTask h_eval_time_;
    ///@}
+
+   /** Entry of the table of all timed tasks */
+   struct TimedTaskEntry
+   {
+      /** name of the task, used by GetTimedTasks and for tracing */
+      const char* name;
+      /** label in the output of PrintAllTimingStatistics */
+      const char* label;
+      /** indentation of the label; a task with indentation 0 starts a
+       *  group, which contains the indented tasks that follow it
+       */
+      int indent;
+      /** the task, or NULL for a group that only prints the sum of
+       *  its tasks
+       */
+      TimedTask TimingStatistics::* task;
+   };
+
+   /** Table of all timed tasks, in the order in which they are printed */
+   static const TimedTaskEntry timed_tasks_[];
+
+   /** Number of entries in timed_tasks_ */
+   static const Index num_timed_tasks_;
+
+   /** Tracer that records the timed tasks */
+   SmartPtr<TimingTracer> tracer_;
+
+   /**@name Memory and I/O statistics of the linear solver */
+   ///@{
+   Number LinearSolverPeakMemory_;
+   Number LinearSolverDiskRead_;
+   Number LinearSolverDiskWrite_;
+   ///@}
 };
 
 } // namespace Ipopt
@@ -0,0 +1,200 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#include "IpTimingTracer.hpp"
+#include "IpDebug.hpp"
+
+#include <chrono>
+
+namespace Ipopt
+{
+
+TimingTracer::TimingTracer(
+   Index buffer_size
+)
+   : mask_(0),
+     tail_(0),
+     head_(0),
+     dropped_(0),
+     iteration_(0),
+     file_(NULL),
+     stop_(false)
+{
+   size_t capacity = 2;
+   while( capacity < (size_t) buffer_size )
+   {
+      capacity *= 2;
+   }
+   mask_ = capacity - 1;
+   slots_ = new Slot[capacity];
+   for( size_t i = 0; i < capacity; i++ )
+   {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+   }
+}
+
+TimingTracer::~TimingTracer()
+{
+   Close();
+   delete[] slots_;
+}
+
+bool TimingTracer::Open(
+   const std::string& filename
+)
+{
+   Close();
+
+   file_ = fopen(filename.c_str(), "w");
+   if( file_ == NULL )
+   {
+      return false;
+   }
+   fprintf(file_, "{\"traceEvents\":[\n"
+           "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Ipopt\"}}");
+   dropped_.store(0, std::memory_order_relaxed);
+   stop_ = false;
+   writer_ = std::thread(&TimingTracer::WriterLoop, this);
+   return true;
+}
+
+void TimingTracer::Close()
+{
+   if( file_ == NULL )
+   {
+      return;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(wakeup_mutex_);
+      stop_ = true;
+   }
+   wakeup_.notify_one();
+   writer_.join();
+
+   fprintf(file_, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":%lu}}\n",
+           (unsigned long) NumDroppedEvents());
+   fclose(file_);
+   file_ = NULL;
+}
+
+Index TimingTracer::RegisterName(
+   const std::string& name
+)
+{
+   std::lock_guard<std::mutex> lock(names_mutex_);
+   for( size_t i = 0; i < names_.size(); i++ )
+   {
+      if( names_[i] == name )
+      {
+         return (Index) i;
+      }
+   }
+   names_.push_back(name);
+   return (Index) names_.size() - 1;
+}
+
+Index TimingTracer::ThreadId()
+{
+   static std::atomic<Index> num_threads(0);
+   static thread_local Index id = num_threads.fetch_add(1, std::memory_order_relaxed);
+   return id;
+}
+
+void TimingTracer::Record(
+   Index  name,
+   bool   begin,
+   Number walltime
+)
+{
+   // bounded multi-producer queue: a producer claims a position by
+   // advancing tail_, fills the slot, and then publishes it by setting
+   // the sequence number of the slot to the position + 1
+   size_t pos = tail_.load(std::memory_order_relaxed);
+   Slot* slot;
+   for( ;; )
+   {
+      slot = &slots_[pos & mask_];
+      size_t seq = slot->sequence.load(std::memory_order_acquire);
+      if( seq == pos )
+      {
+         if( tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) )
+         {
+            break;
+         }
+      }
+      else if( seq < pos )
+      {
+         // the writer thread has not yet emptied this slot
+         dropped_.fetch_add(1, std::memory_order_relaxed);
+         return;
+      }
+      else
+      {
+         pos = tail_.load(std::memory_order_relaxed);
+      }
+   }
+
+   slot->event.walltime = walltime;
+   slot->event.name = name;
+   slot->event.iteration = iteration_.load(std::memory_order_relaxed);
+   slot->event.thread = ThreadId();
+   slot->event.begin = begin;
+   slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void TimingTracer::WriterLoop()
+{
+   for( ;; )
+   {
+      bool stop;
+      {
+         std::unique_lock<std::mutex> lock(wakeup_mutex_);
+         // producers do not notify, so poll the buffer regularly
+         wakeup_.wait_for(lock, std::chrono::milliseconds(20));
+         stop = stop_;
+      }
+      // events recorded before Close was called are in the buffer now
+      Drain();
+      if( stop )
+      {
+         break;
+      }
+   }
+   fflush(file_);
+}
+
+void TimingTracer::Drain()
+{
+   for( ;; )
+   {
+      Slot& slot = slots_[head_ & mask_];
+      if( slot.sequence.load(std::memory_order_acquire) != head_ + 1 )
+      {
+         return;
+      }
+      WriteEvent(slot.event);
+      // release the slot for the producer one round later
+      slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+      head_++;
+   }
+}
+
+void TimingTracer::WriteEvent(
+   const Event& event
+)
+{
+   std::string name;
+   {
+      std::lock_guard<std::mutex> lock(names_mutex_);
+      DBG_ASSERT(event.name >= 0 && event.name < (Index) names_.size());
+      name = names_[event.name];
+   }
+   // the metadata event written by Open comes first, so every event
+   // is preceded by a separator; timestamps are in microseconds
+   fprintf(file_, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"iter\":%d}}",
+           name.c_str(), event.begin ? 'B' : 'E', event.walltime * 1e6, (int) event.thread, (int) event.iteration);
+}
+
+} // namespace Ipopt
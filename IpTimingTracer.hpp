@@ -0,0 +1,192 @@
+// Copyright (C) 2024 COIN-OR Foundation
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+
+#ifndef __IPTIMINGTRACER_HPP__
+#define __IPTIMINGTRACER_HPP__
+
+#include "IpTypes.hpp"
+#include "IpReferenced.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Ipopt
+{
+
+/** Recorder of begin and end events of timed tasks.
+ *
+ *  The events are written into a trace file in the Chrome trace event
+ *  format (JSON), which can be loaded into chrome://tracing, Perfetto,
+ *  or Speedscope.  Each event is tagged with the current iteration
+ *  number and with the thread that recorded it.
+ *
+ *  Recording an event only writes it into a bounded lock-free ring
+ *  buffer, from which a background thread streams the events to the
+ *  file.  If the buffer is full, the event is dropped and counted, so
+ *  that the solver is never blocked by the tracer.
+ */
+class IPOPTLIB_EXPORT TimingTracer: public ReferencedObject
+{
+public:
+   /**@name Constructors/Destructors */
+   ///@{
+   /** Constructor.
+    *
+    *  @param buffer_size number of events that the ring buffer can
+    *                     hold; rounded up to a power of two
+    */
+   TimingTracer(
+      Index buffer_size = 65536
+   );
+
+   /** Destructor; closes the trace file */
+   virtual ~TimingTracer();
+   ///@}
+
+   /** Open the trace file and start the writer thread.
+    *
+    *  @return false, if the file could not be opened
+    */
+   bool Open(
+      const std::string& filename
+   );
+
+   /** Write all pending events, complete the trace file, and close it */
+   void Close();
+
+   /** Whether a trace file is open */
+   bool IsOpen() const
+   {
+      return file_ != NULL;
+   }
+
+   /** Get the identifier for an event name.
+    *
+    *  Names are registered once, e.g., when a TimedTask is attached to
+    *  the tracer, so that recording an event does not copy strings.
+    */
+   Index RegisterName(
+      const std::string& name
+   );
+
+   /** Set the iteration number with which the following events are tagged */
+   void SetIteration(
+      Index iter
+   )
+   {
+      iteration_.store(iter, std::memory_order_relaxed);
+   }
+
+   /** Record the begin or end of a task.
+    *
+    *  @param name     identifier obtained from RegisterName
+    *  @param begin    whether this is the begin of the task
+    *  @param walltime wallclock time of the event, as returned by
+    *                  WallclockTime()
+    */
+   void Record(
+      Index  name,
+      bool   begin,
+      Number walltime
+   );
+
+   /** Number of events that have been dropped because the buffer was full */
+   size_t NumDroppedEvents() const
+   {
+      return dropped_.load(std::memory_order_relaxed);
+   }
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   TimingTracer(
+      const TimingTracer&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const TimingTracer&
+   );
+   ///@}
+
+   /** A recorded event */
+   struct Event
+   {
+      Number walltime;
+      Index name;
+      Index iteration;
+      Index thread;
+      bool begin;
+   };
+
+   /** A slot of the ring buffer.
+    *
+    *  The sequence number tells whether the slot is free for the
+    *  producer with the same position, or filled for the consumer at
+    *  the position before.
+    */
+   struct Slot
+   {
+      std::atomic<size_t> sequence;
+      Event event;
+   };
+
+   /** Main loop of the writer thread */
+   void WriterLoop();
+
+   /** Write all events in the buffer to the file */
+   void Drain();
+
+   /** Write one event to the file */
+   void WriteEvent(
+      const Event& event
+   );
+
+   /** Identifier of the calling thread */
+   static Index ThreadId();
+
+   /** @name Ring buffer */
+   ///@{
+   Slot* slots_;
+   size_t mask_;
+   /** Next position to be filled by a producer */
+   std::atomic<size_t> tail_;
+   /** Next position to be read by the writer thread */
+   size_t head_;
+   std::atomic<size_t> dropped_;
+   ///@}
+
+   std::atomic<Index> iteration_;
+
+   /** Registered event names, guarded by names_mutex_ */
+   std::vector<std::string> names_;
+   std::mutex names_mutex_;
+
+   /** @name Writer thread */
+   ///@{
+   FILE* file_;
+   std::thread writer_;
+   std::mutex wakeup_mutex_;
+   std::condition_variable wakeup_;
+   bool stop_;
+   ///@}
+};
+
+} // namespace Ipopt
+
+#endif
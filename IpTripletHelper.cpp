@@ -27,9 +27,18 @@
 
 #include "IpBlas.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace Ipopt
 {
 
+/** Minimal number of triplet entries for which TripletFillPlan fills
+ *  the blocks in parallel.
+ */
+static const Index min_parallel_fill_entries = 50000;
+
 Index TripletHelper::GetNumberEntries(
    const Matrix& matrix
 )
@@ -1178,5 +1187,411 @@ void TripletHelper::PutValuesInVector(
    THROW_EXCEPTION(UNKNOWN_VECTOR_TYPE, "Unknown vector type passed to TripletHelper::PutValuesInVector");
 }
 
-} // namespace Ipopt
+template<class T>
+void TripletFillPlan::FillValuesOf(
+   Index         n_entries,
+   const Matrix& matrix,
+   Number*       values
+)
+{
+   TripletHelper::FillValues_(n_entries, static_cast<const T&>(matrix), values);
+}
+
+template<class T>
+void TripletFillPlan::FillRowColOf(
+   Index         n_entries,
+   const Matrix& matrix,
+   Index         row_offset,
+   Index         col_offset,
+   Index*        iRow,
+   Index*        jCol
+)
+{
+   TripletHelper::FillRowCol_(n_entries, static_cast<const T&>(matrix), row_offset, col_offset, iRow, jCol);
+}
+
+TripletFillPlan::TripletFillPlan()
+   : n_entries_(0)
+{ }
+
+TripletFillPlan::~TripletFillPlan()
+{ }
+
+void TripletFillPlan::Initialize(
+   const Matrix& matrix
+)
+{
+   blocks_.clear();
+   n_entries_ = 0;
+   std::vector<PathStep> path;
+   AppendBlocks(matrix, path, 0, 0);
+   DBG_ASSERT(n_entries_ == TripletHelper::GetNumberEntries(matrix));
+   current_.resize(blocks_.size());
+   raw_.resize(blocks_.size());
+}
+
+void TripletFillPlan::AppendBlocks(
+   const Matrix&          matrix,
+   std::vector<PathStep>& path,
+   Index                  row_offset,
+   Index                  col_offset
+)
+{
+   const Matrix* mptr = &matrix;
+
+   const CompoundSymMatrix* cmpd_sym = dynamic_cast<const CompoundSymMatrix*>(mptr);
+   if( cmpd_sym )
+   {
+      const CompoundSymMatrixSpace* owner_space =
+         static_cast<const CompoundSymMatrixSpace*>(GetRawPtr(cmpd_sym->OwnerSpace()));
+      Index c_row_offset = row_offset;
+      for( Index i = 0; i < cmpd_sym->NComps_Dim(); i++ )
+      {
+         Index c_col_offset = col_offset;
+         for( Index j = 0; j <= i; j++ )
+         {
+            SmartPtr<const Matrix> blk_mat = cmpd_sym->GetComp(i, j);
+            if( IsValid(blk_mat) )
+            {
+               PathStep step = { i, j, true };
+               path.push_back(step);
+               AppendBlocks(*blk_mat, path, c_row_offset, c_col_offset);
+               path.pop_back();
+            }
+            c_col_offset += owner_space->GetBlockDim(j);
+         }
+         c_row_offset += owner_space->GetBlockDim(i);
+      }
+      return;
+   }
+
+   const CompoundMatrix* cmpd = dynamic_cast<const CompoundMatrix*>(mptr);
+   if( cmpd )
+   {
+      const CompoundMatrixSpace* owner_space = static_cast<const CompoundMatrixSpace*>(GetRawPtr(cmpd->OwnerSpace()));
+      Index c_row_offset = row_offset;
+      for( Index i = 0; i < cmpd->NComps_Rows(); i++ )
+      {
+         Index c_col_offset = col_offset;
+         for( Index j = 0; j < cmpd->NComps_Cols(); j++ )
+         {
+            SmartPtr<const Matrix> blk_mat = cmpd->GetComp(i, j);
+            if( IsValid(blk_mat) )
+            {
+               PathStep step = { i, j, false };
+               path.push_back(step);
+               AppendBlocks(*blk_mat, path, c_row_offset, c_col_offset);
+               path.pop_back();
+            }
+            c_col_offset += owner_space->GetBlockCols(j);
+         }
+         c_row_offset += owner_space->GetBlockRows(i);
+      }
+      return;
+   }
+
+   Block blk;
+   blk.path = path;
+   blk.offset = n_entries_;
+   blk.n_entries = TripletHelper::GetNumberEntries(matrix);
+   blk.row_offset = row_offset;
+   blk.col_offset = col_offset;
+   blk.type = &typeid(matrix);
+
+   if( blk.n_entries == 0 )
+   {
+      return;
+   }
+
+   if( dynamic_cast<const GenTMatrix*>(mptr) )
+   {
+      blk.fill_values = &FillValuesOf<GenTMatrix>;
+      blk.fill_rowcol = &FillRowColOf<GenTMatrix>;
+   }
+   else if( dynamic_cast<const SymTMatrix*>(mptr) )
+   {
+      blk.fill_values = &FillValuesOf<SymTMatrix>;
+      blk.fill_rowcol = &FillRowColOf<SymTMatrix>;
+   }
+   else if( dynamic_cast<const ScaledMatrix*>(mptr) )
+   {
+      blk.fill_values = &FillValuesOf<ScaledMatrix>;
+      blk.fill_rowcol = &FillRowColOf<ScaledMatrix>;
+   }
+   else if( dynamic_cast<const SymScaledMatrix*>(mptr) )
+   {
+      blk.fill_values = &FillValuesOf<SymScaledMatrix>;
+      blk.fill_rowcol = &FillRowColOf<SymScaledMatrix>;
+   }
+   else if( dynamic_cast<const DiagMatrix*>(mptr) )
+   {
+      blk.fill_values = &FillValuesOf<DiagMatrix>;
+      blk.fill_rowcol = &FillRowColOf<DiagMatrix>;
+   }
+   else if( dynamic_cast<const IdentityMatrix*>(mptr) )
+   {
+      blk.fill_values = &FillValuesOf<IdentityMatrix>;
+      blk.fill_rowcol = &FillRowColOf<IdentityMatrix>;
+   }
+   else if( dynamic_cast<const ExpansionMatrix*>(mptr) )
+   {
+      blk.fill_values = &FillValuesOf<ExpansionMatrix>;
+      blk.fill_rowcol = &FillRowColOf<ExpansionMatrix>;
+   }
+   else if( dynamic_cast<const SumMatrix*>(mptr) )
+   {
+      blk.fill_values = &FillValuesOf<SumMatrix>;
+      blk.fill_rowcol = &FillRowColOf<SumMatrix>;
+   }
+   else if( dynamic_cast<const SumSymMatrix*>(mptr) )
+   {
+      blk.fill_values = &FillValuesOf<SumSymMatrix>;
+      blk.fill_rowcol = &FillRowColOf<SumSymMatrix>;
+   }
+   else if( dynamic_cast<const TransposeMatrix*>(mptr) )
+   {
+      blk.fill_values = &FillValuesOf<TransposeMatrix>;
+      blk.fill_rowcol = &FillRowColOf<TransposeMatrix>;
+   }
+   else if( dynamic_cast<const ExpandedMultiVectorMatrix*>(mptr) )
+   {
+      blk.fill_values = &FillValuesOf<ExpandedMultiVectorMatrix>;
+      blk.fill_rowcol = &FillRowColOf<ExpandedMultiVectorMatrix>;
+   }
+   else
+   {
+      THROW_EXCEPTION(UNKNOWN_MATRIX_TYPE, "Unknown matrix type passed to TripletFillPlan::Initialize");
+   }
+
+   blocks_.push_back(blk);
+   n_entries_ += blk.n_entries;
+}
 
+bool TripletFillPlan::GetCurrentBlocks(
+   const Matrix& matrix
+)
+{
+   DBG_ASSERT(current_.size() == blocks_.size());
+   for( size_t k = 0; k < blocks_.size(); k++ )
+   {
+      const Matrix* blk_mat = &matrix;
+      const std::vector<PathStep>& path = blocks_[k].path;
+      for( std::vector<PathStep>::const_iterator step = path.begin(); step != path.end(); ++step )
+      {
+         if( step->sym )
+         {
+            DBG_ASSERT(dynamic_cast<const CompoundSymMatrix*>(blk_mat));
+            blk_mat = GetRawPtr(static_cast<const CompoundSymMatrix*>(blk_mat)->GetComp(step->irow, step->jcol));
+         }
+         else
+         {
+            DBG_ASSERT(dynamic_cast<const CompoundMatrix*>(blk_mat));
+            blk_mat = GetRawPtr(static_cast<const CompoundMatrix*>(blk_mat)->GetComp(step->irow, step->jcol));
+         }
+         if( blk_mat == NULL )
+         {
+            return false;
+         }
+      }
+      if( typeid(*blk_mat) != *blocks_[k].type )
+      {
+         return false;
+      }
+      current_[k] = blk_mat;
+   }
+   return true;
+}
+
+bool TripletFillPlan::GetRawBlock(
+   Index k,
+   bool  with_scaling
+)
+{
+   RawBlock& raw = raw_[k];
+   raw.values = NULL;
+   raw.irow = NULL;
+   raw.jcol = NULL;
+   raw.row_scaling = NULL;
+   raw.col_scaling = NULL;
+
+   const Matrix* core = current_[k];
+   const Vector* row_scaling = NULL;
+   const Vector* col_scaling = NULL;
+   const std::type_info& type = *blocks_[k].type;
+   if( type == typeid(ScaledMatrix) )
+   {
+      const ScaledMatrix* scaled = static_cast<const ScaledMatrix*>(core);
+      core = GetRawPtr(scaled->GetUnscaledMatrix());
+      row_scaling = GetRawPtr(scaled->RowScaling());
+      col_scaling = GetRawPtr(scaled->ColumnScaling());
+   }
+   else if( type == typeid(SymScaledMatrix) )
+   {
+      const SymScaledMatrix* scaled = static_cast<const SymScaledMatrix*>(core);
+      core = GetRawPtr(scaled->GetUnscaledMatrix());
+      row_scaling = GetRawPtr(scaled->RowColScaling());
+      col_scaling = row_scaling;
+   }
+
+   const GenTMatrix* gent = dynamic_cast<const GenTMatrix*>(core);
+   const SymTMatrix* symt = dynamic_cast<const SymTMatrix*>(core);
+   if( gent )
+   {
+      raw.values = gent->Values();
+      raw.irow = gent->Irows();
+      raw.jcol = gent->Jcols();
+   }
+   else if( symt )
+   {
+      raw.values = symt->Values();
+      raw.irow = symt->Irows();
+      raw.jcol = symt->Jcols();
+   }
+   else
+   {
+      return false;
+   }
+
+   if( with_scaling )
+   {
+      if( row_scaling != NULL )
+      {
+         raw.row_scaling = GetScalingValues(*row_scaling, raw.row_buffer);
+      }
+      if( col_scaling == row_scaling )
+      {
+         raw.col_scaling = raw.row_scaling;
+      }
+      else if( col_scaling != NULL )
+      {
+         raw.col_scaling = GetScalingValues(*col_scaling, raw.col_buffer);
+      }
+   }
+   return true;
+}
+
+const Number* TripletFillPlan::GetScalingValues(
+   const Vector&        scaling,
+   std::vector<Number>& buffer
+)
+{
+   const DenseVector* dv = dynamic_cast<const DenseVector*>(&scaling);
+   if( dv && !dv->IsHomogeneous() )
+   {
+      return dv->Values();
+   }
+   Index dim = scaling.Dim();
+   buffer.resize(dim);
+   if( dim > 0 )
+   {
+      TripletHelper::FillValuesFromVector(dim, scaling, &buffer[0]);
+   }
+   return dim > 0 ? &buffer[0] : NULL;
+}
+
+void TripletFillPlan::FillRowCol(
+   const Matrix& matrix,
+   Index*        iRow,
+   Index*        jCol
+)
+{
+   if( !GetCurrentBlocks(matrix) )
+   {
+      Initialize(matrix);
+      TripletHelper::FillRowCol(n_entries_, matrix, iRow, jCol);
+      return;
+   }
+
+   // Blocks that are no triplet matrices are filled here, since the
+   // accessors of the matrices return SmartPtrs.
+   Index nblocks = (Index) blocks_.size();
+   for( Index k = 0; k < nblocks; k++ )
+   {
+      if( !GetRawBlock(k, false) )
+      {
+         const Block& blk = blocks_[k];
+         blk.fill_rowcol(blk.n_entries, *current_[k], blk.row_offset, blk.col_offset, iRow + blk.offset,
+                         jCol + blk.offset);
+      }
+   }
+
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(dynamic, 1) if( n_entries_ >= min_parallel_fill_entries )
+#endif
+   for( Index k = 0; k < nblocks; k++ )
+   {
+      const RawBlock& raw = raw_[k];
+      if( raw.irow == NULL )
+      {
+         continue;
+      }
+      const Block& blk = blocks_[k];
+      Index* blk_iRow = iRow + blk.offset;
+      Index* blk_jCol = jCol + blk.offset;
+      for( Index i = 0; i < blk.n_entries; i++ )
+      {
+         blk_iRow[i] = raw.irow[i] + blk.row_offset;
+         blk_jCol[i] = raw.jcol[i] + blk.col_offset;
+      }
+   }
+}
+
+void TripletFillPlan::FillValues(
+   const Matrix& matrix,
+   Number*       values
+)
+{
+   if( !GetCurrentBlocks(matrix) )
+   {
+      Initialize(matrix);
+      TripletHelper::FillValues(n_entries_, matrix, values);
+      return;
+   }
+
+   // Blocks that are no (scaled) triplet matrices are filled here, since
+   // the accessors of the matrices return SmartPtrs.  For the others,
+   // the arrays are looked up here.
+   Index nblocks = (Index) blocks_.size();
+   for( Index k = 0; k < nblocks; k++ )
+   {
+      if( !GetRawBlock(k, true) )
+      {
+         const Block& blk = blocks_[k];
+         blk.fill_values(blk.n_entries, *current_[k], values + blk.offset);
+      }
+   }
+
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(dynamic, 1) if( n_entries_ >= min_parallel_fill_entries )
+#endif
+   for( Index k = 0; k < nblocks; k++ )
+   {
+      const RawBlock& raw = raw_[k];
+      if( raw.values == NULL )
+      {
+         continue;
+      }
+      const Block& blk = blocks_[k];
+      Number* blk_values = values + blk.offset;
+      for( Index i = 0; i < blk.n_entries; i++ )
+      {
+         blk_values[i] = raw.values[i];
+      }
+      if( raw.row_scaling != NULL )
+      {
+         for( Index i = 0; i < blk.n_entries; i++ )
+         {
+            blk_values[i] *= raw.row_scaling[raw.irow[i] - 1];
+         }
+      }
+      if( raw.col_scaling != NULL )
+      {
+         for( Index i = 0; i < blk.n_entries; i++ )
+         {
+            blk_values[i] *= raw.col_scaling[raw.jcol[i] - 1];
+         }
+      }
+   }
+}
+
+} // namespace Ipopt
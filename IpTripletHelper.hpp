@@ -9,6 +9,10 @@
 
 #include "IpTypes.hpp"
 #include "IpException.hpp"
+#include "IpReferenced.hpp"
+
+#include <vector>
+#include <typeinfo>
 
 namespace Ipopt
 {
@@ -37,6 +41,8 @@ class Vector;
 
 class IPOPTLIB_EXPORT TripletHelper
 {
+   friend class TripletFillPlan;
+
 public:
    /**@name A set of recursive routines that help with the Triplet format. */
    ///@{
@@ -304,5 +310,215 @@ private:
    );
 };
 
+/** Precomputed decomposition of a (compound) matrix into leaf blocks
+ *  for filling the triplet format.
+ *
+ *  Initialize descends through the CompoundMatrix and
+ *  CompoundSymMatrix blocks of a matrix once and records for every
+ *  other block its position in the triplet arrays and the TripletHelper
+ *  routine for its type.  FillValues and FillRowCol then fetch the
+ *  current blocks and fill their (disjoint) ranges of the output
+ *  arrays.
+ *
+ *  Blocks may share Vector and Matrix objects (e.g., the scaling
+ *  vectors), whose reference counts must not be changed concurrently.
+ *  Therefore, the arrays of the blocks that are GenTMatrix or
+ *  SymTMatrix objects, possibly scaled, are looked up serially, and
+ *  only the loops over these arrays run in parallel if OpenMP is
+ *  enabled and the matrix is large enough.  All other blocks are
+ *  filled serially by the TripletHelper routines.
+ *
+ *  If the type of a block changed since Initialize, the serial
+ *  TripletHelper routines are used and the plan is recomputed.
+ */
+class TripletFillPlan: public ReferencedObject
+{
+public:
+   /**@name Constructor/Destructor */
+   ///@{
+   TripletFillPlan();
+
+   ~TripletFillPlan();
+   ///@}
+
+   /** Compute the block decomposition for matrices with the
+    *  structure of matrix.
+    */
+   void Initialize(
+      const Matrix& matrix
+   );
+
+   /** Number of triplet entries of the matrices this plan is for */
+   Index NumberEntries() const
+   {
+      return n_entries_;
+   }
+
+   /** Number of leaf blocks */
+   Index NumberBlocks() const
+   {
+      return (Index) blocks_.size();
+   }
+
+   /** fill the irows, jcols structure for the triplet format from the matrix */
+   void FillRowCol(
+      const Matrix& matrix,
+      Index*        iRow,
+      Index*        jCol
+   );
+
+   /** fill the values for the triplet format from the matrix */
+   void FillValues(
+      const Matrix& matrix,
+      Number*       values
+   );
+
+private:
+   /**@name Default Compiler Generated Methods
+    * (Hidden to avoid implicit creation/calling).
+    *
+    * These methods are not implemented and
+    * we do not want the compiler to implement
+    * them for us, so we declare them private
+    * and do not define them. This ensures that
+    * they will not be implicitly created/called.
+    */
+   ///@{
+   /** Copy Constructor */
+   TripletFillPlan(
+      const TripletFillPlan&
+   );
+
+   /** Default Assignment Operator */
+   void operator=(
+      const TripletFillPlan&
+   );
+   ///@}
+
+   /** Function filling the values of a leaf block of known type */
+   typedef void (*FillValuesFunc)(
+      Index         n_entries,
+      const Matrix& matrix,
+      Number*       values
+   );
+
+   /** Function filling the indices of a leaf block of known type */
+   typedef void (*FillRowColFunc)(
+      Index         n_entries,
+      const Matrix& matrix,
+      Index         row_offset,
+      Index         col_offset,
+      Index*        iRow,
+      Index*        jCol
+   );
+
+   /** One step from a compound matrix to one of its blocks */
+   struct PathStep
+   {
+      Index irow;
+      Index jcol;
+      bool  sym;
+   };
+
+   /** Leaf block of the matrix */
+   struct Block
+   {
+      std::vector<PathStep> path;
+      /** position of the first entry in the triplet arrays */
+      Index                 offset;
+      Index                 n_entries;
+      Index                 row_offset;
+      Index                 col_offset;
+      const std::type_info* type;
+      FillValuesFunc        fill_values;
+      FillRowColFunc        fill_rowcol;
+   };
+
+   /** Arrays of a leaf block that is a (scaled) triplet matrix, looked
+    *  up from the current matrix before the blocks are filled
+    */
+   struct RawBlock
+   {
+      /** values of the triplet matrix, NULL if the block is filled by fill_values */
+      const Number*       values;
+      /** 1-based row indices of the triplet matrix, NULL if the block is filled by fill_rowcol */
+      const Index*        irow;
+      /** 1-based column indices of the triplet matrix */
+      const Index*        jcol;
+      /** row scaling factors, NULL if the rows are not scaled */
+      const Number*       row_scaling;
+      /** column scaling factors, NULL if the columns are not scaled */
+      const Number*       col_scaling;
+      /** storage for the row scaling factors if they are not available as an array */
+      std::vector<Number> row_buffer;
+      /** storage for the column scaling factors if they are not available as an array */
+      std::vector<Number> col_buffer;
+   };
+
+   /** Append the leaf blocks of matrix to blocks_ */
+   void AppendBlocks(
+      const Matrix&          matrix,
+      std::vector<PathStep>& path,
+      Index                  row_offset,
+      Index                  col_offset
+   );
+
+   /** Look up the current leaf blocks of matrix in current_.
+    *
+    *  Returns false if a block does not have the type seen in
+    *  Initialize.
+    */
+   bool GetCurrentBlocks(
+      const Matrix& matrix
+   );
+
+   /** Look up the arrays of the current leaf block k in raw_[k].
+    *
+    *  The scaling factors are only looked up if with_scaling is true.
+    *  Returns false if the block is not a (scaled) triplet matrix.
+    */
+   bool GetRawBlock(
+      Index k,
+      bool  with_scaling
+   );
+
+   /** Get the values of a scaling vector as an array, using buffer if
+    *  they are not stored as an array.
+    */
+   static const Number* GetScalingValues(
+      const Vector&        scaling,
+      std::vector<Number>& buffer
+   );
+
+   template<class T>
+   static void FillValuesOf(
+      Index         n_entries,
+      const Matrix& matrix,
+      Number*       values
+   );
+
+   template<class T>
+   static void FillRowColOf(
+      Index         n_entries,
+      const Matrix& matrix,
+      Index         row_offset,
+      Index         col_offset,
+      Index*        iRow,
+      Index*        jCol
+   );
+
+   /** Total number of triplet entries */
+   Index n_entries_;
+
+   /** Leaf blocks with at least one entry */
+   std::vector<Block> blocks_;
+
+   /** Leaf blocks of the matrix passed to the last fill call */
+   std::vector<const Matrix*> current_;
+
+   /** Arrays of the leaf blocks of the matrix passed to the last fill call */
+   std::vector<RawBlock> raw_;
+};
+
 } // namespace Ipopt
 #endif
@@ -93,6 +93,28 @@ inline double IpCoinGetTimeOfDay()
 
 /** 8< (END) ******************************** */
 
+// Monotonic clock for the wallclock time.  Reading it does not require
+// a system call (QueryPerformanceCounter on Windows, vDSO on Linux).
+#if defined(_MSC_VER) || defined(__MSVCRT__)
+#include <chrono>
+inline double IpMonotonicTime()
+{
+   return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#elif defined(CLOCK_MONOTONIC)
+inline double IpMonotonicTime()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1000000000.0;
+}
+#else
+inline double IpMonotonicTime()
+{
+   return IpCoinGetTimeOfDay();
+}
+#endif
+
 namespace Ipopt
 {
 
@@ -182,9 +204,27 @@ Number SysTime()
    return sys_temp;
 }
 
+void CpuAndSysTime(
+   Number& cputime,
+   Number& systime
+)
+{
+#if defined(_MSC_VER) || defined(__MSVCRT__)
+   cputime = CpuTime();
+   systime = SysTime();
+#else
+   struct rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+   cputime = (double)usage.ru_utime.tv_sec;
+   cputime += 1.0e-6 * ((double) usage.ru_utime.tv_usec);
+   systime = (double)usage.ru_stime.tv_sec;
+   systime += 1.0e-6 * ((double) usage.ru_stime.tv_usec);
+#endif
+}
+
 Number WallclockTime()
 {
-   double callTime = IpCoinGetTimeOfDay();
+   double callTime = IpMonotonicTime();
    if( Wallclock_firstCall_ == -1. )
    {
       Wallclock_firstCall_ = callTime;
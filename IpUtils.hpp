@@ -97,7 +97,19 @@ IPOPTLIB_EXPORT Number CpuTime();
 /** method determining system time */
 IPOPTLIB_EXPORT Number SysTime();
 
-/** method determining wallclock time since first call */
+/** method determining CPU and system time with a single query
+ *
+ *  This is cheaper than calling CpuTime() and SysTime().
+ */
+IPOPTLIB_EXPORT void CpuAndSysTime(
+   Number& cputime,
+   Number& systime
+);
+
+/** method determining wallclock time since first call
+ *
+ *  The time is taken from a monotonic clock.
+ */
 IPOPTLIB_EXPORT Number WallclockTime();
 
 /** Method for comparing two numbers within machine precision.